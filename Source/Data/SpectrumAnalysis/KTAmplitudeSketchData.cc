@@ -0,0 +1,123 @@
+/*
+ * KTAmplitudeSketchData.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "KTAmplitudeSketchData.hh"
+
+#include "KTAmplitudeDistribution.hh"
+#include "KTLogger.hh"
+
+namespace Katydid
+{
+    KTLOGGER(datalog, "KTAmplitudeSketchData");
+
+    const std::string KTAmplitudeSketchData::sName("amplitude-sketch");
+
+    KTAmplitudeSketchData::KTAmplitudeSketchData() :
+            KTExtensibleData< KTAmplitudeSketchData >(),
+            fSketches(),
+            fCompression(100.)
+    {
+    }
+
+    KTAmplitudeSketchData::~KTAmplitudeSketchData()
+    {
+    }
+
+    bool KTAmplitudeSketchData::Initialize(unsigned nComponents, unsigned nFreqBins, double compression)
+    {
+        fCompression = compression;
+        fSketches.clear();
+        fSketches.resize(nComponents, ComponentSketches(nFreqBins, KTTDigest(compression)));
+        return true;
+    }
+
+    bool KTAmplitudeSketchData::Merge(const KTAmplitudeSketchData& other)
+    {
+        if (other.GetNComponents() != GetNComponents() || other.GetNFreqBins() != GetNFreqBins())
+        {
+            KTERROR(datalog, "Cannot merge sketches with different shapes: (" << other.GetNComponents() << " components, " << other.GetNFreqBins() << " frequency bins) into ("
+                    << GetNComponents() << " components, " << GetNFreqBins() << " frequency bins)");
+            return false;
+        }
+
+        for (unsigned iComponent = 0; iComponent < fSketches.size(); ++iComponent)
+        {
+            for (unsigned iFreqBin = 0; iFreqBin < fSketches[iComponent].size(); ++iFreqBin)
+            {
+                fSketches[iComponent][iFreqBin].Merge(other.fSketches[iComponent][iFreqBin]);
+            }
+        }
+        return true;
+    }
+
+    bool KTAmplitudeSketchData::ExportDistributions(KTAmplitudeDistribution& distributions, unsigned distNBins) const
+    {
+        if (distNBins == 0)
+        {
+            KTERROR(datalog, "Distributions need at least one bin");
+            return false;
+        }
+
+        distributions.InitializeNull(GetNComponents(), GetNFreqBins());
+        for (unsigned iComponent = 0; iComponent < fSketches.size(); ++iComponent)
+        {
+            for (unsigned iFreqBin = 0; iFreqBin < fSketches[iComponent].size(); ++iFreqBin)
+            {
+                const KTTDigest& sketch = fSketches[iComponent][iFreqBin];
+                if (sketch.Empty())
+                {
+                    distributions.InitializeADistribution(iComponent, iFreqBin, distNBins, 0., 1.);
+                    for (unsigned iDistBin = 0; iDistBin < distNBins; ++iDistBin) distributions.SetDistValue(0., iFreqBin, iDistBin, iComponent);
+                    continue;
+                }
+
+                double distMin = sketch.GetMin();
+                double distMax = sketch.GetMax();
+                if (distMax <= distMin) distMax = distMin + 1.;
+                distributions.InitializeADistribution(iComponent, iFreqBin, distNBins, distMin, distMax);
+
+                // the content of each bin is the weight between its edges
+                double binWidth = (distMax - distMin) / double(distNBins);
+                double lowerCDF = 0.;
+                for (unsigned iDistBin = 0; iDistBin < distNBins; ++iDistBin)
+                {
+                    double upperCDF = iDistBin + 1 == distNBins ? 1. : sketch.CDF(distMin + double(iDistBin + 1) * binWidth);
+                    distributions.SetDistValue(sketch.GetTotalWeight() * (upperCDF - lowerCDF), iFreqBin, iDistBin, iComponent);
+                    lowerCDF = upperCDF;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool KTAmplitudeSketchData::ExportECDF(KTECDF< double >& ecdf, unsigned freqBin, unsigned component) const
+    {
+        if (component >= fSketches.size() || freqBin >= fSketches[component].size())
+        {
+            KTERROR(datalog, "Data does not contain frequency bin " << freqBin << " for component " << component);
+            return false;
+        }
+
+        ecdf.Clear();
+        const KTTDigest& sketch = fSketches[component][freqBin];
+        if (sketch.Empty()) return true;
+
+        // the same points that KTTDigest::CDF interpolates between
+        const std::vector< KTTDigest::Centroid >& centroids = sketch.GetCentroids();
+        double totalWeight = sketch.GetTotalWeight();
+        double weightSoFar = 0.;
+        ecdf.AddPoint(sketch.GetMin(), 0.);
+        for (std::vector< KTTDigest::Centroid >::const_iterator cIt = centroids.begin(); cIt != centroids.end(); ++cIt)
+        {
+            ecdf.AddPoint(cIt->fMean, (weightSoFar + 0.5 * cIt->fWeight) / totalWeight);
+            weightSoFar += cIt->fWeight;
+        }
+        ecdf.AddPoint(sketch.GetMax(), 1.);
+        return true;
+    }
+
+} /* namespace Katydid */
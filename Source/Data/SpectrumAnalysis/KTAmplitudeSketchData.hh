@@ -0,0 +1,107 @@
+/*
+ * KTAmplitudeSketchData.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#ifndef KTAMPLITUDESKETCHDATA_HH_
+#define KTAMPLITUDESKETCHDATA_HH_
+
+#include "KTData.hh"
+
+#include "KTECDF.hh"
+#include "KTTDigest.hh"
+
+#include <vector>
+
+namespace Katydid
+{
+    class KTAmplitudeDistribution;
+
+    /*!
+     @class KTAmplitudeSketchData
+     @author agent
+
+     @brief Streaming sketches of the amplitude distribution in each frequency bin
+
+     @details
+     Each frequency bin of each component has a KTTDigest, so the memory needed is bounded regardless of the number of
+     spectra that are added, and no range has to be known in advance.
+     Sketches from different files can be combined with Merge(), and the result can be exported to the usual
+     histogram form (KTAmplitudeDistribution) or to a KTECDF.
+    */
+    class KTAmplitudeSketchData : public Nymph::KTExtensibleData< KTAmplitudeSketchData >
+    {
+        public:
+            typedef std::vector< KTTDigest > ComponentSketches; // indexed over frequency-axis bins
+            typedef std::vector< ComponentSketches > Sketches; // indexed over component
+
+        public:
+            KTAmplitudeSketchData();
+            virtual ~KTAmplitudeSketchData();
+
+            /// Clears any existing sketches and creates empty ones
+            bool Initialize(unsigned nComponents, unsigned nFreqBins, double compression);
+
+            unsigned GetNComponents() const;
+            unsigned GetNFreqBins() const;
+            double GetCompression() const;
+
+            const KTTDigest& GetSketch(unsigned freqBin, unsigned component = 0) const;
+            KTTDigest& GetSketch(unsigned freqBin, unsigned component = 0);
+
+            void AddValue(unsigned freqBin, double value, unsigned component = 0);
+
+            /// Adds the values summarized by another set of sketches; the numbers of components and frequency bins have to match
+            bool Merge(const KTAmplitudeSketchData& other);
+
+            /// Fills a histogram of distNBins bins for every frequency bin, spanning the minimum to maximum value of each sketch
+            /// Frequency bins with no values get an empty histogram over [0, 1].
+            bool ExportDistributions(KTAmplitudeDistribution& distributions, unsigned distNBins) const;
+
+            /// Fills an ECDF with the points at which the sketch's CDF is interpolated
+            bool ExportECDF(KTECDF< double >& ecdf, unsigned freqBin, unsigned component = 0) const;
+
+        private:
+            Sketches fSketches;
+            double fCompression;
+
+        public:
+            static const std::string sName;
+    };
+
+    inline unsigned KTAmplitudeSketchData::GetNComponents() const
+    {
+        return unsigned(fSketches.size());
+    }
+
+    inline unsigned KTAmplitudeSketchData::GetNFreqBins() const
+    {
+        return fSketches.empty() ? 0 : unsigned(fSketches[0].size());
+    }
+
+    inline double KTAmplitudeSketchData::GetCompression() const
+    {
+        return fCompression;
+    }
+
+    inline const KTTDigest& KTAmplitudeSketchData::GetSketch(unsigned freqBin, unsigned component) const
+    {
+        return fSketches[component][freqBin];
+    }
+
+    inline KTTDigest& KTAmplitudeSketchData::GetSketch(unsigned freqBin, unsigned component)
+    {
+        return fSketches[component][freqBin];
+    }
+
+    inline void KTAmplitudeSketchData::AddValue(unsigned freqBin, double value, unsigned component)
+    {
+        fSketches[component][freqBin].Add(value);
+        return;
+    }
+
+} /* namespace Katydid */
+
+#endif /* KTAMPLITUDESKETCHDATA_HH_ */
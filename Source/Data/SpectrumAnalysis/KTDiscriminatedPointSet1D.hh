@@ -0,0 +1,328 @@
+/*
+ * KTDiscriminatedPointSet1D.hh
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Flat, bin-sorted container for 1-D discriminated points.
+ *  Each point quantity is stored in its own array (structure of arrays), so filling a slice
+ *  costs a handful of amortized appends instead of a heap allocation and tree insertion per point,
+ *  and consumers that only need one quantity (e.g. the abscissa) stream through contiguous memory.
+ *
+ *  The iteration interface mimics the std::map< unsigned, Point > that it replaced:
+ *  dereferencing an iterator gives a std::pair whose first is the bin and whose second is the Point.
+ *  The pair is assembled on the fly, so iterators are read-only.
+ *  Performance-sensitive code should use the index-based accessors instead.
+ */
+
+#ifndef KTDISCRIMINATEDPOINTSET1D_HH_
+#define KTDISCRIMINATEDPOINTSET1D_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace Katydid
+{
+
+    class KTDiscriminatedPointSet1D
+    {
+        public:
+            struct Point
+            {
+                double fAbscissa;
+                double fOrdinate;
+                double fThreshold;
+                double fMean;
+                double fVariance;
+                double fNeighborhoodAmplitude;
+                Point(double abscissa, double ordinate, double threshold, double mean, double variance, double neighborhoodAmplitude) : fAbscissa(abscissa), fOrdinate(ordinate), fThreshold(threshold), fMean(mean), fVariance(variance), fNeighborhoodAmplitude(neighborhoodAmplitude) {}
+            };
+
+            typedef unsigned key_type;
+            typedef Point mapped_type;
+            typedef std::pair< unsigned, Point > value_type;
+            typedef std::size_t size_type;
+
+            class const_iterator
+            {
+                public:
+                    typedef std::bidirectional_iterator_tag iterator_category;
+                    typedef KTDiscriminatedPointSet1D::value_type value_type;
+                    typedef std::ptrdiff_t difference_type;
+                    typedef value_type reference;
+
+                    /// Holds the assembled pair so that operator-> has something to point to
+                    class pointer
+                    {
+                        public:
+                            pointer(const value_type& value) : fValue(value) {}
+                            const value_type* operator->() const {return &fValue;}
+                        private:
+                            value_type fValue;
+                    };
+
+                public:
+                    const_iterator() : fSet(NULL), fIndex(0) {}
+                    const_iterator(const KTDiscriminatedPointSet1D* set, size_type index) : fSet(set), fIndex(index) {}
+
+                    reference operator*() const {return value_type(fSet->GetBin(fIndex), fSet->GetPoint(fIndex));}
+                    pointer operator->() const {return pointer(**this);}
+
+                    const_iterator& operator++() {++fIndex; return *this;}
+                    const_iterator operator++(int) {const_iterator old(*this); ++fIndex; return old;}
+                    const_iterator& operator--() {--fIndex; return *this;}
+                    const_iterator operator--(int) {const_iterator old(*this); --fIndex; return old;}
+
+                    bool operator==(const const_iterator& rhs) const {return fIndex == rhs.fIndex && fSet == rhs.fSet;}
+                    bool operator!=(const const_iterator& rhs) const {return ! (*this == rhs);}
+
+                    /// Position of the point in the set; use with the index-based accessors
+                    size_type GetIndex() const {return fIndex;}
+
+                private:
+                    const KTDiscriminatedPointSet1D* fSet;
+                    size_type fIndex;
+            };
+            typedef const_iterator iterator;
+
+        public:
+            KTDiscriminatedPointSet1D();
+            ~KTDiscriminatedPointSet1D();
+
+            size_type size() const;
+            bool empty() const;
+            void clear();
+            void reserve(size_type nPoints);
+
+            const_iterator begin() const;
+            const_iterator end() const;
+            const_iterator find(unsigned bin) const;
+            size_type count(unsigned bin) const;
+
+            /// Adds a point; points are expected in increasing bin order, in which case this is an append.
+            /// Out-of-order points are inserted in place; as with std::map, a point in an already-occupied bin is ignored.
+            /// Returns true if the point was added.
+            bool Add(unsigned bin, const Point& point);
+            /// std::map-style insert, for compatibility
+            std::pair< const_iterator, bool > insert(const value_type& binAndPoint);
+
+            unsigned GetBin(size_type index) const;
+            double GetAbscissa(size_type index) const;
+            double GetOrdinate(size_type index) const;
+            double GetThreshold(size_type index) const;
+            double GetMean(size_type index) const;
+            double GetVariance(size_type index) const;
+            double GetNeighborhoodAmplitude(size_type index) const;
+            Point GetPoint(size_type index) const;
+
+            const std::vector< unsigned >& GetBins() const;
+            const std::vector< double >& GetAbscissae() const;
+            const std::vector< double >& GetOrdinates() const;
+            const std::vector< double >& GetThresholds() const;
+            const std::vector< double >& GetMeans() const;
+            const std::vector< double >& GetVariances() const;
+            const std::vector< double >& GetNeighborhoodAmplitudes() const;
+
+        private:
+            void InsertAt(size_type index, unsigned bin, const Point& point);
+
+            std::vector< unsigned > fBins;
+            std::vector< double > fAbscissae;
+            std::vector< double > fOrdinates;
+            std::vector< double > fThresholds;
+            std::vector< double > fMeans;
+            std::vector< double > fVariances;
+            std::vector< double > fNeighborhoodAmplitudes;
+    };
+
+    inline KTDiscriminatedPointSet1D::KTDiscriminatedPointSet1D() :
+            fBins(),
+            fAbscissae(),
+            fOrdinates(),
+            fThresholds(),
+            fMeans(),
+            fVariances(),
+            fNeighborhoodAmplitudes()
+    {
+    }
+
+    inline KTDiscriminatedPointSet1D::~KTDiscriminatedPointSet1D()
+    {
+    }
+
+    inline KTDiscriminatedPointSet1D::size_type KTDiscriminatedPointSet1D::size() const
+    {
+        return fBins.size();
+    }
+
+    inline bool KTDiscriminatedPointSet1D::empty() const
+    {
+        return fBins.empty();
+    }
+
+    inline void KTDiscriminatedPointSet1D::clear()
+    {
+        fBins.clear();
+        fAbscissae.clear();
+        fOrdinates.clear();
+        fThresholds.clear();
+        fMeans.clear();
+        fVariances.clear();
+        fNeighborhoodAmplitudes.clear();
+        return;
+    }
+
+    inline void KTDiscriminatedPointSet1D::reserve(size_type nPoints)
+    {
+        fBins.reserve(nPoints);
+        fAbscissae.reserve(nPoints);
+        fOrdinates.reserve(nPoints);
+        fThresholds.reserve(nPoints);
+        fMeans.reserve(nPoints);
+        fVariances.reserve(nPoints);
+        fNeighborhoodAmplitudes.reserve(nPoints);
+        return;
+    }
+
+    inline KTDiscriminatedPointSet1D::const_iterator KTDiscriminatedPointSet1D::begin() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    inline KTDiscriminatedPointSet1D::const_iterator KTDiscriminatedPointSet1D::end() const
+    {
+        return const_iterator(this, fBins.size());
+    }
+
+    inline KTDiscriminatedPointSet1D::const_iterator KTDiscriminatedPointSet1D::find(unsigned bin) const
+    {
+        std::vector< unsigned >::const_iterator binIt = std::lower_bound(fBins.begin(), fBins.end(), bin);
+        if (binIt == fBins.end() || *binIt != bin) return end();
+        return const_iterator(this, binIt - fBins.begin());
+    }
+
+    inline KTDiscriminatedPointSet1D::size_type KTDiscriminatedPointSet1D::count(unsigned bin) const
+    {
+        return std::binary_search(fBins.begin(), fBins.end(), bin) ? 1 : 0;
+    }
+
+    inline bool KTDiscriminatedPointSet1D::Add(unsigned bin, const Point& point)
+    {
+        // fast path: points arrive in increasing bin order
+        if (fBins.empty() || bin > fBins.back())
+        {
+            fBins.push_back(bin);
+            fAbscissae.push_back(point.fAbscissa);
+            fOrdinates.push_back(point.fOrdinate);
+            fThresholds.push_back(point.fThreshold);
+            fMeans.push_back(point.fMean);
+            fVariances.push_back(point.fVariance);
+            fNeighborhoodAmplitudes.push_back(point.fNeighborhoodAmplitude);
+            return true;
+        }
+
+        std::vector< unsigned >::iterator binIt = std::lower_bound(fBins.begin(), fBins.end(), bin);
+        if (*binIt == bin) return false;
+        InsertAt(binIt - fBins.begin(), bin, point);
+        return true;
+    }
+
+    inline std::pair< KTDiscriminatedPointSet1D::const_iterator, bool > KTDiscriminatedPointSet1D::insert(const value_type& binAndPoint)
+    {
+        bool added = Add(binAndPoint.first, binAndPoint.second);
+        return std::make_pair(find(binAndPoint.first), added);
+    }
+
+    inline void KTDiscriminatedPointSet1D::InsertAt(size_type index, unsigned bin, const Point& point)
+    {
+        fBins.insert(fBins.begin() + index, bin);
+        fAbscissae.insert(fAbscissae.begin() + index, point.fAbscissa);
+        fOrdinates.insert(fOrdinates.begin() + index, point.fOrdinate);
+        fThresholds.insert(fThresholds.begin() + index, point.fThreshold);
+        fMeans.insert(fMeans.begin() + index, point.fMean);
+        fVariances.insert(fVariances.begin() + index, point.fVariance);
+        fNeighborhoodAmplitudes.insert(fNeighborhoodAmplitudes.begin() + index, point.fNeighborhoodAmplitude);
+        return;
+    }
+
+    inline unsigned KTDiscriminatedPointSet1D::GetBin(size_type index) const
+    {
+        return fBins[index];
+    }
+
+    inline double KTDiscriminatedPointSet1D::GetAbscissa(size_type index) const
+    {
+        return fAbscissae[index];
+    }
+
+    inline double KTDiscriminatedPointSet1D::GetOrdinate(size_type index) const
+    {
+        return fOrdinates[index];
+    }
+
+    inline double KTDiscriminatedPointSet1D::GetThreshold(size_type index) const
+    {
+        return fThresholds[index];
+    }
+
+    inline double KTDiscriminatedPointSet1D::GetMean(size_type index) const
+    {
+        return fMeans[index];
+    }
+
+    inline double KTDiscriminatedPointSet1D::GetVariance(size_type index) const
+    {
+        return fVariances[index];
+    }
+
+    inline double KTDiscriminatedPointSet1D::GetNeighborhoodAmplitude(size_type index) const
+    {
+        return fNeighborhoodAmplitudes[index];
+    }
+
+    inline KTDiscriminatedPointSet1D::Point KTDiscriminatedPointSet1D::GetPoint(size_type index) const
+    {
+        return Point(fAbscissae[index], fOrdinates[index], fThresholds[index], fMeans[index], fVariances[index], fNeighborhoodAmplitudes[index]);
+    }
+
+    inline const std::vector< unsigned >& KTDiscriminatedPointSet1D::GetBins() const
+    {
+        return fBins;
+    }
+
+    inline const std::vector< double >& KTDiscriminatedPointSet1D::GetAbscissae() const
+    {
+        return fAbscissae;
+    }
+
+    inline const std::vector< double >& KTDiscriminatedPointSet1D::GetOrdinates() const
+    {
+        return fOrdinates;
+    }
+
+    inline const std::vector< double >& KTDiscriminatedPointSet1D::GetThresholds() const
+    {
+        return fThresholds;
+    }
+
+    inline const std::vector< double >& KTDiscriminatedPointSet1D::GetMeans() const
+    {
+        return fMeans;
+    }
+
+    inline const std::vector< double >& KTDiscriminatedPointSet1D::GetVariances() const
+    {
+        return fVariances;
+    }
+
+    inline const std::vector< double >& KTDiscriminatedPointSet1D::GetNeighborhoodAmplitudes() const
+    {
+        return fNeighborhoodAmplitudes;
+    }
+
+} /* namespace Katydid */
+
+#endif /* KTDISCRIMINATEDPOINTSET1D_HH_ */
@@ -10,10 +10,9 @@
 
 #include "KTData.hh"
 
+#include "KTDiscriminatedPointSet1D.hh"
 #include "KTMemberVariable.hh"
 
-#include <map>
-#include <utility>
 #include <vector>
 
 namespace Katydid
@@ -23,17 +22,8 @@ namespace Katydid
     class KTDiscriminatedPoints1DData : public Nymph::KTExtensibleData< KTDiscriminatedPoints1DData >
     {
         public:
-            struct Point
-            {
-                double fAbscissa;
-                double fOrdinate;
-                double fThreshold;
-                double fMean;
-                double fVariance;
-                double fNeighborhoodAmplitude;
-                Point(double abscissa, double ordinate, double threshold, double mean, double variance, double neighborhoodAmplitude) : fAbscissa(abscissa), fOrdinate(ordinate), fThreshold(threshold), fMean(mean), fVariance(variance), fNeighborhoodAmplitude(neighborhoodAmplitude) {}
-            };
-            typedef std::map< unsigned, Point > SetOfPoints;
+            typedef KTDiscriminatedPointSet1D SetOfPoints;
+            typedef SetOfPoints::Point Point;
 
         protected:
             struct PerComponentData
@@ -49,8 +39,12 @@ namespace Katydid
 
             unsigned GetNComponents() const;
 
+            /// Points should be added in increasing bin order (see KTDiscriminatedPointSet1D)
             void AddPoint(unsigned bin, const Point& point, unsigned component = 0);
 
+            /// Pre-allocate space for nPoints in a component
+            void ReservePoints(unsigned nPoints, unsigned component = 0);
+
             KTDiscriminatedPoints1DData& SetNComponents(unsigned channels);
 
         private:
@@ -76,7 +70,13 @@ namespace Katydid
     inline void KTDiscriminatedPoints1DData::AddPoint(unsigned bin, const Point& point, unsigned component)
     {
         if (component >= fComponentData.size()) fComponentData.resize(component+1);
-        fComponentData[component].fPoints.insert(std::make_pair(bin, point));
+        fComponentData[component].fPoints.Add(bin, point);
+    }
+
+    inline void KTDiscriminatedPoints1DData::ReservePoints(unsigned nPoints, unsigned component)
+    {
+        if (component >= fComponentData.size()) fComponentData.resize(component+1);
+        fComponentData[component].fPoints.reserve(nPoints);
     }
 
     inline KTDiscriminatedPoints1DData& KTDiscriminatedPoints1DData::SetNComponents(unsigned channels)
@@ -16,69 +16,34 @@ namespace Katydid
             KTExtensibleData< KTGainVariationData >(),
             fComponentData(1)
     {
-        fComponentData[0].fSpline = NULL;
-        fComponentData[0].fVarianceSpline = NULL;
     }
 
     KTGainVariationData::KTGainVariationData(const KTGainVariationData& orig) :
             KTExtensibleData< KTGainVariationData >(orig),
-            fComponentData(orig.fComponentData.size())
+            fComponentData(orig.fComponentData)
     {
-        unsigned nComponents = fComponentData.size();
-        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
-        {
-            fComponentData[iComponent].fSpline = new KTSpline(*orig.fComponentData[iComponent].fSpline);
-            fComponentData[iComponent].fVarianceSpline = new KTSpline(*orig.fComponentData[iComponent].fVarianceSpline);
-        }
     }
 
     KTGainVariationData::~KTGainVariationData()
     {
-        while (! fComponentData.empty())
-        {
-            delete fComponentData.back().fSpline;
-            delete fComponentData.back().fVarianceSpline;
-            fComponentData.pop_back();
-        }
     }
 
     KTGainVariationData& KTGainVariationData::operator=(const KTGainVariationData& rhs)
     {
-        unsigned nComponents = rhs.GetNComponents();
-        SetNComponents(nComponents);
-        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
-        {
-            delete fComponentData[iComponent].fSpline;
-            delete fComponentData[iComponent].fVarianceSpline;
-            fComponentData[iComponent].fSpline = new KTSpline(*rhs.fComponentData[iComponent].fSpline);
-            fComponentData[iComponent].fVarianceSpline = new KTSpline(*rhs.fComponentData[iComponent].fVarianceSpline);
-        }
+        fComponentData = rhs.fComponentData;
         return *this;
     }
 
     KTGainVariationData& KTGainVariationData::SetNComponents(unsigned components)
     {
-        unsigned oldSize = fComponentData.size();
-        // if components < oldSize
-        for (unsigned iComponent = components; iComponent < oldSize; ++iComponent)
-        {
-            delete fComponentData[iComponent].fSpline;
-            delete fComponentData[iComponent].fVarianceSpline;
-        }
         fComponentData.resize(components);
-        // if components > oldSize
-        for (unsigned iComponent = oldSize; iComponent < components; ++iComponent)
-        {
-            fComponentData[iComponent].fSpline = NULL;
-            fComponentData[iComponent].fVarianceSpline = NULL;
-        }
         return *this;
     }
 
 #ifdef ROOT_FOUND
     TH1D* KTGainVariationData::CreateGainVariationHistogram(unsigned nBins, unsigned component, const std::string& name) const
     {
-        KTSpline* spline = fComponentData[component].fSpline;
+        KTSpline* spline = fComponentData[component].fSpline.get();
         TH1D* hist = new TH1D(name.c_str(), "Frequency Spectrum: Magnitude", nBins, spline->GetXMin(), spline->GetXMax());
         for (unsigned iBin=0; iBin<nBins; iBin++)
         {
@@ -90,7 +55,7 @@ namespace Katydid
     }
     TH1D* KTGainVariationData::CreateGainVariationVarianceHistogram(unsigned nBins, unsigned component, const std::string& name) const
     {
-        KTSpline* spline = fComponentData[component].fVarianceSpline;
+        KTSpline* spline = fComponentData[component].fVarianceSpline.get();
         TH1D* hist = new TH1D(name.c_str(), "Frequency Spectrum: Variance", nBins, spline->GetXMin(), spline->GetXMax());
         for (unsigned iBin=0; iBin<nBins; iBin++)
         {
@@ -16,19 +16,31 @@
 #include "TH1.h"
 #endif
 
+#include <memory>
 #include <vector>
 
 namespace Katydid
 {
     
 
+    /*!
+     @class KTGainVariationData
+     @author N. S. Oblath
+
+     @brief Gain variation (background mean) and variance splines for each component.
+
+     @details
+     The splines are held by shared pointer: copies of the data, and data objects that were given the same spline
+     (e.g. every slice fit while the background is stable), share the spline objects rather than duplicating them.
+     Splines should therefore not be modified once they've been handed to a KTGainVariationData.
+    */
     class KTGainVariationData : public Nymph::KTExtensibleData< KTGainVariationData >
     {
         protected:
             struct PerComponentData
             {
-                KTSpline* fSpline;
-                KTSpline* fVarianceSpline;
+                std::shared_ptr< KTSpline > fSpline;
+                std::shared_ptr< KTSpline > fVarianceSpline;
             };
 
         public:
@@ -46,9 +58,14 @@ namespace Katydid
 
             unsigned GetNComponents() const;
 
+            /// Takes ownership of the spline
             void SetSpline(KTSpline* spline, unsigned component = 0);
+            /// Takes ownership of the spline
             void SetVarianceSpline(KTSpline* spline, unsigned component = 0);
 
+            void SetSpline(std::shared_ptr< KTSpline > spline, unsigned component = 0);
+            void SetVarianceSpline(std::shared_ptr< KTSpline > spline, unsigned component = 0);
+
             KTGainVariationData& SetNComponents(unsigned components);
 
         private:
@@ -66,22 +83,22 @@ namespace Katydid
 
     inline const KTSpline* KTGainVariationData::GetSpline(unsigned component) const
     {
-        return fComponentData[component].fSpline;
+        return fComponentData[component].fSpline.get();
     }
 
     inline KTSpline* KTGainVariationData::GetSpline(unsigned component)
     {
-        return fComponentData[component].fSpline;
+        return fComponentData[component].fSpline.get();
     }
 
     inline const KTSpline* KTGainVariationData::GetVarianceSpline(unsigned component) const
     {
-        return fComponentData[component].fVarianceSpline;
+        return fComponentData[component].fVarianceSpline.get();
     }
 
     inline KTSpline* KTGainVariationData::GetVarianceSpline(unsigned component)
     {
-        return fComponentData[component].fVarianceSpline;
+        return fComponentData[component].fVarianceSpline.get();
     }
 
     inline unsigned KTGainVariationData::GetNComponents() const
@@ -90,16 +107,24 @@ namespace Katydid
     }
 
     inline void KTGainVariationData::SetSpline(KTSpline* spline, unsigned component)
+    {
+        SetSpline(std::shared_ptr< KTSpline >(spline), component);
+    }
+
+    inline void KTGainVariationData::SetVarianceSpline(KTSpline* spline, unsigned component)
+    {
+        SetVarianceSpline(std::shared_ptr< KTSpline >(spline), component);
+    }
+
+    inline void KTGainVariationData::SetSpline(std::shared_ptr< KTSpline > spline, unsigned component)
     {
         if (component >= fComponentData.size()) fComponentData.resize(component+1);
-        delete fComponentData[component].fSpline;
         fComponentData[component].fSpline = spline;
     }
 
-    inline void KTGainVariationData::SetVarianceSpline(KTSpline* spline, unsigned component)
+    inline void KTGainVariationData::SetVarianceSpline(std::shared_ptr< KTSpline > spline, unsigned component)
     {
         if (component >= fComponentData.size()) fComponentData.resize(component+1);
-        delete fComponentData[component].fVarianceSpline;
         fComponentData[component].fVarianceSpline = spline;
     }
 
@@ -14,6 +14,11 @@
 
 //#include <iostream>
 
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 namespace Katydid
@@ -216,6 +221,242 @@ namespace Katydid
     };
 
 
+    //***************************************
+    // Forest of k-d trees over blocks of points
+    //***************************************
+
+    // For streaming points: each block of consecutive points gets its own k-d tree, which is built once when the block is added.
+    // Blocks are retired from the front as a unit when their points are removed, so the index never has to be rebuilt as a whole.
+    // Queries are run on every block, and the results are merged; point IDs are the indices of the points in the full dataset.
+
+    template< typename TYPE >
+    struct KTTreeIndexForest : KTTreeIndex< TYPE >
+    {
+        virtual ~KTTreeIndexForest() {}
+
+        /// Indexes the next nPoints points in the dataset (after the ones already indexed) as a new block
+        virtual void AddBlock(size_t nPoints) = 0;
+        /// To be called after the first nPoints points have been removed from the dataset; a block that was only partly removed is rebuilt
+        virtual void RetireFirstPoints(size_t nPoints) = 0;
+
+        virtual size_t GetNBlocks() const = 0;
+    };
+
+    template< typename TYPE, typename DatasetAdaptor, bool EUCLIDEAN >
+    struct KTTreeIndexBlockForest : KTTreeIndexForest< TYPE >
+    {
+        typedef typename KTTreeIndex< TYPE >::PointId PointId;
+        typedef typename KTTreeIndex< TYPE >::Neighbors Neighbors;
+
+        // View of a block of consecutive points in the dataset
+        struct BlockAdaptor
+        {
+            const DatasetAdaptor* fDataset;
+            size_t fFirstPoint;
+            size_t fNPoints;
+
+            inline size_t kdtree_get_point_count() const {return fNPoints;}
+            inline TYPE kdtree_get_pt(const size_t idx, int dim) const {return fDataset->kdtree_get_pt(fFirstPoint + idx, dim);}
+            template< class BBOX >
+            bool kdtree_get_bbox(BBOX&) const {return false;}
+        };
+
+        typedef typename std::conditional< EUCLIDEAN, nanoflann::L2_Simple_Adaptor< TYPE, BlockAdaptor >, nanoflann::L1_Adaptor< TYPE, BlockAdaptor > >::type BlockMetric;
+        typedef nanoflann::KDTreeSingleIndexAdaptor< BlockMetric, BlockAdaptor, 2 > BlockIndex;
+
+        struct Block
+        {
+            BlockAdaptor fPoints;
+            BlockIndex fIndex; // holds a reference to fPoints, so blocks can't be moved
+
+            Block(const DatasetAdaptor& dataset, size_t firstPoint, size_t nPoints, const nanoflann::KDTreeSingleIndexAdaptorParams& params) :
+                fPoints{&dataset, firstPoint, nPoints},
+                fIndex(2, fPoints, params)
+            {
+                fIndex.buildIndex();
+            }
+        };
+
+        // Passes the results from a block to the full result set, with the point IDs shifted from the block to the dataset
+        template< typename RESULTSET >
+        struct BlockResultSet
+        {
+            RESULTSET& fResult;
+            size_t fFirstPoint;
+
+            inline bool addPoint(TYPE dist, size_t index) {return fResult.addPoint(dist, index + fFirstPoint);}
+            inline TYPE worstDist() const {return fResult.worstDist();}
+            inline bool full() const {return fResult.full();}
+            inline size_t size() const {return fResult.size();}
+        };
+
+        KTTreeIndexBlockForest(const int /*dimensionality*/, const DatasetAdaptor& inputData, const nanoflann::KDTreeSingleIndexAdaptorParams& params = nanoflann::KDTreeSingleIndexAdaptorParams()) :
+            fDataset(inputData),
+            fParams(params),
+            fBlocks(),
+            fNIndexed(0)
+        {}
+        virtual ~KTTreeIndexBlockForest()
+        {
+            FreeIndex();
+        }
+
+        void AddBlock(size_t nPoints)
+        {
+            if (nPoints == 0) return;
+            fBlocks.push_back(new Block(fDataset, fNIndexed, nPoints, fParams));
+            fNIndexed += nPoints;
+            return;
+        }
+
+        void RetireFirstPoints(size_t nPoints)
+        {
+            if (nPoints >= fNIndexed)
+            {
+                FreeIndex();
+                return;
+            }
+
+            while (! fBlocks.empty() && fBlocks.front()->fPoints.fFirstPoint + fBlocks.front()->fPoints.fNPoints <= nPoints)
+            {
+                delete fBlocks.front();
+                fBlocks.pop_front();
+            }
+            size_t nToRebuild = 0;
+            if (! fBlocks.empty() && fBlocks.front()->fPoints.fFirstPoint < nPoints)
+            {
+                nToRebuild = fBlocks.front()->fPoints.fFirstPoint + fBlocks.front()->fPoints.fNPoints - nPoints;
+                delete fBlocks.front();
+                fBlocks.pop_front();
+            }
+
+            // the points that are left have moved to the front of the dataset; the trees only store indices relative to their blocks
+            for (typename std::deque< Block* >::iterator bIt = fBlocks.begin(); bIt != fBlocks.end(); ++bIt)
+            {
+                (*bIt)->fPoints.fFirstPoint -= nPoints;
+            }
+            fNIndexed -= nPoints;
+
+            if (nToRebuild != 0)
+            {
+                fBlocks.push_front(new Block(fDataset, 0, nToRebuild, fParams));
+            }
+            return;
+        }
+
+        size_t GetNBlocks() const {return fBlocks.size();}
+
+        void FreeIndex()
+        {
+            while (! fBlocks.empty())
+            {
+                delete fBlocks.back();
+                fBlocks.pop_back();
+            }
+            fNIndexed = 0;
+            return;
+        }
+        void BuildIndex()
+        {
+            FreeIndex();
+            AddBlock(fDataset.kdtree_get_point_count());
+            return;
+        }
+
+        size_t size() const {return fNIndexed;}
+        size_t Veclen() {return 2;}
+        size_t UsedMemory()
+        {
+            size_t memory = 0;
+            for (typename std::deque< Block* >::iterator bIt = fBlocks.begin(); bIt != fBlocks.end(); ++bIt)
+            {
+                memory += (*bIt)->fIndex.usedMemory((*bIt)->fIndex);
+            }
+            return memory;
+        }
+
+        // the blocks are rebuilt from the points, so there's no stored form
+        void SaveIndex(FILE*) {throw std::logic_error("A forest of k-d trees cannot be saved");}
+        void LoadIndex(FILE*) {throw std::logic_error("A forest of k-d trees cannot be loaded");}
+
+        template< typename RESULTSET >
+        void FindNeighborsInBlocks(RESULTSET& result, const TYPE* vec, const nanoflann::SearchParams& searchParams) const
+        {
+            for (typename std::deque< Block* >::const_iterator bIt = fBlocks.begin(); bIt != fBlocks.end(); ++bIt)
+            {
+                BlockResultSet< RESULTSET > blockResult = {result, (*bIt)->fPoints.fFirstPoint};
+                (*bIt)->fIndex.findNeighbors(blockResult, vec, searchParams);
+            }
+            return;
+        }
+
+        void FindNeighbors(nanoflann::KNNResultSet< TYPE >& result, const TYPE* vec, const nanoflann::SearchParams& searchParams) const
+        {
+            FindNeighborsInBlocks(result, vec, searchParams);
+        }
+        void FindNeighbors(nanoflann::RadiusResultSet< TYPE >& result, const TYPE* vec, const nanoflann::SearchParams& searchParams) const
+        {
+            FindNeighborsInBlocks(result, vec, searchParams);
+        }
+        void KNNSearch(const TYPE* query_point, const size_t num_closest, size_t* out_indices, TYPE* out_distances_sq, const int /*nChecks_IGNORED*/=10) const
+        {
+            nanoflann::KNNResultSet< TYPE > result(num_closest);
+            result.init(out_indices, out_distances_sq);
+            FindNeighborsInBlocks(result, query_point, nanoflann::SearchParams());
+        }
+        size_t RadiusSearch(const TYPE* query_point, const TYPE radius, std::vector< std::pair< size_t, TYPE > >& IndicesDists, const nanoflann::SearchParams& searchParams) const
+        {
+            // nanoflann uses radius^2 for euclidean distances
+            nanoflann::RadiusResultSet< TYPE > result(EUCLIDEAN ? radius*radius : radius, IndicesDists);
+            FindNeighborsInBlocks(result, query_point, searchParams);
+            if (searchParams.sorted) std::sort(IndicesDists.begin(), IndicesDists.end(), nanoflann::IndexDist_Sorter());
+            return IndicesDists.size();
+        }
+        Neighbors NearestNeighborsByRadius(PointId pid, TYPE radius) const
+        {
+            const TYPE query[2] = {fDataset.kdtree_get_pt(pid, 0), fDataset.kdtree_get_pt(pid, 1)};
+            Neighbors neighbors;
+            RadiusSearch(query, radius, neighbors.GetIndicesAndDists(), nanoflann::SearchParams(32, 0, true));
+            if (EUCLIDEAN)
+            {
+                for (unsigned iPoint = 0; iPoint < neighbors.size(); ++iPoint)
+                {
+                    neighbors.fIndicesAndDists[iPoint].second = sqrt(neighbors.fIndicesAndDists[iPoint].second);
+                }
+            }
+            return neighbors;
+        }
+
+        Neighbors NearestNeighborsByNumber(PointId pid, size_t nPoints) const
+        {
+            const TYPE query[2] = {fDataset.kdtree_get_pt(pid, 0), fDataset.kdtree_get_pt(pid, 1)};
+            std::vector< size_t > out_indices(nPoints);
+            std::vector< TYPE > out_distances_sq(nPoints);
+            nanoflann::KNNResultSet< TYPE > result(nPoints);
+            result.init(out_indices.data(), out_distances_sq.data());
+            FindNeighborsInBlocks(result, query, nanoflann::SearchParams());
+
+            Neighbors neighbors;
+            for (unsigned iPoint = 0; iPoint < result.size(); ++iPoint)
+            {
+                neighbors.GetIndicesAndDists().push_back(std::make_pair(out_indices[iPoint], EUCLIDEAN ? sqrt(out_distances_sq[iPoint]) : out_distances_sq[iPoint]));
+            }
+            return neighbors;
+        }
+
+        const DatasetAdaptor& fDataset;
+        nanoflann::KDTreeSingleIndexAdaptorParams fParams;
+        std::deque< Block* > fBlocks;
+        size_t fNIndexed;
+    };
+
+    template< typename TYPE, typename DatasetAdaptor >
+    using KTTreeIndexForestManhattan = KTTreeIndexBlockForest< TYPE, DatasetAdaptor, false >;
+
+    template< typename TYPE, typename DatasetAdaptor >
+    using KTTreeIndexForestEuclidean = KTTreeIndexBlockForest< TYPE, DatasetAdaptor, true >;
+
+
 } /* namespace Katydid */
 
 #endif /* KTKDTREE_HH_ */
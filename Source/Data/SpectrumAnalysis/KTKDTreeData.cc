@@ -9,6 +9,8 @@
 
 #include "KTLogger.hh"
 
+#include <algorithm>
+
 namespace Katydid
 {
     KTLOGGER(kdtlog, "KTKDTreeData");
@@ -74,7 +76,49 @@ namespace Katydid
             //points.pop_back();
         }
         KTDEBUG(kdtlog, "Removing " << points.size() << " points; original size: " << origSize << "; new size: " << fComponentData[component].fCloud.fPoints.size());
-        BuildIndex();
+        BuildIndex(component);
+        return;
+    }
+
+    void KTKDTreeData::AddIndexBlock(size_t nPoints, unsigned component)
+    {
+        PerComponentData& compData = fComponentData[component];
+        TreeIndexForest* forest = NULL;
+        if (compData.fDistanceMethod == kManhattan) forest = dynamic_cast< KTTreeIndexForestManhattan< double, KTPointCloud< Point > >* >(compData.fTreeIndex);
+        else forest = dynamic_cast< KTTreeIndexForestEuclidean< double, KTPointCloud< Point > >* >(compData.fTreeIndex);
+
+        if (forest == NULL)
+        {
+            size_t nAlreadyIndexed = GetNIndexedPoints(component);
+            delete compData.fTreeIndex;
+            if (compData.fDistanceMethod == kManhattan)
+            {
+                KTDEBUG(kdtlog, "Creating forest index with Manhattan distance metric");
+                forest = new KTTreeIndexForestManhattan< double, KTPointCloud< Point > >(fNDimensions, compData.fCloud, nanoflann::KDTreeSingleIndexAdaptorParams(compData.fMaxLeafSize));
+            }
+            else
+            {
+                KTDEBUG(kdtlog, "Creating forest index with Euclidean distance metric");
+                forest = new KTTreeIndexForestEuclidean< double, KTPointCloud< Point > >(fNDimensions, compData.fCloud, nanoflann::KDTreeSingleIndexAdaptorParams(compData.fMaxLeafSize));
+            }
+            compData.fTreeIndex = forest;
+            forest->AddBlock(nAlreadyIndexed);
+        }
+
+        KTDEBUG(kdtlog, "Adding a block of " << nPoints << " points to the forest for component " << component << "; it now has " << forest->GetNBlocks() + 1 << " blocks");
+        forest->AddBlock(nPoints);
+        return;
+    }
+
+    void KTKDTreeData::RemoveLeadingPoints(size_t nPoints, unsigned component)
+    {
+        PerComponentData& compData = fComponentData[component];
+        nPoints = std::min(nPoints, compData.fCloud.fPoints.size());
+        compData.fCloud.fPoints.erase(compData.fCloud.fPoints.begin(), compData.fCloud.fPoints.begin() + nPoints);
+
+        TreeIndexForest* forest = dynamic_cast< TreeIndexForest* >(compData.fTreeIndex);
+        if (forest != NULL) forest->RetireFirstPoints(nPoints);
+        else ClearIndex(component);
         return;
     }
 
@@ -49,6 +49,7 @@ namespace Katydid
 
             typedef KTPointCloud< Point >::SetOfPoints SetOfPoints;
             typedef KTTreeIndex< double > TreeIndex;
+            typedef KTTreeIndexForest< double > TreeIndexForest;
 
             enum DistanceMethod
             {
@@ -109,6 +110,14 @@ namespace Katydid
             void BuildIndex(unsigned component = 0);
             void BuildIndex(DistanceMethod, unsigned maxLeafSize = 10, unsigned component = 0);
 
+            /// Number of points, from the start of the set of points, that are covered by the index
+            size_t GetNIndexedPoints(unsigned component = 0) const;
+            /// Indexes the next nPoints points that aren't yet indexed as a separate block of a forest of k-d trees
+            /// If the index isn't a forest with the component's distance method, it's replaced by one, and the points it covered become the first block.
+            void AddIndexBlock(size_t nPoints, unsigned component = 0);
+            /// Removes the first nPoints points; if the index is a forest, the blocks with those points are retired, otherwise the index is cleared
+            void RemoveLeadingPoints(size_t nPoints, unsigned component = 0);
+
             KTKDTreeData& SetNComponents(unsigned channels);
 
         private:
@@ -162,6 +171,11 @@ namespace Katydid
         return;
     }
 
+    inline size_t KTKDTreeData::GetNIndexedPoints(unsigned component) const
+    {
+        return fComponentData[component].fTreeIndex == NULL ? 0 : fComponentData[component].fTreeIndex->size();
+    }
+
     inline unsigned KTKDTreeData::GetNComponents() const
     {
         return unsigned(fComponentData.size());
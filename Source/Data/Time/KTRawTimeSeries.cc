@@ -12,14 +12,16 @@ namespace Katydid
 
     KTRawTimeSeries::KTRawTimeSeries() :
             KTVarTypePhysicalArray< uint64_t >(),
-            fSampleSize(1)
+            fSampleSize(1),
+            fStorageOwner()
     {
         SetAt(0., 0);
     }
 
     KTRawTimeSeries::KTRawTimeSeries(size_t dataTypeSize, uint32_t dataFormat, size_t nBins, double rangeMin, double rangeMax) :
             KTVarTypePhysicalArray< uint64_t >(dataTypeSize, dataFormat, nBins, rangeMin, rangeMax),
-            fSampleSize(1)
+            fSampleSize(1),
+            fStorageOwner()
     {
         for (unsigned iBin = 0; iBin < nBins; ++iBin)
         {
@@ -27,10 +29,19 @@ namespace Katydid
         }
     }
 
+    KTRawTimeSeries::KTRawTimeSeries(size_t dataTypeSize, uint32_t dataFormat, storage_type storage, size_t nBins, double rangeMin, double rangeMax, std::shared_ptr< void > storageOwner) :
+            KTVarTypePhysicalArray< uint64_t >(storage, dataTypeSize, dataFormat, nBins, rangeMin, rangeMax),
+            fSampleSize(1),
+            fStorageOwner(storageOwner)
+    {
+    }
+
     KTRawTimeSeries::KTRawTimeSeries(const KTRawTimeSeries& orig) :
-            KTVarTypePhysicalArray< uint64_t >(orig),
-            fSampleSize(orig.fSampleSize)
+            KTVarTypePhysicalArray< uint64_t >(orig, true),
+            fSampleSize(orig.fSampleSize),
+            fStorageOwner()
     {
+        // the data is copied (copyData = true), so a copy of a view owns its own storage
     }
 
     KTRawTimeSeries::~KTRawTimeSeries()
@@ -39,8 +50,10 @@ namespace Katydid
 
     KTRawTimeSeries& KTRawTimeSeries::operator=(const KTRawTimeSeries& rhs)
     {
-        KTVarTypePhysicalArray< uint64_t >::operator=(rhs);
+        if (this == &rhs) return *this;
+        KTVarTypePhysicalArray< uint64_t >::operator=< uint64_t >(rhs);
         fSampleSize = rhs.fSampleSize;
+        fStorageOwner.reset();
         return *this;
     }
 
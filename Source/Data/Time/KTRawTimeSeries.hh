@@ -6,6 +6,10 @@
  *
  *  NOTE: For complex sampling, KTRawTimeSeries consists of a single array with interleaved real and imaginary samples.
  *        A KTRawTimeSeries with N complex samples will have 2*N bins.
+ *
+ *  NOTE: A KTRawTimeSeries can also be a view onto a buffer owned elsewhere (e.g. a record pinned by an egg reader).
+ *        In that case the time series holds a reference to the buffer's owner, which keeps the buffer alive for as long as the view exists.
+ *        Views should be treated as read-only, since the same buffer may be shared by several time series.
  */
 
 #ifndef KTRAWTIMESERIES_HH_
@@ -15,6 +19,8 @@
 
 #include "KTMemberVariable.hh"
 
+#include <memory>
+
 namespace Katydid
 {
     
@@ -24,6 +30,8 @@ namespace Katydid
         public:
             KTRawTimeSeries();
             KTRawTimeSeries(size_t dataTypeSize, uint32_t dataFormat, size_t nBins, double rangeMin, double rangeMax);
+            /// View constructor: no data is copied; storageOwner keeps the buffer that storage points into alive
+            KTRawTimeSeries(size_t dataTypeSize, uint32_t dataFormat, storage_type storage, size_t nBins, double rangeMin, double rangeMax, std::shared_ptr< void > storageOwner);
             KTRawTimeSeries(const KTRawTimeSeries& orig);
             virtual ~KTRawTimeSeries();
 
@@ -33,10 +41,21 @@ namespace Katydid
             template< typename XInterfaceType >
             KTVarTypePhysicalArray< XInterfaceType > CreateInterface() const;
 
+            /// Returns true if this time series is a view onto a buffer owned elsewhere
+            bool IsView() const;
+
             MEMBERVARIABLE(size_t, SampleSize);
 
+        private:
+            std::shared_ptr< void > fStorageOwner;
+
     };
 
+    inline bool KTRawTimeSeries::IsView() const
+    {
+        return ! fOwnsStorage;
+    }
+
     template< typename XInterfaceType >
     KTVarTypePhysicalArray< XInterfaceType > KTRawTimeSeries::CreateInterface() const
     {
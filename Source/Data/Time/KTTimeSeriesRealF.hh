@@ -0,0 +1,84 @@
+/*
+ * KTTimeSeriesRealF.hh
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef KTTIMESERIESREALF_HH_
+#define KTTIMESERIESREALF_HH_
+
+#include "KTPhysicalArray.hh"
+#include "KTTimeSeries.hh"
+
+namespace Katydid
+{
+
+    /*!
+     @class KTTimeSeriesRealF
+     @author agent
+
+     @brief Single-precision real time series
+
+     @details
+     Float counterpart of KTTimeSeriesReal, for use with the single-precision FFT processors (KTForwardFFTWF and KTReverseFFTWF).
+     It can be stored in KTTimeSeriesData like any other time series.
+    */
+    class KTTimeSeriesRealF : public KTTimeSeries, public KTPhysicalArray< 1, float >
+    {
+        public:
+            KTTimeSeriesRealF();
+            KTTimeSeriesRealF(size_t nBins, double rangeMin=0., double rangeMax=1.);
+            KTTimeSeriesRealF(float value, size_t nBins, double rangeMin=0., double rangeMax=1.);
+            KTTimeSeriesRealF(const KTTimeSeriesRealF& orig);
+            virtual ~KTTimeSeriesRealF();
+
+            KTTimeSeriesRealF& operator=(const KTTimeSeriesRealF& rhs);
+
+            virtual void Scale(double scale);
+
+            virtual unsigned GetNTimeBins() const;
+            virtual double GetTimeBinWidth() const;
+
+            virtual void SetValue(unsigned bin, double value);
+            virtual double GetValue(unsigned bin) const;
+
+            virtual void Print(unsigned startPrint, unsigned nToPrint) const;
+
+#ifdef ROOT_FOUND
+        public:
+            virtual TH1D* CreateHistogram(const std::string& name = "hTimeSeries") const;
+            virtual TH1D* CreateAmplitudeDistributionHistogram(const std::string& name = "hTimeSeriesDist") const;
+#endif
+    };
+
+    inline void KTTimeSeriesRealF::Scale(double scale)
+    {
+        this->KTPhysicalArray< 1, float >::operator*=(float(scale));
+        return;
+    }
+
+    inline unsigned KTTimeSeriesRealF::GetNTimeBins() const
+    {
+        return this->size();
+    }
+
+    inline double KTTimeSeriesRealF::GetTimeBinWidth() const
+    {
+        return this->GetBinWidth();
+    }
+
+    inline void KTTimeSeriesRealF::SetValue(unsigned bin, double value)
+    {
+        (*this)(bin) = float(value);
+        return;
+    }
+
+    inline double KTTimeSeriesRealF::GetValue(unsigned bin) const
+    {
+        return (*this)(bin);
+    }
+
+} /* namespace Katydid */
+
+#endif /* KTTIMESERIESREALF_HH_ */
@@ -183,6 +183,34 @@ namespace Katydid
         }
         return *this;
     }
+    const std::string KTConvolvedMultiPSData::sName("convolved-multi-ps");
+
+    KTConvolvedMultiPSData::KTConvolvedMultiPSData() :
+            KTMultiPSDataCore(),
+            KTExtensibleData()
+    {
+    }
+
+    KTConvolvedMultiPSData::~KTConvolvedMultiPSData()
+    {
+    }
+
+    KTConvolvedMultiPSData& KTConvolvedMultiPSData::SetNComponents(unsigned num)
+    {
+        unsigned oldSize = fSpectra.size();
+        // if num < oldSize
+        for (unsigned iComponent = num; iComponent < oldSize; ++iComponent)
+        {
+            DeleteSpectra(iComponent);
+        }
+        fSpectra.resize(num);
+        // if num > oldSize
+        for (unsigned iComponent = oldSize; iComponent < num; ++iComponent)
+        {
+            fSpectra[iComponent] = NULL;
+        }
+        return *this;
+    }
 
 
 } /* namespace Katydid */
@@ -16,6 +16,7 @@
 #include "KTFrequencySpectrumDataFFTW.hh"
 #include "KTFrequencySpectrumPolar.hh"
 #include "KTFrequencySpectrumDataPolar.hh"
+#include "KTMultiPSData.hh"
 
 #include <vector>
 
@@ -99,6 +100,18 @@ namespace Katydid
             static const std::string sName;
 
     };
+    class KTConvolvedMultiPSData : public KTMultiPSDataCore, public Nymph::KTExtensibleData< KTConvolvedMultiPSData >
+    {
+        public:
+            KTConvolvedMultiPSData();
+            virtual ~KTConvolvedMultiPSData();
+
+            KTConvolvedMultiPSData& SetNComponents(unsigned channels);
+
+        public:
+            static const std::string sName;
+
+    };
 
 
 } /* namespace Katydid */
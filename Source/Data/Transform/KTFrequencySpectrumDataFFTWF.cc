@@ -0,0 +1,58 @@
+/*
+ * KTFrequencySpectrumDataFFTWF.cc
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "KTFrequencySpectrumDataFFTWF.hh"
+
+namespace Katydid
+{
+    KTFrequencySpectrumDataFFTWFCore::KTFrequencySpectrumDataFFTWFCore() :
+            KTFrequencySpectrumData(),
+            fSpectra(1)
+    {
+        fSpectra[0] = NULL;
+    }
+
+    KTFrequencySpectrumDataFFTWFCore::~KTFrequencySpectrumDataFFTWFCore()
+    {
+        while (! fSpectra.empty())
+        {
+            delete fSpectra.back();
+            fSpectra.pop_back();
+        }
+    }
+
+
+    const std::string KTFrequencySpectrumDataFFTWF::sName("frequency-spectrum-fftwf");
+
+    KTFrequencySpectrumDataFFTWF::KTFrequencySpectrumDataFFTWF() :
+            KTFrequencySpectrumDataFFTWFCore(),
+            KTExtensibleData< KTFrequencySpectrumDataFFTWF >()
+    {
+    }
+
+    KTFrequencySpectrumDataFFTWF::~KTFrequencySpectrumDataFFTWF()
+    {
+    }
+
+    KTFrequencySpectrumDataFFTWF& KTFrequencySpectrumDataFFTWF::SetNComponents(unsigned components)
+    {
+        unsigned oldSize = fSpectra.size();
+        // if components < oldSize
+        for (unsigned iComponent = components; iComponent < oldSize; ++iComponent)
+        {
+            delete fSpectra[iComponent];
+        }
+        fSpectra.resize(components);
+        // if components > oldSize
+        for (unsigned iComponent = oldSize; iComponent < components; ++iComponent)
+        {
+            fSpectra[iComponent] = NULL;
+        }
+        return *this;
+    }
+
+} /* namespace Katydid */
@@ -0,0 +1,110 @@
+/**
+ @file KTFrequencySpectrumDataFFTWF.hh
+ @brief Contains KTFrequencySpectrumDataFFTWF
+ @details Single-precision counterpart of KTFrequencySpectrumDataFFTW
+ @author: agent
+ @date: Oct 17, 2026
+ */
+
+#ifndef KTFREQUENCYSPECTRUMDATAFFTWF_HH_
+#define KTFREQUENCYSPECTRUMDATAFFTWF_HH_
+
+#include "KTData.hh"
+
+#include "KTFrequencySpectrumFFTWF.hh"
+
+#include <vector>
+
+namespace Katydid
+{
+
+    class KTFrequencySpectrumDataFFTWFCore : public KTFrequencySpectrumData
+    {
+        public:
+            typedef KTFrequencySpectrumFFTWF spectrum_type;
+
+        public:
+            KTFrequencySpectrumDataFFTWFCore();
+            virtual ~KTFrequencySpectrumDataFFTWFCore();
+
+            unsigned GetNComponents() const;
+
+            const KTFrequencySpectrumFFTWF* GetSpectrumFFTWF(unsigned component = 0) const;
+            KTFrequencySpectrumFFTWF* GetSpectrumFFTWF(unsigned component = 0);
+
+            const KTFrequencySpectrum* GetSpectrum(unsigned component = 0) const;
+            KTFrequencySpectrum* GetSpectrum(unsigned component = 0);
+
+            const KTFrequencyDomainArray* GetArray(unsigned component = 0) const;
+            KTFrequencyDomainArray* GetArray(unsigned component = 0);
+
+            void SetSpectrum(KTFrequencySpectrumFFTWF* record, unsigned component = 0);
+
+            virtual KTFrequencySpectrumDataFFTWFCore& SetNComponents(unsigned channels) = 0;
+
+        protected:
+            std::vector< KTFrequencySpectrumFFTWF* > fSpectra;
+
+    };
+
+
+    class KTFrequencySpectrumDataFFTWF : public KTFrequencySpectrumDataFFTWFCore, public Nymph::KTExtensibleData< KTFrequencySpectrumDataFFTWF >
+    {
+        public:
+            KTFrequencySpectrumDataFFTWF();
+            virtual ~KTFrequencySpectrumDataFFTWF();
+
+            virtual KTFrequencySpectrumDataFFTWF& SetNComponents(unsigned components);
+
+        public:
+            static const std::string sName;
+
+    };
+
+
+    inline const KTFrequencySpectrumFFTWF* KTFrequencySpectrumDataFFTWFCore::GetSpectrumFFTWF(unsigned component) const
+    {
+        return fSpectra[component];
+    }
+
+    inline KTFrequencySpectrumFFTWF* KTFrequencySpectrumDataFFTWFCore::GetSpectrumFFTWF(unsigned component)
+    {
+        return fSpectra[component];
+    }
+
+    inline const KTFrequencySpectrum* KTFrequencySpectrumDataFFTWFCore::GetSpectrum(unsigned component) const
+    {
+        return fSpectra[component];
+    }
+
+    inline KTFrequencySpectrum* KTFrequencySpectrumDataFFTWFCore::GetSpectrum(unsigned component)
+    {
+        return fSpectra[component];
+    }
+
+    inline const KTFrequencyDomainArray* KTFrequencySpectrumDataFFTWFCore::GetArray(unsigned component) const
+    {
+        return fSpectra[component];
+    }
+
+    inline KTFrequencyDomainArray* KTFrequencySpectrumDataFFTWFCore::GetArray(unsigned component)
+    {
+        return fSpectra[component];
+    }
+
+    inline unsigned KTFrequencySpectrumDataFFTWFCore::GetNComponents() const
+    {
+        return unsigned(fSpectra.size());
+    }
+
+    inline void KTFrequencySpectrumDataFFTWFCore::SetSpectrum(KTFrequencySpectrumFFTWF* record, unsigned component)
+    {
+        if (component >= fSpectra.size()) SetNComponents(component+1);
+        else delete fSpectra[component];
+        fSpectra[component] = record;
+        return;
+    }
+
+} /* namespace Katydid */
+
+#endif /* KTFREQUENCYSPECTRUMDATAFFTWF_HH_ */
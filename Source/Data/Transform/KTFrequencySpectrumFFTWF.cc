@@ -0,0 +1,165 @@
+/*
+ * KTFrequencySpectrumFFTWF.cc
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "KTFrequencySpectrumFFTWF.hh"
+
+#include "KTLogger.hh"
+#include "KTPowerSpectrum.hh"
+#include "KTPowerSpectrumF.hh"
+
+#include <cmath>
+#include <sstream>
+
+using std::stringstream;
+
+namespace Katydid
+{
+    KTLOGGER(fslog, "KTFrequencySpectrumFFTWF");
+
+    KTFrequencySpectrumFFTWF::KTFrequencySpectrumFFTWF() :
+            KTPhysicalArray< 1, std::complex<float> >(),
+            KTFrequencySpectrum(),
+            fIsArrayOrderFlipped(false),
+            fIsSizeEven(true),
+            fLeftOfCenterOffset(0),
+            fCenterBin(0),
+            fNTimeBins(0)
+    {
+    }
+
+    KTFrequencySpectrumFFTWF::KTFrequencySpectrumFFTWF(size_t nBins, double rangeMin, double rangeMax, bool arrayOrderIsFlipped) :
+            KTPhysicalArray< 1, std::complex<float> >(nBins, rangeMin, rangeMax),
+            KTFrequencySpectrum(),
+            fIsArrayOrderFlipped(arrayOrderIsFlipped),
+            fIsSizeEven(nBins%2 == 0),
+            fLeftOfCenterOffset((nBins+1)/2),
+            fCenterBin(nBins/2),
+            fNTimeBins(0)
+    {
+    }
+
+    KTFrequencySpectrumFFTWF::KTFrequencySpectrumFFTWF(const KTFrequencySpectrumFFTWF& orig) :
+            KTPhysicalArray< 1, std::complex<float> >(orig),
+            KTFrequencySpectrum(),
+            fIsArrayOrderFlipped(orig.fIsArrayOrderFlipped),
+            fIsSizeEven(orig.fIsSizeEven),
+            fLeftOfCenterOffset(orig.fLeftOfCenterOffset),
+            fCenterBin(orig.fCenterBin),
+            fNTimeBins(orig.fNTimeBins)
+    {
+    }
+
+    KTFrequencySpectrumFFTWF::~KTFrequencySpectrumFFTWF()
+    {
+    }
+
+    KTFrequencySpectrumFFTWF& KTFrequencySpectrumFFTWF::CConjugate()
+    {
+        unsigned nBins = size();
+        for (unsigned iBin = 0; iBin < nBins; ++iBin)
+        {
+            fData[iBin] = std::conj(fData[iBin]);
+        }
+        return *this;
+    }
+
+    KTFrequencySpectrumFFTWF& KTFrequencySpectrumFFTWF::AnalyticAssociate()
+    {
+        // This is only valid if the original signal is Real only (not complex)
+        // See KTFrequencySpectrumFFTW::AnalyticAssociate(); the storage format is the same
+        unsigned nBins = size();
+        unsigned nyquistPos = nBins / 2;
+        for (unsigned iBin = 1; iBin < nyquistPos; ++iBin)
+        {
+            fData[iBin] *= 2.f;
+        }
+        for (unsigned iBin = nyquistPos; iBin < nBins; ++iBin)
+        {
+            fData[iBin] = std::complex<float>(0.f, 0.f);
+        }
+        return *this;
+    }
+
+    KTFrequencySpectrumFFTWF& KTFrequencySpectrumFFTWF::Scale(double scale)
+    {
+        (*this) *= std::complex<float>(float(scale), 0.f);
+        return *this;
+    }
+
+    KTPowerSpectrum* KTFrequencySpectrumFFTWF::CreatePowerSpectrum() const
+    {
+        return CreatePowerSpectrumOfType< KTPowerSpectrum >();
+    }
+
+    KTPowerSpectrumF* KTFrequencySpectrumFFTWF::CreatePowerSpectrumF() const
+    {
+        return CreatePowerSpectrumOfType< KTPowerSpectrumF >();
+    }
+
+    template< class XPowerSpectrumType >
+    XPowerSpectrumType* KTFrequencySpectrumFFTWF::CreatePowerSpectrumOfType() const
+    {
+        // The binning is the same as in KTFrequencySpectrumFFTW::CreatePowerSpectrum()
+        typedef typename XPowerSpectrumType::value_type value_type;
+
+        double maxFreq = std::max(fabs(GetRangeMin()), fabs(GetRangeMax()));
+        double minFreq = -0.5 * GetBinWidth();
+        unsigned nBins = (maxFreq - minFreq) / GetBinWidth();
+        if (GetRangeMax() < 0. || GetRangeMin() > 0.)
+        {
+            minFreq = std::min(fabs(GetRangeMin()), fabs(GetRangeMax()));
+            nBins = size();
+        }
+
+        XPowerSpectrumType* newPS = new XPowerSpectrumType(nBins, minFreq, maxFreq);
+        for (unsigned iBin = 0; iBin < nBins; ++iBin) (*newPS)(iBin) = 0.;
+
+        int dcBin = FindBin(0.);
+        int firstPosFreqBin = dcBin;
+        int lastPosFreqBin = size();
+        int firstNegFreqBin = 0;
+        int lastNegFreqBin = dcBin;
+        if (dcBin >= (int)size())
+        {
+            firstPosFreqBin = size();
+            lastNegFreqBin = size();
+        }
+        else if (dcBin < 0)
+        {
+            firstPosFreqBin = 0;
+            firstNegFreqBin = dcBin;
+        }
+
+        // the norm is accumulated in float; the product with the scaling is done in the output precision
+        value_type scaling = 1. / KTPowerSpectrum::GetResistance() / (double)GetNTimeBins();
+
+        for (int iBin = firstPosFreqBin; iBin < lastPosFreqBin; ++iBin)
+        {
+            (*newPS)(iBin) = std::norm((*this)(iBin)) * scaling;
+        }
+        for (int iBin = firstNegFreqBin; iBin < lastNegFreqBin; ++iBin)
+        {
+            (*newPS)(iBin) = std::norm((*this)(iBin)) * scaling;
+        }
+
+        return newPS;
+    }
+
+    void KTFrequencySpectrumFFTWF::Print(unsigned startPrint, unsigned nToPrint) const
+    {
+        stringstream printStream;
+        for (unsigned iBin = startPrint; iBin < startPrint + nToPrint; ++iBin)
+        {
+            // order matters, so use (*this)() to access values
+            printStream << "Bin " << iBin << ";   x = " << GetBinCenter(iBin) <<
+                    ";   y = " << (*this)(iBin) << "\n";
+        }
+        KTDEBUG(fslog, "\n" << printStream.str());
+        return;
+    }
+
+} /* namespace Katydid */
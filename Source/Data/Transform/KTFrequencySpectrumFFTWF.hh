@@ -0,0 +1,210 @@
+/**
+ @file KTFrequencySpectrumFFTWF.hh
+ @brief Contains KTFrequencySpectrumFFTWF
+ @details Single-precision frequency spectrum in the FFTW format
+ @author: agent
+ @date: Oct 17, 2026
+ */
+
+#ifndef KTFREQUENCYSPECTRUMFFTWF_HH_
+#define KTFREQUENCYSPECTRUMFFTWF_HH_
+
+#include "KTFrequencySpectrum.hh"
+#include "KTPhysicalArray.hh"
+
+#include <complex>
+#include <string>
+
+namespace Katydid
+{
+    class KTPowerSpectrumF;
+
+    /*!
+     @class KTFrequencySpectrumFFTWF
+     @author agent
+
+     @brief Single-precision counterpart of KTFrequencySpectrumFFTW
+
+     @details
+     The data is stored as std::complex<float>, which has the same layout as fftwf_complex, so it can be used directly with the fftwf_ functions.
+     Bin access follows the same ordering rules as KTFrequencySpectrumFFTW (i.e. a C2C spectrum is stored with the array order flipped).
+
+     The KTFrequencySpectrum interface works in double precision; CreatePowerSpectrum() returns a double-precision KTPowerSpectrum,
+     and CreatePowerSpectrumF() returns a single-precision KTPowerSpectrumF.
+    */
+    class KTFrequencySpectrumFFTWF : public KTPhysicalArray< 1, std::complex<float> >, public KTFrequencySpectrum
+    {
+        public:
+            KTFrequencySpectrumFFTWF();
+            KTFrequencySpectrumFFTWF(size_t nBins, double rangeMin=0., double rangeMax=1., bool arrayOrderIsFlipped=false);
+            KTFrequencySpectrumFFTWF(const KTFrequencySpectrumFFTWF& orig);
+            virtual ~KTFrequencySpectrumFFTWF();
+
+        public:
+            bool GetIsArrayOrderFlipped() const;
+            bool GetIsSizeEven() const;
+            size_t GetLeftOfCenterOffset() const;
+            size_t GetCenterBin() const;
+
+        protected:
+            bool fIsArrayOrderFlipped; /// Flag to indicate that the bins to the left of center are actually in the right half of the array in memory
+            bool fIsSizeEven; /// Flag to indicate if the size of the array is even
+            size_t fLeftOfCenterOffset; /// The number of bins by which the negative-frequency Nyquist bin is offset
+            size_t fCenterBin; /// The bin number of the DC bin
+
+        public:
+            const KTAxisProperties< 1 >& GetAxis() const;
+            KTAxisProperties< 1 >& GetAxis();
+
+            const std::string& GetOrdinateLabel() const;
+
+            // replace some of the KTPhysicalArray interface
+
+            const std::complex<float>& operator()(unsigned i) const;
+            std::complex<float>& operator()(unsigned i);
+
+            virtual double GetReal(unsigned bin) const;
+            virtual double GetImag(unsigned bin) const;
+
+            virtual void SetRect(unsigned bin, double real, double imag);
+
+            virtual double GetAbs(unsigned bin) const;
+            virtual double GetArg(unsigned bin) const;
+            virtual double GetNorm(unsigned bin) const;
+
+            virtual void SetPolar(unsigned bin, double abs, double arg);
+
+            virtual unsigned GetNFrequencyBins() const;
+            virtual double GetFrequencyBinWidth() const;
+
+            virtual unsigned GetNTimeBins() const;
+            virtual void SetNTimeBins(unsigned bins);
+
+        public:
+            /// In-place calculation of the complex conjugate
+            virtual KTFrequencySpectrumFFTWF& CConjugate();
+            /// In-place calculation of the analytic associate
+            virtual KTFrequencySpectrumFFTWF& AnalyticAssociate();
+
+            virtual KTFrequencySpectrumFFTWF& Scale(double scale);
+
+            virtual KTPowerSpectrum* CreatePowerSpectrum() const;
+            KTPowerSpectrumF* CreatePowerSpectrumF() const;
+
+            void Print(unsigned startPrint, unsigned nToPrint) const;
+
+        private:
+            /// Fills the given power spectrum from this frequency spectrum; works for either precision
+            template< class XPowerSpectrumType >
+            XPowerSpectrumType* CreatePowerSpectrumOfType() const;
+
+            unsigned fNTimeBins;
+    };
+
+    inline bool KTFrequencySpectrumFFTWF::GetIsArrayOrderFlipped() const
+    {
+        return fIsArrayOrderFlipped;
+    }
+
+    inline bool KTFrequencySpectrumFFTWF::GetIsSizeEven() const
+    {
+        return fIsSizeEven;
+    }
+
+    inline size_t KTFrequencySpectrumFFTWF::GetLeftOfCenterOffset() const
+    {
+        return fLeftOfCenterOffset;
+    }
+
+    inline size_t KTFrequencySpectrumFFTWF::GetCenterBin() const
+    {
+        return fCenterBin;
+    }
+
+    inline const KTAxisProperties< 1 >& KTFrequencySpectrumFFTWF::GetAxis() const
+    {
+        return *this;
+    }
+
+    inline KTAxisProperties< 1 >& KTFrequencySpectrumFFTWF::GetAxis()
+    {
+        return *this;
+    }
+
+    inline const std::string& KTFrequencySpectrumFFTWF::GetOrdinateLabel() const
+    {
+        return GetDataLabel();
+    }
+
+    inline const std::complex<float>& KTFrequencySpectrumFFTWF::operator()(unsigned i) const
+    {
+        if (! fIsArrayOrderFlipped) return fData[i];
+        return (i >= fCenterBin) ? fData[i - fCenterBin] : fData[i + fLeftOfCenterOffset];
+    }
+
+    inline std::complex<float>& KTFrequencySpectrumFFTWF::operator()(unsigned i)
+    {
+        if (! fIsArrayOrderFlipped) return fData[i];
+        return (i >= fCenterBin) ? fData[i - fCenterBin] : fData[i + fLeftOfCenterOffset];
+    }
+
+    inline double KTFrequencySpectrumFFTWF::GetReal(unsigned bin) const
+    {
+        return (*this)(bin).real();
+    }
+
+    inline double KTFrequencySpectrumFFTWF::GetImag(unsigned bin) const
+    {
+        return (*this)(bin).imag();
+    }
+
+    inline void KTFrequencySpectrumFFTWF::SetRect(unsigned bin, double real, double imag)
+    {
+        (*this)(bin) = std::complex<float>(real, imag);
+        return;
+    }
+
+    inline double KTFrequencySpectrumFFTWF::GetAbs(unsigned bin) const
+    {
+        return std::abs((*this)(bin));
+    }
+
+    inline double KTFrequencySpectrumFFTWF::GetNorm(unsigned bin) const
+    {
+        return std::norm((*this)(bin));
+    }
+
+    inline double KTFrequencySpectrumFFTWF::GetArg(unsigned bin) const
+    {
+        return std::arg((*this)(bin));
+    }
+
+    inline void KTFrequencySpectrumFFTWF::SetPolar(unsigned bin, double abs, double arg)
+    {
+        (*this)(bin) = std::polar(float(abs), float(arg));
+        return;
+    }
+
+    inline unsigned KTFrequencySpectrumFFTWF::GetNFrequencyBins() const
+    {
+        return size();
+    }
+
+    inline double KTFrequencySpectrumFFTWF::GetFrequencyBinWidth() const
+    {
+        return GetBinWidth();
+    }
+
+    inline unsigned KTFrequencySpectrumFFTWF::GetNTimeBins() const
+    {
+        return fNTimeBins;
+    }
+
+    inline void KTFrequencySpectrumFFTWF::SetNTimeBins(unsigned bins)
+    {
+        fNTimeBins = bins;
+        return;
+    }
+
+} /* namespace Katydid */
+#endif /* KTFREQUENCYSPECTRUMFFTWF_HH_ */
@@ -0,0 +1,57 @@
+/*
+ * KTPowerSpectrumDataF.cc
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "KTPowerSpectrumDataF.hh"
+
+
+namespace Katydid
+{
+    KTPowerSpectrumDataFCore::KTPowerSpectrumDataFCore() :
+            KTFrequencyDomainArrayData()
+    {
+    }
+
+    KTPowerSpectrumDataFCore::~KTPowerSpectrumDataFCore()
+    {
+        while (! fSpectra.empty())
+        {
+            delete fSpectra.back();
+            fSpectra.pop_back();
+        }
+    }
+
+
+    const std::string KTPowerSpectrumDataF::sName("power-spectrum-f");
+
+    KTPowerSpectrumDataF::KTPowerSpectrumDataF() :
+            KTPowerSpectrumDataFCore(),
+            KTExtensibleData()
+    {
+    }
+
+    KTPowerSpectrumDataF::~KTPowerSpectrumDataF()
+    {
+    }
+
+    KTPowerSpectrumDataF& KTPowerSpectrumDataF::SetNComponents(unsigned num)
+    {
+        unsigned oldSize = fSpectra.size();
+        // if num < oldSize
+        for (unsigned iComponent = num; iComponent < oldSize; ++iComponent)
+        {
+            delete fSpectra[iComponent];
+        }
+        fSpectra.resize(num);
+        // if num > oldSize
+        for (unsigned iComponent = oldSize; iComponent < num; ++iComponent)
+        {
+            fSpectra[iComponent] = NULL;
+        }
+        return *this;
+    }
+
+} /* namespace Katydid */
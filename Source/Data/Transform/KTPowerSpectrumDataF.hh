@@ -0,0 +1,96 @@
+/*
+ * KTPowerSpectrumDataF.hh
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef KTPOWERSPECTRUMDATAF_HH_
+#define KTPOWERSPECTRUMDATAF_HH_
+
+#include "KTData.hh"
+
+#include "KTFrequencyDomainArray.hh"
+#include "KTPowerSpectrumF.hh"
+
+#include <vector>
+
+namespace Katydid
+{
+
+    class KTPowerSpectrumDataFCore : public KTFrequencyDomainArrayData
+    {
+        public:
+            typedef KTPowerSpectrumF spectrum_type;
+
+        public:
+            KTPowerSpectrumDataFCore();
+            virtual ~KTPowerSpectrumDataFCore();
+
+            virtual unsigned GetNComponents() const;
+
+            const KTPowerSpectrumF* GetSpectrum(unsigned component = 0) const;
+            KTPowerSpectrumF* GetSpectrum(unsigned component = 0);
+
+            const KTFrequencyDomainArray* GetArray(unsigned component = 0) const;
+            KTFrequencyDomainArray* GetArray(unsigned component = 0);
+
+            void SetSpectrum(KTPowerSpectrumF* spectrum, unsigned component = 0);
+
+            virtual KTPowerSpectrumDataFCore& SetNComponents(unsigned channels) = 0;
+
+        protected:
+            std::vector< KTPowerSpectrumF* > fSpectra;
+    };
+
+
+    class KTPowerSpectrumDataF : public KTPowerSpectrumDataFCore, public Nymph::KTExtensibleData< KTPowerSpectrumDataF >
+    {
+        public:
+            KTPowerSpectrumDataF();
+            virtual ~KTPowerSpectrumDataF();
+
+            KTPowerSpectrumDataF& SetNComponents(unsigned channels);
+
+        public:
+            static const std::string sName;
+
+    };
+
+
+    inline const KTPowerSpectrumF* KTPowerSpectrumDataFCore::GetSpectrum(unsigned component) const
+    {
+        return fSpectra[component];
+    }
+
+    inline KTPowerSpectrumF* KTPowerSpectrumDataFCore::GetSpectrum(unsigned component)
+    {
+        return fSpectra[component];
+    }
+
+    inline const KTFrequencyDomainArray* KTPowerSpectrumDataFCore::GetArray(unsigned component) const
+    {
+        return fSpectra[component];
+    }
+
+    inline KTFrequencyDomainArray* KTPowerSpectrumDataFCore::GetArray(unsigned component)
+    {
+        return fSpectra[component];
+    }
+
+    inline unsigned KTPowerSpectrumDataFCore::GetNComponents() const
+    {
+        return unsigned(fSpectra.size());
+    }
+
+    inline void KTPowerSpectrumDataFCore::SetSpectrum(KTPowerSpectrumF* spectrum, unsigned component)
+    {
+        if (component >= fSpectra.size()) SetNComponents(component+1);
+        else delete fSpectra[component];
+        fSpectra[component] = spectrum;
+        return;
+    }
+
+} /* namespace Katydid */
+
+#endif /* KTPOWERSPECTRUMDATAF_HH_ */
@@ -0,0 +1,94 @@
+/*
+ * KTPowerSpectrumF.cc
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "KTPowerSpectrumF.hh"
+
+#include "KTLogger.hh"
+
+#include <algorithm>
+
+namespace Katydid
+{
+
+    KTLOGGER(pslog, "KTPowerSpectrumF");
+
+    KTPowerSpectrumF::KTPowerSpectrumF(size_t nBins, double rangeMin, double rangeMax) :
+            KTPhysicalArray< 1, float >(nBins, rangeMin, rangeMax),
+            KTFrequencyDomainArray(),
+            fMode(KTPowerSpectrum::kPower)
+    {
+        SetAxisLabel("Frequency (Hz)");
+        SetDataLabel("Power (W)");
+    }
+
+    KTPowerSpectrumF::KTPowerSpectrumF(float value, size_t nBins, double rangeMin, double rangeMax) :
+            KTPowerSpectrumF(nBins, rangeMin, rangeMax)
+    {
+        for (unsigned index = 0; index < nBins; ++index)
+        {
+            fData[index] = value;
+        }
+    }
+
+    KTPowerSpectrumF::KTPowerSpectrumF(const KTPowerSpectrumF& orig) :
+            KTPhysicalArray< 1, float >(orig),
+            KTFrequencyDomainArray(orig),
+            fMode(orig.GetMode())
+    {
+    }
+
+    KTPowerSpectrumF::~KTPowerSpectrumF()
+    {
+    }
+
+    void KTPowerSpectrumF::ConvertToPowerSpectrum()
+    {
+        if (fMode == KTPowerSpectrum::kPower) return;
+
+        KTDEBUG(pslog, "Converting to Power Spectrum");
+        (*this) *= float(GetBinWidth());
+        fMode = KTPowerSpectrum::kPower;
+        SetDataLabel("Power (W)");
+
+        return;
+    }
+
+    void KTPowerSpectrumF::ConvertToPowerSpectralDensity()
+    {
+        if (fMode == KTPowerSpectrum::kPSD) return;
+
+        KTDEBUG(pslog, "Converting to Power SpectralDensity");
+        (*this) *= float(1. / GetBinWidth());
+        fMode = KTPowerSpectrum::kPSD;
+        SetDataLabel("Power Spectral Density (W/Hz)");
+
+        return;
+    }
+
+    KTPowerSpectrumF& KTPowerSpectrumF::operator=(const KTPowerSpectrumF& rhs)
+    {
+        KTPhysicalArray< 1, float >::operator=(rhs);
+        fMode = rhs.fMode;
+        return *this;
+    }
+
+    KTPowerSpectrumF& KTPowerSpectrumF::Scale(double scale)
+    {
+        (*this) *= float(scale);
+        return *this;
+    }
+
+    KTPowerSpectrum* KTPowerSpectrumF::CreateDoublePrecisionSpectrum() const
+    {
+        KTPowerSpectrum* newPS = new KTPowerSpectrum(size(), GetRangeMin(), GetRangeMax());
+        std::copy(begin(), end(), newPS->begin());
+        newPS->OverrideMode(fMode);
+        newPS->SetDataLabel(GetDataLabel());
+        return newPS;
+    }
+
+} /* namespace Katydid */
@@ -0,0 +1,127 @@
+/*
+ * KTPowerSpectrumF.hh
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef KTPOWERSPECTRUMF_HH_
+#define KTPOWERSPECTRUMF_HH_
+
+#include "KTFrequencyDomainArray.hh"
+#include "KTPhysicalArray.hh"
+#include "KTPowerSpectrum.hh"
+
+#include <string>
+
+namespace Katydid
+{
+
+    /*!
+     @class KTPowerSpectrumF
+     @author agent
+
+     @brief Single-precision power spectrum
+
+     @details
+     Float counterpart of KTPowerSpectrum, created from a KTFrequencySpectrumFFTWF.
+     The modes and the resistance are the same as for KTPowerSpectrum.
+     Processors that only handle double precision can be given a copy made with CreateDoublePrecisionSpectrum().
+    */
+    class KTPowerSpectrumF : public KTPhysicalArray< 1, float >, public KTFrequencyDomainArray
+    {
+        public:
+            typedef KTPowerSpectrum::Mode Mode;
+
+        public:
+            KTPowerSpectrumF(size_t nBins=1, double rangeMin=0., double rangeMax=1.);
+            KTPowerSpectrumF(float value, size_t nBins, double rangeMin=0., double rangeMax=1.);
+            KTPowerSpectrumF(const KTPowerSpectrumF& orig);
+            virtual ~KTPowerSpectrumF();
+
+            unsigned GetNFrequencyBins() const;
+            double GetFrequencyBinWidth() const;
+
+            const KTAxisProperties< 1 >& GetAxis() const;
+            KTAxisProperties< 1 >& GetAxis();
+
+            const std::string& GetOrdinateLabel() const;
+
+            void ConvertToPowerSpectrum();
+            void ConvertToPowerSpectralDensity();
+
+            bool IsPowerSpectrum() const;
+            bool IsPowerSpectralDensity() const;
+
+        public:
+            KTPowerSpectrumF& operator=(const KTPowerSpectrumF& rhs);
+
+            KTPowerSpectrumF& Scale(double scale);
+
+            Mode GetMode() const;
+            void SetMode(Mode mode);
+            void OverrideMode(Mode mode);
+
+            /// Creates a double-precision copy of this spectrum
+            KTPowerSpectrum* CreateDoublePrecisionSpectrum() const;
+
+        protected:
+            Mode fMode;
+
+    };
+
+    inline const KTAxisProperties< 1 >& KTPowerSpectrumF::GetAxis() const
+    {
+        return *this;
+    }
+
+    inline KTAxisProperties< 1 >& KTPowerSpectrumF::GetAxis()
+    {
+        return *this;
+    }
+
+    inline const std::string& KTPowerSpectrumF::GetOrdinateLabel() const
+    {
+        return GetDataLabel();
+    }
+
+    inline unsigned KTPowerSpectrumF::GetNFrequencyBins() const
+    {
+        return size();
+    }
+
+    inline double KTPowerSpectrumF::GetFrequencyBinWidth() const
+    {
+        return GetBinWidth();
+    }
+
+    inline bool KTPowerSpectrumF::IsPowerSpectrum() const
+    {
+        return fMode == KTPowerSpectrum::kPower;
+    }
+
+    inline bool KTPowerSpectrumF::IsPowerSpectralDensity() const
+    {
+        return fMode == KTPowerSpectrum::kPSD;
+    }
+
+    inline void KTPowerSpectrumF::SetMode(KTPowerSpectrumF::Mode mode)
+    {
+        if (mode == KTPowerSpectrum::kPSD) ConvertToPowerSpectralDensity();
+        else ConvertToPowerSpectrum();
+        return;
+    }
+
+    inline void KTPowerSpectrumF::OverrideMode(KTPowerSpectrumF::Mode mode)
+    {
+        fMode = mode;
+        return;
+    }
+
+    inline KTPowerSpectrumF::Mode KTPowerSpectrumF::GetMode() const
+    {
+        return fMode;
+    }
+
+} /* namespace Katydid */
+#endif /* KTPOWERSPECTRUMF_HH_ */
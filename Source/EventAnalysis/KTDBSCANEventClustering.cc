@@ -33,6 +33,7 @@ namespace Katydid
             KTPrimaryProcessor(name),
             fRadii(fNDimensions / fNPointsPerTrack),
             fMinPoints(3),
+            fUseDistanceMatrix(false),
             fTimeBinWidth(1),
             fFreqBinWidth(1.),
             fCompTracks(1, vector< KTProcessedTrackData >()),
@@ -57,6 +58,7 @@ namespace Katydid
         if (node == NULL) return false;
 
         SetMinPoints(node->get_value("min-points", GetMinPoints()));
+        SetUseDistanceMatrix(node->get_value("use-distance-matrix", GetUseDistanceMatrix()));
 
         if (node->has("radii"))
         {
@@ -129,12 +131,6 @@ namespace Katydid
     {
         KTPROG(tclog, "Starting DBSCAN event clustering");
 
-        KTDBSCAN< DistanceMatrix > dbScan;
-
-        dbScan.SetRadius(1.);
-        dbScan.SetMinPoints(fMinPoints);
-        KTINFO(tclog, "DBSCAN configured");
-
         for (unsigned iComponent = 0; iComponent < fCompTracks.size(); ++iComponent)
         {
             KTDEBUG(tclog, "Clustering component " << iComponent);
@@ -175,22 +171,28 @@ namespace Katydid
                 normPoints[iPoint++] = newPoint;
             }
 
-            DistanceMatrix distMat;
-            distMat.ComputeDistances< TrackDistance< Point > >(normPoints);
-
             // do the clustering!
-            KTINFO(tclog, "Starting DBSCAN");
-            KTDBSCAN< DistanceMatrix >::DBSResults results;
-            if (! dbScan.DoClustering(distMat, results))
+            vector< Cluster > clusters;
+            if (fUseDistanceMatrix)
             {
-                KTERROR(tclog, "An error occurred while clustering");
-                return false;
+                DistanceMatrix distMat;
+                distMat.ComputeDistances< TrackDistance< Point > >(normPoints);
+                if (! FindClusters(distMat, clusters)) return false;
+            }
+            else
+            {
+                KTTrackDistanceIndex trackIndex;
+                for (Points::const_iterator pIt = normPoints.begin(); pIt != normPoints.end(); ++pIt)
+                {
+                    trackIndex.AddTrack((*pIt)(0), (*pIt)(1), (*pIt)(2), (*pIt)(3));
+                }
+                trackIndex.BuildIndex();
+                if (! FindClusters(trackIndex, clusters)) return false;
             }
-            KTDEBUG(tclog, "DBSCAN finished");
 
             // loop over the clusters found, and create data objects for them
-            KTDEBUG(tclog, "Found " << results.fClusters.size() << " clusters; creating candidate events");
-            for (vector< KTDBSCAN< DistanceMatrix >::Cluster >::const_iterator clustIt = results.fClusters.begin(); clustIt != results.fClusters.end(); ++clustIt)
+            KTDEBUG(tclog, "Found " << clusters.size() << " clusters; creating candidate events");
+            for (vector< Cluster >::const_iterator clustIt = clusters.begin(); clustIt != clusters.end(); ++clustIt)
             {
                 if (clustIt->empty())
                 {
@@ -209,7 +211,7 @@ namespace Katydid
                 eventData.SetAcquisitionID(fCompTracks[0][0].GetAcquisitionID());
                 eventData.SetEventID(fDataCount);
 
-                for (KTDBSCAN< DistanceMatrix >::Cluster::const_iterator pointIdIt = clustIt->begin(); pointIdIt != clustIt->end(); ++pointIdIt)
+                for (Cluster::const_iterator pointIdIt = clustIt->begin(); pointIdIt != clustIt->end(); ++pointIdIt)
                 {
                     eventData.AddTrack(fCompTracks[iComponent][*pointIdIt]);
                 }
@@ -230,6 +232,26 @@ namespace Katydid
         return true;
     }
 
+    template< typename DistanceData >
+    bool KTDBSCANEventClustering::FindClusters(const DistanceData& dist, std::vector< Cluster >& clusters)
+    {
+        KTDBSCAN< DistanceData > dbScan;
+        dbScan.SetRadius(1.);
+        dbScan.SetMinPoints(fMinPoints);
+
+        KTINFO(tclog, "Starting DBSCAN");
+        typename KTDBSCAN< DistanceData >::DBSResults results;
+        if (! dbScan.DoClustering(dist, results))
+        {
+            KTERROR(tclog, "An error occurred while clustering");
+            return false;
+        }
+        KTDEBUG(tclog, "DBSCAN finished");
+
+        clusters.swap(results.fClusters);
+        return true;
+    }
+
     void KTDBSCANEventClustering::SetNComponents(unsigned nComps)
     {
         fCompTracks.resize(nComps, vector< KTProcessedTrackData >());
@@ -13,6 +13,7 @@
 
 #include "KTDBSCAN.hh"
 #include "KTDistanceMatrix.hh"
+#include "KTTrackDistanceIndex.hh"
 #include "KTSlot.hh"
 #include "KTData.hh"
 #include "KTMemberVariable.hh"
@@ -40,18 +41,7 @@ namespace Katydid
 
             double GetDistance(const VEC_T v1, const VEC_T v2)
             {
-                double deltaT, deltaF;
-                if (v1(0) < v2(0))
-                {
-                    deltaT = std::max(0., v2(0) - v1(2));
-                    deltaF = v2(1) - v1(3);
-                }
-                else
-                {
-                    deltaT = std::max(0., v1(0) - v2(2));
-                    deltaF = v1(1) - v2(3);
-                }
-                return sqrt(deltaT * deltaT + deltaF * deltaF);
+                return TrackDistanceBetween(v1, v2);
             };
 
     };
@@ -77,6 +67,9 @@ namespace Katydid
      Available configuration values:
      - "radii": double[2] -- array used to describe the distances that will be used to cluster tracks together; [time, frequency]
      - "min-points": unsigned int -- minimum number of tracks required to have a cluster
+     - "use-distance-matrix": bool -- if true, the distances between all pairs of tracks are computed and stored, which takes
+       time and memory that grow as the square of the number of tracks; by default the neighbors of each track are found with
+       a KTTrackDistanceIndex, which gives the same clusters
 
      Slots:
      - "track": void (shared_ptr<KTData>) -- If this is a new acquisition; Adds tracks to the internally-stored set of points; Requires KTSliceHeader and KTDiscriminatedPoints1DData.
@@ -105,6 +98,7 @@ namespace Katydid
 
             MEMBERVARIABLE(unsigned, MinPoints);
             MEMBERVARIABLEREF(Point, Radii);
+            MEMBERVARIABLE(bool, UseDistanceMatrix);
 
         public:
             // Store point information locally
@@ -123,6 +117,10 @@ namespace Katydid
             unsigned GetDataCount() const;
 
         private:
+            typedef std::vector< size_t > Cluster;
+
+            template< typename DistanceData >
+            bool FindClusters(const DistanceData& dist, std::vector< Cluster >& clusters);
 
             double fTimeBinWidth;
             double fFreqBinWidth;
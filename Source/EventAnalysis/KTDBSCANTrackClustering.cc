@@ -31,6 +31,7 @@ namespace Katydid
             //fRadii(fNDimensions),
             fMinPoints(3),
             fRadius(1.),
+            fNThreads(1),
             //fTimeBinWidth(1),
             //fFreqBinWidth(1.),
             //fCompPoints(1, Points()),
@@ -57,6 +58,7 @@ namespace Katydid
 
         SetMinPoints(node->get_value("min-points", GetMinPoints()));
         SetRadius(node->get_value("radius", GetRadius()));
+        SetNThreads(node->get_value("n-threads", GetNThreads()));
 
         /*
         if (node->has("radii"))
@@ -102,11 +104,11 @@ namespace Katydid
         newPoint(0) = slHeader.GetTimeInRun() + 0.5 * fTimeBinWidth;
         for (unsigned iComponent = 0; iComponent != fCompPoints.size(); ++iComponent)
         {
-            const KTDiscriminatedPoints1DData::SetOfPoints&  incomingPts = discPoints.GetSetOfPoints(iComponent);
-            for (KTDiscriminatedPoints1DData::SetOfPoints::const_iterator pIt = incomingPts.begin();
-                    pIt != incomingPts.end(); ++pIt)
+            const std::vector< double >& incomingFreqs = discPoints.GetSetOfPoints(iComponent).GetAbscissae();
+            fCompPoints[iComponent].reserve(fCompPoints[iComponent].size() + incomingFreqs.size());
+            for (std::vector< double >::const_iterator fIt = incomingFreqs.begin(); fIt != incomingFreqs.end(); ++fIt)
             {
-                newPoint(1) = pIt->second.fAbscissa;
+                newPoint(1) = *fIt;
                 fCompPoints[iComponent].push_back(newPoint);
                 KTDEBUG(tclog, "Point " << fCompPoints[iComponent].size()-1 << " is now " << fCompPoints[iComponent].back());
             }
@@ -158,6 +160,7 @@ namespace Katydid
 
         dbScan.SetRadius(fRadius);
         dbScan.SetMinPoints(fMinPoints);
+        dbScan.SetNThreads(fNThreads);
         KTINFO(tclog, "DBSCAN configured");
 
         for (unsigned iComponent = 0; iComponent < data.GetNComponents(); ++iComponent)
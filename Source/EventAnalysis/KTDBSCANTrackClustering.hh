@@ -45,6 +45,7 @@ namespace Katydid
      Available configuration values:
      - "radius": double -- double used to define the circle around points to be clustered together
      - "min-points": unsigned int -- minimum number of points required to have a cluster
+     - "n-threads": unsigned int -- number of threads used by DBSCAN; the results are the same for any number of threads
 
      Slots:
      - "points": void (shared_ptr<KTData>) -- If this is a new acquisition, triggers the clustering algorithm; Adds points to the internally-stored set of points; Requires KTSliceHeader and KTDiscriminatedPoints1DData.
@@ -72,6 +73,7 @@ namespace Katydid
 
             MEMBERVARIABLE(unsigned, MinPoints);
             MEMBERVARIABLE(double, Radius);
+            MEMBERVARIABLE(unsigned, NThreads);
             MEMBERVARIABLE_NOSET(unsigned, DataCount);            
             //MEMBERVARIABLEREF(Point, Radii);
 
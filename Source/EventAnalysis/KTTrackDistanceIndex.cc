@@ -0,0 +1,109 @@
+/*
+ * KTTrackDistanceIndex.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "KTTrackDistanceIndex.hh"
+
+#include "KTLogger.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Katydid
+{
+    KTLOGGER(tdilog, "KTTrackDistanceIndex");
+
+    KTTrackDistanceIndex::KTTrackDistanceIndex(unsigned maxLeafSize) :
+            fTracks(),
+            fStartPoints(),
+            fEndPoints(),
+            fMaxLeafSize(maxLeafSize),
+            fStartIndex(NULL),
+            fEndIndex(NULL)
+    {
+        fStartPoints.fTracks = &fTracks;
+        fEndPoints.fTracks = &fTracks;
+    }
+
+    KTTrackDistanceIndex::~KTTrackDistanceIndex()
+    {
+        Clear();
+    }
+
+    void KTTrackDistanceIndex::Clear()
+    {
+        delete fStartIndex;
+        fStartIndex = NULL;
+        delete fEndIndex;
+        fEndIndex = NULL;
+        fTracks.clear();
+        return;
+    }
+
+    void KTTrackDistanceIndex::AddTrack(double startTime, double startFreq, double endTime, double endFreq)
+    {
+        Track track;
+        track.fCoords[0] = startTime;
+        track.fCoords[1] = startFreq;
+        track.fCoords[2] = endTime;
+        track.fCoords[3] = endFreq;
+        fTracks.push_back(track);
+        return;
+    }
+
+    void KTTrackDistanceIndex::BuildIndex()
+    {
+        delete fStartIndex;
+        delete fEndIndex;
+        KTDEBUG(tdilog, "Building track index with " << fTracks.size() << " tracks");
+        fStartIndex = new StartIndex(4, fStartPoints, nanoflann::KDTreeSingleIndexAdaptorParams(fMaxLeafSize));
+        fStartIndex->buildIndex();
+        fEndIndex = new EndIndex(4, fEndPoints, nanoflann::KDTreeSingleIndexAdaptorParams(fMaxLeafSize));
+        fEndIndex->buildIndex();
+        return;
+    }
+
+    KTTrackDistanceIndex::Neighbors KTTrackDistanceIndex::NearestNeighborsByRadius(PointId pid, double radius) const
+    {
+        Neighbors neighbors;
+        if (fStartIndex == NULL || fEndIndex == NULL) return neighbors;
+
+        const Track& track = fTracks[pid];
+        std::vector< size_t > candidates;
+        InRangeResultSet candidateSet = {candidates};
+
+        // the ranges are padded so that rounding can't leave out a track that passes the exact check below
+        const double range = radius * (1. + 1.e-6) + 1.e-12 * std::max(std::max(std::fabs(track(0)), std::fabs(track(1))), std::max(std::fabs(track(2)), std::fabs(track(3))));
+
+        // tracks that start after this one: their start is close to this track's end
+        const double laterRange[4] = {track(0), track(2) + range, track(3) - range, track(3) + range};
+        fStartIndex->findNeighbors(candidateSet, laterRange, nanoflann::SearchParams());
+        size_t nLaterCandidates = candidates.size();
+
+        // tracks that start before this one: their end is close to this track's start
+        const double earlierRange[4] = {track(0), track(0) - range, track(1) - range, track(1) + range};
+        fEndIndex->findNeighbors(candidateSet, earlierRange, nanoflann::SearchParams());
+
+        // tracks with the same start time are found by both searches; they're only kept from the search that matches
+        // which of the pair TrackDistanceBetween() treats as earlier, which depends on the order of the IDs
+        for (size_t iCand = 0; iCand < candidates.size(); ++iCand)
+        {
+            PointId cid = candidates[iCand];
+            if (cid == pid) continue;
+
+            bool thisIsEarlier = track(0) < fTracks[cid](0) || (track(0) == fTracks[cid](0) && cid < pid);
+            if (thisIsEarlier != (iCand < nLaterCandidates)) continue;
+
+            // same argument order as the distance matrix, which only computes distance(lower ID, higher ID)
+            double distance = pid < cid ? TrackDistanceBetween(track, fTracks[cid]) : TrackDistanceBetween(fTracks[cid], track);
+            if (distance < radius) neighbors.push_back(cid);
+        }
+
+        std::sort(neighbors.begin(), neighbors.end());
+        return neighbors;
+    }
+
+} /* namespace Katydid */
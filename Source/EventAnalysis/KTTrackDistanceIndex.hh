@@ -0,0 +1,186 @@
+/**
+ @file KTTrackDistanceIndex.hh
+ @brief Contains KTTrackDistanceIndex
+ @details Spatial index for finding the tracks within a given track distance of one another
+ @author: agent
+ @date: Oct 18, 2026
+ */
+
+#ifndef KTTRACKDISTANCEINDEX_HH_
+#define KTTRACKDISTANCEINDEX_HH_
+
+#include "nanoflann.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace Katydid
+{
+    // Track distance
+    // Vector format for representing tracks: (tstart, fstart, tend, fend)
+    // Dimension t: for tstart_1 < tstart_2, Dt = max(0, tstart_2 - tend_1)
+    // Dimension f: Df = fstart_2 - fend_1
+    // Dist = sqrt(Dt^2 + Df^2)
+    // If the start times are equal, v2 is treated as the earlier track.
+    template < typename VEC_T >
+    double TrackDistanceBetween(const VEC_T& v1, const VEC_T& v2)
+    {
+        double deltaT, deltaF;
+        if (v1(0) < v2(0))
+        {
+            deltaT = std::max(0., v2(0) - v1(2));
+            deltaF = v2(1) - v1(3);
+        }
+        else
+        {
+            deltaT = std::max(0., v1(0) - v2(2));
+            deltaF = v1(1) - v2(3);
+        }
+        return sqrt(deltaT * deltaT + deltaF * deltaF);
+    }
+
+    /*!
+     @class KTTrackDistanceIndex
+     @author agent
+
+     @brief Finds the tracks within a given track distance of a track, without computing the distances between all pairs of tracks
+
+     @details
+     Tracks are (t_start, f_start, t_end, f_end), in coordinates normalized such that the clustering radius is the same in
+     time and frequency.  The distance between two tracks is TrackDistanceBetween(); since the time difference is clamped at
+     zero, the neighbors of a track are not within a circle around any one of its points, so the index uses range queries:
+     - tracks that start after the query track: their start points are in
+       [t_start, t_end + radius] x [f_end - radius, f_end + radius];
+     - tracks that start before the query track: their start times are <= t_start, their end times are >= t_start - radius,
+       and their end frequencies are in [f_start - radius, f_start + radius].
+     Each range is searched with a nanoflann k-d tree over the start or end points, using a metric that is zero inside the
+     range, and the candidates are then checked with the exact track distance.
+
+     Memory use is linear in the number of tracks.  The neighbors are the same, and in the same order (increasing point ID),
+     as those from a KTSymmetricDistanceMatrix computed with TrackDistance, so DBSCAN gives the same clusters with either.
+
+     Interface expected by KTDBSCAN: PointId, Neighbors, size(), and NearestNeighborsByRadius(); the latter can be called
+     from several threads at once.
+    */
+    class KTTrackDistanceIndex
+    {
+        public:
+            typedef size_t PointId;
+            typedef std::vector< PointId > Neighbors;
+
+            struct Track
+            {
+                double fCoords[4]; // (t_start, f_start, t_end, f_end)
+                inline double operator()(unsigned iCoord) const {return fCoords[iCoord];}
+            };
+            typedef std::vector< Track > Tracks;
+
+        public:
+            KTTrackDistanceIndex(unsigned maxLeafSize = 10);
+            ~KTTrackDistanceIndex();
+
+            /// Removes all tracks and the index
+            void Clear();
+
+            /// Adds a track in normalized coordinates; BuildIndex() has to be called before searching
+            void AddTrack(double startTime, double startFreq, double endTime, double endFreq);
+
+            void BuildIndex();
+
+            size_t size() const;
+            const Tracks& GetTracks() const;
+
+            /// Returns the IDs of the tracks within radius of track pid, in increasing order; pid itself is not included
+            Neighbors NearestNeighborsByRadius(PointId pid, double radius) const;
+
+        private:
+            KTTrackDistanceIndex(const KTTrackDistanceIndex&);
+            KTTrackDistanceIndex& operator=(const KTTrackDistanceIndex&);
+
+            // The dataset views have four dimensions so that each side of a range is its own dimension:
+            // start points are (t_start, t_start, f_start, f_start), and end points are (t_start, t_end, f_end, f_end)
+            struct StartPoints
+            {
+                const Tracks* fTracks;
+                inline size_t kdtree_get_point_count() const {return fTracks->size();}
+                inline double kdtree_get_pt(const size_t idx, int dim) const {return (*fTracks)[idx].fCoords[dim < 2 ? 0 : 1];}
+                template< class BBOX >
+                bool kdtree_get_bbox(BBOX&) const {return false;}
+            };
+            struct EndPoints
+            {
+                const Tracks* fTracks;
+                inline size_t kdtree_get_point_count() const {return fTracks->size();}
+                inline double kdtree_get_pt(const size_t idx, int dim) const {return (*fTracks)[idx].fCoords[dim == 0 ? 0 : (dim == 1 ? 2 : 3)];}
+                template< class BBOX >
+                bool kdtree_get_bbox(BBOX&) const {return false;}
+            };
+
+            // "Distance" from a range: the sum of how far each coordinate is outside of its side of the range.
+            // Bit d of UPPERSIDES is set if query coordinate d is an upper bound, and clear if it's a lower bound.
+            // Each term only grows as a coordinate moves away from the range, so it's a valid bound for nanoflann's pruning.
+            template< class DataSource, unsigned UPPERSIDES >
+            struct RangeAdaptor
+            {
+                typedef double ElementType;
+                typedef double DistanceType;
+
+                const DataSource& data_source;
+
+                RangeAdaptor(const DataSource& dataSource) : data_source(dataSource) {}
+
+                inline double evalMetric(const double* a, const size_t b_idx, size_t size, double /*worst_dist*/ = -1.) const
+                {
+                    double result = 0.;
+                    for (size_t dim = 0; dim < size; ++dim)
+                    {
+                        result += accum_dist(a[dim], data_source.kdtree_get_pt(b_idx, dim), dim);
+                    }
+                    return result;
+                }
+
+                template< typename U, typename V >
+                inline double accum_dist(const U a, const V b, const size_t dim) const
+                {
+                    return (UPPERSIDES >> dim) & 1u ? std::max(0., double(b - a)) : std::max(0., double(a - b));
+                }
+            };
+
+            // collects the points with zero distance from the range
+            struct InRangeResultSet
+            {
+                std::vector< size_t >& fIndices;
+
+                inline bool addPoint(double, size_t index) {fIndices.push_back(index); return true;}
+                inline double worstDist() const {return std::numeric_limits< double >::min();}
+                inline bool full() const {return true;}
+                inline size_t size() const {return fIndices.size();}
+            };
+
+            // start points: t_start >= lower, t_start <= upper, f_start >= lower, f_start <= upper
+            typedef nanoflann::KDTreeSingleIndexAdaptor< RangeAdaptor< StartPoints, 10u >, StartPoints, 4 > StartIndex;
+            // end points: t_start <= upper, t_end >= lower, f_end >= lower, f_end <= upper
+            typedef nanoflann::KDTreeSingleIndexAdaptor< RangeAdaptor< EndPoints, 9u >, EndPoints, 4 > EndIndex;
+
+            Tracks fTracks;
+            StartPoints fStartPoints;
+            EndPoints fEndPoints;
+            unsigned fMaxLeafSize;
+            StartIndex* fStartIndex;
+            EndIndex* fEndIndex;
+    };
+
+    inline size_t KTTrackDistanceIndex::size() const
+    {
+        return fTracks.size();
+    }
+
+    inline const KTTrackDistanceIndex::Tracks& KTTrackDistanceIndex::GetTracks() const
+    {
+        return fTracks;
+    }
+
+} /* namespace Katydid */
+#endif /* KTTRACKDISTANCEINDEX_HH_ */
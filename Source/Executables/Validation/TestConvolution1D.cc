@@ -10,8 +10,12 @@
 #include "TFile.h"
 #endif
 
+#include <algorithm>
 #include <cmath>
+#include <fstream>
 #include <iostream>
+#include <string>
+#include <vector>
 
 using namespace Katydid;
 
@@ -29,8 +33,8 @@ int main()
 	unsigned nKernelBins = 1000;
 	double blurWidth = 200.0e3;
 
-	// You'll need to change this to your own path
-	std::string kernelPath = "/Users/ezayas/Katydid/Examples/CustomApplications/GaussianKernel.json";
+	// The kernel is written to the current directory
+	std::string kernelPath = "TestConvolution1DKernel.json";
 
 	KTPowerSpectrum* powerSpect = new KTPowerSpectrum( nBins, rangeMin, rangeMax );
 	KTFrequencySpectrumFFTW* fftwSpect = new KTFrequencySpectrumFFTW( nBins, rangeMin, rangeMax );
@@ -72,20 +76,48 @@ int main()
 
 	std::cout << "Kernel from script parameters is: \n" << kernel << std::endl;
 
+	std::ofstream kernelFile( kernelPath.c_str() );
+	kernelFile << kernel;
+	kernelFile.close();
+
 	convProcessor.SetKernel( kernelPath );
 	convProcessor.SetBlockSize( 4096 );
 	convProcessor.SetNormalizeKernel( true );
 	convProcessor.FinishSetup();
 
-    const int block = convProcessor.GetBlockSize();
-    const int overlap = nKernelBins - 1;
-    const int step = block - overlap;
+    convProcessor.Initialize( convProcessor.GetBlockSize() );
 
-    convProcessor.Initialize( nBins, block, step, overlap );
+    KTPowerSpectrum* convolvedPowerSpect = convProcessor.DoConvolution( powerSpect );
+    KTFrequencySpectrumFFTW* convolvedFFTWSpect = convProcessor.DoConvolution( fftwSpect );
+    KTFrequencySpectrumPolar* convolvedPolarSpect = convProcessor.DoConvolution( polarSpect );
 
-    KTPowerSpectrum* convolvedPowerSpect = convProcessor.DoConvolution( powerSpect, block, step, overlap );
-    KTFrequencySpectrumFFTW* convolvedFFTWSpect = convProcessor.DoConvolution( fftwSpect, block, step, overlap );
-    KTFrequencySpectrumPolar* convolvedPolarSpect = convProcessor.DoConvolution( polarSpect, block, step, overlap );
+    // Compare to the direct convolution with the normalized kernel, including the last (zero-padded) block
+    // (with the values as they were written to the kernel file)
+    std::vector< double > kernelValues( nKernelBins );
+    double kernelNorm = 0.;
+    for( unsigned iBin = 0; iBin < nKernelBins; ++iBin )
+    {
+        kernelValues[iBin] = std::stod( std::to_string( (*blur)(iBin) ) );
+        kernelNorm += kernelValues[iBin];
+    }
+    double maxDiff = 0.;
+    for( unsigned iBin = 0; iBin < nBins; iBin += 7 )
+    {
+        double direct = 0.;
+        for( unsigned iKernel = 0; iKernel < nKernelBins && iKernel <= iBin; ++iKernel )
+        {
+            direct += kernelValues[iKernel] / kernelNorm * (*powerSpect)(iBin - iKernel);
+        }
+        maxDiff = std::max( maxDiff, std::fabs( (*convolvedPowerSpect)(iBin) - direct ) );
+        maxDiff = std::max( maxDiff, std::fabs( convolvedFFTWSpect->GetReal(iBin) - direct ) );
+        maxDiff = std::max( maxDiff, std::fabs( convolvedPolarSpect->GetReal(iBin) - direct ) );
+    }
+    if( maxDiff > 1.e-6 )
+    {
+        KTERROR(vallog, "Convolution differs from the direct calculation by up to " << maxDiff);
+        return -1;
+    }
+    KTINFO(vallog, "Convolution matches the direct calculation to within " << maxDiff);
 /*
     for( int i = 0; i < nBins; ++i )
     {
@@ -125,6 +157,9 @@ int main()
     delete fftwSpect;
     delete polarSpect;
     delete blur;
+    delete convolvedPowerSpect;
+    delete convolvedFFTWSpect;
+    delete convolvedPolarSpect;
 
     std::cout << "ROOT file has been written to the current directory with the results of this validation." << std::endl;
     std::cout << "If you want to check the contents, open a TBrowser in the file:\n\n$ root TestConvolution1D.root\nroot [1] new TBrowser\n" << std::endl;
@@ -0,0 +1,110 @@
+/*
+ * TestDACKernels.cc
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ *
+ *  Usage: > ./TestDACKernels
+ *
+ *  Purpose: Check that every DAC conversion kernel that the CPU supports gives exactly the same voltages as the lookup table,
+ *           with and without weights
+ */
+
+#include "KTConstants.hh"
+#include "KTDACKernels.hh"
+#include "KTLogger.hh"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Katydid;
+
+KTLOGGER(testlog, "TestDACKernels");
+
+template< typename XSampleType >
+unsigned TestKernels(unsigned dataTypeSize, uint32_t dataFormat)
+{
+    size_t nLevels = size_t(1) << (8 * dataTypeSize);
+    int64_t intLevelOffset = dataFormat == sDigitizedS ? nLevels / 2 : 0;
+    double gain = 0.5 / double(nLevels);
+    double offset = -0.25;
+
+    std::vector< double > voltages(nLevels);
+    for (size_t iLevel = 0; iLevel < nLevels; ++iLevel)
+    {
+        voltages[iLevel] = offset + gain * double(int64_t(iLevel) - intLevelOffset);
+    }
+
+    // an odd number of samples exercises the scalar tail of the vectorized loops
+    std::vector< XSampleType > samples(1037);
+    std::vector< double > weights(samples.size());
+    for (unsigned iSample = 0; iSample < samples.size(); ++iSample)
+    {
+        samples[iSample] = XSampleType(rand());
+        weights[iSample] = double(rand()) / double(RAND_MAX);
+    }
+    std::vector< double > output(samples.size());
+
+    KTDACKernelParams params;
+    params.fVoltages = &voltages[0];
+    params.fIntLevelOffset = intLevelOffset;
+    params.fGain = gain;
+    params.fOffset = offset;
+    params.fWeights = &weights[0];
+
+    unsigned nFailures = 0;
+    for (int instSet = KTDACKernels::kScalar; instSet <= KTDACKernels::GetInstructionSet(); ++instSet)
+    {
+        for (int iVariant = 0; iVariant < 4; ++iVariant)
+        {
+            bool isAffine = iVariant & 1;
+            bool isWeighted = iVariant & 2;
+            KTDACKernel kernel = KTDACKernels::SelectKernel(dataTypeSize, dataFormat, isAffine, isWeighted, KTDACKernels::InstructionSet(instSet));
+            kernel(reinterpret_cast< const uint8_t* >(&samples[0]), &output[0], samples.size(), params);
+
+            unsigned nMismatches = 0;
+            for (size_t iSample = 0; iSample < samples.size(); ++iSample)
+            {
+                double expected = voltages[int64_t(samples[iSample]) + intLevelOffset];
+                if (isWeighted) expected *= weights[iSample];
+                if (memcmp(&output[iSample], &expected, sizeof(double)) != 0) ++nMismatches;
+            }
+
+            std::string kernelName = KTDACKernels::GetInstructionSetName(KTDACKernels::InstructionSet(instSet)) + (isAffine ? " affine" : " lookup") + (isWeighted ? " weighted" : "");
+            if (nMismatches == 0)
+            {
+                KTINFO(testlog, "Data type size " << dataTypeSize << ", format " << dataFormat << ", " << kernelName << " kernel: passed");
+            }
+            else
+            {
+                KTERROR(testlog, "Data type size " << dataTypeSize << ", format " << dataFormat << ", " << kernelName << " kernel: " << nMismatches << " samples do not match");
+                ++nFailures;
+            }
+        }
+    }
+    return nFailures;
+}
+
+int main()
+{
+    srand(20493);
+
+    KTINFO(testlog, "CPU instruction set: " << KTDACKernels::GetInstructionSetName(KTDACKernels::GetInstructionSet()));
+
+    unsigned nFailures = 0;
+    nFailures += TestKernels< uint8_t >(1, sDigitizedUS);
+    nFailures += TestKernels< int8_t >(1, sDigitizedS);
+    nFailures += TestKernels< uint16_t >(2, sDigitizedUS);
+    nFailures += TestKernels< int16_t >(2, sDigitizedS);
+
+    if (nFailures != 0)
+    {
+        KTERROR(testlog, nFailures << " kernel tests failed");
+        return -1;
+    }
+
+    KTINFO(testlog, "All kernel tests passed");
+    return 0;
+}
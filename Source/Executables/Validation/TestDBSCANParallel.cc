@@ -0,0 +1,107 @@
+/*
+ * TestDBSCANParallel.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Usage: > ./TestDBSCANParallel
+ *
+ *  Purpose: Check that the parallel DBSCAN gives exactly the same noise flags, cluster assignments, and cluster contents
+ *           (in the same order) as the serial DBSCAN, on dense blobs in a background of noise, for several thread counts
+ */
+
+#include "KTDBSCAN.hh"
+#include "KTKDTree.hh"
+#include "KTLogger.hh"
+#include "KTPointCloud.hh"
+
+#include <cstdlib>
+
+using namespace Katydid;
+
+KTLOGGER(testlog, "TestDBSCANParallel");
+
+typedef KTPointCloud< KT2DPoint< double > > Cloud;
+typedef KTTreeIndex< double > TreeIndex;
+typedef KTDBSCAN< TreeIndex > DBSCAN;
+
+double Uniform(double min, double max)
+{
+    return min + (max - min) * double(rand()) / double(RAND_MAX);
+}
+
+bool SameResults(const DBSCAN::DBSResults& serial, const DBSCAN::DBSResults& parallel)
+{
+    return serial.fNoise == parallel.fNoise &&
+            serial.fPointIdToClusterId == parallel.fPointIdToClusterId &&
+            serial.fClusters == parallel.fClusters;
+}
+
+int main()
+{
+    srand(1618);
+
+    // blobs of different densities, some close enough to share border points, on top of a uniform background
+    Cloud cloud;
+    const unsigned nBlobs = 40;
+    for (unsigned iBlob = 0; iBlob < nBlobs; ++iBlob)
+    {
+        double centerX = Uniform(0., 100.), centerY = Uniform(0., 100.), size = Uniform(0.5, 3.);
+        unsigned nPoints = 50 + rand() % 500;
+        for (unsigned iPoint = 0; iPoint < nPoints; ++iPoint)
+        {
+            KT2DPoint< double > point;
+            point.fCoords[0] = centerX + Uniform(-size, size);
+            point.fCoords[1] = centerY + Uniform(-size, size);
+            cloud.fPoints.push_back(point);
+        }
+    }
+    for (unsigned iPoint = 0; iPoint < 5000; ++iPoint)
+    {
+        KT2DPoint< double > point;
+        point.fCoords[0] = Uniform(0., 100.);
+        point.fCoords[1] = Uniform(0., 100.);
+        cloud.fPoints.push_back(point);
+    }
+
+    KTTreeIndexEuclidean< double, Cloud > treeIndex(2, cloud, nanoflann::KDTreeSingleIndexAdaptorParams(10));
+    treeIndex.BuildIndex();
+    KTINFO(testlog, "Clustering " << treeIndex.size() << " points");
+
+    unsigned nFailures = 0;
+    const double radii[] = {0.3, 0.7, 1.5};
+    const unsigned minPoints[] = {1, 3, 8};
+    for (unsigned iRadius = 0; iRadius < 3; ++iRadius)
+    {
+        for (unsigned iMinPoints = 0; iMinPoints < 3; ++iMinPoints)
+        {
+            DBSCAN serialDBSCAN(radii[iRadius], minPoints[iMinPoints]);
+            DBSCAN::DBSResults serialResults;
+            serialDBSCAN.DoSerialClustering(treeIndex, serialResults);
+
+            for (unsigned nThreads = 1; nThreads <= 4; ++nThreads)
+            {
+                DBSCAN parallelDBSCAN(radii[iRadius], minPoints[iMinPoints]);
+                parallelDBSCAN.SetNThreads(nThreads);
+                DBSCAN::DBSResults parallelResults;
+                parallelDBSCAN.DoParallelClustering(treeIndex, parallelResults);
+
+                if (! SameResults(serialResults, parallelResults))
+                {
+                    KTERROR(testlog, "Radius " << radii[iRadius] << ", min points " << minPoints[iMinPoints] << ", " << nThreads << " threads: parallel results differ from the serial results");
+                    ++nFailures;
+                }
+            }
+            KTINFO(testlog, "Radius " << radii[iRadius] << ", min points " << minPoints[iMinPoints] << ": " << serialResults.fClusters.size() << " clusters");
+        }
+    }
+
+    if (nFailures != 0)
+    {
+        KTERROR(testlog, nFailures << " parallel DBSCAN tests failed");
+        return -1;
+    }
+
+    KTINFO(testlog, "All parallel DBSCAN tests passed");
+    return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * TestDiscriminatedPoints1D.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Usage: > ./TestDiscriminatedPoints1D
+ *
+ *  Purpose: Check that KTDiscriminatedPointSet1D holds the same points, in the same (bin) order, as the std::map that it replaced,
+ *           for points added in order, out of order, and with repeated bins, and that KTDiscriminatedPoints1DData keeps the
+ *           components separate
+ */
+
+#include "KTDiscriminatedPoints1DData.hh"
+#include "KTLogger.hh"
+
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace Katydid;
+
+KTLOGGER(testlog, "TestDiscriminatedPoints1D");
+
+typedef KTDiscriminatedPoints1DData::SetOfPoints SetOfPoints;
+typedef SetOfPoints::Point Point;
+typedef std::map< unsigned, Point > ReferenceMap;
+
+Point MakePoint(unsigned bin, unsigned version)
+{
+    // every quantity is different, so that a mix-up between the arrays would be noticed
+    double value = double(bin) + 0.001 * double(version);
+    return Point(value, 2. * value, 3. * value, 4. * value, 5. * value, 6. * value);
+}
+
+bool SamePoint(const Point& lhs, const Point& rhs)
+{
+    return lhs.fAbscissa == rhs.fAbscissa && lhs.fOrdinate == rhs.fOrdinate && lhs.fThreshold == rhs.fThreshold &&
+            lhs.fMean == rhs.fMean && lhs.fVariance == rhs.fVariance && lhs.fNeighborhoodAmplitude == rhs.fNeighborhoodAmplitude;
+}
+
+// Compares the set with the map: size, iteration order, the index-based accessors, find(), and count()
+unsigned Compare(const SetOfPoints& points, const ReferenceMap& reference, const std::string& name)
+{
+    unsigned nFailures = 0;
+    if (points.size() != reference.size())
+    {
+        KTERROR(testlog, name << ": the set has " << points.size() << " points; expected " << reference.size());
+        return 1;
+    }
+
+    SetOfPoints::const_iterator pointIt = points.begin();
+    size_t index = 0;
+    for (ReferenceMap::const_iterator refIt = reference.begin(); refIt != reference.end(); ++refIt, ++pointIt, ++index)
+    {
+        if (pointIt->first != refIt->first || ! SamePoint(pointIt->second, refIt->second) || pointIt.GetIndex() != index ||
+                points.GetBin(index) != refIt->first || ! SamePoint(points.GetPoint(index), refIt->second) ||
+                points.GetAbscissae()[index] != refIt->second.fAbscissa || points.GetNeighborhoodAmplitudes()[index] != refIt->second.fNeighborhoodAmplitude)
+        {
+            KTERROR(testlog, name << ": point " << index << " (bin " << refIt->first << ") does not match");
+            ++nFailures;
+        }
+
+        SetOfPoints::const_iterator foundIt = points.find(refIt->first);
+        if (foundIt == points.end() || foundIt.GetIndex() != index || points.count(refIt->first) != 1)
+        {
+            KTERROR(testlog, name << ": bin " << refIt->first << " was not found at position " << index);
+            ++nFailures;
+        }
+    }
+    if (pointIt != points.end())
+    {
+        KTERROR(testlog, name << ": iteration did not end after the last point");
+        ++nFailures;
+    }
+
+    // a bin that's not in the set
+    unsigned missingBin = reference.empty() ? 0 : reference.rbegin()->first + 1;
+    if (points.find(missingBin) != points.end() || points.count(missingBin) != 0)
+    {
+        KTERROR(testlog, name << ": found bin " << missingBin << ", which was never added");
+        ++nFailures;
+    }
+    return nFailures;
+}
+
+int main()
+{
+    srand(4669);
+
+    unsigned nFailures = 0;
+
+    // points in increasing bin order, with gaps and with repeated bins; as with std::map, the first point in a bin is kept
+    {
+        SetOfPoints points;
+        ReferenceMap reference;
+        unsigned bin = 0;
+        for (unsigned iPoint = 0; iPoint < 1000; ++iPoint)
+        {
+            if (rand() % 4 != 0) bin += 1 + rand() % 5;
+            Point point = MakePoint(bin, iPoint);
+            bool added = points.Add(bin, point);
+            bool refAdded = reference.insert(ReferenceMap::value_type(bin, point)).second;
+            if (added != refAdded) ++nFailures;
+        }
+        nFailures += Compare(points, reference, "In order");
+    }
+
+    // points in random order, including repeated bins, which are inserted in place
+    {
+        SetOfPoints points;
+        ReferenceMap reference;
+        for (unsigned iPoint = 0; iPoint < 1000; ++iPoint)
+        {
+            unsigned bin = rand() % 700;
+            Point point = MakePoint(bin, iPoint);
+            bool added = points.insert(SetOfPoints::value_type(bin, point)).second;
+            bool refAdded = reference.insert(ReferenceMap::value_type(bin, point)).second;
+            if (added != refAdded) ++nFailures;
+        }
+        nFailures += Compare(points, reference, "Random order");
+
+        points.clear();
+        if (! points.empty() || points.begin() != points.end()) ++nFailures;
+    }
+
+    // several components, each filled after reserving space; the components must not share points
+    {
+        const unsigned nComponents = 4;
+        KTDiscriminatedPoints1DData data;
+        data.SetNComponents(nComponents);
+        std::vector< ReferenceMap > references(nComponents);
+        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+        {
+            data.ReservePoints(100 * (iComponent + 1), iComponent);
+        }
+        // interleave the components, with repeated bins in each
+        for (unsigned bin = 0; bin < 500; ++bin)
+        {
+            for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+            {
+                if (bin % (iComponent + 2) != 0) continue;
+                for (unsigned iRepeat = 0; iRepeat < 2; ++iRepeat)
+                {
+                    Point point = MakePoint(bin, 10 * iComponent + iRepeat);
+                    data.AddPoint(bin, point, iComponent);
+                    references[iComponent].insert(ReferenceMap::value_type(bin, point));
+                }
+            }
+        }
+        // adding to a component past the last one adds components
+        data.AddPoint(7, MakePoint(7, 99), nComponents);
+        references.push_back(ReferenceMap());
+        references.back().insert(ReferenceMap::value_type(7, MakePoint(7, 99)));
+
+        if (data.GetNComponents() != nComponents + 1)
+        {
+            KTERROR(testlog, "There are " << data.GetNComponents() << " components; expected " << nComponents + 1);
+            ++nFailures;
+        }
+        for (unsigned iComponent = 0; iComponent < data.GetNComponents(); ++iComponent)
+        {
+            nFailures += Compare(data.GetSetOfPoints(iComponent), references[iComponent], "Component " + std::to_string(iComponent));
+        }
+    }
+
+    if (nFailures != 0)
+    {
+        KTERROR(testlog, nFailures << " discriminated-point tests failed");
+        return -1;
+    }
+
+    KTINFO(testlog, "All discriminated-point tests passed");
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*
+ * TestKDTreeForest.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Usage: > ./TestKDTreeForest
+ *
+ *  Purpose: Slide a window over slices of random points, keeping the index as a forest of per-block trees,
+ *           and check the radius and nearest-neighbor searches against a single tree built from the same points
+ */
+
+#include "KTKDTree.hh"
+#include "KTLogger.hh"
+#include "KTPointCloud.hh"
+
+#include <cmath>
+#include <cstdlib>
+#include <stdint.h>
+
+using namespace Katydid;
+
+KTLOGGER(testlog, "TestKDTreeForest");
+
+struct SlicePoint : KT2DPoint< double >
+{
+    typedef KT2DPoint< double >::coord_t coord_t;
+    uint64_t fSliceNumber;
+};
+
+typedef KTPointCloud< SlicePoint > Cloud;
+
+template< bool EUCLIDEAN >
+unsigned CheckSearches(const Cloud& cloud, const KTTreeIndex< double >& forest, const KTTreeIndex< double >& tree)
+{
+    typedef KTTreeIndex< double >::Neighbors Neighbors;
+
+    const double radius = 1.5;
+    const size_t nNearest = 5;
+
+    unsigned nFailures = 0;
+    for (size_t iPoint = 0; iPoint < cloud.fPoints.size(); ++iPoint)
+    {
+        Neighbors forestByRadius = forest.NearestNeighborsByRadius(iPoint, radius);
+        Neighbors treeByRadius = tree.NearestNeighborsByRadius(iPoint, radius);
+        bool radiusMatches = forestByRadius.size() == treeByRadius.size();
+        for (size_t iNeighbor = 0; radiusMatches && iNeighbor < forestByRadius.size(); ++iNeighbor)
+        {
+            radiusMatches = std::fabs(forestByRadius.dist(iNeighbor) - treeByRadius.dist(iNeighbor)) < 1.e-12;
+        }
+
+        Neighbors forestByNumber = forest.NearestNeighborsByNumber(iPoint, nNearest);
+        Neighbors treeByNumber = tree.NearestNeighborsByNumber(iPoint, nNearest);
+        bool numberMatches = forestByNumber.size() == nNearest;
+        for (size_t iNeighbor = 0; numberMatches && iNeighbor < nNearest; ++iNeighbor)
+        {
+            numberMatches = std::fabs(forestByNumber.dist(iNeighbor) - treeByNumber.dist(iNeighbor)) < 1.e-12;
+        }
+
+        if (! radiusMatches || ! numberMatches) ++nFailures;
+    }
+    return nFailures;
+}
+
+template< bool EUCLIDEAN >
+unsigned RunWindows(const char* name)
+{
+    typedef KTTreeIndexBlockForest< double, Cloud, EUCLIDEAN > Forest;
+    typedef typename std::conditional< EUCLIDEAN, KTTreeIndexEuclidean< double, Cloud >, KTTreeIndexManhattan< double, Cloud > >::type Tree;
+
+    const unsigned windowSize = 6;
+    const unsigned windowOverlap = 2;
+    const unsigned stride = windowSize - windowOverlap;
+    const unsigned nSlices = 60;
+    const unsigned maxPointsPerSlice = 40;
+
+    Cloud cloud;
+    Forest forest(2, cloud, nanoflann::KDTreeSingleIndexAdaptorParams(10));
+
+    unsigned nFailures = 0;
+    size_t blockStart = 0;
+    for (uint64_t iSlice = 0; iSlice < nSlices; ++iSlice)
+    {
+        unsigned nPoints = rand() % maxPointsPerSlice;
+        for (unsigned iPoint = 0; iPoint < nPoints; ++iPoint)
+        {
+            SlicePoint point;
+            point.fSliceNumber = iSlice;
+            point.fCoords[0] = double(iSlice) + double(rand()) / double(RAND_MAX);
+            point.fCoords[1] = 20. * double(rand()) / double(RAND_MAX);
+            cloud.fPoints.push_back(point);
+        }
+
+        // each block holds the slices that leave the window together
+        if ((iSlice + 1) % stride == 0)
+        {
+            forest.AddBlock(cloud.fPoints.size() - blockStart);
+            blockStart = cloud.fPoints.size();
+        }
+
+        if ((iSlice + 1 - windowSize) % stride == 0 && iSlice + 1 >= windowSize)
+        {
+            forest.AddBlock(cloud.fPoints.size() - blockStart);
+            blockStart = cloud.fPoints.size();
+
+            Tree tree(2, cloud, nanoflann::KDTreeSingleIndexAdaptorParams(10));
+            tree.BuildIndex();
+            if (forest.size() != cloud.fPoints.size()) ++nFailures;
+            nFailures += CheckSearches< EUCLIDEAN >(cloud, forest, tree);
+
+            // alternate between removing whole blocks and removing part of a block, which has to be rebuilt
+            uint64_t firstSliceKept = iSlice + 1 - windowOverlap - (iSlice % 2);
+            size_t nToRemove = 0;
+            while (nToRemove != cloud.fPoints.size() && cloud.fPoints[nToRemove].fSliceNumber < firstSliceKept) ++nToRemove;
+            cloud.fPoints.erase(cloud.fPoints.begin(), cloud.fPoints.begin() + nToRemove);
+            forest.RetireFirstPoints(nToRemove);
+            blockStart -= nToRemove;
+        }
+    }
+
+    KTINFO(testlog, name << ": " << nFailures << " mismatches; " << forest.GetNBlocks() << " blocks in the final forest");
+    return nFailures;
+}
+
+int main()
+{
+    srand(2718);
+
+    unsigned nFailures = RunWindows< true >("Euclidean") + RunWindows< false >("Manhattan");
+    if (nFailures != 0)
+    {
+        KTERROR(testlog, "The forest's searches do not match a single tree");
+        return -1;
+    }
+
+    KTINFO(testlog, "All k-d tree forest tests passed");
+    return 0;
+}
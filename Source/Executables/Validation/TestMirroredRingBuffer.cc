@@ -0,0 +1,83 @@
+/*
+ * TestMirroredRingBuffer.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Usage: > ./TestMirroredRingBuffer
+ *
+ *  Purpose: Check that the mirrored ring buffer behaves as a FIFO, with its contents always contiguous,
+ *           through wrap-arounds and growth
+ */
+
+#include "KTLogger.hh"
+#include "KTMirroredRingBuffer.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+using namespace Katydid;
+
+KTLOGGER(testlog, "TestMirroredRingBuffer");
+
+int main()
+{
+    srand(5813);
+
+    KTMirroredRingBuffer< int > buffer;
+    buffer.Reserve(100);
+    if (buffer.Capacity() != 128)
+    {
+        KTERROR(testlog, "Capacity is " << buffer.Capacity() << "; expected 128");
+        return -1;
+    }
+
+    // the reference is a plain deque
+    std::deque< int > reference;
+    int nextValue = 0;
+    unsigned nFailures = 0;
+    for (unsigned iStep = 0; iStep < 1000; ++iStep)
+    {
+        // blocks of up to 60 samples wrap around the ring often, and occasionally make it grow
+        std::vector< int > block(rand() % 60);
+        for (unsigned iValue = 0; iValue < block.size(); ++iValue)
+        {
+            block[iValue] = nextValue++;
+            reference.push_back(block[iValue]);
+        }
+        buffer.Append(block.data(), block.size());
+
+        size_t nToConsume = std::min(size_t(rand() % 60), reference.size());
+        buffer.Consume(nToConsume);
+        reference.erase(reference.begin(), reference.begin() + nToConsume);
+
+        if (buffer.Size() != reference.size())
+        {
+            KTERROR(testlog, "Step " << iStep << ": size is " << buffer.Size() << "; expected " << reference.size());
+            ++nFailures;
+            continue;
+        }
+        // read the contents through one pointer, so they have to be contiguous
+        const int* contents = buffer.GetData();
+        for (unsigned iValue = 0; iValue < reference.size(); ++iValue)
+        {
+            if (contents[iValue] != reference[iValue])
+            {
+                KTERROR(testlog, "Step " << iStep << ": value " << iValue << " is " << contents[iValue] << "; expected " << reference[iValue]);
+                ++nFailures;
+                break;
+            }
+        }
+    }
+
+    if (nFailures != 0)
+    {
+        KTERROR(testlog, nFailures << " ring buffer tests failed");
+        return -1;
+    }
+
+    KTINFO(testlog, "All ring buffer tests passed; final capacity: " << buffer.Capacity());
+    return 0;
+}
@@ -6,6 +6,9 @@
 @details
 This executable tests the finding of SparseWaterfallCandidates by faking DiscriminatedPoints1DData
 and tests the behavior of the algorithms in this processor.
+It also checks the STF's indexed point-to-line association against a reference copy of the original linear scan over the
+active lines: on dense fake data, with many lines active at once and retired out of order, both have to produce the same
+candidates, with the same IDs (i.e. retired in the same order), slopes, and points (i.e. matched in the same order).
 */
 
 
@@ -23,6 +26,10 @@ and tests the behavior of the algorithms in this processor.
 #include "KTROOTTreeTypeWriterEventAnalysis.hh"
 #include "KTRandom.hh"
 
+#include <cmath>
+#include <limits>
+#include <map>
+#include <vector>
 
 
 using namespace Katydid;
@@ -97,6 +104,248 @@ KTDiscriminatedPoints1DData createFakeData(unsigned sliceNumber, double timeBinW
 
 
 
+// Reference for the point-to-line association: the original linear scan over the active lines, which are kept in order of
+// creation and erased in place.  Only the total-SNR cut is reproduced, so the other cuts have to be off in the STF.
+class ReferenceSTF
+{
+    public:
+        struct Candidate
+        {
+            unsigned fID;
+            double fSlope;
+            KTDiscriminatedPoints fPoints;
+        };
+
+        ReferenceSTF(const KTSequentialTrackFinder& stf) :
+                fSTF(stf),
+                fActiveLines(),
+                fCandidates()
+        {}
+
+        void CollectDiscrimPointsFromSlice(KTSliceHeader& slHeader, KTDiscriminatedPoints1DData& discrimPoints)
+        {
+            double freqBinWidth = slHeader.GetSampleRate() / (double)slHeader.GetRawSliceSize();
+            unsigned minBin = (unsigned)(fSTF.GetMinFrequency() / freqBinWidth);
+            unsigned maxBin = (unsigned)(fSTF.GetMaxFrequency() / freqBinWidth);
+            double newTimeInAcq = slHeader.GetTimeInAcq() + 0.5 * slHeader.GetSliceLength();
+            double newTimeInRunC = slHeader.GetTimeInRun() + 0.5 * slHeader.GetSliceLength();
+
+            KTSequentialTrackFinder::STFDiscriminatedPowerSortedPoints points;
+            const KTDiscriminatedPoints1DData::SetOfPoints& incomingPts = discrimPoints.GetSetOfPoints(0);
+            for (unsigned iPoint = 0; iPoint < incomingPts.size(); ++iPoint)
+            {
+                if (incomingPts.GetBin(iPoint) < minBin || incomingPts.GetBin(iPoint) > maxBin) continue;
+                points.emplace(incomingPts, iPoint, newTimeInRunC, newTimeInAcq);
+            }
+
+            for (KTSequentialTrackFinder::STFDiscriminatedPowerSortedPoints::reverse_iterator pointIt = points.rbegin(); pointIt != points.rend(); ++pointIt)
+            {
+                if (pointIt->fFrequency == 0.0 || pointIt->fAmplitude == 0.0) continue;
+
+                bool match = false;
+                std::vector< KTSequentialLineData >::iterator lineIt = fActiveLines.begin();
+                while (lineIt != fActiveLines.end())
+                {
+                    if (lineIt->GetEndTimeInRunC() < pointIt->fTimeInRunC - fSTF.GetTimeGapTolerance())
+                    {
+                        if (lineIt->GetNPoints() >= fSTF.GetMinPoints())
+                        {
+                            lineIt->LineSNRTrimming(fSTF.GetTrimmingThreshold(), fSTF.GetMinPoints());
+                            if (lineIt->GetNPoints() >= fSTF.GetMinPoints() && lineIt->GetSlope() >= fSTF.GetMinSlope())
+                            {
+                                CalculateSlope(*lineIt);
+                                EmitCandidate(*lineIt);
+                            }
+                        }
+                        lineIt = fActiveLines.erase(lineIt);
+                        continue;
+                    }
+
+                    bool timeCondition = pointIt->fTimeInRunC > lineIt->GetEndTimeInRunC();
+                    double deviation = std::abs(pointIt->fFrequency - (lineIt->GetEndFrequency() + lineIt->GetSlope() * (pointIt->fTimeInAcq - lineIt->GetEndTimeInAcq())));
+                    if ((timeCondition && deviation < fSTF.GetFrequencyAcceptance()) ||
+                            (lineIt->GetNPoints() == 1 && timeCondition && deviation < fSTF.GetInitialFrequencyAcceptance()))
+                    {
+                        lineIt->AddPoint(*pointIt);
+                        CalculateSlope(*lineIt);
+                        match = true;
+                        break;
+                    }
+                    ++lineIt;
+                }
+
+                if (! match)
+                {
+                    KTSequentialLineData newLine;
+                    newLine.SetSlope(fSTF.GetInitialSlope());
+                    newLine.SetAcquisitionID(slHeader.GetAcquisitionID(0));
+                    newLine.SetComponent(0);
+                    newLine.AddPoint(*pointIt);
+                    CalculateSlope(newLine);
+                    fActiveLines.push_back(newLine);
+                }
+            }
+            return;
+        }
+
+        void AcquisitionIsOver()
+        {
+            for (std::vector< KTSequentialLineData >::iterator lineIt = fActiveLines.begin(); lineIt != fActiveLines.end(); ++lineIt)
+            {
+                if (lineIt->GetNPoints() >= fSTF.GetMinPoints())
+                {
+                    lineIt->LineSNRTrimming(fSTF.GetTrimmingThreshold(), fSTF.GetMinPoints());
+                    if (lineIt->GetNPoints() >= fSTF.GetMinPoints() && lineIt->GetSlope() > fSTF.GetMinSlope())
+                    {
+                        EmitCandidate(*lineIt);
+                    }
+                }
+            }
+            fActiveLines.clear();
+            return;
+        }
+
+        const std::vector< Candidate >& GetCandidates() const
+        {
+            return fCandidates;
+        }
+
+    private:
+        // The STF's default slope method, "weighted-first-point-ref"
+        void CalculateSlope(KTSequentialLineData& line)
+        {
+            unsigned nSlopePoints = fSTF.GetNSlopePoints();
+            KTDiscriminatedPoints& points = line.GetPoints();
+            if (line.GetNPoints() > nSlopePoints)
+            {
+                KTDiscriminatedPoints::iterator pointIt = points.end();
+                std::advance(pointIt, -1);
+                line.SetWeightedSlopeSum(line.GetWeightedSlopeSum() + (pointIt->fFrequency - line.GetStartFrequency()) / (pointIt->fTimeInRunC - line.GetStartTimeInRunC()) * line.GetSNRList().back());
+                std::advance(pointIt, -(fSTF.GetNSlopePoints() - 1));
+                line.SetWeightedSlopeSum(line.GetWeightedSlopeSum() - (pointIt->fFrequency - line.GetStartFrequency()) / (pointIt->fTimeInRunC - line.GetStartTimeInRunC()) * line.GetSNRList().rbegin()[nSlopePoints - 1]);
+                line.SetTotalWideSNR(line.GetTotalWideSNR() - line.GetSNRList().rbegin()[nSlopePoints - 1]);
+                line.SetSlope(line.GetWeightedSlopeSum() / line.GetTotalWideSNR());
+            }
+            else if (line.GetNPoints() > 1)
+            {
+                line.SetWeightedSlopeSum(line.GetWeightedSlopeSum() + (points.rbegin()->fFrequency - line.GetStartFrequency()) / (points.rbegin()->fTimeInRunC - line.GetStartTimeInRunC()) * line.GetSNRList().back());
+                line.SetSlope(line.GetWeightedSlopeSum() / line.GetTotalWideSNR());
+            }
+            else
+            {
+                line.SetSlope(fSTF.GetInitialSlope());
+            }
+            return;
+        }
+
+        void EmitCandidate(KTSequentialLineData& line)
+        {
+            line.CalculateTotalPower();
+            line.CalculateTotalSNR();
+            line.CalculateTotalNUP();
+            if (fSTF.GetApplyTotalSNRCut() && line.GetTotalWideSNR() <= fSTF.GetTotalSNRThreshold()) return;
+
+            Candidate candidate;
+            candidate.fID = fCandidates.size();
+            candidate.fSlope = line.GetSlope();
+            candidate.fPoints = line.GetPoints();
+            fCandidates.push_back(candidate);
+            return;
+        }
+
+        const KTSequentialTrackFinder& fSTF;
+        std::vector< KTSequentialLineData > fActiveLines;
+        std::vector< Candidate > fCandidates;
+};
+
+// Dense fake data in a narrow band: many short noise lines and several overlapping tracks with different slopes, start
+// times, and lengths, so that many lines are active at once and they end (and are retired) in a different order than they started
+KTDiscriminatedPoints1DData createDenseFakeData(unsigned sliceNumber, double freqBinWidth, KTRNGUniform<>& binDistribution, KTRNGGaussian<>& powerDistribution, KTRNGPoisson<>& nPointsDistribution)
+{
+    const double pointPowerMean = 1e-6;
+    const double pointPowerStd = 1e-7;
+    const double threshold = pointPowerMean - 2 * pointPowerStd;
+
+    KTDiscriminatedPoints1DData disc1d;
+
+    int nPoints = nPointsDistribution();
+    for (int iPoint = 0; iPoint < nPoints; ++iPoint)
+    {
+        double power = std::abs(powerDistribution());
+        unsigned iBin = binDistribution();
+        disc1d.AddPoint(iBin, KTDiscriminatedPoints1DData::Point(freqBinWidth * ((double)iBin + 0.5), power, threshold, pointPowerMean, pointPowerStd, 2 * power), 0);
+    }
+
+    // start slice, length (slices), first bin, and slope (bins per slice) of each track
+    const unsigned nTracks = 6;
+    const unsigned trackStarts[nTracks] = {5, 10, 12, 30, 31, 60};
+    const unsigned trackLengths[nTracks] = {80, 20, 45, 10, 60, 25};
+    const double trackFirstBins[nTracks] = {1050., 1100., 1090., 1200., 1150., 1020.};
+    const double trackSlopes[nTracks] = {1.5, 0.5, 2., 0., 1., 3.};
+    for (unsigned iTrack = 0; iTrack < nTracks; ++iTrack)
+    {
+        if (sliceNumber < trackStarts[iTrack] || sliceNumber >= trackStarts[iTrack] + trackLengths[iTrack]) continue;
+        double power = 2. * pointPowerMean + std::abs(powerDistribution());
+        unsigned iBin = (unsigned)(trackFirstBins[iTrack] + trackSlopes[iTrack] * (double)(sliceNumber - trackStarts[iTrack]));
+        disc1d.AddPoint(iBin, KTDiscriminatedPoints1DData::Point(freqBinWidth * ((double)iBin + 0.5), power, threshold, pointPowerMean, pointPowerStd, 2 * power), 0);
+    }
+    return disc1d;
+}
+
+// Runs the STF and the reference on the same data, and compares the candidates in the order of their IDs
+unsigned TestAssociationEquivalence(const std::string& name, KTSequentialTrackFinder& stf, unsigned nSlices, double timeBinWidth, double freqBinWidth)
+{
+    ReferenceSTF reference(stf);
+
+    KTRNGUniform<> binDistribution(1000, 1300);
+    KTRNGGaussian<> powerDistribution(1e-6, 1e-7);
+    KTRNGPoisson<> nPointsDistribution(12);
+    for (unsigned iSlice = 0; iSlice < nSlices; ++iSlice)
+    {
+        KTSliceHeader header = createFakeHeader(iSlice, timeBinWidth);
+        KTDiscriminatedPoints1DData disc1d = createDenseFakeData(iSlice, freqBinWidth, binDistribution, powerDistribution, nPointsDistribution);
+        stf.CollectDiscrimPointsFromSlice(header, disc1d);
+        reference.CollectDiscrimPointsFromSlice(header, disc1d);
+    }
+    stf.AcquisitionIsOver();
+    reference.AcquisitionIsOver();
+
+    std::map< unsigned, const KTSequentialLineData* > stfCandidates;
+    const std::set< Nymph::KTDataPtr >& candidates = stf.GetCandidates();
+    for (std::set< Nymph::KTDataPtr >::const_iterator cIt = candidates.begin(); cIt != candidates.end(); ++cIt)
+    {
+        const KTSequentialLineData& line = (*cIt)->Of< KTSequentialLineData >();
+        stfCandidates[line.GetCandidateID()] = &line;
+    }
+
+    const std::vector< ReferenceSTF::Candidate >& refCandidates = reference.GetCandidates();
+    KTINFO(testlog, name << ": " << candidates.size() << " candidates from the STF and " << refCandidates.size() << " from the reference");
+    if (stfCandidates.size() != candidates.size() || candidates.size() != refCandidates.size() || refCandidates.size() < 5)
+    {
+        KTERROR(testlog, name << ": the numbers of candidates do not match (or the IDs are not unique, or there are too few candidates to be a test)");
+        return 1;
+    }
+
+    unsigned nFailures = 0;
+    std::map< unsigned, const KTSequentialLineData* >::const_iterator stfIt = stfCandidates.begin();
+    for (std::vector< ReferenceSTF::Candidate >::const_iterator refIt = refCandidates.begin(); refIt != refCandidates.end(); ++refIt, ++stfIt)
+    {
+        const KTSequentialLineData& line = *stfIt->second;
+        bool samePoints = line.GetPoints().size() == refIt->fPoints.size();
+        KTDiscriminatedPoints::const_iterator refPointIt = refIt->fPoints.begin();
+        for (KTDiscriminatedPoints::const_iterator pointIt = line.GetPoints().begin(); samePoints && pointIt != line.GetPoints().end(); ++pointIt, ++refPointIt)
+        {
+            samePoints = pointIt->fTimeInRunC == refPointIt->fTimeInRunC && pointIt->fFrequency == refPointIt->fFrequency && pointIt->fAmplitude == refPointIt->fAmplitude;
+        }
+        if (stfIt->first != refIt->fID || line.GetSlope() != refIt->fSlope || ! samePoints)
+        {
+            KTERROR(testlog, name << ": candidate " << stfIt->first << " (" << line.GetPoints().size() << " points, slope " << line.GetSlope() << ") does not match reference candidate "
+                    << refIt->fID << " (" << refIt->fPoints.size() << " points, slope " << refIt->fSlope << ")");
+            ++nFailures;
+        }
+    }
+    return nFailures;
+}
 
 
 int main()
@@ -108,6 +357,36 @@ int main()
 
     KTINFO(testlog, "Testing STF!");
 
+    // Association equivalence: one run with the default cuts and acceptances, and one with a wider acceptance for the second
+    // point of a line, negative slopes allowed, and the total-SNR cut
+    unsigned nFailures = 0;
+    {
+        KTSequentialTrackFinder stf;
+        stf.SetMinFrequency(0.);
+        stf.SetMaxFrequency(100.e6);
+        stf.SetTimeGapTolerance(3.5 * timeBinWidth);
+        nFailures += TestAssociationEquivalence("Default settings", stf, 150, timeBinWidth, freqBinWidth);
+    }
+    {
+        KTSequentialTrackFinder stf;
+        stf.SetMinFrequency(0.);
+        stf.SetMaxFrequency(100.e6);
+        stf.SetTimeGapTolerance(5.5 * timeBinWidth);
+        stf.SetFrequencyAcceptance(60.e3);
+        stf.SetInitialFrequencyAcceptance(150.e3);
+        stf.SetMinPoints(2);
+        stf.SetMinSlope(-std::numeric_limits< double >::max());
+        stf.SetTrimmingThreshold(0.9);
+        stf.SetApplyTotalSNRCut(true);
+        stf.SetTotalSNRThreshold(3);
+        nFailures += TestAssociationEquivalence("Wide acceptance", stf, 150, timeBinWidth, freqBinWidth);
+    }
+    if (nFailures != 0)
+    {
+        KTERROR(testlog, nFailures << " candidates from the STF do not match the reference association");
+        return -1;
+    }
+
     KTSequentialTrackFinder stf;
     KTOverlappingTrackClustering otc;
     KTIterativeTrackClustering itc;
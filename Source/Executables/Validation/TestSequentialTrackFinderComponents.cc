@@ -0,0 +1,240 @@
+/*
+ * TestSequentialTrackFinderComponents.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Usage: > ./TestSequentialTrackFinderComponents
+ *
+ *  Purpose: Check that the sequential track finder processes every component of the discriminated points given to the disc-1d slot,
+ *           that the components don't share lines (each component's candidates are the same as when that component is
+ *           processed alone), and that the candidates, including their IDs, don't depend on the number of component threads
+ */
+
+#include "KTDiscriminatedPoints1DData.hh"
+#include "KTLogger.hh"
+#include "KTRandom.hh"
+#include "KTSequentialLineData.hh"
+#include "KTSequentialTrackFinder.hh"
+#include "KTSliceHeader.hh"
+
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace Katydid;
+
+KTLOGGER(testlog, "TestSequentialTrackFinderComponents");
+
+typedef KTDiscriminatedPoints1DData::Point Point;
+
+struct FakePoint
+{
+    unsigned fBin;
+    double fPower;
+};
+typedef std::vector< FakePoint > FakeComponent; // one slice of one component
+typedef std::vector< FakeComponent > FakeSlice; // indexed over component
+
+const unsigned sNComponents = 4;
+const double sTimeBinWidth = 4.096e-5;
+const double sFreqBinWidth = 24414.0625; // 100 MHz / 4096
+const double sPointPowerMean = 1e-6;
+const double sPointPowerStd = 1e-7;
+
+// All of the components cover the same band, so lines shared between components would pick up points from the others.
+// Each component has noise and two tracks, which start at different times in different components.
+std::vector< FakeSlice > CreateFakeData(unsigned nSlices)
+{
+    KTRNGUniform<> binDistribution(1000, 1200);
+    KTRNGGaussian<> powerDistribution(sPointPowerMean, sPointPowerStd);
+    KTRNGPoisson<> nPointsDistribution(6);
+
+    std::vector< FakeSlice > slices(nSlices, FakeSlice(sNComponents));
+    for (unsigned iSlice = 0; iSlice < nSlices; ++iSlice)
+    {
+        for (unsigned iComponent = 0; iComponent < sNComponents; ++iComponent)
+        {
+            FakeComponent& component = slices[iSlice][iComponent];
+            int nPoints = nPointsDistribution();
+            for (int iPoint = 0; iPoint < nPoints; ++iPoint)
+            {
+                FakePoint point = {binDistribution(), std::abs(powerDistribution())};
+                component.push_back(point);
+            }
+
+            for (unsigned iTrack = 0; iTrack < 2; ++iTrack)
+            {
+                unsigned trackStart = 5 + 10 * iComponent + 40 * iTrack;
+                if (iSlice < trackStart || iSlice >= trackStart + 30) continue;
+                FakePoint point = {1050 + 50 * iTrack + (iSlice - trackStart), 2. * sPointPowerMean + std::abs(powerDistribution())};
+                component.push_back(point);
+            }
+        }
+    }
+    return slices;
+}
+
+KTSliceHeader CreateFakeHeader(unsigned sliceNumber)
+{
+    KTSliceHeader header;
+    header.SetNComponents(sNComponents);
+    header.SetBinWidth(sTimeBinWidth);
+    header.SetTimeInAcq(sTimeBinWidth * sliceNumber);
+    header.SetTimeInRun(sTimeBinWidth * sliceNumber);
+    header.SetSampleRate(100.e6);
+    header.SetRawSliceSize(4096);
+    for (unsigned iComponent = 0; iComponent < sNComponents; ++iComponent)
+    {
+        header.SetAcquisitionID(5, iComponent);
+    }
+    return header;
+}
+
+// Candidate properties that identify it, with the points flattened as (time, frequency) pairs
+struct CandidateSummary
+{
+    unsigned fID;
+    unsigned fComponent;
+    double fSlope;
+    std::vector< double > fPoints;
+
+    bool operator==(const CandidateSummary& rhs) const
+    {
+        return fComponent == rhs.fComponent && fSlope == rhs.fSlope && fPoints == rhs.fPoints;
+    }
+};
+
+// Runs the STF over the data, using only the components in includeComponents (the others are left empty);
+// returns the candidates in order of their IDs
+std::vector< CandidateSummary > RunSTF(const std::vector< FakeSlice >& slices, unsigned nThreads, const std::vector< bool >& includeComponents)
+{
+    KTSequentialTrackFinder stf;
+    stf.SetMinFrequency(0.);
+    stf.SetMaxFrequency(100.e6);
+    stf.SetTimeGapTolerance(3.5 * sTimeBinWidth);
+    stf.SetFrequencyAcceptance(60.e3);
+    stf.SetInitialFrequencyAcceptance(100.e3);
+    stf.SetMinPoints(3);
+    stf.SetTrimmingThreshold(0.9);
+    stf.SetNComponentThreads(nThreads);
+
+    const double threshold = sPointPowerMean - 2. * sPointPowerStd;
+    for (unsigned iSlice = 0; iSlice < slices.size(); ++iSlice)
+    {
+        KTSliceHeader header = CreateFakeHeader(iSlice);
+        KTDiscriminatedPoints1DData disc1d;
+        disc1d.SetNComponents(sNComponents);
+        for (unsigned iComponent = 0; iComponent < sNComponents; ++iComponent)
+        {
+            if (! includeComponents[iComponent]) continue;
+            const FakeComponent& component = slices[iSlice][iComponent];
+            for (FakeComponent::const_iterator pointIt = component.begin(); pointIt != component.end(); ++pointIt)
+            {
+                disc1d.AddPoint(pointIt->fBin, Point(sFreqBinWidth * ((double)pointIt->fBin + 0.5), pointIt->fPower, threshold, sPointPowerMean, sPointPowerStd, 2. * pointIt->fPower), iComponent);
+            }
+        }
+        stf.CollectDiscrimPointsFromSlice(header, disc1d);
+    }
+    stf.AcquisitionIsOver();
+
+    std::map< unsigned, CandidateSummary > summaries;
+    const std::set< Nymph::KTDataPtr >& candidates = stf.GetCandidates();
+    for (std::set< Nymph::KTDataPtr >::const_iterator cIt = candidates.begin(); cIt != candidates.end(); ++cIt)
+    {
+        const KTSequentialLineData& line = (*cIt)->Of< KTSequentialLineData >();
+        CandidateSummary& summary = summaries[line.GetCandidateID()];
+        summary.fID = line.GetCandidateID();
+        summary.fComponent = line.GetComponent();
+        summary.fSlope = line.GetSlope();
+        for (KTDiscriminatedPoints::const_iterator pointIt = line.GetPoints().begin(); pointIt != line.GetPoints().end(); ++pointIt)
+        {
+            summary.fPoints.push_back(pointIt->fTimeInRunC);
+            summary.fPoints.push_back(pointIt->fFrequency);
+        }
+    }
+
+    std::vector< CandidateSummary > result;
+    for (std::map< unsigned, CandidateSummary >::const_iterator sIt = summaries.begin(); sIt != summaries.end(); ++sIt)
+    {
+        result.push_back(sIt->second);
+    }
+    if (result.size() != candidates.size())
+    {
+        KTERROR(testlog, "Candidate IDs are not unique");
+    }
+    return result;
+}
+
+int main()
+{
+    const unsigned nSlices = 150;
+    std::vector< FakeSlice > slices = CreateFakeData(nSlices);
+
+    unsigned nFailures = 0;
+
+    std::vector< bool > allComponents(sNComponents, true);
+    std::vector< CandidateSummary > singleThread = RunSTF(slices, 1, allComponents);
+
+    // every component is processed, and each finds at least its two tracks
+    std::vector< std::vector< CandidateSummary > > byComponent(sNComponents);
+    for (std::vector< CandidateSummary >::const_iterator cIt = singleThread.begin(); cIt != singleThread.end(); ++cIt)
+    {
+        if (cIt->fComponent >= sNComponents)
+        {
+            KTERROR(testlog, "Candidate " << cIt->fID << " is from component " << cIt->fComponent << ", which doesn't exist");
+            ++nFailures;
+            continue;
+        }
+        byComponent[cIt->fComponent].push_back(*cIt);
+    }
+    for (unsigned iComponent = 0; iComponent < sNComponents; ++iComponent)
+    {
+        KTINFO(testlog, "Component " << iComponent << ": " << byComponent[iComponent].size() << " candidates");
+        if (byComponent[iComponent].size() < 2)
+        {
+            KTERROR(testlog, "Component " << iComponent << " has " << byComponent[iComponent].size() << " candidates; expected at least 2");
+            ++nFailures;
+        }
+    }
+
+    // the same candidates, with the same IDs, with any number of threads
+    const unsigned nThreadsToTest[] = {2, 3, 8};
+    for (unsigned iTest = 0; iTest < 3; ++iTest)
+    {
+        std::vector< CandidateSummary > multiThread = RunSTF(slices, nThreadsToTest[iTest], allComponents);
+        bool same = multiThread.size() == singleThread.size();
+        for (unsigned iCand = 0; same && iCand < multiThread.size(); ++iCand)
+        {
+            same = multiThread[iCand].fID == singleThread[iCand].fID && multiThread[iCand] == singleThread[iCand];
+        }
+        if (! same)
+        {
+            KTERROR(testlog, "The candidates found with " << nThreadsToTest[iTest] << " threads (" << multiThread.size() << ") differ from those found with 1 thread (" << singleThread.size() << ")");
+            ++nFailures;
+        }
+    }
+
+    // each component alone gives the same candidates, in the same order, as it does alongside the others
+    for (unsigned iComponent = 0; iComponent < sNComponents; ++iComponent)
+    {
+        std::vector< bool > oneComponent(sNComponents, false);
+        oneComponent[iComponent] = true;
+        std::vector< CandidateSummary > alone = RunSTF(slices, 2, oneComponent);
+        if (alone != byComponent[iComponent])
+        {
+            KTERROR(testlog, "Component " << iComponent << " alone gives " << alone.size() << " candidates, which differ from the " << byComponent[iComponent].size() << " it gives with the other components");
+            ++nFailures;
+        }
+    }
+
+    if (nFailures != 0)
+    {
+        KTERROR(testlog, nFailures << " sequential-track-finder component tests failed");
+        return -1;
+    }
+
+    KTINFO(testlog, "All sequential-track-finder component tests passed");
+    return 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * TestSlidingWindowStats.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Usage: > ./TestSlidingWindowStats
+ *
+ *  Purpose: Check the sliding-window means against a direct average of the last N arrays, for real and complex data,
+ *           with every instruction set that the CPU supports; and check that KTDataAccumulator's sliding-window and
+ *           exponential paths give the same frequency-ordered average and variance for R2C and flipped (C2C) FFTW spectra
+ */
+
+#include "KTDataAccumulator.hh"
+#include "KTFrequencySpectrumDataFFTW.hh"
+#include "KTFrequencySpectrumFFTW.hh"
+#include "KTFrequencySpectrumVariance.hh"
+#include "KTLogger.hh"
+#include "KTSlidingWindowStats.hh"
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Katydid;
+
+KTLOGGER(testlog, "TestSlidingWindowStats");
+
+// Every bin has a different value, so that any mix-up between storage order and frequency order would show
+KTFrequencySpectrumFFTW* MakeSpectrum(size_t nBins, bool isFlipped)
+{
+    KTFrequencySpectrumFFTW* spectrum = new KTFrequencySpectrumFFTW(nBins, -0.5 * double(nBins), 0.5 * double(nBins), isFlipped);
+    for (unsigned iBin = 0; iBin < nBins; ++iBin)
+    {
+        (*spectrum)(iBin) = std::complex< double >(10. + double(iBin), 0.5 * double(iBin * iBin) - 3.);
+    }
+    return spectrum;
+}
+
+// Accumulates accSize copies of the same spectrum with the sliding window and with the exponential average; both should
+// give that spectrum as the average, its norm as the mean of the norms, and zero variance after finalizing
+unsigned CompareAccumulatorPaths(size_t nBins, bool isFlipped)
+{
+    const unsigned accSize = 5;
+    std::string name = std::string(isFlipped ? "C2C" : "R2C") + " spectrum with " + std::to_string(nBins) + " bins";
+
+    KTDataAccumulator slidingAcc, exponentialAcc;
+    slidingAcc.SetAccumulatorSize(accSize);
+    slidingAcc.SetUseSlidingWindow(true);
+    exponentialAcc.SetAccumulatorSize(accSize);
+    exponentialAcc.SetUseSlidingWindow(false);
+    for (unsigned iSlice = 0; iSlice < accSize; ++iSlice)
+    {
+        // the exponential average scales the new spectrum in place, so each path gets its own copy
+        KTFrequencySpectrumDataFFTW slidingData, exponentialData;
+        slidingData.SetSpectrum(MakeSpectrum(nBins, isFlipped), 0);
+        exponentialData.SetSpectrum(MakeSpectrum(nBins, isFlipped), 0);
+        slidingAcc.AddData(slidingData);
+        exponentialAcc.AddData(exponentialData);
+    }
+
+    std::unique_ptr< KTFrequencySpectrumFFTW > reference(MakeSpectrum(nBins, isFlipped));
+    KTDataAccumulator::Accumulator& slidingStruct = slidingAcc.GetAccumulatorNonConst< KTFrequencySpectrumDataFFTW >();
+    KTDataAccumulator::Accumulator& exponentialStruct = exponentialAcc.GetAccumulatorNonConst< KTFrequencySpectrumDataFFTW >();
+    const KTFrequencySpectrumFFTW* slidingAv = slidingStruct.fData->Of< KTFrequencySpectrumDataFFTW >().GetSpectrumFFTW(0);
+    const KTFrequencySpectrumFFTW* exponentialAv = exponentialStruct.fData->Of< KTFrequencySpectrumDataFFTW >().GetSpectrumFFTW(0);
+    const KTFrequencySpectrumVariance* slidingVar = slidingStruct.fData->Of< KTFrequencySpectrumVarianceDataFFTW >().GetSpectrum(0);
+    const KTFrequencySpectrumVariance* exponentialVar = exponentialStruct.fData->Of< KTFrequencySpectrumVarianceDataFFTW >().GetSpectrum(0);
+
+    unsigned nFailures = 0;
+    double maxError = 0.;
+    for (unsigned iBin = 0; iBin < nBins; ++iBin)
+    {
+        double refNorm = reference->GetNorm(iBin);
+        maxError = std::max(maxError, std::abs((*slidingAv)(iBin) - (*reference)(iBin)) / std::abs((*reference)(iBin)));
+        maxError = std::max(maxError, std::abs((*exponentialAv)(iBin) - (*reference)(iBin)) / std::abs((*reference)(iBin)));
+        maxError = std::max(maxError, std::fabs((*slidingVar)(iBin) - refNorm) / refNorm);
+        maxError = std::max(maxError, std::fabs((*exponentialVar)(iBin) - refNorm) / refNorm);
+    }
+    if (maxError > 1.e-12)
+    {
+        KTERROR(testlog, name << ": the accumulated spectra are not the frequency-ordered input; largest relative error: " << maxError);
+        ++nFailures;
+    }
+
+    // finalizing subtracts the norm of the average from the mean of the norms, bin by bin
+    slidingStruct.Finalize();
+    exponentialStruct.Finalize();
+    double maxVariance = 0.;
+    for (unsigned iBin = 0; iBin < nBins; ++iBin)
+    {
+        double refNorm = reference->GetNorm(iBin);
+        maxVariance = std::max(maxVariance, std::fabs((*slidingVar)(iBin)) / refNorm);
+        maxVariance = std::max(maxVariance, std::fabs((*exponentialVar)(iBin)) / refNorm);
+    }
+    if (maxVariance > 1.e-12)
+    {
+        KTERROR(testlog, name << ": the variance of identical spectra is not zero; largest relative variance: " << maxVariance);
+        ++nFailures;
+    }
+    return nFailures;
+}
+
+int main()
+{
+    srand(3391);
+
+    // an odd number of bins exercises the scalar tail of the vectorized loops
+    const unsigned windowSize = 7;
+    const size_t nBins = 13;
+    const unsigned nArrays = 1000;
+
+    unsigned nFailures = 0;
+    for (int instSet = KTThresholdKernels::kScalar; instSet <= KTThresholdKernels::GetInstructionSet(); ++instSet)
+    {
+        for (unsigned valuesPerBin = 1; valuesPerBin <= 2; ++valuesPerBin)
+        {
+            KTThresholdKernels::InstructionSet kernels = KTThresholdKernels::InstructionSet(instSet);
+            std::string name = KTThresholdKernels::GetInstructionSetName(kernels) + (valuesPerBin == 1 ? " real" : " complex");
+            size_t nValues = nBins * valuesPerBin;
+
+            KTSlidingWindowStats window(kernels);
+            window.Initialize(windowSize, nBins, valuesPerBin);
+
+            std::deque< std::vector< double > > history;
+            std::vector< double > mean(nValues), meanOfNorms(nBins);
+            double maxError = 0., maxNormError = 0.;
+            for (unsigned iArray = 0; iArray < nArrays; ++iArray)
+            {
+                // a large offset makes the add/subtract updates lose precision if they drift
+                std::vector< double > values(nValues);
+                for (size_t iValue = 0; iValue < nValues; ++iValue)
+                {
+                    values[iValue] = 1000. + double(rand()) / double(RAND_MAX) - 0.5;
+                }
+                history.push_back(values);
+                if (history.size() > windowSize) history.pop_front();
+
+                window.Add(&values[0], &mean[0], &meanOfNorms[0]);
+
+                for (size_t iBin = 0; iBin < nBins; ++iBin)
+                {
+                    double refNorm = 0.;
+                    for (unsigned iPart = 0; iPart < valuesPerBin; ++iPart)
+                    {
+                        size_t iValue = iBin * valuesPerBin + iPart;
+                        double refMean = 0.;
+                        for (unsigned iEntry = 0; iEntry < history.size(); ++iEntry)
+                        {
+                            refMean += history[iEntry][iValue];
+                            refNorm += history[iEntry][iValue] * history[iEntry][iValue];
+                        }
+                        refMean /= double(history.size());
+                        maxError = std::max(maxError, std::fabs(mean[iValue] - refMean) / refMean);
+                    }
+                    refNorm /= double(history.size());
+                    maxNormError = std::max(maxNormError, std::fabs(meanOfNorms[iBin] - refNorm) / refNorm);
+                }
+            }
+
+            KTINFO(testlog, name << ": largest relative errors of the mean and mean of norms: " << maxError << ", " << maxNormError);
+            if (maxError > 1.e-12 || maxNormError > 1.e-12 || window.GetNInWindow() != windowSize)
+            {
+                KTERROR(testlog, name << ": sliding-window statistics do not match the direct average");
+                ++nFailures;
+            }
+        }
+    }
+
+    // odd and even sizes have different offsets between storage order and frequency order when the spectrum is flipped
+    for (size_t nBins = 12; nBins <= 13; ++nBins)
+    {
+        nFailures += CompareAccumulatorPaths(nBins, false);
+        nFailures += CompareAccumulatorPaths(nBins, true);
+    }
+
+    if (nFailures != 0)
+    {
+        KTERROR(testlog, nFailures << " sliding-window tests failed");
+        return -1;
+    }
+
+    KTINFO(testlog, "All sliding-window tests passed");
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*
+ * TestSpline.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Usage: > ./TestSpline
+ *
+ *  Purpose: Check the natural cubic spline: it passes through its points, reproduces straight lines,
+ *           and the binned implementation matches point-by-point evaluation
+ */
+
+#include "KTLogger.hh"
+#include "KTSpline.hh"
+
+#include <cmath>
+#include <memory>
+
+using namespace Katydid;
+
+KTLOGGER(testlog, "TestSpline");
+
+int main()
+{
+    unsigned nFailures = 0;
+
+    // unevenly spaced points on a smooth curve
+    const unsigned nPoints = 12;
+    double xVals[nPoints], yVals[nPoints];
+    for (unsigned iPoint = 0; iPoint < nPoints; ++iPoint)
+    {
+        xVals[iPoint] = 50.e6 + 10.e6 * double(iPoint) + 1.e6 * double(iPoint % 3);
+        yVals[iPoint] = 1. + 0.5 * std::sin(1.e-7 * xVals[iPoint]);
+    }
+    KTSpline spline(xVals, yVals, nPoints);
+
+    for (unsigned iPoint = 0; iPoint < nPoints; ++iPoint)
+    {
+        if (std::fabs(spline.Evaluate(xVals[iPoint]) - yVals[iPoint]) > 1.e-12)
+        {
+            KTERROR(testlog, "Spline at point " << iPoint << " is " << spline.Evaluate(xVals[iPoint]) << "; expected " << yVals[iPoint]);
+            ++nFailures;
+        }
+    }
+
+    // the binned implementation extends past both end points, to exercise the extrapolation
+    unsigned nBins = 16384;
+    double xMin = 45.e6, xMax = 170.e6;
+    std::shared_ptr< KTSpline::Implementation > imp = spline.Implement(nBins, xMin, xMax);
+    double maxDiff = 0., mean = 0.;
+    for (unsigned iBin = 0; iBin < nBins; ++iBin)
+    {
+        double expected = spline.Evaluate(imp->GetBinCenter(iBin));
+        maxDiff = std::max(maxDiff, std::fabs((*imp)(iBin) - expected));
+        mean += expected;
+    }
+    mean /= double(nBins);
+    if (maxDiff > 1.e-9)
+    {
+        KTERROR(testlog, "Implementation differs from evaluation by up to " << maxDiff);
+        ++nFailures;
+    }
+    if (std::fabs(imp->GetMean() - mean) > 1.e-9)
+    {
+        KTERROR(testlog, "Implementation mean is " << imp->GetMean() << "; expected " << mean);
+        ++nFailures;
+    }
+    if (spline.Implement(nBins, xMin, xMax) != imp)
+    {
+        KTERROR(testlog, "Implementation was not cached");
+        ++nFailures;
+    }
+
+    // a natural spline through points on a line is that line
+    double xLine[4] = {0., 1., 3., 7.};
+    double yLine[4] = {2., 4., 8., 16.};
+    KTSpline line(xLine, yLine, 4);
+    for (double x = -1.; x <= 8.; x += 0.25)
+    {
+        if (std::fabs(line.Evaluate(x) - (2. + 2. * x)) > 1.e-12)
+        {
+            KTERROR(testlog, "Straight-line spline at " << x << " is " << line.Evaluate(x) << "; expected " << 2. + 2. * x);
+            ++nFailures;
+        }
+    }
+
+    if (nFailures != 0)
+    {
+        KTERROR(testlog, nFailures << " spline tests failed");
+        return -1;
+    }
+
+    KTINFO(testlog, "All spline tests passed");
+    return 0;
+}
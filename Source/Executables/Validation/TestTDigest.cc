@@ -0,0 +1,356 @@
+/*
+ * TestTDigest.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Usage: > ./TestTDigest
+ *
+ *  Purpose: Check the accuracy of KTTDigest's quantiles and CDF against the exact values from the sorted data, from 1e-4 to 0.9999;
+ *           that merging digests is as accurate as one digest of all of the values; that the number of centroids is bounded
+ *           by the compression; that a digest restored with MergeCentroids matches the original; and that KTAmplitudeSketchData
+ *           exports distributions and ECDFs that agree with the data
+ */
+
+#include "KTAmplitudeDistribution.hh"
+#include "KTAmplitudeSketchData.hh"
+#include "KTECDF.hh"
+#include "KTLogger.hh"
+#include "KTTDigest.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Katydid;
+
+KTLOGGER(testlog, "TestTDigest");
+
+const double sQuantiles[] = {1.e-4, 1.e-3, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 0.9999};
+const unsigned sNQuantiles = sizeof(sQuantiles) / sizeof(double);
+
+// The allowed error in cumulative fraction: 10% of q * (1 - q), which is how the t-digest's resolution scales, so the tails are held
+// to a tighter tolerance, plus a couple of values for the counting
+double Tolerance(double q, double nValues)
+{
+    return 0.1 * q * (1. - q) + 2. / nValues;
+}
+
+// The fraction of the (sorted) values below value
+double ExactCDF(const std::vector< double >& sorted, double value)
+{
+    return double(std::lower_bound(sorted.begin(), sorted.end(), value) - sorted.begin()) / double(sorted.size());
+}
+
+double ExactQuantile(const std::vector< double >& sorted, double q)
+{
+    size_t index = std::min(size_t(q * double(sorted.size())), sorted.size() - 1);
+    return sorted[index];
+}
+
+// Compares the digest's quantiles and CDF to the exact ones, both measured as cumulative fractions
+unsigned CheckAccuracy(const KTTDigest& digest, const std::vector< double >& sorted, const std::string& name, double toleranceScale = 1.)
+{
+    unsigned nFailures = 0;
+    double nValues = double(sorted.size());
+    if (digest.GetTotalWeight() != nValues || digest.GetMin() != sorted.front() || digest.GetMax() != sorted.back())
+    {
+        KTERROR(testlog, name << ": the digest has weight " << digest.GetTotalWeight() << " and range [" << digest.GetMin() << ", " << digest.GetMax()
+                << "]; expected " << nValues << " and [" << sorted.front() << ", " << sorted.back() << "]");
+        ++nFailures;
+    }
+
+    for (unsigned iQ = 0; iQ < sNQuantiles; ++iQ)
+    {
+        double q = sQuantiles[iQ];
+        double tolerance = toleranceScale * Tolerance(q, nValues);
+
+        double quantile = digest.Quantile(q);
+        double quantileFraction = ExactCDF(sorted, quantile);
+        if (std::fabs(quantileFraction - q) > tolerance)
+        {
+            KTERROR(testlog, name << ": quantile " << q << " is " << quantile << ", which is at a fraction of " << quantileFraction << " of the data (tolerance: " << tolerance << ")");
+            ++nFailures;
+        }
+
+        double cdf = digest.CDF(ExactQuantile(sorted, q));
+        if (std::fabs(cdf - q) > tolerance)
+        {
+            KTERROR(testlog, name << ": the CDF at the exact " << q << " quantile is " << cdf << " (tolerance: " << tolerance << ")");
+            ++nFailures;
+        }
+    }
+    return nFailures;
+}
+
+unsigned CheckNCentroids(const KTTDigest& digest, const std::string& name)
+{
+    size_t nCentroids = digest.GetCentroids().size();
+    if (nCentroids > size_t(digest.GetCompression()))
+    {
+        KTERROR(testlog, name << ": the digest has " << nCentroids << " centroids; expected no more than " << digest.GetCompression());
+        return 1;
+    }
+    return 0;
+}
+
+int main()
+{
+    std::mt19937 generator(4669);
+
+    unsigned nFailures = 0;
+
+    const unsigned nValues = 100000;
+
+    // a skewed distribution, with a long tail
+    std::vector< double > values(nValues);
+    std::exponential_distribution< double > exponential(1.);
+    for (unsigned iValue = 0; iValue < nValues; ++iValue) values[iValue] = exponential(generator);
+    std::vector< double > sorted(values);
+    std::sort(sorted.begin(), sorted.end());
+
+    // accuracy and size of a single digest, for several compressions
+    const double compressions[] = {20., 100., 300.};
+    for (unsigned iComp = 0; iComp < 3; ++iComp)
+    {
+        KTTDigest digest(compressions[iComp]);
+        for (unsigned iValue = 0; iValue < nValues; ++iValue)
+        {
+            digest.Add(values[iValue]);
+            // the bound holds at every stage, not just at the end
+            if (iValue % 10000 == 9999) nFailures += CheckNCentroids(digest, "Compression " + std::to_string(compressions[iComp]) + ", " + std::to_string(iValue + 1) + " values");
+        }
+        // the accuracy tolerance is set for the default compression and better
+        if (compressions[iComp] >= 100.) nFailures += CheckAccuracy(digest, sorted, "Compression " + std::to_string(compressions[iComp]));
+    }
+
+    // merging: the values are split between digests that each see a different part of the distribution
+    {
+        KTTDigest all;
+        KTTDigest lower, upper;
+        double median = ExactQuantile(sorted, 0.5);
+        for (unsigned iValue = 0; iValue < nValues; ++iValue)
+        {
+            all.Add(values[iValue]);
+            if (values[iValue] < median) lower.Add(values[iValue]);
+            else upper.Add(values[iValue]);
+        }
+        KTTDigest merged;
+        merged.Merge(lower);
+        merged.Merge(upper);
+        nFailures += CheckAccuracy(merged, sorted, "Merged halves");
+        nFailures += CheckNCentroids(merged, "Merged halves");
+
+        // many small digests, as from many files; each merge can coarsen the centroids a little, so this gets twice the tolerance
+        KTTDigest mergedMany;
+        for (unsigned iPart = 0; iPart < 100; ++iPart)
+        {
+            KTTDigest part;
+            for (unsigned iValue = iPart; iValue < nValues; iValue += 100) part.Add(values[iValue]);
+            mergedMany.Merge(part);
+        }
+        nFailures += CheckAccuracy(mergedMany, sorted, "Merged parts", 2.);
+        nFailures += CheckNCentroids(mergedMany, "Merged parts");
+
+        // the merged digests should be about as close to the single digest as it is to the data
+        for (unsigned iQ = 0; iQ < sNQuantiles; ++iQ)
+        {
+            double q = sQuantiles[iQ];
+            double difference = std::fabs(all.CDF(merged.Quantile(q)) - q);
+            if (difference > Tolerance(q, nValues))
+            {
+                KTERROR(testlog, "Merged halves: quantile " << q << " is at a fraction of " << q + difference << " of the single digest");
+                ++nFailures;
+            }
+        }
+
+        // merging an empty digest changes nothing
+        double beforeMedian = merged.Quantile(0.5);
+        merged.Merge(KTTDigest());
+        if (merged.GetTotalWeight() != double(nValues) || merged.Quantile(0.5) != beforeMedian)
+        {
+            KTERROR(testlog, "Merging an empty digest changed the digest");
+            ++nFailures;
+        }
+    }
+
+    // a digest restored from its centroids, as when it's read from a file
+    {
+        KTTDigest original;
+        for (unsigned iValue = 0; iValue < nValues; ++iValue) original.Add(values[iValue]);
+
+        KTTDigest restored(original.GetCompression());
+        restored.MergeCentroids(original.GetCentroids(), original.GetMin(), original.GetMax());
+        if (restored.GetTotalWeight() != original.GetTotalWeight() || restored.GetMin() != original.GetMin() || restored.GetMax() != original.GetMax())
+        {
+            KTERROR(testlog, "Restored digest has weight " << restored.GetTotalWeight() << " and range [" << restored.GetMin() << ", " << restored.GetMax()
+                    << "]; expected " << original.GetTotalWeight() << " and [" << original.GetMin() << ", " << original.GetMax() << "]");
+            ++nFailures;
+        }
+        if (restored.GetCentroids().size() > original.GetCentroids().size())
+        {
+            KTERROR(testlog, "Restored digest has " << restored.GetCentroids().size() << " centroids; the original has " << original.GetCentroids().size());
+            ++nFailures;
+        }
+        for (unsigned iQ = 0; iQ < sNQuantiles; ++iQ)
+        {
+            double q = sQuantiles[iQ];
+            double difference = std::fabs(original.CDF(restored.Quantile(q)) - q);
+            if (difference > 1.e-9)
+            {
+                KTERROR(testlog, "Restored digest: quantile " << q << " is at a fraction of " << q + difference << " of the original");
+                ++nFailures;
+            }
+        }
+        nFailures += CheckAccuracy(restored, sorted, "Restored");
+    }
+
+    // sketches of several frequency bins and components, exported as histograms and ECDFs
+    {
+        const unsigned nComponents = 2;
+        const unsigned nFreqBins = 3;
+        const unsigned nSketchValues = 20000;
+        KTAmplitudeSketchData sketches;
+        sketches.Initialize(nComponents, nFreqBins, 100.);
+
+        // bin 2 of the last component is left empty; the others get a different scale each
+        std::vector< std::vector< std::vector< double > > > sketchValues(nComponents, std::vector< std::vector< double > >(nFreqBins));
+        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+        {
+            for (unsigned iFreqBin = 0; iFreqBin < nFreqBins; ++iFreqBin)
+            {
+                if (iComponent == nComponents - 1 && iFreqBin == nFreqBins - 1) continue;
+                double scale = 1. + double(iFreqBin + nFreqBins * iComponent);
+                for (unsigned iValue = 0; iValue < nSketchValues; ++iValue)
+                {
+                    double value = scale * exponential(generator);
+                    sketches.AddValue(iFreqBin, value, iComponent);
+                    sketchValues[iComponent][iFreqBin].push_back(value);
+                }
+                std::sort(sketchValues[iComponent][iFreqBin].begin(), sketchValues[iComponent][iFreqBin].end());
+            }
+        }
+
+        const unsigned distNBins = 50;
+        KTAmplitudeDistribution distributions;
+        if (! sketches.ExportDistributions(distributions, distNBins) || distributions.GetNComponents() != nComponents || distributions.GetNFreqBins() != nFreqBins)
+        {
+            KTERROR(testlog, "Exporting the distributions failed");
+            return -1;
+        }
+
+        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+        {
+            for (unsigned iFreqBin = 0; iFreqBin < nFreqBins; ++iFreqBin)
+            {
+                std::string name = "Component " + std::to_string(iComponent) + ", frequency bin " + std::to_string(iFreqBin);
+                const std::vector< double >& exact = sketchValues[iComponent][iFreqBin];
+                const KTTDigest& sketch = sketches.GetSketch(iFreqBin, iComponent);
+                const KTAmplitudeDistribution::Distribution& dist = distributions.GetDistribution(iFreqBin, iComponent);
+
+                if (dist.size() != distNBins)
+                {
+                    KTERROR(testlog, name << ": the distribution has " << dist.size() << " bins; expected " << distNBins);
+                    ++nFailures;
+                    continue;
+                }
+
+                if (exact.empty())
+                {
+                    double total = 0.;
+                    for (unsigned iDistBin = 0; iDistBin < distNBins; ++iDistBin) total += dist(iDistBin);
+                    if (! sketch.Empty() || dist.GetRangeMin() != 0. || dist.GetRangeMax() != 1. || total != 0.)
+                    {
+                        KTERROR(testlog, name << ": the empty sketch should export an empty distribution over [0, 1]");
+                        ++nFailures;
+                    }
+                    KTECDF< double > ecdf;
+                    if (! sketches.ExportECDF(ecdf, iFreqBin, iComponent) || ecdf.GetNPoints() != 0)
+                    {
+                        KTERROR(testlog, name << ": the empty sketch should export an empty ECDF");
+                        ++nFailures;
+                    }
+                    continue;
+                }
+
+                nFailures += CheckAccuracy(sketch, exact, name);
+
+                // histogram: spans the data, holds all of the weight, and each bin holds about the number of values between its edges
+                if (dist.GetRangeMin() != exact.front() || dist.GetRangeMax() != exact.back())
+                {
+                    KTERROR(testlog, name << ": the distribution spans [" << dist.GetRangeMin() << ", " << dist.GetRangeMax() << "]; expected [" << exact.front() << ", " << exact.back() << "]");
+                    ++nFailures;
+                }
+                double total = 0.;
+                double maxBinError = 0.;
+                double binWidth = dist.GetBinWidth();
+                for (unsigned iDistBin = 0; iDistBin < distNBins; ++iDistBin)
+                {
+                    total += dist(iDistBin);
+                    double lowerFraction = ExactCDF(exact, dist.GetRangeMin() + double(iDistBin) * binWidth);
+                    double upperFraction = iDistBin + 1 == distNBins ? 1. : ExactCDF(exact, dist.GetRangeMin() + double(iDistBin + 1) * binWidth);
+                    maxBinError = std::max(maxBinError, std::fabs(dist(iDistBin) / double(exact.size()) - (upperFraction - lowerFraction)));
+                }
+                if (std::fabs(total - double(exact.size())) > 1.e-6 * double(exact.size()))
+                {
+                    KTERROR(testlog, name << ": the distribution holds " << total << " values; expected " << exact.size());
+                    ++nFailures;
+                }
+                if (maxBinError > 0.01)
+                {
+                    KTERROR(testlog, name << ": a distribution bin is off by " << maxBinError << " of the values");
+                    ++nFailures;
+                }
+
+                // ECDF: the points are the min, the centroids, and the max, and it interpolates the same way as the sketch's CDF
+                KTECDF< double > ecdf;
+                if (! sketches.ExportECDF(ecdf, iFreqBin, iComponent) || ecdf.GetNPoints() != sketch.GetCentroids().size() + 2 ||
+                        ecdf.GetValue(0) != exact.front() || ecdf.GetCumulative(0) != 0. ||
+                        ecdf.GetValue(ecdf.GetNPoints() - 1) != exact.back() || ecdf.GetCumulative(ecdf.GetNPoints() - 1) != 1.)
+                {
+                    KTERROR(testlog, name << ": the ECDF does not have the expected points");
+                    ++nFailures;
+                    continue;
+                }
+                for (unsigned iQ = 0; iQ < sNQuantiles; ++iQ)
+                {
+                    double value = ExactQuantile(exact, sQuantiles[iQ]);
+                    if (std::fabs(ecdf(value) - sketch.CDF(value)) > 1.e-9)
+                    {
+                        KTERROR(testlog, name << ": the ECDF at " << value << " is " << ecdf(value) << "; the sketch's CDF is " << sketch.CDF(value));
+                        ++nFailures;
+                    }
+                }
+            }
+        }
+
+        // merging sketch data: the shapes have to match
+        KTAmplitudeSketchData copy;
+        copy.Initialize(nComponents, nFreqBins, 100.);
+        KTAmplitudeSketchData wrongShape;
+        wrongShape.Initialize(nComponents, nFreqBins + 1, 100.);
+        if (! copy.Merge(sketches) || copy.GetSketch(0, 1).GetTotalWeight() != double(nSketchValues) || wrongShape.Merge(sketches))
+        {
+            KTERROR(testlog, "Merging sketch data did not work as expected");
+            ++nFailures;
+        }
+
+        KTECDF< double > ecdf;
+        if (sketches.ExportECDF(ecdf, nFreqBins, 0) || sketches.ExportECDF(ecdf, 0, nComponents))
+        {
+            KTERROR(testlog, "Exporting an ECDF for a nonexistent bin should fail");
+            ++nFailures;
+        }
+    }
+
+    if (nFailures != 0)
+    {
+        KTERROR(testlog, nFailures << " t-digest tests failed");
+        return -1;
+    }
+
+    KTINFO(testlog, "All t-digest tests passed");
+    return 0;
+}
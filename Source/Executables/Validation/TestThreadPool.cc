@@ -0,0 +1,87 @@
+/*
+ * TestThreadPool.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Usage: > ./TestThreadPool
+ *
+ *  Purpose: Check that KTThreadPool runs every task exactly once, on valid workers, for several thread counts,
+ *           and that an exception thrown by a task reaches the caller
+ */
+
+#include "KTLogger.hh"
+#include "KTThreadPool.hh"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace Katydid;
+
+KTLOGGER(testlog, "TestThreadPool");
+
+int main()
+{
+    unsigned nFailures = 0;
+
+    KTThreadPool pool;
+    unsigned threadCounts[4] = {1, 2, 4, 3};
+    for (unsigned iCount = 0; iCount < 4; ++iCount)
+    {
+        pool.SetNThreads(threadCounts[iCount]);
+
+        // several loops on the same threads, including ones with fewer tasks than threads
+        unsigned taskCounts[4] = {1000, 3, 1, 0};
+        for (unsigned iLoop = 0; iLoop < 4; ++iLoop)
+        {
+            unsigned nTasks = taskCounts[iLoop];
+            std::vector< unsigned > nRuns(nTasks, 0);
+            std::vector< unsigned > workers(nTasks, 0);
+            pool.ParallelFor(nTasks, [&](unsigned iTask, unsigned iWorker)
+            {
+                ++nRuns[iTask];
+                workers[iTask] = iWorker;
+            });
+
+            for (unsigned iTask = 0; iTask < nTasks; ++iTask)
+            {
+                if (nRuns[iTask] != 1 || workers[iTask] >= pool.GetNThreads())
+                {
+                    KTERROR(testlog, pool.GetNThreads() << " threads: task " << iTask << " ran " << nRuns[iTask] << " times, on worker " << workers[iTask]);
+                    ++nFailures;
+                }
+            }
+        }
+
+        bool caught = false;
+        std::vector< unsigned > nRuns(100, 0);
+        try
+        {
+            pool.ParallelFor(100, [&](unsigned iTask, unsigned)
+            {
+                ++nRuns[iTask];
+                if (iTask == 10) throw std::runtime_error("task 10 failed");
+            });
+        }
+        catch (std::runtime_error& e)
+        {
+            caught = true;
+        }
+        unsigned nRun = 0;
+        for (unsigned iTask = 0; iTask < 100; ++iTask) nRun += nRuns[iTask];
+        if (! caught || nRun != 100)
+        {
+            KTERROR(testlog, pool.GetNThreads() << " threads: exception caught: " << caught << "; tasks run: " << nRun);
+            ++nFailures;
+        }
+    }
+
+    if (nFailures != 0)
+    {
+        KTERROR(testlog, nFailures << " thread pool tests failed");
+        return -1;
+    }
+
+    KTINFO(testlog, "All thread pool tests passed");
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*
+ * TestThresholdKernels.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Usage: > ./TestThresholdKernels
+ *
+ *  Purpose: Check that every thresholding kernel that the CPU supports agrees with a straightforward loop
+ */
+
+#include "KTLogger.hh"
+#include "KTThresholdKernels.hh"
+
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace Katydid;
+
+KTLOGGER(testlog, "TestThresholdKernels");
+
+int main()
+{
+    srand(8271);
+
+    KTINFO(testlog, "CPU instruction set: " << KTThresholdKernels::GetInstructionSetName(KTThresholdKernels::GetInstructionSet()));
+
+    // an odd number of values exercises the scalar tail of the vectorized loops
+    std::vector< double > values(4099);
+    for (unsigned iValue = 0; iValue < values.size(); ++iValue)
+    {
+        values[iValue] = double(rand()) / double(RAND_MAX);
+    }
+    double threshold = 0.9;
+
+    // a per-value threshold curve, as used by the variable discriminator
+    std::vector< double > thresholds(values.size());
+    for (unsigned iValue = 0; iValue < values.size(); ++iValue)
+    {
+        thresholds[iValue] = 0.5 + 0.45 * std::sin(0.01 * double(iValue));
+    }
+
+    double refSum = 0., refSumOfSquares = 0.;
+    std::vector< unsigned > refIndices, refCurveIndices;
+    for (unsigned iValue = 0; iValue < values.size(); ++iValue)
+    {
+        refSum += values[iValue];
+        refSumOfSquares += values[iValue] * values[iValue];
+        if (values[iValue] >= threshold) refIndices.push_back(iValue);
+        if (values[iValue] >= thresholds[iValue]) refCurveIndices.push_back(iValue);
+    }
+
+    unsigned nFailures = 0;
+    for (int instSet = KTThresholdKernels::kScalar; instSet <= KTThresholdKernels::GetInstructionSet(); ++instSet)
+    {
+        std::string name = KTThresholdKernels::GetInstructionSetName(KTThresholdKernels::InstructionSet(instSet));
+
+        // the summation order differs from the reference loop, so allow for rounding
+        double sum = 0., sumOfSquares = 0.;
+        KTThresholdKernels::SumAndSumOfSquares(&values[0], values.size(), sum, sumOfSquares, KTThresholdKernels::InstructionSet(instSet));
+        if (std::fabs(sum - refSum) > 1.e-10 * refSum || std::fabs(sumOfSquares - refSumOfSquares) > 1.e-10 * refSumOfSquares)
+        {
+            KTERROR(testlog, name << " sums: " << sum << ", " << sumOfSquares << "; expected " << refSum << ", " << refSumOfSquares);
+            ++nFailures;
+        }
+
+        std::vector< unsigned > indices(values.size() + 4);
+        size_t nAbove = KTThresholdKernels::FindAboveThreshold(&values[0], values.size(), threshold, &indices[0], KTThresholdKernels::InstructionSet(instSet));
+        indices.resize(nAbove);
+        if (indices != refIndices)
+        {
+            KTERROR(testlog, name << " threshold: found " << nAbove << " values above threshold; expected " << refIndices.size());
+            ++nFailures;
+        }
+
+        std::vector< unsigned > curveIndices(values.size() + 4);
+        nAbove = KTThresholdKernels::FindAboveThresholds(&values[0], &thresholds[0], values.size(), &curveIndices[0], KTThresholdKernels::InstructionSet(instSet));
+        curveIndices.resize(nAbove);
+        if (curveIndices != refCurveIndices)
+        {
+            KTERROR(testlog, name << " threshold curve: found " << nAbove << " values above threshold; expected " << refCurveIndices.size());
+            ++nFailures;
+        }
+    }
+
+    std::vector< double > prefixSums(values.size() + 1);
+    KTThresholdKernels::PrefixSums(&values[0], values.size(), &prefixSums[0]);
+    double directSum = values[100] + values[101] + values[102];
+    if (std::fabs(prefixSums[103] - prefixSums[100] - directSum) > 1.e-10)
+    {
+        KTERROR(testlog, "Prefix sums: sum of [100, 102] is " << prefixSums[103] - prefixSums[100] << "; expected " << directSum);
+        ++nFailures;
+    }
+
+    if (nFailures != 0)
+    {
+        KTERROR(testlog, nFailures << " kernel tests failed");
+        return -1;
+    }
+
+    KTINFO(testlog, "All kernel tests passed");
+    return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * TestTrackDistanceIndex.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *
+ *  Usage: > ./TestTrackDistanceIndex
+ *
+ *  Purpose: Check that the neighbors found with KTTrackDistanceIndex, and the DBSCAN clusters made from them,
+ *           are the same as those from a distance matrix holding the track distance between every pair of tracks
+ */
+
+#include "KTDBSCAN.hh"
+#include "KTDistanceMatrix.hh"
+#include "KTLogger.hh"
+#include "KTTrackDistanceIndex.hh"
+
+#include <cstdlib>
+
+using namespace Katydid;
+
+KTLOGGER(testlog, "TestTrackDistanceIndex");
+
+typedef KTSymmetricDistanceMatrix< double > DistanceMatrix;
+
+template< typename VEC_T >
+class TrackDistance
+{
+    protected:
+        typedef VEC_T vector_type;
+
+        double GetDistance(const VEC_T v1, const VEC_T v2)
+        {
+            return TrackDistanceBetween(v1, v2);
+        }
+};
+
+double Uniform(double min, double max)
+{
+    return min + (max - min) * double(rand()) / double(RAND_MAX);
+}
+
+int main()
+{
+    srand(5772);
+
+    // time-ordered tracks in normalized coordinates; start times are rounded so that many of them are tied
+    const unsigned nTracks = 3000;
+    DistanceMatrix::Points points(nTracks, DistanceMatrix::Point(4));
+    double startTime = 0.;
+    for (unsigned iTrack = 0; iTrack < nTracks; ++iTrack)
+    {
+        if (rand() % 3 != 0) startTime += double(rand() % 4) * 0.25;
+        double startFreq = Uniform(0., 60.);
+        double length = rand() % 5 == 0 ? 0. : Uniform(0., 6.);
+        points[iTrack](0) = startTime;
+        points[iTrack](1) = startFreq;
+        points[iTrack](2) = startTime + length;
+        points[iTrack](3) = startFreq + Uniform(-0.5, 3.) * length;
+    }
+
+    DistanceMatrix distMat;
+    distMat.ComputeDistances< TrackDistance< DistanceMatrix::Point > >(points);
+
+    KTTrackDistanceIndex trackIndex;
+    for (unsigned iTrack = 0; iTrack < nTracks; ++iTrack)
+    {
+        trackIndex.AddTrack(points[iTrack](0), points[iTrack](1), points[iTrack](2), points[iTrack](3));
+    }
+    trackIndex.BuildIndex();
+
+    unsigned nFailures = 0;
+    const double radii[] = {0.5, 1., 2.};
+    for (unsigned iRadius = 0; iRadius < 3; ++iRadius)
+    {
+        unsigned nMismatches = 0;
+        size_t nNeighbors = 0;
+        for (size_t iTrack = 0; iTrack < nTracks; ++iTrack)
+        {
+            DistanceMatrix::Neighbors fromMatrix = distMat.NearestNeighborsByRadius(iTrack, radii[iRadius]);
+            KTTrackDistanceIndex::Neighbors fromIndex = trackIndex.NearestNeighborsByRadius(iTrack, radii[iRadius]);
+            if (fromMatrix != fromIndex) ++nMismatches;
+            nNeighbors += fromMatrix.size();
+        }
+        KTINFO(testlog, "Radius " << radii[iRadius] << ": " << nNeighbors << " neighbors in total; " << nMismatches << " tracks with different neighbors");
+        nFailures += nMismatches;
+
+        for (unsigned minPoints = 2; minPoints <= 4; minPoints += 2)
+        {
+            KTDBSCAN< DistanceMatrix > matrixDBSCAN(radii[iRadius], minPoints);
+            KTDBSCAN< DistanceMatrix >::DBSResults matrixResults;
+            matrixDBSCAN.DoClustering(distMat, matrixResults);
+
+            KTDBSCAN< KTTrackDistanceIndex > indexDBSCAN(radii[iRadius], minPoints);
+            KTDBSCAN< KTTrackDistanceIndex >::DBSResults indexResults;
+            indexDBSCAN.DoClustering(trackIndex, indexResults);
+
+            if (matrixResults.fClusters != indexResults.fClusters || matrixResults.fNoise != indexResults.fNoise)
+            {
+                KTERROR(testlog, "Radius " << radii[iRadius] << ", min points " << minPoints << ": the clusters are different");
+                ++nFailures;
+            }
+        }
+    }
+
+    if (nFailures != 0)
+    {
+        KTERROR(testlog, nFailures << " track distance index tests failed");
+        return -1;
+    }
+
+    KTINFO(testlog, "All track distance index tests passed");
+    return 0;
+}
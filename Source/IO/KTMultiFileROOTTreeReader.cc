@@ -8,6 +8,7 @@
 #include "KTMultiFileROOTTreeReader.hh"
 
 #include "KTAmplitudeDistribution.hh"
+#include "KTAmplitudeSketchData.hh"
 
 #include "KTLogger.hh"
 #include "TAxis.h"
@@ -16,6 +17,7 @@
 #include "TTree.h"
 
 #include <sstream>
+#include <vector>
 #include "KTROOTTreeTypeWriterSpectrumAnalysis.hh"
 
 
@@ -38,8 +40,10 @@ namespace Katydid
             fFileIter(fFilenames.end()),
             fDataTypes(),
             fAmpDistSignal("amp-dist", this),
+            fAmpSketchSignal("amp-sketch", this),
             fDoneSignal("done", this),
-            fAppendAmpDistSlot("amp-dist", this, &KTMultiFileROOTTreeReader::Append, &fAmpDistSignal)
+            fAppendAmpDistSlot("amp-dist", this, &KTMultiFileROOTTreeReader::Append, &fAmpDistSignal),
+            fAppendAmpSketchSlot("amp-sketch", this, &KTMultiFileROOTTreeReader::Append, &fAmpSketchSignal)
     {
     }
 
@@ -81,6 +85,10 @@ namespace Katydid
         {
             fDataTypes.push_back(DataType(type, treeName, &KTMultiFileROOTTreeReader::AppendAmpDistData, &fAmpDistSignal));
         }
+        else if (type == "amp-sketch")
+        {
+            fDataTypes.push_back(DataType(type, treeName, &KTMultiFileROOTTreeReader::AppendAmpSketchData, &fAmpSketchSignal));
+        }
         else
         {
             KTERROR(inlog, "Invalid run-data-type: " << type);
@@ -235,4 +243,75 @@ namespace Katydid
         return true;
     }
 
+    bool KTMultiFileROOTTreeReader::AppendAmpSketchData(TTree* tree, Nymph::KTData& appendToData)
+    {
+        // Create data structures
+        TAmplitudeSketchData ampSketchData;
+        ampSketchData.fMeans = NULL;
+        ampSketchData.fWeights = NULL;
+        tree->SetBranchAddress("Component", &ampSketchData.fComponent);
+        tree->SetBranchAddress("FreqBin", &ampSketchData.fFreqBin);
+        tree->SetBranchAddress("Compression", &ampSketchData.fCompression);
+        tree->SetBranchAddress("Min", &ampSketchData.fMin);
+        tree->SetBranchAddress("Max", &ampSketchData.fMax);
+        tree->SetBranchAddress("Means", &ampSketchData.fMeans);
+        tree->SetBranchAddress("Weights", &ampSketchData.fWeights);
+
+        // Determine the number of components and the number of frequency bins
+        unsigned nEntries = (unsigned)tree->GetEntries();
+        if (nEntries == 0)
+        {
+            KTERROR(inlog, "The amplitude sketch tree is empty");
+            return false;
+        }
+        unsigned nComponents = 0;
+        unsigned nFreqBins = 0;
+        for (unsigned iEntry=0; iEntry < nEntries; iEntry++)
+        {
+            tree->GetEntry(iEntry);
+            if (ampSketchData.fComponent >= nComponents) nComponents = ampSketchData.fComponent + 1;
+            if (ampSketchData.fFreqBin >= nFreqBins) nFreqBins = ampSketchData.fFreqBin + 1;
+        }
+
+        // Sketches already in the data are added to, so that repeated appends accumulate
+        bool mergeIntoExisting = appendToData.Has< KTAmplitudeSketchData >();
+        KTAmplitudeSketchData& sketchData = appendToData.Of< KTAmplitudeSketchData >();
+        if (mergeIntoExisting && (sketchData.GetNComponents() != nComponents || sketchData.GetNFreqBins() != nFreqBins))
+        {
+            KTERROR(inlog, "Cannot merge sketches with " << nComponents << " components and " << nFreqBins << " frequency bins into the existing sketches, with "
+                    << sketchData.GetNComponents() << " components and " << sketchData.GetNFreqBins() << " frequency bins");
+            return false;
+        }
+        if (! mergeIntoExisting)
+        {
+            tree->GetEntry(0);
+            KTDEBUG(inlog, "Initializing new set of amplitude sketches, with " << nComponents << " components and " << nFreqBins << " frequency bins");
+            sketchData.Initialize(nComponents, nFreqBins, ampSketchData.fCompression);
+        }
+
+        // Read in the data
+        std::vector< KTTDigest::Centroid > centroids;
+        for (unsigned iEntry=0; iEntry < nEntries; iEntry++)
+        {
+            tree->GetEntry(iEntry);
+
+            centroids.resize(ampSketchData.fMeans->size());
+            for (unsigned iCentroid = 0; iCentroid < centroids.size(); ++iCentroid)
+            {
+                centroids[iCentroid].fMean = (*ampSketchData.fMeans)[iCentroid];
+                centroids[iCentroid].fWeight = (*ampSketchData.fWeights)[iCentroid];
+            }
+            if (! centroids.empty())
+            {
+                sketchData.GetSketch(ampSketchData.fFreqBin, ampSketchData.fComponent).MergeCentroids(centroids, ampSketchData.fMin, ampSketchData.fMax);
+            }
+        }
+
+        tree->ResetBranchAddresses();
+        delete ampSketchData.fMeans;
+        delete ampSketchData.fWeights;
+
+        return true;
+    }
+
 } /* namespace Katydid */
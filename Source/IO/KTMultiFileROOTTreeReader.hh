@@ -43,12 +43,15 @@ namespace Katydid
      The run-data-type option determines the function used to read the file.
      The available options are:
      - "amp-dist" -- Emits signal "amp-dist" after file read
+     - "amp-sketch" -- Emits signal "amp-sketch" after file read
 
      Slots:
      - "amp-dist": void (Nymph::KTDataPtr) -- Add amplitude distribution data; Requires KTData; Adds KTAmplitudeDistribution; Emits signal "amp-dist" upon successful file read.
+     - "amp-sketch": void (Nymph::KTDataPtr) -- Add amplitude sketch data; Requires KTData; Adds KTAmplitudeSketchData, or merges into it if the data already has sketches of the same shape; Emits signal "amp-sketch" upon successful file read.
 
      Signals:
      - "amp-dist": void (Nymph::KTDataPtr) -- Emitted after reading an amp-dist file; Guarantees KTAmplitudeDistribution.
+     - "amp-sketch": void (Nymph::KTDataPtr) -- Emitted after reading an amp-sketch file; Guarantees KTAmplitudeSketchData.
     */
 
 
@@ -100,6 +103,7 @@ namespace Katydid
 
         private:
             bool AppendAmpDistData(TTree*, Nymph::KTData& data);
+            bool AppendAmpSketchData(TTree*, Nymph::KTData& data);
 
 
             //**************
@@ -107,6 +111,7 @@ namespace Katydid
             //**************
         private:
             Nymph::KTSignalData fAmpDistSignal;
+            Nymph::KTSignalData fAmpSketchSignal;
             Nymph::KTSignalOneArg< void > fDoneSignal;
 
             //**************
@@ -114,6 +119,7 @@ namespace Katydid
             //**************
         private:
             Nymph::KTSlotDataOneType< Nymph::KTData > fAppendAmpDistSlot;
+            Nymph::KTSlotDataOneType< Nymph::KTData > fAppendAmpSketchSlot;
     };
 
     inline const std::deque< std::string >& KTMultiFileROOTTreeReader::GetFilenames() const
@@ -7,6 +7,7 @@
 
 #include "KT2ROOT.hh"
 #include "KTAmplitudeDistribution.hh"
+#include "KTAmplitudeSketchData.hh"
 #include "KTDiscriminatedPoints1DData.hh"
 #include "KTKDTreeData.hh"
 #include "KTHoughData.hh"
@@ -40,12 +41,14 @@ namespace Katydid
                     fDiscPoints1DTree(NULL),
                     fKDTreeTree(NULL),
                     fAmpDistTree(NULL),
+                    fAmpSketchTree(NULL),
                     fHoughTree(NULL),
                     fFlattenedPSDTree(NULL),
                     fFlattenedLabelMaskTree(NULL),
                     fDiscPoints1DData(),
                     fKDTreePointData(),
                     fAmpDistData(),
+                    fAmpSketchData(),
                     fHoughData(),
                     fPowerValue(0.0),
                     fLabel(0)
@@ -54,6 +57,8 @@ namespace Katydid
 
     KTROOTTreeTypeWriterSpectrumAnalysis::~KTROOTTreeTypeWriterSpectrumAnalysis()
     {
+        delete fAmpSketchData.fMeans;
+        delete fAmpSketchData.fWeights;
     }
 
 
@@ -63,6 +68,7 @@ namespace Katydid
         fWriter->RegisterSlot("kd-tree", this, &KTROOTTreeTypeWriterSpectrumAnalysis::WriteKDTree);
         fWriter->RegisterSlot("kd-tree-scaled", this, &KTROOTTreeTypeWriterSpectrumAnalysis::WriteKDTreeScaled);
         fWriter->RegisterSlot("amp-dist", this, &KTROOTTreeTypeWriterSpectrumAnalysis::WriteAmplitudeDistributions);
+        fWriter->RegisterSlot("amp-sketch", this, &KTROOTTreeTypeWriterSpectrumAnalysis::WriteAmplitudeSketches);
         fWriter->RegisterSlot("hough", this, &KTROOTTreeTypeWriterSpectrumAnalysis::WriteHoughData);
         fWriter->RegisterSlot("ps-flat", this, &KTROOTTreeTypeWriterSpectrumAnalysis::WriteFlattenedPSDData);
         fWriter->RegisterSlot("ps-mask", this, &KTROOTTreeTypeWriterSpectrumAnalysis::WriteFlattenedLabelMask);
@@ -392,6 +398,96 @@ namespace Katydid
     }
 
 
+    //**************************
+    // Amplitude Sketches
+    //**************************
+
+    void KTROOTTreeTypeWriterSpectrumAnalysis::WriteAmplitudeSketches(Nymph::KTDataPtr data)
+    {
+        KTAmplitudeSketchData& sketchData = data->Of< KTAmplitudeSketchData >();
+
+        if (! fWriter->OpenAndVerifyFile()) return;
+
+        if (fAmpSketchTree == NULL)
+        {
+            if (! SetupAmplitudeSketchTree())
+            {
+                KTERROR(publog, "Something went wrong while setting up the amplitude sketch tree! Nothing was written.");
+                return;
+            }
+        }
+
+        // one entry per frequency bin, holding the centroids of its sketch
+        fAmpSketchData.fCompression = sketchData.GetCompression();
+        for (fAmpSketchData.fComponent = 0; fAmpSketchData.fComponent < sketchData.GetNComponents(); fAmpSketchData.fComponent++)
+        {
+            for (fAmpSketchData.fFreqBin = 0; fAmpSketchData.fFreqBin < sketchData.GetNFreqBins(); fAmpSketchData.fFreqBin++)
+            {
+                const KTTDigest& sketch = sketchData.GetSketch(fAmpSketchData.fFreqBin, fAmpSketchData.fComponent);
+                const std::vector< KTTDigest::Centroid >& centroids = sketch.GetCentroids();
+                fAmpSketchData.fMin = sketch.GetMin();
+                fAmpSketchData.fMax = sketch.GetMax();
+                fAmpSketchData.fMeans->resize(centroids.size());
+                fAmpSketchData.fWeights->resize(centroids.size());
+                for (unsigned iCentroid = 0; iCentroid < centroids.size(); ++iCentroid)
+                {
+                    (*fAmpSketchData.fMeans)[iCentroid] = centroids[iCentroid].fMean;
+                    (*fAmpSketchData.fWeights)[iCentroid] = centroids[iCentroid].fWeight;
+                }
+
+                fAmpSketchTree->Fill();
+            }
+        }
+
+        return;
+    }
+
+    bool KTROOTTreeTypeWriterSpectrumAnalysis::SetupAmplitudeSketchTree()
+    {
+        if (fAmpSketchData.fMeans == NULL) fAmpSketchData.fMeans = new std::vector< Double_t >();
+        if (fAmpSketchData.fWeights == NULL) fAmpSketchData.fWeights = new std::vector< Double_t >();
+
+        if( fWriter->GetAccumulate() )
+        {
+            fWriter->GetFile()->GetObject( "ampSketch", fAmpSketchTree );
+
+            if( fAmpSketchTree != NULL )
+            {
+                KTINFO( publog, "Tree already exists; will add to it" );
+                fWriter->AddTree( fAmpSketchTree );
+
+                fAmpSketchTree->SetBranchAddress("Component", &fAmpSketchData.fComponent);
+                fAmpSketchTree->SetBranchAddress("FreqBin", &fAmpSketchData.fFreqBin);
+                fAmpSketchTree->SetBranchAddress("Compression", &fAmpSketchData.fCompression);
+                fAmpSketchTree->SetBranchAddress("Min", &fAmpSketchData.fMin);
+                fAmpSketchTree->SetBranchAddress("Max", &fAmpSketchData.fMax);
+                fAmpSketchTree->SetBranchAddress("Means", &fAmpSketchData.fMeans);
+                fAmpSketchTree->SetBranchAddress("Weights", &fAmpSketchData.fWeights);
+
+                return true;
+            }
+        }
+
+        fAmpSketchTree = new TTree("ampSketch", "Amplitude Sketches");
+        if (fAmpSketchTree == NULL)
+        {
+            KTERROR(publog, "Tree was not created!");
+            return false;
+        }
+        fWriter->AddTree(fAmpSketchTree);
+
+        fAmpSketchTree->Branch("Component", &fAmpSketchData.fComponent, "fComponent/i");
+        fAmpSketchTree->Branch("FreqBin", &fAmpSketchData.fFreqBin, "fFreqBin/i");
+        fAmpSketchTree->Branch("Compression", &fAmpSketchData.fCompression, "fCompression/D");
+        fAmpSketchTree->Branch("Min", &fAmpSketchData.fMin, "fMin/D");
+        fAmpSketchTree->Branch("Max", &fAmpSketchData.fMax, "fMax/D");
+        fAmpSketchTree->Branch("Means", &fAmpSketchData.fMeans);
+        fAmpSketchTree->Branch("Weights", &fAmpSketchData.fWeights);
+
+        return true;
+    }
+
+
     //*************************
     // Hough Transform Data
     //*************************
@@ -19,6 +19,8 @@
 
 #include "Rtypes.h"
 
+#include <vector>
+
 class TH1D;
 class TH2D;
 class TTree;
@@ -72,6 +74,17 @@ namespace Katydid
         TH1D* fDistribution;
     };
 
+    struct TAmplitudeSketchData
+    {
+        UInt_t fComponent;
+        UInt_t fFreqBin;
+        Double_t fCompression;
+        Double_t fMin;
+        Double_t fMax;
+        std::vector< Double_t >* fMeans;
+        std::vector< Double_t >* fWeights;
+    };
+
     struct THoughData
     {
         UInt_t fComponent;
@@ -95,6 +108,7 @@ namespace Katydid
             void WriteKDTree(Nymph::KTDataPtr data);
             void WriteKDTreeScaled(Nymph::KTDataPtr data);
             void WriteAmplitudeDistributions(Nymph::KTDataPtr data);
+            void WriteAmplitudeSketches(Nymph::KTDataPtr data);
             void WriteHoughData(Nymph::KTDataPtr data);
             void WriteFlattenedPSDData(Nymph::KTDataPtr data);
             void WriteFlattenedLabelMask(Nymph::KTDataPtr data);
@@ -103,6 +117,7 @@ namespace Katydid
             TTree* GetDiscriminatedPoints1DTree() const;
             TTree* GetKDTreeTree() const;
             TTree* GetAmplitudeDistributionTree() const;
+            TTree* GetAmplitudeSketchTree() const;
             TTree* GetHoughTree() const;
             TTree* GetFlattenedPSDTree() const;
             TTree* GetFlattenedLabelMaskTree() const;
@@ -111,6 +126,7 @@ namespace Katydid
             bool SetupDiscriminatedPoints1DTree();
             bool SetupKDTreeTree();
             bool SetupAmplitudeDistributionTree();
+            bool SetupAmplitudeSketchTree();
             bool SetupHoughTree();
             bool SetupFlattenedPSDTree();
             bool SetupFlattenedLabelMaskTree();
@@ -120,6 +136,7 @@ namespace Katydid
             TTree* fDiscPoints1DTree;
             TTree* fKDTreeTree;
             TTree* fAmpDistTree;
+            TTree* fAmpSketchTree;
             TTree* fHoughTree;
             TTree* fFlattenedPSDTree;
             TTree* fFlattenedLabelMaskTree;
@@ -127,6 +144,7 @@ namespace Katydid
             TDiscriminatedPoints1DData fDiscPoints1DData;
             TKDTreePointData fKDTreePointData;
             TAmplitudeDistributionData fAmpDistData;
+            TAmplitudeSketchData fAmpSketchData;
             THoughData fHoughData;
 
             double fPowerValue;
@@ -148,6 +166,11 @@ namespace Katydid
         return fAmpDistTree;
     }
 
+    inline TTree* KTROOTTreeTypeWriterSpectrumAnalysis::GetAmplitudeSketchTree() const
+    {
+        return fAmpSketchTree;
+    }
+
     inline TTree* KTROOTTreeTypeWriterSpectrumAnalysis::GetHoughTree() const
     {
         return fHoughTree;
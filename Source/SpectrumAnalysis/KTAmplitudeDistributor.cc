@@ -7,6 +7,7 @@
 
 #include "KTAmplitudeDistributor.hh"
 
+#include "KTAmplitudeSketchData.hh"
 #include "KTCorrelationData.hh"
 #include "KTEggHeader.hh"
 #include "KTFrequencySpectrumPolar.hh"
@@ -39,6 +40,8 @@ namespace Katydid
             fDistMin(0.),
             fDistMax(1.),
             fUseBuffer(true),
+            fUseSketch(false),
+            fSketchCompression(100.),
             fTakeValuesPolar(&KTAmplitudeDistributor::TakeValuesToBuffer),
             fTakeValuesFFTW(&KTAmplitudeDistributor::TakeValuesToBuffer),
             fInvDistBinWidth(1.),
@@ -49,6 +52,7 @@ namespace Katydid
             fNSlicesProcessed(0),
             fDistributionData(Nymph::KTDataPtr()),
             fDistributions(NULL),
+            fSketches(NULL),
             fAmpDistSignal("amp-dist", this),
             fFSPolarSlot("fs-polar", this, &KTAmplitudeDistributor::AddValues),
             fFSFFTWSlot("fs-fftw", this, &KTAmplitudeDistributor::AddValues),
@@ -56,6 +60,7 @@ namespace Katydid
             fNormFSFFTWSlot("norm-fs-fftw", this, &KTAmplitudeDistributor::AddValues),
             fCorrSlot("corr", this, &KTAmplitudeDistributor::AddValues),
             fWVSlot("wv", this, &KTAmplitudeDistributor::AddValues),
+            fMergeSketchSlot("merge-sketch", this, &KTAmplitudeDistributor::MergeSketches),
             fCompleteDistributions("finish", this, &KTAmplitudeDistributor::FinishAmpDist)
     {
     }
@@ -104,6 +109,9 @@ namespace Katydid
             SetDistMax(node->get_value< double >("dist-max"));
         }
 
+        SetUseSketch(node->get_value< bool >("use-sketch", fUseSketch));
+        SetSketchCompression(node->get_value< double >("sketch-compression", fSketchCompression));
+
         return true;
     }
 
@@ -115,7 +123,14 @@ namespace Katydid
         fNSlicesProcessed = 0;
 
         fBuffer.clear();
-        if (fUseBuffer)
+        if (fUseSketch)
+        {
+            // Set the TakeValues function pointers
+            fTakeValuesPolar = &KTAmplitudeDistributor::TakeValuesToSketches;
+            fTakeValuesFFTW = &KTAmplitudeDistributor::TakeValuesToSketches;
+            KTDEBUG(adlog, "Function pointers set to take values to sketches");
+        }
+        else if (fUseBuffer)
         {
             // This command initializes the nested vectors with the correct number of elements
             // It's assumed that fBufferSize is set before this function is called.
@@ -146,7 +161,13 @@ namespace Katydid
         fDistributionData.reset(new Nymph::KTData());
 
         fDistributions = &(fDistributionData->Of< KTAmplitudeDistribution >());
-        if (! fUseBuffer)
+        if (fUseSketch)
+        {
+            // The distributions are initialized when they're exported from the sketches
+            fSketches = &(fDistributionData->Of< KTAmplitudeSketchData >());
+            fSketches->Initialize(fNComponents, fNFreqBins, fSketchCompression);
+        }
+        else if (! fUseBuffer)
         {
             // In the case that the buffer is being used, fDistributions will be initialized to the correct size later
             fDistributions->InitializeNew(fNComponents, fNFreqBins, fDistNBins, fDistMin, fDistMax);
@@ -186,6 +207,33 @@ namespace Katydid
         return CoreAddValues(data);
     }
 
+    bool KTAmplitudeDistributor::MergeSketches(KTAmplitudeSketchData& data)
+    {
+        if (! fUseSketch)
+        {
+            KTERROR(adlog, "Sketches can only be merged in sketch mode (\"use-sketch\" = true)");
+            return false;
+        }
+
+        if (! fDistributions)
+        {
+            if (! Initialize(data.GetNComponents(), data.GetNFreqBins()))
+            {
+                KTERROR(adlog, "Something went wrong while initializing the processor");
+                return false;
+            }
+        }
+
+        if (! fSketches->Merge(data))
+        {
+            KTERROR(adlog, "Unable to merge the sketches");
+            return false;
+        }
+
+        KTINFO(adlog, "Merged sketches for " << data.GetNComponents() << " components");
+        return true;
+    }
+
     bool KTAmplitudeDistributor::CoreAddValues(KTFrequencySpectrumDataFFTWCore& data)
     {
         if (fCalculateMinBin)
@@ -313,6 +361,15 @@ namespace Katydid
         return true;
     }
 
+    bool KTAmplitudeDistributor::TakeValuesToSketches(const KTFrequencySpectrumPolar* spectrum, unsigned component)
+    {
+        for (unsigned iBin = fMinBin; iBin <= fMaxBin; iBin++)
+        {
+            fSketches->AddValue(iBin, (*spectrum)(iBin).abs(), component);
+        }
+        return true;
+    }
+
     bool KTAmplitudeDistributor::TakeValuesToBuffer(const KTFrequencySpectrumFFTW* spectrum, unsigned component)
     {
         if (fNSlicesProcessed == fBufferSize)
@@ -347,6 +404,15 @@ namespace Katydid
         return true;
     }
 
+    bool KTAmplitudeDistributor::TakeValuesToSketches(const KTFrequencySpectrumFFTW* spectrum, unsigned component)
+    {
+        for (unsigned iBin = fMinBin; iBin <= fMaxBin; iBin++)
+        {
+            fSketches->AddValue(iBin, spectrum->GetAbs(iBin), component);
+        }
+        return true;
+    }
+
 
     bool KTAmplitudeDistributor::CreateDistributionsFromBuffer()
     {
@@ -415,7 +481,16 @@ namespace Katydid
 
     void KTAmplitudeDistributor::FinishAmpDist()
     {
-        if (fUseBuffer && ! fBuffer.empty())
+        if (fUseSketch && fSketches != NULL)
+        {
+            KTDEBUG(adlog, "Exporting distributions from sketches");
+            if (! fSketches->ExportDistributions(*fDistributions, fDistNBins))
+            {
+                KTERROR(adlog, "A problem occurred while exporting the distributions from the sketches");
+                return;
+            }
+        }
+        else if (fUseBuffer && ! fBuffer.empty())
         {
             CreateDistributionsFromBuffer();
         }
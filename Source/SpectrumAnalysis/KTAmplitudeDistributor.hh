@@ -19,6 +19,7 @@
 namespace Katydid
 {
     
+    class KTAmplitudeSketchData;
     class KTCorrelationData;
     class KTDiscriminatedPoints1DData;
     class KTEggHeader;
@@ -40,6 +41,15 @@ namespace Katydid
      @brief Collects distributions of amplitudes for each frequency bin over many slices.
 
      @details
+     The distributions can be made in one of two ways:
+     - Histograms (default): one fixed-bin histogram per frequency bin.  The range of each histogram is either given ("dist-min/max"),
+       or determined from the first "buffer-size" spectra, which are buffered until then.
+     - Sketches ("use-sketch" = true): one streaming quantile sketch (KTTDigest) per frequency bin.  No range or buffering is needed,
+       and the memory used doesn't grow with the number of spectra.  When the distributions are finished, the sketches are exported
+       to histograms of "dist-n-bins" bins spanning the range of the values in each frequency bin.
+       The sketches are included in the output data (KTAmplitudeSketchData), so they can be written and later merged with sketches from
+       other files using the "merge-sketch" slot.
+
      Config name: "amplitude-distributor"
 
      Available configuration values:
@@ -52,6 +62,8 @@ namespace Katydid
      - "buffer-size": unsigned -- number of spectra to store initially to determine the range of the distribution (if not using "dist-min/max")
      - "dist-min": double -- minimum of the distribution (if not using "buffer-size")
      - "dist-max": double -- maximum of the distribution (if not using "buffer-size")
+     - "use-sketch": bool -- whether to use streaming sketches instead of histograms (default: false); the buffer and "dist-min/max" are then not used
+     - "sketch-compression": double -- accuracy parameter of the sketches; each sketch holds about this many centroids (default: 100)
 
      Slots:
      - Running
@@ -61,11 +73,12 @@ namespace Katydid
        - "norm-fs-fftw": void (Nymph::KTDataPtr) -- Adds values from a spectrum to the amplitude distribution; Requires KTNormalizedFSDataFFTW
        - "corr": void (Nymph::KTDataPtr) -- Adds values from a spectrum to the amplitude distribution; Requires KTCorrelationData
        - "wv": void (Nymph::KTDataPtr) -- Adds values from a spectrum to the amplitude distribution; Requires KTWignerVilleData
+       - "merge-sketch": void (Nymph::KTDataPtr) -- Merges sketches made elsewhere (e.g. read from a file) into the sketches (sketch mode only); Requires KTAmplitudeSketchData
      - Completion
        - "finish": void () -- Completes the calculation of the amplitude distribution; Emits "amp-dist"
 
      Signals:
-     \li \c "amp-dist": void (Nymph::KTDataPtr) Emitted upon completion of an amplitude distribution; Guarantees KTAmplitudeDistributor
+     \li \c "amp-dist": void (Nymph::KTDataPtr) Emitted upon completion of an amplitude distribution; Guarantees KTAmplitudeDistribution (and KTAmplitudeSketchData in sketch mode)
     */
 
     class KTAmplitudeDistributor : public Nymph::KTProcessor
@@ -108,6 +121,12 @@ namespace Katydid
             double GetDistMax() const;
             void SetDistMax(double max);
 
+            bool GetUseSketch() const;
+            void SetUseSketch(bool useSketch);
+
+            double GetSketchCompression() const;
+            void SetSketchCompression(double compression);
+
         private:
             double fMinFrequency;
             double fMaxFrequency;
@@ -121,6 +140,8 @@ namespace Katydid
             double fDistMin;
             double fDistMax;
             bool fUseBuffer;
+            bool fUseSketch;
+            double fSketchCompression;
 
         public:
             bool Initialize(unsigned nComponents, unsigned nFreqBins);
@@ -132,6 +153,9 @@ namespace Katydid
             bool AddValues(KTCorrelationData& data);
             bool AddValues(KTWignerVilleData& data);
 
+            /// Merges sketches made elsewhere into this processor's sketches; initializes the processor if no spectra have been added yet
+            bool MergeSketches(KTAmplitudeSketchData& data);
+
             void FinishAmpDist();
 
         private:
@@ -141,10 +165,12 @@ namespace Katydid
             bool (KTAmplitudeDistributor::*fTakeValuesPolar)(const KTFrequencySpectrumPolar*, unsigned);
             bool TakeValuesToBuffer(const KTFrequencySpectrumPolar* spectrum, unsigned component);
             bool TakeValuesToDistributions(const KTFrequencySpectrumPolar* spectrum, unsigned component);
+            bool TakeValuesToSketches(const KTFrequencySpectrumPolar* spectrum, unsigned component);
 
             bool (KTAmplitudeDistributor::*fTakeValuesFFTW)(const KTFrequencySpectrumFFTW*, unsigned);
             bool TakeValuesToBuffer(const KTFrequencySpectrumFFTW* spectrum, unsigned component);
             bool TakeValuesToDistributions(const KTFrequencySpectrumFFTW* spectrum, unsigned component);
+            bool TakeValuesToSketches(const KTFrequencySpectrumFFTW* spectrum, unsigned component);
 
             bool CreateDistributionsEmpty();
             bool CreateDistributionsFromBuffer();
@@ -161,6 +187,7 @@ namespace Katydid
 
             Nymph::KTDataPtr fDistributionData;
             KTAmplitudeDistribution* fDistributions;
+            KTAmplitudeSketchData* fSketches; // only used in sketch mode
 
 
             //***************
@@ -181,6 +208,7 @@ namespace Katydid
             Nymph::KTSlotDataOneType< KTNormalizedFSDataFFTW > fNormFSFFTWSlot;
             Nymph::KTSlotDataOneType< KTCorrelationData > fCorrSlot;
             Nymph::KTSlotDataOneType< KTWignerVilleData > fWVSlot;
+            Nymph::KTSlotDataOneType< KTAmplitudeSketchData > fMergeSketchSlot;
 
             Nymph::KTSlotNoArg< void () > fCompleteDistributions;
 
@@ -291,5 +319,27 @@ namespace Katydid
         return;
     }
 
+    inline bool KTAmplitudeDistributor::GetUseSketch() const
+    {
+        return fUseSketch;
+    }
+
+    inline void KTAmplitudeDistributor::SetUseSketch(bool useSketch)
+    {
+        fUseSketch = useSketch;
+        return;
+    }
+
+    inline double KTAmplitudeDistributor::GetSketchCompression() const
+    {
+        return fSketchCompression;
+    }
+
+    inline void KTAmplitudeDistributor::SetSketchCompression(double compression)
+    {
+        fSketchCompression = compression;
+        return;
+    }
+
 } /* namespace Katydid */
 #endif /* KTAMPLITUDEDISTRIBUTOR_HH_ */
@@ -8,15 +8,20 @@
 #include "KTConvolution.hh"
 
 #include "KTConvolvedSpectrumData.hh"
+#include "KTFFTWPlanCache.hh"
 #include "KTFrequencySpectrumPolar.hh"
 #include "KTFrequencySpectrumFFTW.hh"
 #include "KTPowerSpectrum.hh"
+#include "KTSpectrumCollectionData.hh"
 
 #include "param_codec.hh"
 #include "param_json.hh"
 #include "param.hh"
 #include "KTConfigurator.hh"
 
+#include <algorithm>
+#include <cstring>
+
 using std::string;
 using std::vector;
 
@@ -33,45 +38,29 @@ namespace Katydid
             fNormalizeKernel(false),
             fTransformType("convolution"),
             fTransformFlag("ESTIMATE"),
-            fRegularSize(0),
-            fShortSize(0),
+            fMaxBatchBlocks(64),
             fTransformFlagMap(),
-            fComplexToRealPlan(),
-            fRealToComplexPlan(),
-            fC2CForwardPlan(),
-            fC2CReversePlan(),
-            fComplexToRealPlanShort(),
-            fRealToComplexPlanShort(),
-            fC2CForwardPlanShort(),
-            fC2CReversePlanShort(),
-            fInputArrayReal(NULL),
-            fOutputArrayReal(NULL),
-            fInputArrayComplex(NULL),
-            fOutputArrayComplex(NULL),
-            fTransformedInputArray(NULL),
-            fTransformedOutputArray(NULL),
-            fTransformedInputArrayFromReal(NULL),
-            fTransformedOutputArrayFromReal(NULL),
+            fBlock(0),
+            fOverlap(0),
+            fStep(0),
             fTransformedKernelXAsReal(NULL),
             fTransformedKernelXAsComplex(NULL),
-            fGeneralTransformedInputArray(NULL),
-            fGeneralTransformedOutputArray(NULL),
-            fGeneralTransformedKernelArray(NULL),
-            nBinLimitRegular(0),
-            nBinLimitShort(0),
-            fGeneralForwardPlan(),
-            fGeneralReversePlan(),
-            fGeneralForwardPlanShort(),
-            fGeneralReversePlanShort(),
+            fRealBlocks(NULL),
+            fComplexBlocks(NULL),
+            fRealStage(),
+            fComplexStage(),
+            fQueue(),
             fTransformFlagUnsigned(FFTW_ESTIMATE),
             fKernelSize(0),
             fInitialized(false),
             fPSSignal("ps", this),
             fFSFFTWSignal("fs-fftw", this),
             fFSPolarSignal("fs-polar", this),
+            fPSCollectionSignal("ps-coll", this),
             fPSSlot("ps", this, &KTConvolution1D::Convolve1D, &fPSSignal),
             fFSFFTWSlot("fs-fftw", this, &KTConvolution1D::Convolve1D, &fFSFFTWSignal),
-            fFSPolarSlot("fs-polar", this, &KTConvolution1D::Convolve1D, &fFSPolarSignal)
+            fFSPolarSlot("fs-polar", this, &KTConvolution1D::Convolve1D, &fFSPolarSignal),
+            fPSCollectionSlot("ps-coll", this, &KTConvolution1D::Convolve1D, &fPSCollectionSignal)
     {
         SetupInternalMaps();
     }
@@ -87,8 +76,16 @@ namespace Katydid
 
         SetKernel(node->get_value< std::string >("kernel", GetKernel()));
         SetBlockSize(node->get_value< unsigned >("block-size", GetBlockSize()));
+        SetNormalizeKernel(node->get_value< bool >("normalize", GetNormalizeKernel()));
         SetTransformType(node->get_value< std::string >("transform-type", GetTransformType()));
         SetTransformFlag(node->get_value< std::string >("transform-flag", GetTransformFlag()));
+        SetMaxBatchBlocks(node->get_value< unsigned >("max-batch-blocks", GetMaxBatchBlocks()));
+
+        if (GetMaxBatchBlocks() == 0)
+        {
+            KTERROR(sdlog, "The maximum number of blocks per batch must be at least 1");
+            return false;
+        }
 
         return FinishSetup();
     }
@@ -114,7 +111,8 @@ namespace Katydid
         TransformFlagMap::const_iterator iter = fTransformFlagMap.find( fTransformFlag );
         fTransformFlagUnsigned = iter->second;
 
-        // Read in the kernel
+        // Read in the kernel; its transforms will be redone for the new kernel
+        FreeArrays();
         if( ! ParseKernel() )
         {
             KTERROR(sdlog, "Failed to parse kernel json. Aborting");
@@ -124,17 +122,9 @@ namespace Katydid
         return true;
     }
 
-    void KTConvolution1D::AllocateArrays( int nSizeRegular, int nSizeShort )
+    void KTConvolution1D::AllocateArrays( int block )
     {
-        KTDEBUG(sdlog, "DFT initialization started");
-        KTDEBUG(sdlog, "Regular size = " << nSizeRegular);
-        KTDEBUG(sdlog, "Short size = " << nSizeShort);
-
-        if( nSizeShort > nSizeRegular )
-        {
-            KTWARN(sdlog, "Short size is larger than regular size; something weird happened. Aborting DFT initialization");
-            return;
-        }
+        KTDEBUG(sdlog, "Allocating arrays for block size " << block << "; " << GetMaxBatchBlocks() << " blocks per batch");
 
         if( fInitialized )
         {
@@ -142,130 +132,43 @@ namespace Katydid
             FreeArrays();
         }
 
-        // Input/Output arrays
-        fInputArrayReal = (double*) fftw_malloc( sizeof( double ) * nSizeRegular );
-        fOutputArrayReal = (double*) fftw_malloc( sizeof( double ) * nSizeRegular );
-        fInputArrayComplex = (fftw_complex*) fftw_malloc( sizeof( fftw_complex ) * nSizeRegular );
-        fOutputArrayComplex = (fftw_complex*) fftw_malloc( sizeof( fftw_complex ) * nSizeRegular );
-
-        // Intermediate (fourier space) arrays
-        fTransformedInputArray = (fftw_complex*) fftw_malloc( sizeof( fftw_complex ) * nSizeRegular );
-        fTransformedOutputArray = (fftw_complex*) fftw_malloc( sizeof( fftw_complex ) * nSizeRegular );
-        fTransformedInputArrayFromReal = (fftw_complex*) fftw_malloc( sizeof( fftw_complex ) * (nSizeRegular/2 + 1) );
-        fTransformedOutputArrayFromReal = (fftw_complex*) fftw_malloc( sizeof( fftw_complex ) * (nSizeRegular/2 + 1) );
-
-        // DFT plans
-        fRealToComplexPlan = fftw_plan_dft_r2c_1d( nSizeRegular, fInputArrayReal, fTransformedInputArrayFromReal, fTransformFlagUnsigned );
-        fComplexToRealPlan = fftw_plan_dft_c2r_1d( nSizeRegular, fTransformedOutputArrayFromReal, fOutputArrayReal, fTransformFlagUnsigned );
-        fC2CForwardPlan = fftw_plan_dft_1d( nSizeRegular, fInputArrayComplex, fTransformedInputArray, FFTW_FORWARD, fTransformFlagUnsigned );
-        fC2CReversePlan = fftw_plan_dft_1d( nSizeRegular, fTransformedOutputArray, fOutputArrayComplex, FFTW_BACKWARD, fTransformFlagUnsigned );
-
-        fRealToComplexPlanShort = fftw_plan_dft_r2c_1d( nSizeShort, fInputArrayReal, fTransformedInputArrayFromReal, fTransformFlagUnsigned );
-        fComplexToRealPlanShort = fftw_plan_dft_c2r_1d( nSizeShort, fTransformedOutputArrayFromReal, fOutputArrayReal, fTransformFlagUnsigned );
-        fC2CForwardPlanShort = fftw_plan_dft_1d( nSizeShort, fInputArrayComplex, fTransformedInputArray, FFTW_FORWARD, fTransformFlagUnsigned );
-        fC2CReversePlanShort = fftw_plan_dft_1d( nSizeShort, fTransformedOutputArray, fOutputArrayComplex, FFTW_BACKWARD, fTransformFlagUnsigned );
+        int nComplexFromReal = block/2 + 1;
 
-        // All the same for short size
-        // But we can skip this if the size is chosen right
+        // Kernel transforms
+        fTransformedKernelXAsReal = (fftw_complex*) fftw_malloc( sizeof( fftw_complex ) * nComplexFromReal );
+        fTransformedKernelXAsComplex = (fftw_complex*) fftw_malloc( sizeof( fftw_complex ) * block );
 
-        if( nSizeShort == fKernelSize - 1 )
-        {
-            KTINFO(sdlog, "Input blocks are divided evenly! I will only initialize one group of FFTW plans");
-
-            fRegularSize = nSizeRegular;
-            fShortSize = nSizeShort;
-            fInitialized = true;
-
-            return;
-        }
-
-        // Store these guys
-        fRegularSize = nSizeRegular;
-        fShortSize = nSizeShort;
-
-        // Make sure we don't come back here unless something weird happens
-        fInitialized = true;
+        // Blocks; the real blocks have room for the in-place transform
+        fRealBlocks = (double*) fftw_malloc( sizeof( fftw_complex ) * nComplexFromReal * GetMaxBatchBlocks() );
+        fComplexBlocks = (fftw_complex*) fftw_malloc( sizeof( fftw_complex ) * block * GetMaxBatchBlocks() );
 
         return;
     }  
 
     void KTConvolution1D::FreeArrays()
     {
-        if( fInputArrayReal != nullptr )
-        {
-            fftw_free( fInputArrayReal );
-            fInputArrayReal = nullptr;
-        }
-        if( fOutputArrayReal != nullptr )
-        {
-            fftw_free( fOutputArrayReal );
-            fOutputArrayReal = nullptr;
-        }
-        if( fInputArrayComplex != nullptr )
+        if( fTransformedKernelXAsReal != nullptr )
         {
-            fftw_free( fInputArrayComplex );
-            fInputArrayComplex = nullptr;
+            fftw_free( fTransformedKernelXAsReal );
+            fTransformedKernelXAsReal = nullptr;
         }
-        if( fOutputArrayComplex != nullptr )
+        if( fTransformedKernelXAsComplex != nullptr )
         {
-            fftw_free( fOutputArrayComplex );
-            fOutputArrayComplex = nullptr;
+            fftw_free( fTransformedKernelXAsComplex );
+            fTransformedKernelXAsComplex = nullptr;
         }
-
-        if( fTransformedInputArray != nullptr )
+        if( fRealBlocks != nullptr )
         {
-            fftw_free( fTransformedInputArray );
-            fTransformedInputArray = nullptr;
+            fftw_free( fRealBlocks );
+            fRealBlocks = nullptr;
         }
-
-        if( fTransformedOutputArray != nullptr )
+        if( fComplexBlocks != nullptr )
         {
-            fftw_free( fTransformedOutputArray );
-            fTransformedOutputArray = nullptr;
-        }
-
-        if( fRealToComplexPlan != nullptr )
-        {
-            fftw_destroy_plan( fRealToComplexPlan );
-            fRealToComplexPlan = nullptr;
-        }
-        if( fComplexToRealPlan != nullptr )
-        {
-            fftw_destroy_plan( fComplexToRealPlan );
-            fComplexToRealPlan = nullptr;
-        }
-        if( fC2CForwardPlan != nullptr )
-        {
-            fftw_destroy_plan( fC2CForwardPlan );
-            fC2CForwardPlan = nullptr;
-        }
-        if( fC2CReversePlan != nullptr )
-        {
-            fftw_destroy_plan( fC2CReversePlan );
-            fC2CReversePlan = nullptr;
-        }
-
-        if( fRealToComplexPlanShort != nullptr )
-        {
-            fftw_destroy_plan( fRealToComplexPlanShort );
-            fRealToComplexPlanShort = nullptr;
-        }
-        if( fComplexToRealPlanShort != nullptr )
-        {
-            fftw_destroy_plan( fComplexToRealPlanShort );
-            fComplexToRealPlanShort = nullptr;
-        }
-        if( fC2CForwardPlanShort != nullptr )
-        {
-            fftw_destroy_plan( fC2CForwardPlanShort );
-            fC2CForwardPlanShort = nullptr;
-        }
-        if( fC2CReversePlanShort != nullptr )
-        {
-            fftw_destroy_plan( fC2CReversePlanShort );
-            fC2CReversePlanShort = nullptr;
+            fftw_free( fComplexBlocks );
+            fComplexBlocks = nullptr;
         }
 
+        fBlock = 0;
         fInitialized = false;
 
         return;
@@ -299,6 +202,7 @@ namespace Katydid
         // Also calculate the norm in case we need that
 
         double norm = 0.;
+        kernelX.clear();
         for( int iValue = 0; iValue < fKernelSize; ++iValue )
         {
             kernelX.push_back( kernel1DArray.get_value< double >(iValue) );
@@ -369,166 +273,211 @@ namespace Katydid
         return CoreConvolve1D( static_cast< KTFrequencySpectrumDataPolarCore& >(data), newData );
     }
 
-    template< class XSpectraType >
-    bool KTConvolution1D::SetUpGeneralVars()
+    bool KTConvolution1D::Convolve1D( KTPSCollectionData& data )
     {
-        return false;
-    }
+        KTINFO(sdlog, "Received power spectrum collection. Performing 1D convolution");
+        // New data object
+        KTConvolvedMultiPSData& newData = data.Of< KTConvolvedMultiPSData >();
+        newData.SetNComponents( data.GetNComponents() );
 
-    template<>
-    bool KTConvolution1D::SetUpGeneralVars< KTPowerSpectrum* >()
-    {
-        fGeneralTransformedInputArray = fTransformedInputArrayFromReal;
-        fGeneralTransformedOutputArray = fTransformedOutputArrayFromReal;
-        fGeneralTransformedKernelArray = fTransformedKernelXAsReal;
-        fGeneralForwardPlan = fRealToComplexPlan;
-        fGeneralForwardPlanShort = fRealToComplexPlanShort;
-        fGeneralReversePlan = fComplexToRealPlan;
-        fGeneralReversePlanShort = fComplexToRealPlanShort;
-        nBinLimitRegular = fRegularSize/2 + 1;
-        nBinLimitShort = fShortSize/2 + 1;
+        if( ! Initialize( GetBlockSize() ) )
+        {
+            KTERROR(sdlog, "Unable to initialize the convolution. Aborting.");
+            return false;
+        }
 
-        return true;
-    }
+        for( unsigned iComponent = 0; iComponent < data.GetNComponents(); ++iComponent )
+        {
+            const KTMultiPS* spectra = data.GetSpectra( iComponent );
+            if( spectra == nullptr ) continue;
 
-    template<>
-    bool KTConvolution1D::SetUpGeneralVars< KTFrequencySpectrumFFTW* >()
-    {
-        fGeneralTransformedInputArray = fTransformedInputArray;
-        fGeneralTransformedOutputArray = fTransformedOutputArray;
-        fGeneralTransformedKernelArray = fTransformedKernelXAsComplex;
-        fGeneralForwardPlan = fC2CForwardPlan;
-        fGeneralForwardPlanShort = fC2CForwardPlanShort;
-        fGeneralReversePlan = fC2CReversePlan;
-        fGeneralReversePlanShort = fC2CReversePlanShort;
-        nBinLimitRegular = fRegularSize;
-        nBinLimitShort = fShortSize;
+            // All of the spectra in the collection are convolved in one go
+            std::vector< const KTPowerSpectrum* > inputs( spectra->begin(), spectra->end() );
+            std::vector< KTPowerSpectrum* > outputs;
+            DoConvolution( inputs, outputs );
 
-        return true;
-    }
+            KTMultiPS* newSpectra = new KTMultiPS( spectra->size(), spectra->GetRangeMin(), spectra->GetRangeMax() );
+            bool success = true;
+            for( unsigned iSpectrum = 0; iSpectrum < outputs.size(); ++iSpectrum )
+            {
+                (*newSpectra)(iSpectrum) = outputs[iSpectrum];
+                success = success && (inputs[iSpectrum] == nullptr || outputs[iSpectrum] != nullptr);
+            }
+            newData.SetSpectra( newSpectra, iComponent );
 
-    template<>
-    bool KTConvolution1D::SetUpGeneralVars< KTFrequencySpectrumPolar* >()
-    {
-        fGeneralTransformedInputArray = fTransformedInputArray;
-        fGeneralTransformedOutputArray = fTransformedOutputArray;
-        fGeneralTransformedKernelArray = fTransformedKernelXAsComplex;
-        fGeneralForwardPlan = fC2CForwardPlan;
-        fGeneralForwardPlanShort = fC2CForwardPlanShort;
-        fGeneralReversePlan = fC2CReversePlan;
-        fGeneralReversePlanShort = fC2CReversePlanShort;
-        nBinLimitRegular = fRegularSize;
-        nBinLimitShort = fShortSize;
+            if( ! success )
+            {
+                KTERROR(sdlog, "Convolution was unsuccessful. Aborting.");
+                return false;
+            }
+        }
 
         return true;
     }
 
-    void KTConvolution1D::ConjugateAndReverse( KTPowerSpectrum& spectrum )
+    void KTConvolution1D::StageSpectrum( const KTPowerSpectrum& spectrum )
     {
-        double temp;
         int nBins = spectrum.GetNFrequencyBins();
-        for( int iBin = 0; iBin < (nBins+1)/2; ++iBin )
+        int nBlocks = (nBins + fStep - 1) / fStep;
+        fRealStage.assign( nBlocks * fStep + fOverlap, 0. );
+
+        const double* values = spectrum.GetData();
+        if( fTransformType == "cross-correlation" )
         {
-            temp = spectrum(iBin);
-            spectrum(iBin) = spectrum(nBins - iBin - 1);
-            spectrum(nBins - iBin - 1) = temp;
+            std::reverse_copy( values, values + nBins, fRealStage.begin() + fOverlap );
+        }
+        else
+        {
+            std::copy( values, values + nBins, fRealStage.begin() + fOverlap );
         }
-
         return;
     }
 
-    void KTConvolution1D::ConjugateAndReverse( KTFrequencySpectrumFFTW& spectrum )
+    void KTConvolution1D::StageSpectrum( const KTFrequencySpectrumFFTW& spectrum )
     {
         int nBins = spectrum.GetNFrequencyBins();
-        for( int iBin = 0; iBin < (nBins+1)/2; ++iBin )
+        int nBlocks = (nBins + fStep - 1) / fStep;
+        fComplexStage.assign( nBlocks * fStep + fOverlap, std::complex< double >() );
+
+        // The bin accessor takes care of the array ordering
+        std::complex< double >* staged = &fComplexStage[fOverlap];
+        if( fTransformType == "cross-correlation" )
         {
-            auto tmpReal = spectrum.GetReal(iBin);
-            auto tmpImag = spectrum.GetImag(iBin);
-            spectrum.SetRect(iBin, spectrum.GetReal(nBins - iBin - 1), 
-                                -1. * spectrum.GetImag(nBins - iBin - 1));
-            spectrum.SetRect(nBins - iBin -1, tmpReal, -1. * tmpImag);
+            for( int iBin = 0; iBin < nBins; ++iBin ) staged[iBin] = std::conj( spectrum(nBins - iBin - 1) );
+        }
+        else
+        {
+            for( int iBin = 0; iBin < nBins; ++iBin ) staged[iBin] = spectrum(iBin);
         }
-
         return;
     }
 
-    void KTConvolution1D::ConjugateAndReverse( KTFrequencySpectrumPolar& spectrum )
+    void KTConvolution1D::StageSpectrum( const KTFrequencySpectrumPolar& spectrum )
     {
-        fftw_complex temp;
         int nBins = spectrum.GetNFrequencyBins();
-        for( int iBin = 0; iBin < (nBins+1)/2; ++iBin )
+        int nBlocks = (nBins + fStep - 1) / fStep;
+        fComplexStage.assign( nBlocks * fStep + fOverlap, std::complex< double >() );
+
+        // Each bin is converted from polar form once, rather than once for every block it appears in
+        std::complex< double >* staged = &fComplexStage[fOverlap];
+        if( fTransformType == "cross-correlation" )
         {
-            temp[0] = spectrum.GetReal( iBin );
-            temp[1] = spectrum.GetImag( iBin );
-            spectrum.SetRect( iBin, spectrum.GetReal(nBins - iBin - 1), -1. * spectrum.GetImag(nBins - iBin - 1) );
-            spectrum.SetRect( nBins - iBin - 1, temp[0], -1. * temp[1] );
+            for( int iBin = 0; iBin < nBins; ++iBin ) staged[iBin] = std::complex< double >( spectrum.GetReal(nBins - iBin - 1), -1. * spectrum.GetImag(nBins - iBin - 1) );
+        }
+        else
+        {
+            for( int iBin = 0; iBin < nBins; ++iBin ) staged[iBin] = std::complex< double >( spectrum.GetReal(iBin), spectrum.GetImag(iBin) );
         }
-
         return;
     }
 
-    void KTConvolution1D::SetInputArray( int position, int nBin, const KTPowerSpectrum* initialSpectrum )
+    void KTConvolution1D::LoadBlock( const KTPowerSpectrum*, int firstBin, unsigned iSlot )
     {
+        // staged bin firstBin is input bin firstBin - fOverlap
+        double* block = fRealBlocks + iSlot * 2 * (fBlock/2 + 1);
+        memcpy( block, &fRealStage[firstBin], sizeof( double ) * fBlock );
+        return;
+    }
 
-        if( position < 0 ) { fInputArrayReal[nBin] = 0.0; }
-        else { fInputArrayReal[nBin] = (*initialSpectrum)(position); }
-
+    void KTConvolution1D::LoadBlock( const KTFrequencySpectrum*, int firstBin, unsigned iSlot )
+    {
+        memcpy( fComplexBlocks + iSlot * fBlock, &fComplexStage[firstBin], sizeof( fftw_complex ) * fBlock );
         return;
     }
 
-    void KTConvolution1D::SetInputArray( int position, int nBin, const KTFrequencySpectrumFFTW* initialSpectrum )
+    bool KTConvolution1D::ConvolveBlocks( const KTPowerSpectrum*, unsigned nBlocks )
     {
-        if( position < 0 )
-        {
-            fInputArrayComplex[nBin][0] = 0.0;
-            fInputArrayComplex[nBin][1] = 0.0;
-        }
-        else
-        {
-            fInputArrayComplex[nBin][0] = initialSpectrum->GetReal(position);
-            fInputArrayComplex[nBin][1] = initialSpectrum->GetImag(position);
+        KTFFTWPlanCache::PlanKey forwardKey( KTFFTWPlanCache::kR2C, fBlock, fTransformFlagUnsigned );
+        forwardKey.fHowMany = nBlocks;
+        forwardKey.fInPlace = true;
+        KTFFTWPlanCache::PlanKey reverseKey( KTFFTWPlanCache::kC2R, fBlock, fTransformFlagUnsigned );
+        reverseKey.fHowMany = nBlocks;
+        reverseKey.fInPlace = true;
+
+        KTFFTWPlanCache* planCache = KTFFTWPlanCache::get_instance();
+        fftw_plan forwardPlan = planCache->GetPlan( forwardKey );
+        fftw_plan reversePlan = planCache->GetPlan( reverseKey );
+        if( forwardPlan == NULL || reversePlan == NULL ) return false;
+
+        fftw_complex* transformed = reinterpret_cast< fftw_complex* >( fRealBlocks );
+        fftw_execute_dft_r2c( forwardPlan, fRealBlocks, transformed );
+
+        // Bin multiplication in fourier space
+        int nComplex = fBlock/2 + 1;
+        for( unsigned iBlock = 0; iBlock < nBlocks; ++iBlock )
+        {
+            fftw_complex* blockBins = transformed + iBlock * nComplex;
+            for( int iBin = 0; iBin < nComplex; ++iBin )
+            {
+                double real = blockBins[iBin][0] * fTransformedKernelXAsReal[iBin][0] - blockBins[iBin][1] * fTransformedKernelXAsReal[iBin][1];
+                blockBins[iBin][1] = blockBins[iBin][0] * fTransformedKernelXAsReal[iBin][1] + blockBins[iBin][1] * fTransformedKernelXAsReal[iBin][0];
+                blockBins[iBin][0] = real;
+            }
         }
 
-        return;
+        fftw_execute_dft_c2r( reversePlan, transformed, fRealBlocks );
+        return true;
     }
 
-    void KTConvolution1D::SetInputArray( int position, int nBin, const KTFrequencySpectrumPolar* initialSpectrum )
+    bool KTConvolution1D::ConvolveBlocks( const KTFrequencySpectrum*, unsigned nBlocks )
     {
-        if( position < 0 )
-        {
-            fInputArrayComplex[nBin][0] = 0.0;
-            fInputArrayComplex[nBin][1] = 0.0;
-        }
-        else
+        KTFFTWPlanCache::PlanKey forwardKey( KTFFTWPlanCache::kC2C, fBlock, fTransformFlagUnsigned, FFTW_FORWARD );
+        forwardKey.fHowMany = nBlocks;
+        forwardKey.fInPlace = true;
+        KTFFTWPlanCache::PlanKey reverseKey( KTFFTWPlanCache::kC2C, fBlock, fTransformFlagUnsigned, FFTW_BACKWARD );
+        reverseKey.fHowMany = nBlocks;
+        reverseKey.fInPlace = true;
+
+        KTFFTWPlanCache* planCache = KTFFTWPlanCache::get_instance();
+        fftw_plan forwardPlan = planCache->GetPlan( forwardKey );
+        fftw_plan reversePlan = planCache->GetPlan( reverseKey );
+        if( forwardPlan == NULL || reversePlan == NULL ) return false;
+
+        fftw_execute_dft( forwardPlan, fComplexBlocks, fComplexBlocks );
+
+        for( unsigned iBlock = 0; iBlock < nBlocks; ++iBlock )
         {
-            fInputArrayComplex[nBin][0] = initialSpectrum->GetReal(position);
-            fInputArrayComplex[nBin][1] = initialSpectrum->GetImag(position);
+            fftw_complex* blockBins = fComplexBlocks + iBlock * fBlock;
+            for( int iBin = 0; iBin < fBlock; ++iBin )
+            {
+                double real = blockBins[iBin][0] * fTransformedKernelXAsComplex[iBin][0] - blockBins[iBin][1] * fTransformedKernelXAsComplex[iBin][1];
+                blockBins[iBin][1] = blockBins[iBin][0] * fTransformedKernelXAsComplex[iBin][1] + blockBins[iBin][1] * fTransformedKernelXAsComplex[iBin][0];
+                blockBins[iBin][0] = real;
+            }
         }
 
-        return;
+        fftw_execute_dft( reversePlan, fComplexBlocks, fComplexBlocks );
+        return true;
     }
 
-    void KTConvolution1D::SetOutputArray( int position, int nBin, KTPowerSpectrum& transformedPS, double norm )
+    void KTConvolution1D::StoreBlock( unsigned iSlot, int firstBin, KTPowerSpectrum& output )
     {
-        transformedPS(position) = fOutputArrayReal[nBin] / (double)norm;
-
+        // The first fOverlap bins of each block are wrapped around, and are discarded
+        const double* block = fRealBlocks + iSlot * 2 * (fBlock/2 + 1);
+        int nBins = std::min( fStep, int(output.GetNFrequencyBins()) - firstBin );
+        memcpy( output.GetData() + firstBin, block + fOverlap, sizeof( double ) * nBins );
         return;
     }
 
-    void KTConvolution1D::SetOutputArray( int position, int nBin, KTFrequencySpectrumFFTW& transformedFSFFTW, double norm )
+    void KTConvolution1D::StoreBlock( unsigned iSlot, int firstBin, KTFrequencySpectrumFFTW& output )
     {
-        
-        transformedFSFFTW.SetRect(position, 
-                                fOutputArrayComplex[nBin][0] / (double)norm, 
-                                fOutputArrayComplex[nBin][1] / (double)norm);
-
+        const fftw_complex* block = fComplexBlocks + iSlot * fBlock;
+        int nBins = std::min( fStep, int(output.GetNFrequencyBins()) - firstBin );
+        for( int iBin = 0; iBin < nBins; ++iBin )
+        {
+            output(firstBin + iBin) = std::complex< double >( block[fOverlap + iBin][0], block[fOverlap + iBin][1] );
+        }
         return;
     }
 
-    void KTConvolution1D::SetOutputArray( int position, int nBin, KTFrequencySpectrumPolar& transformedFSPolar, double norm )
+    void KTConvolution1D::StoreBlock( unsigned iSlot, int firstBin, KTFrequencySpectrumPolar& output )
     {
-        transformedFSPolar.SetRect( position, fOutputArrayComplex[nBin][0] / (double)norm, fOutputArrayComplex[nBin][1] / (double)norm );
-
+        const fftw_complex* block = fComplexBlocks + iSlot * fBlock;
+        int nBins = std::min( fStep, int(output.GetNFrequencyBins()) - firstBin );
+        for( int iBin = 0; iBin < nBins; ++iBin )
+        {
+            output.SetRect( firstBin + iBin, block[fOverlap + iBin][0], block[fOverlap + iBin][1] );
+        }
         return;
     }
 
@@ -558,45 +507,71 @@ namespace Katydid
         return;
     }
 
-    void KTConvolution1D::Initialize( int nBinsTotal, int block, int step, int overlap )
+    bool KTConvolution1D::Initialize( int block )
     {
-        KTINFO(sdlog, "DFTs are not yet initialized; doing so now");
+        // The kernel transform only depends on the block size, so it's reused until that changes
+        if( fInitialized && block == fBlock ) return true;
 
-        // Slightly obnoxious conditionals to determine the sizes
-        // Ordinary block is given, but the shorter block at the end is harder
-        // Maybe there is a simpler way to determine this, I'm not sure
+        KTINFO(sdlog, "DFTs are not yet initialized for block size " << block << "; doing so now");
 
-        if( (nBinsTotal + overlap) % step >= overlap )
-        {
-            AllocateArrays( block, (nBinsTotal + overlap) % step );
-        }
-        else
+        if( fKernelSize == 0 || block < fKernelSize || int(kernelX.size()) != block )
         {
-            AllocateArrays( block, ((nBinsTotal + overlap) % step) + step );
+            KTERROR(sdlog, "The kernel has not been set up for block size " << block);
+            return false;
         }
 
-        // Also transform the kernel, we only need to do this once
+        AllocateArrays( block );
+
+        fBlock = block;
+        fOverlap = fKernelSize - 1;
+        fStep = fBlock - fOverlap;
+
+        KTDEBUG(sdlog, "Block size: " << fBlock << "; overlap: " << fOverlap << "; step size: " << fStep);
+
+        // Transform the kernel in place, in the arrays where it's kept
         KTDEBUG(sdlog, "Transforming kernel");
 
-        for( int iBin = 0; iBin < block; ++iBin )
+        KTFFTWPlanCache::PlanKey realKey( KTFFTWPlanCache::kR2C, fBlock, fTransformFlagUnsigned );
+        realKey.fInPlace = true;
+        KTFFTWPlanCache::PlanKey complexKey( KTFFTWPlanCache::kC2C, fBlock, fTransformFlagUnsigned, FFTW_FORWARD );
+        complexKey.fInPlace = true;
+
+        KTFFTWPlanCache* planCache = KTFFTWPlanCache::get_instance();
+        fftw_plan realPlan = planCache->GetPlan( realKey );
+        fftw_plan complexPlan = planCache->GetPlan( complexKey );
+        if( realPlan == NULL || complexPlan == NULL )
         {
-            fInputArrayReal[iBin] = kernelX[iBin];
-            fInputArrayComplex[iBin][0] = kernelX[iBin];
-            fInputArrayComplex[iBin][1] = 0.;
+            FreeArrays();
+            return false;
         }
 
-        fftw_execute( fRealToComplexPlan );
-        fftw_execute( fC2CForwardPlan );
-        
-        fTransformedKernelXAsReal = new fftw_complex[block];
-        fTransformedKernelXAsComplex = new fftw_complex[block];
-        for( int iBin = 0; iBin < block; ++iBin )
+        double* kernelAsReal = reinterpret_cast< double* >( fTransformedKernelXAsReal );
+        for( int iBin = 0; iBin < fBlock; ++iBin )
+        {
+            kernelAsReal[iBin] = kernelX[iBin];
+            fTransformedKernelXAsComplex[iBin][0] = kernelX[iBin];
+            fTransformedKernelXAsComplex[iBin][1] = 0.;
+        }
+
+        fftw_execute_dft_r2c( realPlan, kernelAsReal, fTransformedKernelXAsReal );
+        fftw_execute_dft( complexPlan, fTransformedKernelXAsComplex, fTransformedKernelXAsComplex );
+
+        // The reverse DFT is unnormalized, so its 1/N goes in here once instead of on every output bin
+        double norm = 1. / double(fBlock);
+        for( int iBin = 0; iBin < fBlock/2 + 1; ++iBin )
+        {
+            fTransformedKernelXAsReal[iBin][0] *= norm;
+            fTransformedKernelXAsReal[iBin][1] *= norm;
+        }
+        for( int iBin = 0; iBin < fBlock; ++iBin )
         {
-            fTransformedKernelXAsReal[iBin][0] = fTransformedInputArrayFromReal[iBin][0];
-            fTransformedKernelXAsReal[iBin][1] = fTransformedInputArrayFromReal[iBin][1];
-            fTransformedKernelXAsComplex[iBin][0] = fTransformedInputArray[iBin][0];
-            fTransformedKernelXAsComplex[iBin][1] = fTransformedInputArray[iBin][1];
+            fTransformedKernelXAsComplex[iBin][0] *= norm;
+            fTransformedKernelXAsComplex[iBin][1] *= norm;
         }
+
+        fInitialized = true;
+
+        return true;
     }
 
 
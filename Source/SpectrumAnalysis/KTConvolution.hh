@@ -20,6 +20,7 @@
 
 #include <vector>
 #include <cmath>
+#include <complex>
 #include <fftw3.h>
 #include <map>
 #include <iostream>
@@ -27,6 +28,7 @@
 namespace Katydid
 {
     
+    class KTFrequencySpectrum;
     class KTFrequencySpectrumDataFFTW;
     class KTFrequencySpectrumDataFFTWCore;
     class KTFrequencySpectrumDataPolar;
@@ -40,6 +42,8 @@ namespace Katydid
     class KTConvolvedPowerSpectrumData;
     class KTConvolvedFrequencySpectrumDataFFTW;
     class KTConvolvedFrequencySpectrumDataPolar;
+    class KTConvolvedMultiPSData;
+    class KTPSCollectionData;
 
 
     /*!
@@ -52,6 +56,11 @@ namespace Katydid
      Uses the overlap-save method to efficiently calculate the convolution. The input is broken up into blocks of size N, where
      N can be specified at runtime or determined automatically. N must be larger than the size of the kernel, and a power of 2 is recommended
      to maximize the FFT efficiency.
+
+     The kernel is transformed once per block size, with the normalization of the reverse DFT folded in, and reused for every block.
+     Blocks are transformed in place, several at a time: the blocks of a spectrum (or of every spectrum in a collection) are queued
+     into one aligned buffer, and each full batch is done with a single multi-transform FFTW plan.
+     The last block of a spectrum is zero-padded to the full block size, so every block uses the same plans and kernel transform.
   
      Configuration name: "convolution"
 
@@ -61,16 +70,19 @@ namespace Katydid
      - "normalize": bool -- Normalize the kernel. If false, the output will be scaled by the norm of the kernel
      - "transform-type": std::string -- "convolution" or "cross-correlation"
      - "transform-flag": std:string -- Transform flag for FFTW
+     - "max-batch-blocks": unsigned -- Maximum number of blocks transformed with one FFTW execution (default: 64)
 
      Slots:
      - "ps": void (Nymph::KTDataPtr) -- Convolves a power spectrum; Requires KTPowerSpectrumData; Adds KTConvolvedPowerSpectrumData
      - "fs-fftw": void (Nymph::KTDataPtr) -- Convolves a frequency spectrum; Requires KTFrequencySpectrumDataFFTW; Adds KTConvolvedFrequencySpectrumDataFFTW
      - "fs-polar": void (Nymph::KTDataPtr) -- Convolves a frequency spectrum; Requires KTFrequencySpectrumDataPolar; Adds KTConvolvedFrequencySpectrumDataPolar
+     - "ps-coll": void (Nymph::KTDataPtr) -- Convolves every power spectrum in a collection; Requires KTPSCollectionData; Adds KTConvolvedMultiPSData
 
      Signals:
      - "ps": void (Nymph::KTDataPtr) -- Emitted upon convolution of a power spectrum; Guarantees KTConvolvedPowerSpectrumData
      - "fs-fftw": void (Nymph::KTDataPtr) -- Emitted upon convolution of a frequency spectrum; Guarantees KTConvolvedFrequencySpectrumDataFFTW
      - "fs-polar": void (Nymph::KTDataPtr) -- Emitted upon convolution of a frequency spectrum; Guarantees KTConvolvedFrequencySpectrumDataPolar
+     - "ps-coll": void (Nymph::KTDataPtr) -- Emitted upon convolution of a collection of power spectra; Guarantees KTConvolvedMultiPSData
     */
 
     KTLOGGER(convlog_hh, "KTConvolution.hh");
@@ -90,9 +102,7 @@ namespace Katydid
             MEMBERVARIABLE(bool, NormalizeKernel);
             MEMBERVARIABLE(std::string, TransformType);
             MEMBERVARIABLE_NOSET(std::string, TransformFlag);
-
-            MEMBERVARIABLE_NOSET(double, RegularSize);
-            MEMBERVARIABLE_NOSET(double, ShortSize);
+            MEMBERVARIABLE(unsigned, MaxBatchBlocks);
 
             void SetTransformFlag(const std::string& flag);
 
@@ -103,39 +113,31 @@ namespace Katydid
 
             typedef std::map< std::string, unsigned > TransformFlagMap;
             TransformFlagMap fTransformFlagMap;
-            
-            fftw_plan fComplexToRealPlan;
-            fftw_plan fRealToComplexPlan;
-            fftw_plan fC2CForwardPlan;
-            fftw_plan fC2CReversePlan;
-
-            fftw_plan fComplexToRealPlanShort;
-            fftw_plan fRealToComplexPlanShort;
-            fftw_plan fC2CForwardPlanShort;
-            fftw_plan fC2CReversePlanShort;
-
-            double *fInputArrayReal;
-            double *fOutputArrayReal;
-            fftw_complex *fInputArrayComplex;
-            fftw_complex *fOutputArrayComplex;
-
-            fftw_complex *fTransformedInputArray;
-            fftw_complex *fTransformedOutputArray;
-            fftw_complex *fTransformedInputArrayFromReal;
-            fftw_complex *fTransformedOutputArrayFromReal;
-
-            fftw_complex *fTransformedKernelXAsReal;
-            fftw_complex *fTransformedKernelXAsComplex;
-
-            fftw_complex* fGeneralTransformedInputArray;
-            fftw_complex* fGeneralTransformedOutputArray;
-            fftw_complex* fGeneralTransformedKernelArray;
-            int nBinLimitRegular;
-            int nBinLimitShort;
-            fftw_plan fGeneralForwardPlan;
-            fftw_plan fGeneralReversePlan;
-            fftw_plan fGeneralForwardPlanShort;
-            fftw_plan fGeneralReversePlanShort;
+
+            // Overlap-save geometry, set by Initialize()
+            int fBlock;
+            int fOverlap;
+            int fStep;
+
+            // Transforms of the kernel, including the 1/N of the reverse DFT; made once per block size
+            fftw_complex* fTransformedKernelXAsReal; // fBlock/2 + 1 bins
+            fftw_complex* fTransformedKernelXAsComplex; // fBlock bins
+
+            // Batches of blocks, transformed in place; real blocks are padded to 2*(fBlock/2 + 1) values
+            double* fRealBlocks;
+            fftw_complex* fComplexBlocks;
+
+            // Input spectrum preceded by fOverlap zeros and followed by the zero-padding of the last block;
+            // for cross-correlation it's also conjugated and reversed
+            std::vector< double > fRealStage;
+            std::vector< std::complex< double > > fComplexStage;
+
+            struct QueuedBlock
+            {
+                unsigned fOutput; // index of the output spectrum
+                int fFirstBin; // first output bin filled by this block
+            };
+            std::vector< QueuedBlock > fQueue;
 
             unsigned fTransformFlagUnsigned;
             int fKernelSize;
@@ -148,6 +150,7 @@ namespace Katydid
             bool Convolve1D( KTPowerSpectrumData& data );
             bool Convolve1D( KTFrequencySpectrumDataFFTW& data );
             bool Convolve1D( KTFrequencySpectrumDataPolar& data );
+            bool Convolve1D( KTPSCollectionData& data );
 
             template< class XSpectrumDataCore, class XConvolvedSpectrumTypeData >
             bool CoreConvolve1D( XSpectrumDataCore& data, XConvolvedSpectrumTypeData& newData );
@@ -156,32 +159,43 @@ namespace Katydid
             const KTFrequencySpectrumFFTW* GetSpectrum( KTFrequencySpectrumDataFFTWCore& data, unsigned iComponent );
             const KTFrequencySpectrumPolar* GetSpectrum( KTFrequencySpectrumDataPolarCore& data, unsigned iComponent );
 
+            /// Convolves one spectrum; the caller owns the returned spectrum
             template< class XSpectraType >
-            XSpectraType* DoConvolution( const XSpectraType* initialSpectrum, const int block, const int step, const int overlap );
+            XSpectraType* DoConvolution( const XSpectraType* initialSpectrum );
 
+            /// Convolves a set of spectra, batching the blocks of all of them together; the caller owns the spectra put in outputs
             template< class XSpectraType >
-            bool SetUpGeneralVars();
-
-            void ConjugateAndReverse( KTPowerSpectrum& spectrum );
-            void ConjugateAndReverse( KTFrequencySpectrumFFTW& spectrum );
-            void ConjugateAndReverse( KTFrequencySpectrumPolar& spectrum );
-
-            void SetInputArray( int position, int nBin, const KTPowerSpectrum* initialSpectrum );
-            void SetInputArray( int position, int nBin, const KTFrequencySpectrumFFTW* initialSpectrum );
-            void SetInputArray( int position, int nBin, const KTFrequencySpectrumPolar* initialSpectrum );
-
-            void SetOutputArray( int position, int nBin, KTPowerSpectrum& transformedPS, double norm );
-            void SetOutputArray( int position, int nBin, KTFrequencySpectrumFFTW& transformedFSFFTW, double norm );
-            void SetOutputArray( int position, int nBin, KTFrequencySpectrumPolar& transformedFSPolar, double norm );
+            void DoConvolution( const std::vector< const XSpectraType* >& inputs, std::vector< XSpectraType* >& outputs );
 
             void SetupInternalMaps();
 
             bool FinishSetup();
-            void Initialize( int nBinsTotal, int block, int step, int overlap );
+            /// Sets up the block geometry and transforms the kernel; does nothing if it's already been done for this block size
+            bool Initialize( int block );
 
-            void AllocateArrays( int nSizeRegular, int nSizeShort );
+            void AllocateArrays( int block );
             void FreeArrays();
 
+        private:
+            // The overloads taking KTPowerSpectrum use the real transforms; those taking KTFrequencySpectrum use the complex transforms
+            void StageSpectrum( const KTPowerSpectrum& spectrum );
+            void StageSpectrum( const KTFrequencySpectrumFFTW& spectrum );
+            void StageSpectrum( const KTFrequencySpectrumPolar& spectrum );
+
+            void LoadBlock( const KTPowerSpectrum*, int firstBin, unsigned iSlot );
+            void LoadBlock( const KTFrequencySpectrum*, int firstBin, unsigned iSlot );
+
+            /// Forward DFT, multiplication by the kernel transform, and reverse DFT of the first nBlocks blocks
+            bool ConvolveBlocks( const KTPowerSpectrum*, unsigned nBlocks );
+            bool ConvolveBlocks( const KTFrequencySpectrum*, unsigned nBlocks );
+
+            void StoreBlock( unsigned iSlot, int firstBin, KTPowerSpectrum& output );
+            void StoreBlock( unsigned iSlot, int firstBin, KTFrequencySpectrumFFTW& output );
+            void StoreBlock( unsigned iSlot, int firstBin, KTFrequencySpectrumPolar& output );
+
+            template< class XSpectraType >
+            bool FlushBlocks( std::vector< XSpectraType* >& outputs );
+
             //***************
             // Signals
             //***************
@@ -190,6 +204,7 @@ namespace Katydid
             Nymph::KTSignalData fPSSignal;
             Nymph::KTSignalData fFSFFTWSignal;
             Nymph::KTSignalData fFSPolarSignal;
+            Nymph::KTSignalData fPSCollectionSignal;
 
             //***************
             // Slots
@@ -199,7 +214,8 @@ namespace Katydid
 
             Nymph::KTSlotDataOneType< KTPowerSpectrumData > fPSSlot;
             Nymph::KTSlotDataOneType< KTFrequencySpectrumDataFFTW > fFSFFTWSlot;
-            Nymph::KTSlotDataOneType< KTFrequencySpectrumDataPolar > fFSPolarSlot;            
+            Nymph::KTSlotDataOneType< KTFrequencySpectrumDataPolar > fFSPolarSlot;
+            Nymph::KTSlotDataOneType< KTPSCollectionData > fPSCollectionSlot;
 
     };
 
@@ -208,162 +224,108 @@ namespace Katydid
     {
         newData.SetNComponents( data.GetNComponents() );
 
-        // Set overlap-and-save method parameters
-        // These do not change, but I want to group them together like this so it's easy to follow
-        int block = GetBlockSize();
-        int overlap = fKernelSize - 1;
-        int step = block - overlap;
-
-        KTINFO(convlog_hh, "Block size: " << block);
-        KTINFO(convlog_hh, "Overlap: " << overlap);
-        KTINFO(convlog_hh, "Step size: " << step);
-
-        int nBinsTotal = GetSpectrum( data, 0 )->GetNFrequencyBins();
-        KTINFO(convlog_hh, "nBinsTotal = " << nBinsTotal);
-
-        // Now that nBinsTotal is determined, we can initialize the DFTs
-        // The following conditional should only be true on the first slice
-        if( ! fInitialized )
+        // Now that the block size is determined, we can initialize the DFTs
+        // This only does any work on the first slice
+        if( ! Initialize( GetBlockSize() ) )
         {
-            Initialize( nBinsTotal, block, step, overlap );
+            KTERROR(convlog_hh, "Unable to initialize the convolution. Aborting.");
+            return false;
         }
 
-        // First loop over components
+        // The blocks of all of the components are transformed together
+        std::vector< const typename XSpectrumDataCore::spectrum_type* > inputs( data.GetNComponents() );
         for( unsigned iComponent = 0; iComponent < data.GetNComponents(); ++iComponent )
         {
-            KTINFO(convlog_hh, "Starting component: " << iComponent);
+            inputs[iComponent] = GetSpectrum( data, iComponent );
+        }
 
-            // Get power spectrum and initialize convolved spectrum for this component
-            typename XSpectrumDataCore::spectrum_type* transformedSpectrum = DoConvolution( GetSpectrum( data, iComponent ), block, step, overlap );
+        std::vector< typename XSpectrumDataCore::spectrum_type* > outputs;
+        DoConvolution( inputs, outputs );
 
-            if( transformedSpectrum == nullptr )
+        for( unsigned iComponent = 0; iComponent < data.GetNComponents(); ++iComponent )
+        {
+            if( outputs[iComponent] == nullptr )
             {
                 KTERROR( convlog_hh, "Convolution was unsuccessful. Aborting." );
+                for( unsigned iOutput = iComponent; iOutput < outputs.size(); ++iOutput ) delete outputs[iOutput];
                 return false;
             }
 
             // Set power spectrum
-            newData.SetSpectrum( transformedSpectrum, iComponent );
-            KTDEBUG(convlog_hh, "Filled new spectrum");
+            newData.SetSpectrum( outputs[iComponent], iComponent );
         }
 
-        KTINFO(convlog_hh, "All components finished successfully!");
+        KTDEBUG(convlog_hh, "All components finished successfully!");
 
         return true;
     }
 
     template< class XSpectraType >
-    XSpectraType* KTConvolution1D::DoConvolution( const XSpectraType* myInitialSpectrum, const int block, const int step, const int overlap )
+    XSpectraType* KTConvolution1D::DoConvolution( const XSpectraType* initialSpectrum )
     {
-        int nBinsTotal = myInitialSpectrum->GetNFrequencyBins();
-
-        // non-const version
-        XSpectraType* initialSpectrum = new XSpectraType( *myInitialSpectrum );
-
-        // If we're doing cross-correlation, first we need to conjugate and reverse the input spectrum
-        if( fTransformType == "cross-correlation" )
-        {
-            ConjugateAndReverse( *initialSpectrum );
-        }
-
-        XSpectraType* transformedSpectrum = new XSpectraType( nBinsTotal, initialSpectrum->GetRangeMin(), initialSpectrum->GetRangeMax() );
+        std::vector< const XSpectraType* > inputs( 1, initialSpectrum );
+        std::vector< XSpectraType* > outputs;
+        DoConvolution( inputs, outputs );
+        return outputs[0];
+    }
 
-        if( ! SetUpGeneralVars< XSpectraType* >() )
-        {
-            KTERROR(convlog_hh, "Spectrum type unknown. Returning blank spectrum");
-            return transformedSpectrum;
-        }
+    template< class XSpectraType >
+    void KTConvolution1D::DoConvolution( const std::vector< const XSpectraType* >& inputs, std::vector< XSpectraType* >& outputs )
+    {
+        outputs.assign( inputs.size(), nullptr );
+        fQueue.clear();
 
-        // Loop over block numbers
-        int blockNumber = 0;
-        int position = 0;
-        while( (blockNumber+1) * step <= nBinsTotal )
+        bool success = true;
+        for( unsigned iSpectrum = 0; iSpectrum < inputs.size(); ++iSpectrum )
         {
-            KTDEBUG(convlog_hh, "Block number: " << blockNumber);
-            KTDEBUG(convlog_hh, "Starting position: " << blockNumber * step - overlap);
-            KTDEBUG(convlog_hh, "nBinsTotal: " << nBinsTotal);
-
-            // Fill input array
-            for( int nBin = 0; nBin < block; ++nBin )
-            {
-                position = nBin + blockNumber * step - overlap;
-                SetInputArray( position, nBin, initialSpectrum );
-            }
+            const XSpectraType* input = inputs[iSpectrum];
+            if( input == nullptr ) continue;
 
-            // FFT of input block
-            KTDEBUG(convlog_hh, "Performing DFT");
-            fftw_execute( fGeneralForwardPlan );
+            int nBinsTotal = input->GetNFrequencyBins();
+            outputs[iSpectrum] = new XSpectraType( nBinsTotal, input->GetRangeMin(), input->GetRangeMax() );
 
-            // Bin multiplication in fourier space
-            KTDEBUG(convlog_hh, "Multiplying arrays in fourier space");
+            StageSpectrum( *input );
 
-            for( int nBin = 0; nBin < nBinLimitRegular; ++nBin )
+            // Queue the blocks; each one is copied out of the staged spectrum, so the next spectrum can be staged before the batch is done
+            for( int firstBin = 0; firstBin < nBinsTotal; firstBin += fStep )
             {
-                fGeneralTransformedOutputArray[nBin][0] = fGeneralTransformedInputArray[nBin][0] * fGeneralTransformedKernelArray[nBin][0] - fGeneralTransformedInputArray[nBin][1] * fGeneralTransformedKernelArray[nBin][1];
-                fGeneralTransformedOutputArray[nBin][1] = fGeneralTransformedInputArray[nBin][0] * fGeneralTransformedKernelArray[nBin][1] + fGeneralTransformedInputArray[nBin][1] * fGeneralTransformedKernelArray[nBin][0];
-            }
-
-            // Reverse FFT of output block
-            KTDEBUG(convlog_hh, "Performing reverse DFT");
-            fftw_execute( fGeneralReversePlan );
+                LoadBlock( input, firstBin, fQueue.size() );
+                QueuedBlock queued = { iSpectrum, firstBin };
+                fQueue.push_back( queued );
 
-            // Loop over bins in the output block and fill the convolved spectrum
-            for( int nBin = overlap; nBin < block; ++nBin )
-            {
-                SetOutputArray( nBin - overlap + blockNumber * step, nBin, *transformedSpectrum, block );
+                if( fQueue.size() == GetMaxBatchBlocks() ) success = FlushBlocks( outputs ) && success;
             }
-
-            // Increment block number
-            ++blockNumber;
         }
+        if( ! fQueue.empty() ) success = FlushBlocks( outputs ) && success;
 
-        if( blockNumber * step == nBinsTotal )
+        if( ! success )
         {
-            KTINFO(convlog_hh, "Reached end of input data");
-            return transformedSpectrum;
-        }
-
-        KTINFO(convlog_hh, "Reached final block");
-        KTINFO(convlog_hh, "Starting position: " << blockNumber * step - overlap);
-
-        // Same procedure as above, this time with a shorter final block
-
-#ifndef NDEBUG
-        int lastNBin = 0;
-#endif
-        for( int nBin = 0; position+1 < nBinsTotal; ++nBin )
-        {
-            position = nBin + blockNumber * step - overlap;
-            SetInputArray( position, nBin, initialSpectrum );
-#ifndef NDEBUG
-            lastNBin = nBin;
-#endif
+            for( unsigned iSpectrum = 0; iSpectrum < outputs.size(); ++iSpectrum )
+            {
+                delete outputs[iSpectrum];
+                outputs[iSpectrum] = nullptr;
+            }
         }
 
-        KTDEBUG(convlog_hh, "Short array length = " << lastNBin);
-        KTDEBUG(convlog_hh, "Initialized short array length = " << fShortSize);
-
-        // FFT of input block
-        fftw_execute( fGeneralForwardPlanShort );
-
-        for( int nBin = 0; nBin < nBinLimitShort; ++nBin )
-        {
-            fGeneralTransformedOutputArray[nBin][0] = fGeneralTransformedInputArray[nBin][0] * fGeneralTransformedKernelArray[nBin][0] - fGeneralTransformedInputArray[nBin][1] * fGeneralTransformedKernelArray[nBin][1];
-            fGeneralTransformedOutputArray[nBin][1] = fGeneralTransformedInputArray[nBin][0] * fGeneralTransformedKernelArray[nBin][1] + fGeneralTransformedInputArray[nBin][1] * fGeneralTransformedKernelArray[nBin][0];
-        }
+        return;
+    }
 
-        // Reverse FFT of output block
-        fftw_execute( fGeneralReversePlanShort );
+    template< class XSpectraType >
+    bool KTConvolution1D::FlushBlocks( std::vector< XSpectraType* >& outputs )
+    {
+        KTDEBUG(convlog_hh, "Convolving a batch of " << fQueue.size() << " blocks");
 
-        // Loop over bins in the output block and fill the convolved spectrum
-        for( int nBin = overlap; nBin < fShortSize; ++nBin )
+        bool success = ConvolveBlocks( static_cast< const XSpectraType* >(nullptr), fQueue.size() );
+        if( success )
         {
-            SetOutputArray( nBin - overlap + blockNumber * step, nBin, *transformedSpectrum, fShortSize );
+            for( unsigned iSlot = 0; iSlot < fQueue.size(); ++iSlot )
+            {
+                StoreBlock( iSlot, fQueue[iSlot].fFirstBin, *outputs[fQueue[iSlot].fOutput] );
+            }
         }
 
-        KTINFO(convlog_hh, "Component finished!");
-
-        return transformedSpectrum;
+        fQueue.clear();
+        return success;
     }
 
     inline const KTPowerSpectrum* KTConvolution1D::GetSpectrum( KTPowerSpectrumDataCore& data, unsigned iComponent )
@@ -28,6 +28,7 @@ namespace Katydid
     KTCorrelator::KTCorrelator(const std::string& name) :
             KTProcessor(name),
             fPairs(),
+            fThreadPool(1),
             fCorrSignal("correlation", this),
             fFSPolarSlot("fs-polar", this, &KTCorrelator::Correlate, &fCorrSignal),
             fFSFFTWSlot("fs-fftw", this, &KTCorrelator::Correlate, &fCorrSignal),
@@ -58,6 +59,8 @@ namespace Katydid
             }
         }
 
+        SetNPairThreads(node->get_value< unsigned >("n-pair-threads", GetNPairThreads()));
+
         return true;
     }
 
@@ -87,51 +90,47 @@ namespace Katydid
 
     bool KTCorrelator::CoreCorrelate(KTFrequencySpectrumDataPolarCore& data, KTCorrelationData& newData)
     {
-        unsigned iPair = 0;
-        for (PairVector::const_iterator iter = fPairs.begin(); iter != fPairs.end(); ++iter)
+        // each pair is an independent task; the results are stored in pair order afterwards
+        vector< KTFrequencySpectrumPolar* > results(fPairs.size(), NULL);
+        fThreadPool.ParallelFor(fPairs.size(), [&](unsigned iPair, unsigned)
         {
-            unsigned firstChannel = (*iter).first;
-            unsigned secondChannel = (*iter).second;
-            KTFrequencySpectrumPolar* result = DoCorrelation(data.GetSpectrumPolar(firstChannel), data.GetSpectrumPolar(secondChannel));
-            if (result == NULL)
-            {
-                KTWARN(corrlog, "Something went wrong with the correlation of channels " << firstChannel << " and " << secondChannel);
-            }
-            else
-            {
-                newData.SetSpectrum(result, iPair);
-                newData.SetInputPair(firstChannel, secondChannel, iPair);
-            }
-            iPair++;
-        }
+            results[iPair] = DoCorrelation(data.GetSpectrumPolar(fPairs[iPair].first), data.GetSpectrumPolar(fPairs[iPair].second));
+        });
 
-        KTINFO(corrlog, "Correlations complete; " << iPair << " channel-pairs correlated.");
-        return true;
+        return StoreCorrelations(results, newData);
     }
 
     bool KTCorrelator::CoreCorrelate(KTFrequencySpectrumDataFFTWCore& data, KTCorrelationData& newData)
     {
-        unsigned iPair = 0;
-        for (PairVector::const_iterator iter = fPairs.begin(); iter != fPairs.end(); ++iter)
+        // each pair is an independent task; the results are stored in pair order afterwards
+        vector< KTFrequencySpectrumPolar* > results(fPairs.size(), NULL);
+        fThreadPool.ParallelFor(fPairs.size(), [&](unsigned iPair, unsigned)
+        {
+            results[iPair] = DoCorrelation(data.GetSpectrumFFTW(fPairs[iPair].first), data.GetSpectrumFFTW(fPairs[iPair].second));
+        });
+
+        return StoreCorrelations(results, newData);
+    }
+
+    bool KTCorrelator::StoreCorrelations(vector< KTFrequencySpectrumPolar* >& results, KTCorrelationData& newData)
+    {
+        for (unsigned iPair = 0; iPair < fPairs.size(); ++iPair)
         {
-            unsigned firstChannel = (*iter).first;
-            unsigned secondChannel = (*iter).second;
-            KTFrequencySpectrumPolar* result = DoCorrelation(data.GetSpectrumFFTW(firstChannel), data.GetSpectrumFFTW(secondChannel));
-            if (result == NULL)
+            unsigned firstChannel = fPairs[iPair].first;
+            unsigned secondChannel = fPairs[iPair].second;
+            if (results[iPair] == NULL)
             {
                 KTWARN(corrlog, "Something went wrong with the correlation of channels " << firstChannel << " and " << secondChannel);
             }
             else
             {
-                newData.SetSpectrum(result, iPair);
+                newData.SetSpectrum(results[iPair], iPair);
                 newData.SetInputPair(firstChannel, secondChannel, iPair);
             }
-            iPair++;
         }
 
-        KTINFO(corrlog, "Correlations complete; " << iPair << " channel-pairs correlated.");
+        KTINFO(corrlog, "Correlations complete; " << fPairs.size() << " channel-pairs correlated.");
         return true;
-
     }
 
     KTFrequencySpectrumPolar* KTCorrelator::DoCorrelation(const KTFrequencySpectrumPolar* firstSpectrum, const KTFrequencySpectrumPolar* secondSpectrum)
@@ -13,6 +13,7 @@
 #include "KTProcessor.hh"
 
 #include "KTSlot.hh"
+#include "KTThreadPool.hh"
 
 #include <utility>
 #include <vector>
@@ -40,6 +41,8 @@ namespace Katydid
      Available configuration values:
      - "corr-pairs": array of arrays -- channel pairs to be correlated
                                         e.g.: "corr-pairs": [ [0, 1], [1, 0], [1, 1] ]
+     - "n-pair-threads": unsigned -- number of threads over which the channel pairs are shared out (default: 1, i.e. the pairs are correlated in order on the calling thread);
+                                     the output components are always in the order of the pairs
 
       Slots:
      - "fs-polar": void (Nymph::KTDataPtr) -- Performs correlations between frequency spectrum components; Requires KTFrequencySpectrumDataPolar; Adds KTCorrelationData
@@ -67,9 +70,14 @@ namespace Katydid
             const PairVector& GetPairVector() const;
             void ClearPairs();
 
+            unsigned GetNPairThreads() const;
+            void SetNPairThreads(unsigned nThreads);
+
         private:
             PairVector fPairs;
 
+            KTThreadPool fThreadPool;
+
         public:
 
             bool Correlate(KTFrequencySpectrumDataPolar& data);
@@ -80,6 +88,8 @@ namespace Katydid
         private:
             bool CoreCorrelate(KTFrequencySpectrumDataPolarCore& data, KTCorrelationData& newData);
             bool CoreCorrelate(KTFrequencySpectrumDataFFTWCore& data, KTCorrelationData& newData);
+            /// Moves the per-pair results into the output data, in pair order
+            bool StoreCorrelations(std::vector< KTFrequencySpectrumPolar* >& results, KTCorrelationData& newData);
 
             KTFrequencySpectrumPolar* DoCorrelation(const KTFrequencySpectrumPolar* firstSpectrum, const KTFrequencySpectrumPolar* secondSpectrum);
             KTFrequencySpectrumPolar* DoCorrelation(const KTFrequencySpectrumFFTW* firstSpectrum, const KTFrequencySpectrumFFTW* secondSpectrum);
@@ -125,5 +135,16 @@ namespace Katydid
         return;
     }
 
+    inline unsigned KTCorrelator::GetNPairThreads() const
+    {
+        return fThreadPool.GetNThreads();
+    }
+
+    inline void KTCorrelator::SetNPairThreads(unsigned nThreads)
+    {
+        fThreadPool.SetNThreads(nThreads);
+        return;
+    }
+
 } /* namespace Katydid */
 #endif /* KTCORRELATOR_HH_ */
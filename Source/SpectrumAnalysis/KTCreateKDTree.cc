@@ -39,6 +39,7 @@ namespace Katydid
             fDataPtr(new Nymph::KTData()),
             fTreeData(fDataPtr->Of< KTKDTreeData >()),
             fSliceInWindowCount(0),
+            fFirstSliceKept(0),
             fInvScalingX(1.),
             fInvScalingY(1.),
             fHaveNewData(false),
@@ -138,15 +139,16 @@ namespace Katydid
         for (unsigned iComponent = 0; iComponent != nComponents; ++iComponent)
         {
             const KTDiscriminatedPoints1DData::SetOfPoints&  incomingPts = discPoints.GetSetOfPoints(iComponent);
-            for (KTDiscriminatedPoints1DData::SetOfPoints::const_iterator pIt = incomingPts.begin();
-                    pIt != incomingPts.end(); ++pIt)
+            unsigned nIncomingPts = incomingPts.size();
+            fTreeData.GetSetOfPoints(iComponent).reserve(fTreeData.GetSetOfPoints(iComponent).size() + nIncomingPts);
+            for (unsigned iPoint = 0; iPoint < nIncomingPts; ++iPoint)
             {
-                newPoint.fCoords[1] = fInvScalingY * pIt->second.fAbscissa;
-                newPoint.fAmplitude = pIt->second.fOrdinate;
-                newPoint.fBinInSlice = pIt->first;
-                newPoint.fMean = pIt->second.fMean;
-                newPoint.fVariance = pIt->second.fVariance;
-                newPoint.fNeighborhoodAmplitude = pIt->second.fNeighborhoodAmplitude;
+                newPoint.fCoords[1] = fInvScalingY * incomingPts.GetAbscissa(iPoint);
+                newPoint.fAmplitude = incomingPts.GetOrdinate(iPoint);
+                newPoint.fBinInSlice = incomingPts.GetBin(iPoint);
+                newPoint.fMean = incomingPts.GetMean(iPoint);
+                newPoint.fVariance = incomingPts.GetVariance(iPoint);
+                newPoint.fNeighborhoodAmplitude = incomingPts.GetNeighborhoodAmplitude(iPoint);
                 fTreeData.AddPoint(newPoint, iComponent);
             }
             KTDEBUG(kdlog, "Tree data (component " << iComponent << ") now has " << fTreeData.GetSetOfPoints(iComponent).size() << " points (Slice Number: " << newPoint.fSliceNumber << ")");
@@ -157,7 +159,8 @@ namespace Katydid
         // if fSliceInWindowCount == fWindowSize, then we need to move the window before taking the next slice
         if (fWindowSize != 0 && fSliceInWindowCount == fWindowSize)
         {
-            if (! MakeTree(true) || ! ClearTree(true, slHeader.GetSliceNumber() - fWindowOverlap + 1))
+            fFirstSliceKept = slHeader.GetSliceNumber() - fWindowOverlap + 1;
+            if (! MakeTree(true) || ! ClearTree(true, fFirstSliceKept))
             {
                 KTERROR(kdlog, "An error occurred while clustering or clearing the tree");
                 return false;
@@ -225,7 +228,14 @@ namespace Katydid
         unsigned nComponents = fTreeData.GetNComponents();
         for (unsigned iComponent = 0; iComponent != nComponents; ++iComponent)
         {
-            fTreeData.BuildIndex(fDistanceMethod, fMaxLeafSize, iComponent);
+            if (fWindowSize == 0)
+            {
+                fTreeData.BuildIndex(fDistanceMethod, fMaxLeafSize, iComponent);
+            }
+            else
+            {
+                IndexNewPoints(iComponent, willContinue);
+            }
         }
 
         // yet another exception to the separation of normal function and signals/slots; sorry
@@ -248,19 +258,17 @@ namespace Katydid
         {
             KTDEBUG(kdlog, "ClearTree(true)");
 
-            // clear data up to the
+            // clear data up to the first slice kept; the index blocks holding those points are retired with them
             unsigned nComponents = fTreeData.GetNComponents();
             for (unsigned iComponent = 0; iComponent != nComponents; ++iComponent)
             {
-                fTreeData.ClearIndex(iComponent);
-                KTKDTreeData::SetOfPoints& points = fTreeData.GetSetOfPoints(iComponent);
-                KTKDTreeData::SetOfPoints::iterator startErase = points.begin();
-                KTKDTreeData::SetOfPoints::iterator endErase = startErase;
-                while (endErase != points.end() && endErase->fSliceNumber < firstSliceKept)
+                const KTKDTreeData::SetOfPoints& points = fTreeData.GetSetOfPoints(iComponent);
+                size_t nToRemove = 0;
+                while (nToRemove != points.size() && points[nToRemove].fSliceNumber < firstSliceKept)
                 {
-                    ++endErase;
+                    ++nToRemove;
                 }
-                points.erase(startErase, endErase);
+                fTreeData.RemoveLeadingPoints(nToRemove, iComponent);
             }
         }
         else
@@ -278,6 +286,38 @@ namespace Katydid
         return true;
     }
 
+    void KTCreateKDTree::IndexNewPoints(unsigned component, bool willContinue)
+    {
+        fTreeData.SetDistanceMethod(fDistanceMethod, component);
+        fTreeData.SetMaxLeafSize(fMaxLeafSize, component);
+
+        const KTKDTreeData::SetOfPoints& points = fTreeData.GetSetOfPoints(component);
+        size_t blockStart = fTreeData.GetNIndexedPoints(component);
+
+        // if the window will move, split the new points where the window will be cleared: before fFirstSliceKept, and then every (size - overlap) slices
+        unsigned stride = fWindowSize > fWindowOverlap ? fWindowSize - fWindowOverlap : 0;
+        if (willContinue && stride != 0)
+        {
+            while (blockStart != points.size())
+            {
+                uint64_t blockSlice = points[blockStart].fSliceNumber;
+                uint64_t blockEndSlice = blockSlice < fFirstSliceKept ? fFirstSliceKept : fFirstSliceKept + ((blockSlice - fFirstSliceKept) / stride + 1) * stride;
+                size_t blockEnd = blockStart;
+                while (blockEnd != points.size() && points[blockEnd].fSliceNumber < blockEndSlice)
+                {
+                    ++blockEnd;
+                }
+                fTreeData.AddIndexBlock(blockEnd - blockStart, component);
+                blockStart = blockEnd;
+            }
+        }
+        else
+        {
+            fTreeData.AddIndexBlock(points.size() - blockStart, component);
+        }
+        return;
+    }
+
     void KTCreateKDTree::MakeTreeSlot()
     {
         if (! MakeTree(false))
@@ -33,6 +33,11 @@ namespace Katydid
      @brief Creates a KD-Tree
 
      @details
+     Points are added in order of slice number.  With "window-size" set, a tree is made every window-size slices, and the points
+     from slices before the overlap with the next window are then removed.
+     In that case the index is kept as a forest of k-d trees (see KTTreeIndexForest): the new points of each window are indexed
+     in blocks that line up with the slices that will be removed together as the window moves, so each block's tree is built once,
+     and is dropped as a unit when its slices leave the window.  Without windowing, the points are indexed as a single tree.
  
      Notes on setting the time and frequency radius:
      These can be set by the egg header using the "header" slot if they haven't been set already.
@@ -43,8 +48,8 @@ namespace Katydid
      Configuration name: "create-kd-tree"
 
      Available configuration values:
-     - "window-size": unsigned --
-     - "window-overlap": unsigned --
+     - "window-size": unsigned -- Number of slices in each tree; if 0 (the default), a tree is only made at the end of each acquisition
+     - "window-overlap": unsigned -- Number of slices shared by consecutive windows
      - "distance-method": string -- Method used to calculate distances between points; Available options are "manhattan" and "euclidean"
      - "max-leaf-size": unsigned -- Maximum number of points to assign to each leaf node of the k-d tree. Typically should be 10-50. See https://github.com/jlblancoc/nanoflann#21-kdtreesingleindexadaptorparamsleaf_max_size for more details.
      - "time-radius:" double -- Scaling applied to the time axis before adding the point to the tree. Scaled coordinate value = coordinate value / scaling. Using this will prevent it from being set by the egg header.
@@ -108,6 +113,7 @@ namespace Katydid
             KTKDTreeData& fTreeData;
 
             unsigned fSliceInWindowCount;
+            uint64_t fFirstSliceKept; // first slice that will be kept when the current window is cleared
 
             MEMBERVARIABLE(double, InvScalingX);
             MEMBERVARIABLE(double, InvScalingY);
@@ -135,6 +141,8 @@ namespace Katydid
 
             void MakeTreeSlot();
 
+            void IndexNewPoints(unsigned component, bool willContinue);
+
     };
 
     inline void KTCreateKDTree::SetTimeRadius(double radius, bool overrideSet)
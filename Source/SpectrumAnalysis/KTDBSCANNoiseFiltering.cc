@@ -26,6 +26,7 @@ namespace Katydid
             //fRadii(fNDimensions),
             fMinPoints(3),
             fRadius(1.),
+            fNThreads(1),
             fDataCount(0),
             fFilteringDoneSignal("kd-tree", this),
             fKDTreeSlot("kd-tree", this, &KTDBSCANNoiseFiltering::DoFiltering, &fFilteringDoneSignal)
@@ -42,6 +43,7 @@ namespace Katydid
 
         SetMinPoints(node->get_value("min-points", GetMinPoints()));
         SetRadius(node->get_value("radius", GetRadius()));
+        SetNThreads(node->get_value("n-threads", GetNThreads()));
 
         return true;
     }
@@ -73,6 +75,7 @@ namespace Katydid
         DBSCAN_KDTree dbscan;
         dbscan.SetRadius(fRadius);
         dbscan.SetMinPoints(fMinPoints);
+        dbscan.SetNThreads(fNThreads);
         KTINFO(dnflog, "DBSCAN configured");
 
         // do the clustering!
@@ -40,6 +40,7 @@ namespace Katydid
      Available configuration values:
      - "radius": double -- double used to define the circle around points to be clustered together
      - "min-points": unsigned int -- minimum number of points required to have a cluster
+     - "n-threads": unsigned int -- number of threads used by DBSCAN; the results are the same for any number of threads
 
      Slots:
      - "kd-tree": void (KTDataPtr) -- Performs clustering on a KDTree of data; Requires KTKDTreeData.
@@ -63,6 +64,7 @@ namespace Katydid
 
             MEMBERVARIABLE(unsigned, MinPoints);
             MEMBERVARIABLE(double, Radius);
+            MEMBERVARIABLE(unsigned, NThreads);
             MEMBERVARIABLE_NOSET(unsigned, DataCount);            
             //MEMBERVARIABLEREF(Point, Radii);
 
@@ -21,6 +21,7 @@ namespace Katydid
             fAccumulatorSize(10),
             fAveragingFrac(0.1),
             fSignalInterval(1),
+            fUseSlidingWindow(false),
             fDataMap(),
             fLastAccumulatorPtr(),
 
@@ -84,6 +85,7 @@ namespace Katydid
 
         SetAccumulatorSize(node->get_value<unsigned>("number-to-average", fAccumulatorSize));
         SetSignalInterval(node->get_value<unsigned>("signal-interval", fSignalInterval));
+        SetUseSlidingWindow(node->get_value<bool>("sliding-window", fUseSlidingWindow));
 
         return true;
     }
@@ -365,6 +367,31 @@ namespace Katydid
             return false;
         }
 
+        if (UseSlidingWindow())
+        {
+            PrepareSlidingWindows(accDataStruct, nComponents, arraySize, 2);
+            // the window works with (real, imaginary) pairs
+            std::vector< double > newValues(2 * arraySize);
+            std::vector< double > mean(2 * arraySize);
+            for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+            {
+                KTFrequencySpectrumPolar* newSpect = data.GetSpectrumPolar(iComponent);
+                KTFrequencySpectrumPolar* avSpect = accData.GetSpectrumPolar(iComponent);
+                KTFrequencySpectrumVariance* varSpect = devData.GetSpectrum(iComponent);
+                for (unsigned iBin = 0; iBin < arraySize; ++iBin)
+                {
+                    newValues[2 * iBin] = real((*newSpect)(iBin));
+                    newValues[2 * iBin + 1] = imag((*newSpect)(iBin));
+                }
+                accDataStruct.fWindows[iComponent].Add(newValues.data(), mean.data(), varSpect->GetData());
+                for (unsigned iBin = 0; iBin < arraySize; ++iBin)
+                {
+                    (*avSpect)(iBin).set_rect(mean[2 * iBin], mean[2 * iBin + 1]);
+                }
+            }
+            return true;
+        }
+
         for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
         {
             KTFrequencySpectrumPolar* newSpect = data.GetSpectrumPolar(iComponent);
@@ -398,7 +425,8 @@ namespace Katydid
             {
                 KTFrequencySpectrumFFTW* dataFS = data.GetSpectrumFFTW(iComponent);
                 
-                KTFrequencySpectrumFFTW* newFS = new KTFrequencySpectrumFFTW(dataFS->size(), dataFS->GetRangeMin(), dataFS->GetRangeMax());
+                // the average is stored in the same order as the data, so its bin accessors have to know whether that order is flipped
+                KTFrequencySpectrumFFTW* newFS = new KTFrequencySpectrumFFTW(dataFS->size(), dataFS->GetRangeMin(), dataFS->GetRangeMax(), dataFS->GetIsArrayOrderFlipped());
                 KTFrequencySpectrumVariance* newVarFS = new KTFrequencySpectrumVariance(dataFS->size(), dataFS->GetRangeMin(), dataFS->GetRangeMax());
                 
                 newFS->SetNTimeBins(dataFS->GetNTimeBins());
@@ -435,6 +463,37 @@ namespace Katydid
             return false;
         }
 
+        if (UseSlidingWindow())
+        {
+            PrepareSlidingWindows(accDataStruct, nComponents, arraySize, 2);
+            // std::complex< double > is laid out as (real, imaginary), so the spectra are used in place, in storage order;
+            // the variance spectrum is in frequency order, so for a flipped (C2C) spectrum the means of the norms are reordered
+            std::vector< double > meanOfNorms;
+            for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+            {
+                KTFrequencySpectrumFFTW* newSpect = data.GetSpectrumFFTW(iComponent);
+                KTFrequencySpectrumFFTW* avSpect = accData.GetSpectrumFFTW(iComponent);
+                KTFrequencySpectrumVariance* varSpect = devData.GetSpectrum(iComponent);
+                const double* newValues = reinterpret_cast< const double* >(newSpect->GetData().data());
+                double* mean = reinterpret_cast< double* >(avSpect->GetData().data());
+                if (! newSpect->GetIsArrayOrderFlipped())
+                {
+                    accDataStruct.fWindows[iComponent].Add(newValues, mean, varSpect->GetData());
+                    continue;
+                }
+
+                meanOfNorms.resize(arraySize);
+                accDataStruct.fWindows[iComponent].Add(newValues, mean, meanOfNorms.data());
+                unsigned centerBin = newSpect->GetCenterBin();
+                unsigned leftOfCenterOffset = newSpect->GetLeftOfCenterOffset();
+                for (unsigned iBin = 0; iBin < arraySize; ++iBin)
+                {
+                    (*varSpect)(iBin) = meanOfNorms[iBin >= centerBin ? iBin - centerBin : iBin + leftOfCenterOffset];
+                }
+            }
+            return true;
+        }
+
         for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
         {
             KTFrequencySpectrumFFTW* newSpect = data.GetSpectrumFFTW(iComponent);
@@ -512,6 +571,20 @@ namespace Katydid
             return false;
         }
 
+        if (UseSlidingWindow())
+        {
+            PrepareSlidingWindows(accDataStruct, nComponents, arraySize, 1);
+            for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+            {
+                KTPowerSpectrum* newSpect = data.GetSpectrum(iComponent);
+                KTPowerSpectrum* avSpect = accData.GetSpectrum(iComponent);
+                KTFrequencySpectrumVariance* varSpect = devData.GetSpectrum(iComponent);
+                avSpect->SetMode(newSpect->GetMode());
+                accDataStruct.fWindows[iComponent].Add(newSpect->GetData(), avSpect->GetData(), varSpect->GetData());
+            }
+            return true;
+        }
+
         for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
         {
             KTPowerSpectrum* newSpect = data.GetSpectrum(iComponent);
@@ -531,6 +604,26 @@ namespace Katydid
     }
 
 
+    void KTDataAccumulator::PrepareSlidingWindows(Accumulator& accDataStruct, unsigned nComponents, size_t nBins, unsigned valuesPerBin) const
+    {
+        if (accDataStruct.fWindows.size() == nComponents && nComponents != 0 &&
+                accDataStruct.fWindows[0].GetWindowSize() == fAccumulatorSize &&
+                accDataStruct.fWindows[0].GetNBins() == nBins &&
+                accDataStruct.fWindows[0].GetValuesPerBin() == valuesPerBin)
+        {
+            return;
+        }
+
+        KTDEBUG(avlog, "Creating sliding windows of " << fAccumulatorSize << " spectra for " << nComponents << " components with " << nBins << " bins");
+        accDataStruct.fWindows.resize(nComponents);
+        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+        {
+            accDataStruct.fWindows[iComponent].Initialize(fAccumulatorSize, nBins, valuesPerBin);
+        }
+        return;
+    }
+
+
     bool KTDataAccumulator::AccumulatorType< KTTimeSeriesData >::Finalize()
     {
         double scale = fAccumulatorSize == 0 ? 1. / (double)(fSliceHeader.GetSliceNumber()) : 1.;
@@ -15,6 +15,7 @@
 #include "KTLogger.hh"
 #include "KTSlot.hh"
 #include "KTSliceHeader.hh"
+#include "KTSlidingWindowStats.hh"
 
 #include "KTConvolvedSpectrumData.hh"
 #include "KTFrequencySpectrumDataFFTW.hh"
@@ -30,6 +31,7 @@
 
 #include <map>
 #include <typeinfo>
+#include <vector>
 
 namespace Katydid
 {
@@ -54,6 +56,12 @@ namespace Katydid
      Note that this method of calculating A_i gives an effective average of S slices:  
      At slice i, the amount removed from the previous sum is (1 / S) * A_(i-1) instead of (1 / S) * D_(i-N).
      The effective average will be closest to the true average for large N.
+
+     Alternatively, with the "sliding-window" option, the spectrum slots (fs-polar, fs-fftw, ps, and their conv- versions)
+     keep the last S spectra, and A_i is the exact average of those spectra (or of all of them, while fewer than S have been received).
+     The running sums of the values and of their squares are updated by adding the new spectrum and subtracting the one that
+     leaves the window, with the mean and variance accumulators updated in the same vectorized pass (see KTSlidingWindowStats).
+     This costs S spectra of memory per component.  The time-series slots always use the exponential update.
      
      The signal interval is how often the output signal will be emitted.  
      If the signal interval is 0, there will be no slice signals.
@@ -72,6 +80,7 @@ namespace Katydid
      Available configuration options:
      - "number-to-average": unsigned -- Number of slices to average; 0 will sum all slices together, and average at the end
      - "signal-interval": unsigned -- Number of slices between signaling; set to 0 to stop slice signals
+     - "sliding-window": bool -- Use the exact average of the last number-to-average spectra instead of the exponential update; has no effect if number-to-average is 0; default: false
 
      Slots:
      - "ts": void (Nymph::KTDataPtr) -- add to the ts sum; Requires KTTimeSeriesData; Emits signal "ts"
@@ -120,9 +129,10 @@ namespace Katydid
                 Nymph::KTDataPtr fData;
                 KTSliceHeader& fSliceHeader;
                 unsigned fAccumulatorSize;
+                std::vector< KTSlidingWindowStats > fWindows; // one per component; only used in sliding-window mode
 
                 void IncrementSlice();
-                Accumulator() : fData(new Nymph::KTData()), fSliceHeader(fData->Of<KTSliceHeader>()), fAccumulatorSize(0) {}
+                Accumulator() : fData(new Nymph::KTData()), fSliceHeader(fData->Of<KTSliceHeader>()), fAccumulatorSize(0), fWindows() {}
                 virtual ~Accumulator() {}
 
                 unsigned GetSliceNumber() const
@@ -180,10 +190,14 @@ namespace Katydid
             unsigned GetSignalInterval() const;
             void SetSignalInterval(unsigned interval);
 
+            bool GetUseSlidingWindow() const;
+            void SetUseSlidingWindow(bool flag);
+
         private:
             unsigned fAccumulatorSize;
             double fAveragingFrac;
             unsigned fSignalInterval;
+            bool fUseSlidingWindow;
 
         public:
             bool AddData(KTTimeSeriesData& data);
@@ -205,6 +219,10 @@ namespace Katydid
             template< class XDataType >
             Accumulator& GetOrCreateAccumulator();
 
+            bool UseSlidingWindow() const;
+            /// Makes sure that there's a sliding window of the right dimensions for each component
+            void PrepareSlidingWindows(Accumulator& accDataStruct, unsigned nComponents, size_t nBins, unsigned valuesPerBin) const;
+
             bool CoreAddTSDataReal(KTTimeSeriesData& data, Accumulator& accDataStruct, KTTimeSeriesData& accData);
             bool CoreAddTSDataFFTW(KTTimeSeriesData& data, Accumulator& accDataStruct, KTTimeSeriesData& accData);
 
@@ -384,6 +402,22 @@ namespace Katydid
         return;
     }
 
+    inline bool KTDataAccumulator::GetUseSlidingWindow() const
+    {
+        return fUseSlidingWindow;
+    }
+
+    inline void KTDataAccumulator::SetUseSlidingWindow(bool flag)
+    {
+        fUseSlidingWindow = flag;
+        return;
+    }
+
+    inline bool KTDataAccumulator::UseSlidingWindow() const
+    {
+        return fUseSlidingWindow && fAccumulatorSize != 0;
+    }
+
     inline const KTDataAccumulator::AccumulatorMap& KTDataAccumulator::GetAccumulators() const
     {
         return fDataMap;
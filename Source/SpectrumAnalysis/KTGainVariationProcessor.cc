@@ -11,6 +11,7 @@
 #include "KTCorrelationData.hh"
 #include "KTFrequencySpectrumDataPolar.hh"
 #include "KTFrequencySpectrumDataFFTW.hh"
+#include "KTFrequencySpectrumVarianceData.hh"
 #include "KTGainVariationData.hh"
 #include "KTPowerSpectrumData.hh"
 #include "KTSpline.hh"
@@ -45,6 +46,13 @@ namespace Katydid
             fCalculateMinBin(true),
             fCalculateMaxBin(true),
             fVarianceCalcNBins(100),
+            fStreaming(false),
+            fStreamingWeight(0.1),
+            fDriftTolerance(0.01),
+            fXVals(),
+            fYVals(),
+            fMeanStreams(),
+            fVarianceStreams(),
             fGainVarSignal("gain-var", this),
             //fFSPolarSlot("fs-polar", this, &KTGainVariationProcessor::CalculateGainVariation, &fGainVarSignal),
             //fFSFFTWSlot("fs-fftw", this, &KTGainVariationProcessor::CalculateGainVariation, &fGainVarSignal),
@@ -97,6 +105,15 @@ namespace Katydid
         SetNFitPoints(node->get_value< unsigned >("fit-points", fNFitPoints));
         SetVarianceCalcNBins(node->get_value< unsigned >("variance-n-bins", fVarianceCalcNBins));
 
+        SetStreaming(node->get_value< bool >("streaming", fStreaming));
+        SetStreamingWeight(node->get_value< double >("streaming-weight", fStreamingWeight));
+        if (fStreamingWeight <= 0. || fStreamingWeight > 1.)
+        {
+            KTERROR(gvlog, "Streaming weight must be in (0, 1]; it was set to " << fStreamingWeight);
+            return false;
+        }
+        SetDriftTolerance(node->get_value< double >("drift-tolerance", fDriftTolerance));
+
         return true;
     }
 
@@ -327,6 +344,116 @@ namespace Katydid
         return true;
     }
 
+    namespace
+    {
+        // Value of a bin used for the fit points; the modulus for complex spectra
+        double GetFitValue(const KTFrequencySpectrumPolar* spectrum, unsigned iBin)
+        {
+            return (*spectrum)(iBin).abs();
+        }
+
+        double GetFitValue(const KTFrequencySpectrumFFTW* spectrum, unsigned iBin)
+        {
+            return spectrum->GetAbs(iBin);
+        }
+
+        double GetFitValue(const KTPowerSpectrum* spectrum, unsigned iBin)
+        {
+            return (*spectrum)(iBin);
+        }
+
+        double GetFitValue(const KTFrequencySpectrumVariance* spectrum, unsigned iBin)
+        {
+            return (*spectrum)(iBin);
+        }
+    }
+
+    template< class XSpectrum >
+    void KTGainVariationProcessor::CalculateFitPoints(const XSpectrum* spectrum, unsigned nBinsPerFitPoint)
+    {
+        fXVals.resize(fNFitPoints);
+        fYVals.resize(fNFitPoints);
+
+        for (unsigned iFitPoint=0; iFitPoint < fNFitPoints; ++iFitPoint)
+        {
+            unsigned fitPointStartBin = iFitPoint * nBinsPerFitPoint + fMinBin;
+            unsigned fitPointEndBin = fitPointStartBin + nBinsPerFitPoint;
+
+            double leftEdge = spectrum->GetBinLowEdge(fitPointStartBin);
+            double rightEdge = spectrum->GetBinLowEdge(fitPointEndBin);
+            fXVals[iFitPoint] = leftEdge + 0.5 * (rightEdge - leftEdge);
+
+            double mean = 0.;
+            for (unsigned iBin=fitPointStartBin; iBin<fitPointEndBin; ++iBin)
+            {
+                mean += GetFitValue(spectrum, iBin);
+            }
+            mean /= (double)nBinsPerFitPoint;
+            fYVals[iFitPoint] = mean;
+
+            KTDEBUG(gvlog, "Fit point " << iFitPoint << "  " << fXVals[iFitPoint] << "  " << fYVals[iFitPoint]);
+        }
+        return;
+    }
+
+    std::shared_ptr< KTSpline > KTGainVariationProcessor::MakeSpline(std::vector< FitPointStream >& streams, unsigned component)
+    {
+        if (! fStreaming) return CreateSpline(fXVals, fYVals);
+
+        if (component >= streams.size()) streams.resize(component + 1);
+        FitPointStream& stream = streams[component];
+
+        if (! stream.fSpline || stream.fXVals != fXVals)
+        {
+            // first slice, or the fit points have moved: start over
+            KTDEBUG(gvlog, "Starting running fit points for component " << component);
+            stream.fXVals = fXVals;
+            stream.fRunningYVals = fYVals;
+        }
+        else
+        {
+            for (unsigned iFitPoint = 0; iFitPoint < fNFitPoints; ++iFitPoint)
+            {
+                stream.fRunningYVals[iFitPoint] += fStreamingWeight * (fYVals[iFitPoint] - stream.fRunningYVals[iFitPoint]);
+            }
+
+            bool drifted = false;
+            for (unsigned iFitPoint = 0; iFitPoint < fNFitPoints && ! drifted; ++iFitPoint)
+            {
+                drifted = fabs(stream.fRunningYVals[iFitPoint] - stream.fSplineYVals[iFitPoint]) > fDriftTolerance * fabs(stream.fSplineYVals[iFitPoint]);
+            }
+            if (! drifted) return stream.fSpline;
+
+            KTDEBUG(gvlog, "Background for component " << component << " has drifted; refitting");
+        }
+
+        stream.fSplineYVals = stream.fRunningYVals;
+        stream.fSpline = CreateSpline(stream.fXVals, stream.fRunningYVals);
+        return stream.fSpline;
+    }
+
+    std::shared_ptr< KTSpline > KTGainVariationProcessor::CreateSpline(const std::vector< double >& xVals, std::vector< double > yVals) const
+    {
+        if (fNormalize)
+        {
+            // Normalize the fit points to 1
+            double minYVal = yVals[0];
+            for (unsigned iFitPoint=1; iFitPoint < yVals.size(); ++iFitPoint)
+            {
+                if (yVals[iFitPoint] < minYVal) minYVal = yVals[iFitPoint];
+            }
+            for (unsigned iFitPoint=0; iFitPoint < yVals.size(); ++iFitPoint)
+            {
+                yVals[iFitPoint] = yVals[iFitPoint] / minYVal;
+            }
+        }
+
+        std::shared_ptr< KTSpline > spline = std::make_shared< KTSpline >(xVals.data(), yVals.data(), unsigned(xVals.size()));
+        spline->SetXMin(fMinFrequency);
+        spline->SetXMax(fMaxFrequency);
+        return spline;
+    }
+
     bool KTGainVariationProcessor::CoreGainVarCalc(KTFrequencySpectrumDataPolarCore& data, KTGainVariationData& newData)
     {
         if (fCalculateMinBin)
@@ -359,53 +486,8 @@ namespace Katydid
         {
             const KTFrequencySpectrumPolar* spectrum = data.GetSpectrumPolar(iComponent);
 
-            double* xVals = new double[fNFitPoints];
-            double* yVals = new double[fNFitPoints];
-
-            // Calculate fit points
-#pragma omp parallel for default(shared)
-            for (unsigned iFitPoint=0; iFitPoint < fNFitPoints; ++iFitPoint)
-            {
-                unsigned fitPointStartBin = iFitPoint * nBinsPerFitPoint + fMinBin;
-                unsigned fitPointEndBin = fitPointStartBin + nBinsPerFitPoint;
-
-                double leftEdge = spectrum->GetBinLowEdge(fitPointStartBin);
-                double rightEdge = spectrum->GetBinLowEdge(fitPointEndBin);
-                xVals[iFitPoint] = leftEdge + 0.5 * (rightEdge - leftEdge);
-
-                double mean = 0.;
-                for (unsigned iBin=fitPointStartBin; iBin<fitPointEndBin; ++iBin)
-                {
-                    mean += (*spectrum)(iBin).abs();
-                }
-                mean /= (double)nBinsPerFitPoint;
-                yVals[iFitPoint] = mean;
-
-                KTDEBUG(gvlog, "Fit point " << iFitPoint << "  " << xVals[iFitPoint] << "  " << yVals[iFitPoint]);
-            }
-
-            if (fNormalize)
-            {
-                // Normalize the fit points to 1
-                double minYVal = yVals[0];
-                for (unsigned iFitPoint=1; iFitPoint < fNFitPoints; ++iFitPoint)
-                {
-                    if (yVals[iFitPoint] < minYVal) minYVal = yVals[iFitPoint];
-                }
-                for (unsigned iFitPoint=0; iFitPoint < fNFitPoints; ++iFitPoint)
-                {
-                    yVals[iFitPoint] = yVals[iFitPoint] / minYVal;
-                }
-            }
-
-            KTSpline* spline = new KTSpline(xVals, yVals, fNFitPoints);
-            spline->SetXMin(fMinFrequency);
-            spline->SetXMax(fMaxFrequency);
-
-            delete [] xVals;
-            delete [] yVals;
-
-            newData.SetSpline(spline, iComponent);
+            CalculateFitPoints(spectrum, nBinsPerFitPoint);
+            newData.SetSpline(MakeSpline(fMeanStreams, iComponent), iComponent);
         }
         KTINFO(gvlog, "Completed gain variation calculation for " << nComponents);
 
@@ -445,53 +527,8 @@ namespace Katydid
         {
             const KTFrequencySpectrumFFTW* spectrum = data.GetSpectrumFFTW(iComponent);
 
-            double* xVals = new double[fNFitPoints];
-            double* yVals = new double[fNFitPoints];
-
-            // Calculate fit points
-#pragma omp parallel for default(shared)
-            for (unsigned iFitPoint=0; iFitPoint < fNFitPoints; ++iFitPoint)
-            {
-                unsigned fitPointStartBin = iFitPoint * nBinsPerFitPoint + fMinBin;
-                unsigned fitPointEndBin = fitPointStartBin + nBinsPerFitPoint;
-
-                double leftEdge = spectrum->GetBinLowEdge(fitPointStartBin);
-                double rightEdge = spectrum->GetBinLowEdge(fitPointEndBin);
-                xVals[iFitPoint] = leftEdge + 0.5 * (rightEdge - leftEdge);
-
-                double mean = 0.;
-                for (unsigned iBin=fitPointStartBin; iBin<fitPointEndBin; ++iBin)
-                {
-                    mean += spectrum->GetAbs(iBin);
-                }
-                mean /= (double)nBinsPerFitPoint;
-                yVals[iFitPoint] = mean;
-
-                KTDEBUG(gvlog, "Fit point " << iFitPoint << "  " << xVals[iFitPoint] << "  " << yVals[iFitPoint]);
-            }
-
-            // Normalize the fit points to 1
-            if (fNormalize)
-            {
-                double minYVal = yVals[0];
-                for (unsigned iFitPoint=1; iFitPoint < fNFitPoints; ++iFitPoint)
-                {
-                    if (yVals[iFitPoint] < minYVal) minYVal = yVals[iFitPoint];
-                }
-                for (unsigned iFitPoint=0; iFitPoint < fNFitPoints; ++iFitPoint)
-                {
-                    yVals[iFitPoint] = yVals[iFitPoint] / minYVal;
-                }
-            }
-
-            KTSpline* spline = new KTSpline(xVals, yVals, fNFitPoints);
-            spline->SetXMin(fMinFrequency);
-            spline->SetXMax(fMaxFrequency);
-
-            delete [] xVals;
-            delete [] yVals;
-
-            newData.SetSpline(spline, iComponent);
+            CalculateFitPoints(spectrum, nBinsPerFitPoint);
+            newData.SetSpline(MakeSpline(fMeanStreams, iComponent), iComponent);
         }
         KTINFO(gvlog, "Completed gain variation calculation for " << nComponents);
 
@@ -530,53 +567,8 @@ namespace Katydid
         {
             const KTPowerSpectrum* spectrum = data.GetSpectrum(iComponent);
 
-            double* xVals = new double[fNFitPoints];
-            double* yVals = new double[fNFitPoints];
-
-            // Calculate fit points
-#pragma omp parallel for default(shared)
-            for (unsigned iFitPoint=0; iFitPoint < fNFitPoints; ++iFitPoint)
-            {
-                unsigned fitPointStartBin = iFitPoint * nBinsPerFitPoint + fMinBin;
-                unsigned fitPointEndBin = fitPointStartBin + nBinsPerFitPoint;
-
-                double leftEdge = spectrum->GetBinLowEdge(fitPointStartBin);
-                double rightEdge = spectrum->GetBinLowEdge(fitPointEndBin);
-                xVals[iFitPoint] = leftEdge + 0.5 * (rightEdge - leftEdge);
-
-                double mean = 0.;
-                for (unsigned iBin=fitPointStartBin; iBin<fitPointEndBin; ++iBin)
-                {
-                    mean += (*spectrum)(iBin);
-                }
-                mean /= (double)nBinsPerFitPoint;
-                yVals[iFitPoint] = mean;
-
-                KTDEBUG(gvlog, "Fit point " << iFitPoint << "  " << xVals[iFitPoint] << "  " << yVals[iFitPoint]);
-            }
-
-            if (fNormalize)
-            {
-                // Normalize the fit points to 1
-                double minYVal = yVals[0];
-                for (unsigned iFitPoint=1; iFitPoint < fNFitPoints; ++iFitPoint)
-                {
-                    if (yVals[iFitPoint] < minYVal) minYVal = yVals[iFitPoint];
-                }
-                for (unsigned iFitPoint=0; iFitPoint < fNFitPoints; ++iFitPoint)
-                {
-                    yVals[iFitPoint] = yVals[iFitPoint] / minYVal;
-                }
-            }
-
-            KTSpline* spline = new KTSpline(xVals, yVals, fNFitPoints);
-            spline->SetXMin(fMinFrequency);
-            spline->SetXMax(fMaxFrequency);
-
-            delete [] xVals;
-            delete [] yVals;
-
-            newData.SetSpline(spline, iComponent);
+            CalculateFitPoints(spectrum, nBinsPerFitPoint);
+            newData.SetSpline(MakeSpline(fMeanStreams, iComponent), iComponent);
         }
         KTINFO(gvlog, "Completed gain variation calculation for " << nComponents);
 
@@ -615,53 +607,8 @@ namespace Katydid
         {
             const KTFrequencySpectrumVariance* spectrum = data.GetSpectrum(iComponent);
 
-            double* xVals = new double[fNFitPoints];
-            double* yVals = new double[fNFitPoints];
-
-            // Calculate fit points
-#pragma omp parallel for default(shared)
-            for (unsigned iFitPoint=0; iFitPoint < fNFitPoints; ++iFitPoint)
-            {
-                unsigned fitPointStartBin = iFitPoint * nBinsPerFitPoint + fMinBin;
-                unsigned fitPointEndBin = fitPointStartBin + nBinsPerFitPoint;
-
-                double leftEdge = spectrum->GetBinLowEdge(fitPointStartBin);
-                double rightEdge = spectrum->GetBinLowEdge(fitPointEndBin);
-                xVals[iFitPoint] = leftEdge + 0.5 * (rightEdge - leftEdge);
-
-                double mean = 0.;
-                for (unsigned iBin=fitPointStartBin; iBin<fitPointEndBin; ++iBin)
-                {
-                    mean += (*spectrum)(iBin);
-                }
-                mean /= (double)nBinsPerFitPoint;
-                yVals[iFitPoint] = mean;
-
-                KTDEBUG(gvlog, "Fit point " << iFitPoint << "  " << xVals[iFitPoint] << "  " << yVals[iFitPoint]);
-            }
-
-            if (fNormalize)
-            {
-                // Normalize the fit points to 1
-                double minYVal = yVals[0];
-                for (unsigned iFitPoint=1; iFitPoint < fNFitPoints; ++iFitPoint)
-                {
-                    if (yVals[iFitPoint] < minYVal) minYVal = yVals[iFitPoint];
-                }
-                for (unsigned iFitPoint=0; iFitPoint < fNFitPoints; ++iFitPoint)
-                {
-                    yVals[iFitPoint] = yVals[iFitPoint] / minYVal;
-                }
-            }
-
-            KTSpline* spline = new KTSpline(xVals, yVals, fNFitPoints);
-            spline->SetXMin(fMinFrequency);
-            spline->SetXMax(fMaxFrequency);
-
-            delete [] xVals;
-            delete [] yVals;
-
-            newData.SetVarianceSpline(spline, iComponent);
+            CalculateFitPoints(spectrum, nBinsPerFitPoint);
+            newData.SetVarianceSpline(MakeSpline(fVarianceStreams, iComponent), iComponent);
         }
         KTINFO(gvlog, "Completed gain variation calculation for " << nComponents);
 
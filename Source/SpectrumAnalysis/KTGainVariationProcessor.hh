@@ -17,6 +17,8 @@
 #include <fftw3.h>
 
 #include <list>
+#include <memory>
+#include <vector>
 
 namespace Katydid
 {
@@ -38,7 +40,7 @@ namespace Katydid
     class KTPowerSpectrumData;
     class KTPowerSpectrumDataCore;
     class KTPowerSpectrumVarianceData;
-    //class KTSpline;
+    class KTSpline;
 
     /*!
      @class KTGainVariationProcessor
@@ -54,6 +56,12 @@ namespace Katydid
 
      For complex data types (e.g. fs-polar, and fs-fftw), the gain variation curve is taken from the modulus of the data.
 
+     In streaming mode, the fit points (bin-group means of the spectrum and of the variance) are kept as exponentially-weighted
+     running averages over the slices received, per component.  The splines are only refit when a running fit point has drifted
+     from the value used for the current spline by more than the drift tolerance (relative); otherwise the output
+     KTGainVariationData shares the existing splines.  Downstream users that cache per-spline quantities (e.g. the
+     variable spectrum discriminator) can then reuse them from slice to slice.
+
      Configuration name: "gain-variation"
 
      Available configuration values:
@@ -63,6 +71,9 @@ namespace Katydid
      - "min-bin": unsigned -- minimum bin for the fit
      - "max-bin": unsigned -- maximum bin for the fit
      - "variance-n-bins": unsigned -- number of bins to use around each point to calculate the variance if the variance is not provided using one of the "-var" slots
+     - "streaming": bool -- use running fit points, and only refit the splines when the background drifts (default: false)
+     - "streaming-weight": double -- weight of each new slice in the running fit points, in (0, 1] (default: 0.1)
+     - "drift-tolerance": double -- relative change in any running fit point that causes the splines to be refit (default: 0.01)
 
      Slots:
      - "fs-polar-var": void (Nymph::KTDataPtr) -- Calculates gain variation on a frequency spectrum and variance (Polar); Requires KTFrequencySpectrumDataPolar and KTFrequencySpectrumVarianceDataPolar; Adds KTGainVariationData
@@ -115,6 +126,15 @@ namespace Katydid
             unsigned GetVarianceCalcNBins() const;
             void SetVarianceCalcNBins(unsigned nBins);
 
+            bool GetStreaming() const;
+            void SetStreaming(bool flag);
+
+            double GetStreamingWeight() const;
+            void SetStreamingWeight(double weight);
+
+            double GetDriftTolerance() const;
+            void SetDriftTolerance(double tolerance);
+
         private:
             bool fNormalize;
             double fMinFrequency;
@@ -125,6 +145,9 @@ namespace Katydid
             bool fCalculateMinBin;
             bool fCalculateMaxBin;
             unsigned fVarianceCalcNBins;
+            bool fStreaming;
+            double fStreamingWeight;
+            double fDriftTolerance;
 
         public:
             // These functions have been removed because the variance is not calculated correctly here (in CoreVarianceCalc)
@@ -151,6 +174,27 @@ namespace Katydid
             bool CoreGainVarCalc(KTPowerSpectrumDataCore& data, KTGainVariationData& newData);
             bool CoreGainVarCalc(KTFrequencySpectrumVarianceDataCore& data, KTGainVariationData& newData);
 
+            /// Running fit points for the mean or variance curve of one component, used in streaming mode
+            struct FitPointStream
+            {
+                std::vector< double > fXVals;
+                std::vector< double > fRunningYVals;
+                std::vector< double > fSplineYVals; // the running values that fSpline was fit to
+                std::shared_ptr< KTSpline > fSpline;
+            };
+
+            /// Fills fXVals and fYVals with the centers and mean values of the bin groups
+            template< class XSpectrum >
+            void CalculateFitPoints(const XSpectrum* spectrum, unsigned nBinsPerFitPoint);
+            /// Returns the spline for the current fit points; in streaming mode, updates the component's stream and reuses its spline if there's been no drift
+            std::shared_ptr< KTSpline > MakeSpline(std::vector< FitPointStream >& streams, unsigned component);
+            std::shared_ptr< KTSpline > CreateSpline(const std::vector< double >& xVals, std::vector< double > yVals) const;
+
+            std::vector< double > fXVals;
+            std::vector< double > fYVals;
+            std::vector< FitPointStream > fMeanStreams;
+            std::vector< FitPointStream > fVarianceStreams;
+
             // These functions have been removed because the variance is not calculated correctly here
             // See GitHub issue #159
             //bool CoreVarianceCalc(KTFrequencySpectrumDataPolarCore& data, KTFrequencySpectrumVarianceDataCore& newVarData);
@@ -270,5 +314,38 @@ namespace Katydid
         fVarianceCalcNBins = nBins;
     }
 
+    inline bool KTGainVariationProcessor::GetStreaming() const
+    {
+        return fStreaming;
+    }
+
+    inline void KTGainVariationProcessor::SetStreaming(bool flag)
+    {
+        fStreaming = flag;
+        return;
+    }
+
+    inline double KTGainVariationProcessor::GetStreamingWeight() const
+    {
+        return fStreamingWeight;
+    }
+
+    inline void KTGainVariationProcessor::SetStreamingWeight(double weight)
+    {
+        fStreamingWeight = weight;
+        return;
+    }
+
+    inline double KTGainVariationProcessor::GetDriftTolerance() const
+    {
+        return fDriftTolerance;
+    }
+
+    inline void KTGainVariationProcessor::SetDriftTolerance(double tolerance)
+    {
+        fDriftTolerance = tolerance;
+        return;
+    }
+
 } /* namespace Katydid */
 #endif /* KTGAINVARIATIONPROCESSOR_HH_ */
@@ -20,6 +20,9 @@
 #include "KTDiscriminatedPoints1DData.hh"
 
 
+#include <algorithm>
+#include <functional>
+#include <limits>
 #include <numeric>
 #include <cmath>
 
@@ -30,8 +33,8 @@ namespace Katydid
 {
     KTLOGGER(stflog, "KTSequentialTrackFinder");
 
-    KTSequentialTrackFinder::STFDiscriminatedPoint::STFDiscriminatedPoint(KTDiscriminatedPoints1DData::SetOfPoints::const_iterator& pointIt, double newTimeInRunC, double newTimeInAcq) :
-            KTDiscriminatedPoint(newTimeInRunC, pointIt->second.fAbscissa, pointIt->second.fOrdinate, newTimeInAcq, pointIt->second.fMean, pointIt->second.fVariance, pointIt->second.fNeighborhoodAmplitude, pointIt->first)
+    KTSequentialTrackFinder::STFDiscriminatedPoint::STFDiscriminatedPoint(const KTDiscriminatedPoints1DData::SetOfPoints& points, unsigned iPoint, double newTimeInRunC, double newTimeInAcq) :
+            KTDiscriminatedPoint(newTimeInRunC, points.GetAbscissa(iPoint), points.GetOrdinate(iPoint), newTimeInAcq, points.GetMean(iPoint), points.GetVariance(iPoint), points.GetNeighborhoodAmplitude(iPoint), points.GetBin(iPoint))
     {}
 
     KTSequentialTrackFinder::STFDiscriminatedPoint::STFDiscriminatedPoint(KTKDTreeData::SetOfPoints::const_iterator& pointIt, double time, double frequency, double timeScaling) :
@@ -39,6 +42,17 @@ namespace Katydid
     {}
 
 
+    KTSequentialTrackFinder::ComponentLines::ComponentLines() :
+            fActiveLines(),
+            fNextLineOrder(0),
+            fPredictedFreqIndex(),
+            fEndTimeIndex(),
+            fIndexTimeInAcq(0.),
+            fMaxAbsSlope(0.),
+            fFinishedLines()
+    {}
+
+
     KT_REGISTER_PROCESSOR(KTSequentialTrackFinder, "sequential-track-finder");
 
     KTSequentialTrackFinder::KTSequentialTrackFinder(const std::string& name) :
@@ -65,7 +79,8 @@ namespace Katydid
                     fSlopeMethod(slopeMethod::weighted_first_point_ref),
                     fCalculateMinBin(true),
                     fCalculateMaxBin(true),
-                    fActiveLines(),
+                    fComponentLines(),
+                    fThreadPool(1),
                     fNLines(0),
                     fApplyTotalPowerCut(false),
                     fApplyAveragePowerCut(false),
@@ -109,6 +124,7 @@ namespace Katydid
         SetTimeGapTolerance(node->get_value("time-gap-tolerance", GetTimeGapTolerance()));
         SetFrequencyAcceptance(node->get_value("frequency-acceptance", GetFrequencyAcceptance()));
         SetInitialSlope(node->get_value("initial-slope", GetInitialSlope()));
+        SetNComponentThreads(node->get_value< unsigned >("n-component-threads", GetNComponentThreads()));
 
 
         if (node->has("min-bin"))
@@ -244,7 +260,12 @@ namespace Katydid
         }
 
 
-        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+        if (nComponents == 0) return true;
+        fFreqBinWidth = spectrum.GetSpectrum(0)->GetBinWidth();
+
+        // the components have separate lines, so they can be processed concurrently; the candidates are emitted afterwards
+        GetComponentLines(nComponents - 1);
+        fThreadPool.ParallelFor(nComponents, [&](unsigned iComponent, unsigned)
         {
             uint64_t acqID = slHeader.GetAcquisitionID(iComponent);
             KTPowerSpectrum powerSpectrum= *spectrum.GetSpectrum(iComponent);
@@ -257,8 +278,6 @@ namespace Katydid
             //KTSpline::Implementation* splineImp = spline->Implement(nBins, freqMin, freqMax);
             //fReferenceThreshold = (*splineImp)((fMinBin+fMaxBin)/2)*fSNRPowerThreshold;
 
-            fFreqBinWidth = powerSpectrum.GetBinWidth();
-
             double newTimeInAcq = slHeader.GetTimeInAcq() + 0.5 * slHeader.GetSliceLength();
             double newTimeInRunC = slHeader.GetTimeInRun() + 0.5 * slHeader.GetSliceLength();
             KTDEBUG(stflog, "new_TimeInAcq is " << newTimeInAcq);
@@ -268,10 +287,11 @@ namespace Katydid
             STFDiscriminatedPowerSortedPoints points;
 
             const KTDiscriminatedPoints1DData::SetOfPoints&  incomingPts = discrimPoints.GetSetOfPoints(iComponent);
-            for (KTDiscriminatedPoints1DData::SetOfPoints::const_iterator pIt = incomingPts.begin(); pIt != incomingPts.end(); ++pIt)
+            unsigned nIncomingPts = incomingPts.size();
+            for (unsigned iPoint = 0; iPoint < nIncomingPts; ++iPoint)
             {
-                //KTINFO(stflog, "discriminated point: bin = " <<pIt->first<< ", frequency = "<<pIt->second.fAbscissa<< ", amplitude = "<<pIt->second.fOrdinate<<", "<<powerSpectrum(pIt->first) <<", threshold = "<<pIt->second.fThreshold);
-                points.emplace(pIt, newTimeInRunC, newTimeInAcq);
+                //KTINFO(stflog, "discriminated point: bin = " <<incomingPts.GetBin(iPoint)<< ", frequency = "<<incomingPts.GetAbscissa(iPoint)<< ", amplitude = "<<incomingPts.GetOrdinate(iPoint)<<", threshold = "<<incomingPts.GetThreshold(iPoint));
+                points.emplace(incomingPts, iPoint, newTimeInRunC, newTimeInAcq);
             }
 
             KTDEBUG( stflog, "Collected "<<points.size()<<" points");
@@ -281,7 +301,9 @@ namespace Katydid
             // Loop over the high power points
             this->LoopOverHighPowerPoints(powerSpectrum, points, acqID, iComponent);
 
-        }
+        });
+
+        EmitFinishedLines();
         return true;
     }
 
@@ -289,7 +311,7 @@ namespace Katydid
     {
         KTDEBUG(stflog, "Initial slope is: " << fInitialSlope);
 
-        unsigned nComponents = 1;
+        unsigned nComponents = discrimPoints.GetNComponents();
         fFreqBinWidth = (double) slHeader.GetSampleRate() / (double) slHeader.GetRawSliceSize();
         KTDEBUG(stflog, "Frequency bin width " << fFreqBinWidth);
 
@@ -305,7 +327,11 @@ namespace Katydid
         }
 
 
-        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+        if (nComponents == 0) return true;
+
+        // the components have separate lines, so they can be processed concurrently; the candidates are emitted afterwards
+        GetComponentLines(nComponents - 1);
+        fThreadPool.ParallelFor(nComponents, [&](unsigned iComponent, unsigned)
         {
             uint64_t acqID = slHeader.GetAcquisitionID(iComponent);
 
@@ -320,14 +346,15 @@ namespace Katydid
             // this set will collect the discriminated points sorted by power
             STFDiscriminatedPowerSortedPoints points;
 
+            // the points are sorted by bin, so the [fMinBin, fMaxBin] range is found by binary search
             const KTDiscriminatedPoints1DData::SetOfPoints&  incomingPts = discrimPoints.GetSetOfPoints(iComponent);
-            for (KTDiscriminatedPoints1DData::SetOfPoints::const_iterator pIt = incomingPts.begin(); pIt != incomingPts.end(); ++pIt)
+            const std::vector< unsigned >& incomingBins = incomingPts.GetBins();
+            unsigned iFirstPoint = std::lower_bound(incomingBins.begin(), incomingBins.end(), fMinBin) - incomingBins.begin();
+            unsigned iEndPoint = std::upper_bound(incomingBins.begin(), incomingBins.end(), fMaxBin) - incomingBins.begin();
+            for (unsigned iPoint = iFirstPoint; iPoint < iEndPoint; ++iPoint)
             {
-                if ( pIt->first >= fMinBin and pIt->first <= fMaxBin )
-                {
-                    //KTINFO(stflog, "discriminated point: bin = " <<pIt->first<< ", frequency = "<<pIt->second.fAbscissa<< ", amplitude = "<<pIt->second.fOrdinate <<", threshold = "<<pIt->second.fThreshold);
-                    points.emplace(pIt, newTimeInRunC, newTimeInAcq);
-                }
+                //KTINFO(stflog, "discriminated point: bin = " <<incomingBins[iPoint]<< ", frequency = "<<incomingPts.GetAbscissa(iPoint)<< ", amplitude = "<<incomingPts.GetOrdinate(iPoint) <<", threshold = "<<incomingPts.GetThreshold(iPoint));
+                points.emplace(incomingPts, iPoint, newTimeInRunC, newTimeInAcq);
             }
 
             // sort points by power
@@ -337,7 +364,9 @@ namespace Katydid
             // Loop over the high power points
             this->LoopOverHighPowerPoints(points, acqID, iComponent);
 
-        }
+        });
+
+        EmitFinishedLines();
         return true;
     }
 
@@ -390,6 +419,7 @@ namespace Katydid
 
                     // Loop over the high power points
                     this->LoopOverHighPowerPoints(points, acqID, iComponent);
+                    EmitFinishedLines();
 
                     // we're done with those points
                     points.clear();
@@ -410,6 +440,7 @@ namespace Katydid
 
                 // Loop over the high power points
                 this->LoopOverHighPowerPoints(points, acqID, iComponent);
+                EmitFinishedLines();
             }
         }
         return true;
@@ -419,8 +450,11 @@ namespace Katydid
     {
         KTDEBUG(stflog, "Time and Frequency tolerances are "<<fTimeGapTolerance<<" "<<fFrequencyAcceptance);
 
+        if (points.empty()) return true;
+        ComponentLines& lines = GetComponentLines(component);
+        RefreshLineIndex(lines, points.rbegin()->fTimeInAcq);
+
         double newFreq = 0.0;
-        bool match;
 
         //loop in reverse order (by power)
         for(STFDiscriminatedPowerSortedPoints::reverse_iterator pointIt = points.rbegin(); pointIt != points.rend(); ++pointIt)
@@ -450,79 +484,7 @@ namespace Katydid
             }
             else
             {
-                match = false;
-
-                // loop over active lines, in order of earliest start time
-                // dont need to sort them because they are already sorted by the slice of the line's start point
-
-                //KTDEBUG(stflog, "Currently there are N active Lines "<<fActiveLines.size());
-
-                std::vector< KTSequentialLineData >::iterator lineIt = fActiveLines.begin();
-                while( lineIt != fActiveLines.end())
-                {
-                    // Check whether line should still be active. If not then check whether the line is a valid new track candidate.
-                    if (lineIt->GetEndTimeInRunC() <pointIt->fTimeInRunC-fTimeGapTolerance)
-                    {
-                        if (lineIt->GetNPoints() >= fMinPoints)
-                        {
-                            lineIt->LineSNRTrimming(fTrimmingThreshold, fMinPoints);
-
-                            if (lineIt->GetNPoints() >= fMinPoints and lineIt->GetSlope() >= fMinSlope)
-                            {
-                                KTINFO(stflog, "Found track candidate");
-                                (this->*fCalcSlope)(*lineIt);
-                                this->EmitPreCandidate(*lineIt);
-                            }
-                        }
-                        // in any case, this line should be removed from the vector with active lines
-                        lineIt = fActiveLines.erase(lineIt);
-                    }
-                    else
-                    {
-                        // Under these conditions a point will be added to a line
-                        bool timeCondition = tempPoint.fTimeInRunC > lineIt->GetEndTimeInRunC();
-                        bool anyPointCondition = std::abs(tempPoint.fFrequency - (lineIt->GetEndFrequency() + lineIt->GetSlope()*(pointIt->fTimeInAcq - lineIt->GetEndTimeInAcq()))) < fFrequencyAcceptance;
-                        bool secondPointCondition = std::abs(tempPoint.fFrequency - (lineIt->GetEndFrequency() + lineIt->GetSlope()*(pointIt->fTimeInAcq - lineIt->GetEndTimeInAcq()))) < fInitialFrequencyAcceptance;
-
-                        // if point matches this line: insert
-                        if (timeCondition and anyPointCondition)
-                        {
-                            lineIt->AddPoint(tempPoint);
-                            (this->*fCalcSlope)(*lineIt);
-                            match = true;
-                            break;
-                        }
-                        // if this line consists of only one point so far, try again with different radius
-                        else if (lineIt->GetNPoints() == 1 and timeCondition and secondPointCondition)
-                        {
-                            KTDEBUG(stflog, "Trying initial-frequency-acceptance "<<fInitialFrequencyAcceptance);
-                            lineIt->AddPoint(tempPoint);
-                            (this->*fCalcSlope)(*lineIt);
-                            match = true;
-                            break;
-                        }
-                        // if not try next line
-                        else
-                        {
-                            ++lineIt;
-                        }
-                    }
-                }//end of while loop. all existing lines were compared
-
-                // if point was not picked up
-                if (match == false)
-                {
-                    //KTDEBUG(stflog, "Starting new line");
-
-                    KTSequentialLineData newLine;
-                    newLine.SetSlope( fInitialSlope );
-                    newLine.SetAcquisitionID( acqID );
-                    newLine.SetComponent( component );
-                    newLine.AddPoint(tempPoint);
-                    (this->*fCalcSlope)(newLine);
-                    fActiveLines.push_back(newLine);
-                    match = true;
-                }
+                this->AddPointToLines(lines, tempPoint, acqID, component);
             }
         }
         return true;
@@ -532,8 +494,11 @@ namespace Katydid
     {
         KTDEBUG(stflog, "Adding " << points.size() << " points to lines; Time and Frequency tolerances are " << fTimeGapTolerance<< "s and " << fFrequencyAcceptance << "Hz");
 
+        if (points.empty()) return true;
+        ComponentLines& lines = GetComponentLines(component);
+        RefreshLineIndex(lines, points.rbegin()->fTimeInAcq);
+
         double newFreq = 0.0;
-        bool match;
 
         //loop in reverse order (by power)
         for (STFDiscriminatedPowerSortedPoints::reverse_iterator pointIt = points.rbegin(); pointIt != points.rend(); ++pointIt)
@@ -555,97 +520,182 @@ namespace Katydid
             }
             else
             {
-                match = false;
+                this->AddPointToLines(lines, *pointIt, acqID, component);
+            }
+        }
+        return true;
+    }
 
-                // loop over active lines, in order of earliest start time
-                // dont need to sort them because they are already sorted by the slice of the line's start point
+    void KTSequentialTrackFinder::AddPointToLines(ComponentLines& lines, const STFDiscriminatedPoint& point, uint64_t acqID, unsigned component)
+    {
+        // Lines that ended before this are no longer active
+        double activeTimeLimit = point.fTimeInRunC - fTimeGapTolerance;
+
+        // Find the earliest-started active line that the point matches.
+        // Only the lines with extrapolated frequencies near the point's frequency can match; the search window is widened
+        // to allow for the point being at a different time than the index, and for rounding.
+        double window = std::max(fFrequencyAcceptance, fInitialFrequencyAcceptance) + lines.fMaxAbsSlope * std::abs(point.fTimeInAcq - lines.fIndexTimeInAcq);
+        window += 1.e-9 * (window + std::abs(point.fFrequency));
+
+        unsigned iMatch = lines.fActiveLines.size();
+        uint64_t matchOrder = std::numeric_limits< uint64_t >::max();
+        LineIndex::const_iterator freqEnd = lines.fPredictedFreqIndex.upper_bound(point.fFrequency + window);
+        for (LineIndex::const_iterator freqIt = lines.fPredictedFreqIndex.lower_bound(point.fFrequency - window); freqIt != freqEnd; ++freqIt)
+        {
+            const ActiveLine& activeLine = lines.fActiveLines[freqIt->second];
+            if (activeLine.fOrder > matchOrder) continue;
 
-                //KTWARN(stflog, "Currently there are " << fActiveLines.size() << " active Lines ");
+            const KTSequentialLineData& line = activeLine.fLine;
+            if (line.GetEndTimeInRunC() < activeTimeLimit) continue;
 
-                std::vector< KTSequentialLineData >::iterator lineIt = fActiveLines.begin();
-                while( lineIt != fActiveLines.end())
-                {
-                    // Check whether line should still be active. If not then check whether the line is a valid new track candidate.
-                    if (lineIt->GetEndTimeInRunC() < pointIt->fTimeInRunC - fTimeGapTolerance)
-                    {
-                        //KTWARN(stflog, "Gap between end of a line and the current time-in-run (" << pointIt->fTimeInRunC - lineIt->GetEndTimeInRunC()  << ") is larger than the gap tolerance; evaluating line");
-                        if (lineIt->GetNPoints() >= fMinPoints)
-                        {
-                            //KTWARN(stflog, "    line had more than the minimum number of points (" << lineIt->GetNPoints() << ")");
-                            lineIt->LineSNRTrimming(fTrimmingThreshold, fMinPoints);
-
-                            if (lineIt->GetNPoints() >= fMinPoints and lineIt->GetSlope() >= fMinSlope)
-                            {
-                                KTDEBUG(stflog, "Found line candidate");
-                                (this->*fCalcSlope)(*lineIt);
-                                this->EmitPreCandidate(*lineIt);
-                            }
-                            //else
-                            //{
-                            //    KTWARN(stflog, "    line cut after SNR trimming");
-                            //    KTWARN(stflog, "    npoints: " << lineIt->GetNPoints() << "; slope: " << lineIt->GetSlope());
-                           // }
-                        }
-                        //else
-                        //{
-                        //    KTWARN(stflog, "    line was cut because it didn't have enough points (" << lineIt->GetNPoints() << ")");
-                        //}
-                        // in any case, this line should be removed from the vector with active lines
-                        lineIt = fActiveLines.erase(lineIt);
-                    }
-                    else
-                    {
-                        // Under these conditions a point will be added to a line
-                        bool timeCondition = pointIt->fTimeInRunC > lineIt->GetEndTimeInRunC();
-                        //KTWARN(stflog, "time condition: " << timeCondition << " = " << pointIt->fTimeInRunC << " > " << lineIt->GetEndTimeInRunC() );
-                        bool anyPointCondition = std::abs(pointIt->fFrequency - (lineIt->GetEndFrequency() + lineIt->GetSlope()*(pointIt->fTimeInAcq - lineIt->GetEndTimeInAcq()))) < fFrequencyAcceptance;
-                        //KTWARN(stflog, "any point condition: " << anyPointCondition << " = | " << pointIt->fFrequency << " - ( " << lineIt->GetEndFrequency() << " + " << lineIt->GetSlope() << " * ( " << pointIt->fTimeInAcq << " - " << lineIt->GetEndTimeInAcq() << " ))| < " << fFrequencyAcceptance);
-                        bool secondPointCondition = std::abs(pointIt->fFrequency - (lineIt->GetEndFrequency() + lineIt->GetSlope()*(pointIt->fTimeInAcq - lineIt->GetEndTimeInAcq()))) < fInitialFrequencyAcceptance;
-                        //KTWARN(stflog, "second point condition: " << secondPointCondition << " = |" << pointIt->fFrequency << " - ( " << lineIt->GetEndFrequency() << " + " << lineIt->GetSlope() << " * ( " << pointIt->fTimeInAcq << " - " << lineIt->GetEndTimeInAcq() << " ))| < " << fInitialFrequencyAcceptance);
-
-                        // if point matches this line: insert
-                        if (timeCondition and anyPointCondition)
-                        {
-                            KTDEBUG(stflog, "Matching conditions fulfilled");
-                            lineIt->AddPoint(*pointIt);
-                            (this->*fCalcSlope)(*lineIt);
-                            match = true;
-                            break;
-                        }
-                        // if this line consists of only one point so far, try again with different radius
-                        else if (lineIt->GetNPoints() == 1 and timeCondition and secondPointCondition)
-                        {
-                            KTDEBUG(stflog, "Trying initial-frequency-acceptance "<<fInitialFrequencyAcceptance);
-                            lineIt->AddPoint(*pointIt);
-                            (this->*fCalcSlope)(*lineIt);
-                            match = true;
-                            break;
-                        }
-                        // if not try next line
-                        else
-                        {
-                            ++lineIt;
-                        }
-                    }
-                }//end of while loop. all existing lines were compared
+            // Under these conditions a point will be added to a line
+            bool timeCondition = point.fTimeInRunC > line.GetEndTimeInRunC();
+            double freqDistance = std::abs(point.fFrequency - (line.GetEndFrequency() + line.GetSlope()*(point.fTimeInAcq - line.GetEndTimeInAcq())));
+            bool anyPointCondition = freqDistance < fFrequencyAcceptance;
+            // if this line consists of only one point so far, try again with different radius
+            bool secondPointCondition = line.GetNPoints() == 1 and freqDistance < fInitialFrequencyAcceptance;
 
-                // if point was not picked up
-                if (match == false)
-                {
-                    //KTWARN(stflog, "Starting new line");
-
-                    KTSequentialLineData newLine;
-                    newLine.SetSlope( fInitialSlope );
-                    newLine.SetAcquisitionID( acqID );
-                    newLine.SetComponent( component );
-                    newLine.AddPoint(*pointIt);
-                    (this->*fCalcSlope)(newLine);
-                    fActiveLines.push_back(newLine);
-                    match = true;
-                }
+            if (timeCondition and (anyPointCondition or secondPointCondition))
+            {
+                iMatch = freqIt->second;
+                matchOrder = activeLine.fOrder;
             }
         }
-        return true;
+
+        // Lines that are no longer active are finished when they're passed over, i.e. if they were started before the
+        // matching line (or at all, if there's no match), in the order they were started
+        std::vector< unsigned > finishedLines;
+        for (LineIndex::const_iterator endIt = lines.fEndTimeIndex.begin(); endIt != lines.fEndTimeIndex.end() && endIt->first < activeTimeLimit; ++endIt)
+        {
+            if (lines.fActiveLines[endIt->second].fOrder < matchOrder) finishedLines.push_back(endIt->second);
+        }
+        std::sort(finishedLines.begin(), finishedLines.end(), [&lines](unsigned iLhs, unsigned iRhs) {return lines.fActiveLines[iLhs].fOrder < lines.fActiveLines[iRhs].fOrder;});
+        for (std::vector< unsigned >::const_iterator lineIt = finishedLines.begin(); lineIt != finishedLines.end(); ++lineIt)
+        {
+            this->FinishLine(lines, lines.fActiveLines[*lineIt].fLine);
+        }
+
+        if (iMatch != lines.fActiveLines.size())
+        {
+            // if point matches this line: insert
+            KTDEBUG(stflog, "Matching conditions fulfilled");
+            if (lines.fActiveLines[iMatch].fLine.GetNPoints() == 1)
+            {
+                KTDEBUG(stflog, "Trying initial-frequency-acceptance "<<fInitialFrequencyAcceptance);
+            }
+            UnindexLine(lines, iMatch);
+            lines.fActiveLines[iMatch].fLine.AddPoint(point);
+            (this->*fCalcSlope)(lines.fActiveLines[iMatch].fLine);
+            IndexLine(lines, iMatch);
+        }
+        else
+        {
+            // if point was not picked up
+            //KTWARN(stflog, "Starting new line");
+            lines.fActiveLines.push_back(ActiveLine());
+            ActiveLine& newLine = lines.fActiveLines.back();
+            newLine.fOrder = lines.fNextLineOrder++;
+            newLine.fLine.SetSlope( fInitialSlope );
+            newLine.fLine.SetAcquisitionID( acqID );
+            newLine.fLine.SetComponent( component );
+            newLine.fLine.AddPoint(point);
+            (this->*fCalcSlope)(newLine.fLine);
+            IndexLine(lines, lines.fActiveLines.size() - 1);
+        }
+
+        // removing from the back first means that none of the lines being removed get moved
+        std::sort(finishedLines.begin(), finishedLines.end(), std::greater< unsigned >());
+        for (std::vector< unsigned >::const_iterator lineIt = finishedLines.begin(); lineIt != finishedLines.end(); ++lineIt)
+        {
+            RemoveLine(lines, *lineIt);
+        }
+        return;
+    }
+
+    void KTSequentialTrackFinder::FinishLine(ComponentLines& lines, KTSequentialLineData& line)
+    {
+        //KTWARN(stflog, "Gap between end of a line and the current time-in-run is larger than the gap tolerance; evaluating line");
+        if (line.GetNPoints() >= fMinPoints)
+        {
+            line.LineSNRTrimming(fTrimmingThreshold, fMinPoints);
+
+            if (line.GetNPoints() >= fMinPoints and line.GetSlope() >= fMinSlope)
+            {
+                KTDEBUG(stflog, "Found line candidate");
+                (this->*fCalcSlope)(line);
+                lines.fFinishedLines.push_back(line);
+            }
+        }
+        return;
+    }
+
+    void KTSequentialTrackFinder::EmitFinishedLines()
+    {
+        for (std::deque< ComponentLines >::iterator compIt = fComponentLines.begin(); compIt != fComponentLines.end(); ++compIt)
+        {
+            for (std::vector< KTSequentialLineData >::iterator lineIt = compIt->fFinishedLines.begin(); lineIt != compIt->fFinishedLines.end(); ++lineIt)
+            {
+                this->EmitPreCandidate(*lineIt);
+            }
+            compIt->fFinishedLines.clear();
+        }
+        return;
+    }
+
+    KTSequentialTrackFinder::ComponentLines& KTSequentialTrackFinder::GetComponentLines(unsigned component)
+    {
+        if (component >= fComponentLines.size()) fComponentLines.resize(component + 1);
+        return fComponentLines[component];
+    }
+
+    void KTSequentialTrackFinder::RefreshLineIndex(ComponentLines& lines, double timeInAcq)
+    {
+        lines.fPredictedFreqIndex.clear();
+        lines.fEndTimeIndex.clear();
+        lines.fIndexTimeInAcq = timeInAcq;
+        lines.fMaxAbsSlope = 0.;
+        for (unsigned iLine = 0; iLine < lines.fActiveLines.size(); ++iLine)
+        {
+            IndexLine(lines, iLine);
+        }
+        return;
+    }
+
+    void KTSequentialTrackFinder::IndexLine(ComponentLines& lines, unsigned iLine)
+    {
+        ActiveLine& activeLine = lines.fActiveLines[iLine];
+        const KTSequentialLineData& line = activeLine.fLine;
+
+        // a line with an undefined extrapolation can't match any point
+        double predictedFreq = line.GetEndFrequency() + line.GetSlope() * (lines.fIndexTimeInAcq - line.GetEndTimeInAcq());
+        activeLine.fHasPredictedFreq = ! std::isnan(predictedFreq);
+        if (activeLine.fHasPredictedFreq) activeLine.fFreqIt = lines.fPredictedFreqIndex.emplace(predictedFreq, iLine);
+        activeLine.fEndTimeIt = lines.fEndTimeIndex.emplace(line.GetEndTimeInRunC(), iLine);
+        lines.fMaxAbsSlope = std::max(lines.fMaxAbsSlope, std::abs(line.GetSlope()));
+        return;
+    }
+
+    void KTSequentialTrackFinder::UnindexLine(ComponentLines& lines, unsigned iLine)
+    {
+        ActiveLine& activeLine = lines.fActiveLines[iLine];
+        if (activeLine.fHasPredictedFreq) lines.fPredictedFreqIndex.erase(activeLine.fFreqIt);
+        lines.fEndTimeIndex.erase(activeLine.fEndTimeIt);
+        return;
+    }
+
+    void KTSequentialTrackFinder::RemoveLine(ComponentLines& lines, unsigned iLine)
+    {
+        UnindexLine(lines, iLine);
+
+        unsigned iLast = lines.fActiveLines.size() - 1;
+        if (iLine != iLast)
+        {
+            lines.fActiveLines[iLine] = std::move(lines.fActiveLines[iLast]);
+            if (lines.fActiveLines[iLine].fHasPredictedFreq) lines.fActiveLines[iLine].fFreqIt->second = iLine;
+            lines.fActiveLines[iLine].fEndTimeIt->second = iLine;
+        }
+        lines.fActiveLines.pop_back();
+        return;
     }
 
 
@@ -848,21 +898,29 @@ namespace Katydid
     {
         KTINFO(stflog, "Got egg-done signal. Checking remaining line candidates");
 
-        std::vector< KTSequentialLineData >::iterator lineIt = fActiveLines.begin();
-        while( lineIt != fActiveLines.end())
+        EmitFinishedLines();
+
+        // the remaining lines are finished component by component, in the order they were started
+        for (std::deque< ComponentLines >::iterator compIt = fComponentLines.begin(); compIt != fComponentLines.end(); ++compIt)
         {
-            if (lineIt->GetNPoints() >= fMinPoints)
+            std::vector< ActiveLine >& activeLines = compIt->fActiveLines;
+            std::sort(activeLines.begin(), activeLines.end(), [](const ActiveLine& lhs, const ActiveLine& rhs) {return lhs.fOrder < rhs.fOrder;});
+            for (std::vector< ActiveLine >::iterator lineIt = activeLines.begin(); lineIt != activeLines.end(); ++lineIt)
             {
-                lineIt->LineSNRTrimming(fTrimmingThreshold, fMinPoints);
-
-                if (lineIt->GetNPoints() >= fMinPoints and lineIt->GetSlope() > fMinSlope)
+                KTSequentialLineData& line = lineIt->fLine;
+                if (line.GetNPoints() >= fMinPoints)
                 {
-                    this->EmitPreCandidate(*lineIt);
+                    line.LineSNRTrimming(fTrimmingThreshold, fMinPoints);
+
+                    if (line.GetNPoints() >= fMinPoints and line.GetSlope() > fMinSlope)
+                    {
+                        this->EmitPreCandidate(line);
+                    }
                 }
             }
-            lineIt = fActiveLines.erase(lineIt);
         }
-        KTDEBUG(stflog, "Now there should be no lines left over " << fActiveLines.empty());
+        fComponentLines.clear();
+        KTDEBUG(stflog, "Now there should be no lines left over " << fComponentLines.empty());
     }
 
     /*void KTSequentialTrackFinder::CalculateWeightedSlope(LineRef& line)
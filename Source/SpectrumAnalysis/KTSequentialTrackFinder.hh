@@ -14,10 +14,14 @@
 #include "KTDiscriminatedPoints1DData.hh"
 #include "KTDiscriminatedPoint.hh"
 #include "KTKDTreeData.hh"
+#include "KTSequentialLineData.hh"
 
 #include "KTMemberVariable.hh"
 #include "KTSlot.hh"
+#include "KTThreadPool.hh"
 
+#include <deque>
+#include <map>
 #include <set>
 
 
@@ -26,7 +30,6 @@ namespace Katydid
     class KTEggHeader;
     class KTPowerSpectrum;
     class KTPowerSpectrumData;
-    class KTSequentialLineData;
     class KTSliceHeader;
 
     /*!
@@ -70,6 +73,20 @@ namespace Katydid
      - "average-snr-threshold": threshold for apply-average-snr-cut
      - "total-residual-threshold": threshold for apply-total-residual-cut
      - "average-residual-threshold": threshold for apply-average-residual
+     - "n-component-threads": unsigned -- number of threads over which the components of a slice are shared out (default: 1, i.e. the components are processed in order on the calling thread); applies to both the disc-1d and disc-1d-ps slots, which process every component
+
+     Point-to-line association:
+     The points of each slice are compared to the active lines in order of decreasing power.  A point is added to the
+     earliest-started active line whose extrapolation to the point's time is within frequency-acceptance (or within
+     initial-frequency-acceptance, for lines with one point).  The active lines are indexed by that extrapolated frequency,
+     refreshed at the start of each slice, so that only the lines near the point's frequency are compared.  Lines that have
+     ended by more than time-gap-tolerance are retired in the order they were started, as the lines they precede are passed over.
+
+     Components:
+     Each component has its own active lines, so the components of a slice are independent and can be processed in parallel
+     (see "n-component-threads").  The candidates are emitted after all of the components of a slice have been processed:
+     those of component 0 first, then those of component 1, etc., each in the order its lines were finished.  The results
+     don't depend on the number of threads.
 
      Slope method:
      The slope-method controls which method is used for updating the line slope when a new point is added to the line.
@@ -80,7 +97,7 @@ namespace Katydid
 
 
      Slots:
-     - "disc-1d": void (KTDataPtr) -- clusters discriminated points to sequential lines candidates
+     - "disc-1d": void (KTDataPtr) -- clusters discriminated points to sequential lines candidates; every component of the discriminated points is processed (previously only component 0 was)
      - "disc-1d-ps": void (KTDataPtr) -- clusters discriminated points to sequential line candidates; updates point properties using power spectrum slice
      - "done": void () -- Processes remaining active lines and emits clustering-done signal
 
@@ -104,7 +121,7 @@ namespace Katydid
         public:
             struct STFDiscriminatedPoint : KTDiscriminatedPoint
             {
-                STFDiscriminatedPoint(KTDiscriminatedPoints1DData::SetOfPoints::const_iterator& pointIt, double newTimeInRunC, double newTimeInAcq);
+                STFDiscriminatedPoint(const KTDiscriminatedPoints1DData::SetOfPoints& points, unsigned iPoint, double newTimeInRunC, double newTimeInAcq);
                 STFDiscriminatedPoint(KTKDTreeData::SetOfPoints::const_iterator& pointIt, double time, double frequency, double timeScaling);
             };
 
@@ -169,6 +186,9 @@ namespace Katydid
             MEMBERVARIABLE(double, MinFrequency);
             MEMBERVARIABLE(double, MaxFrequency);
 
+            unsigned GetNComponentThreads() const;
+            void SetNComponentThreads(unsigned nThreads);
+
         public:
             bool InitializeWithHeader(KTEggHeader& header);
 
@@ -195,7 +215,52 @@ namespace Katydid
             const std::set< Nymph::KTDataPtr >& GetCandidates() const;
 
         private:
-            std::vector< KTSequentialLineData > fActiveLines;
+            // key: predicted frequency or end time; value: position in the active-line vector
+            typedef std::multimap< double, unsigned > LineIndex;
+
+            struct ActiveLine
+            {
+                KTSequentialLineData fLine;
+                uint64_t fOrder; // lines are compared to points in the order they were started
+                bool fHasPredictedFreq;
+                LineIndex::iterator fFreqIt;
+                LineIndex::iterator fEndTimeIt;
+            };
+
+            // The lines of one component, which are independent of those of the other components
+            struct ComponentLines
+            {
+                ComponentLines();
+
+                std::vector< ActiveLine > fActiveLines;
+                uint64_t fNextLineOrder;
+                LineIndex fPredictedFreqIndex; // frequency of each line extrapolated to fIndexTimeInAcq
+                LineIndex fEndTimeIndex; // end time in run of each line
+                double fIndexTimeInAcq;
+                double fMaxAbsSlope; // largest slope magnitude of the lines in the index
+                std::vector< KTSequentialLineData > fFinishedLines; // waiting to be emitted, in the order they were finished
+            };
+
+            /// Returns the lines of a component; components can only be added while no components are being processed
+            ComponentLines& GetComponentLines(unsigned component);
+
+            /// Adds the point to the line it matches, or starts a new line, and retires the lines that it passes over
+            void AddPointToLines(ComponentLines& lines, const STFDiscriminatedPoint& point, uint64_t acqID, unsigned component);
+            /// Trims a line that has ended, and queues it to be emitted if it passes the cuts
+            void FinishLine(ComponentLines& lines, KTSequentialLineData& line);
+            /// Emits the queued lines of all components, in component order
+            void EmitFinishedLines();
+
+            void RefreshLineIndex(ComponentLines& lines, double timeInAcq);
+            void IndexLine(ComponentLines& lines, unsigned iLine);
+            void UnindexLine(ComponentLines& lines, unsigned iLine);
+            /// Removes a line by moving the last line into its place
+            void RemoveLine(ComponentLines& lines, unsigned iLine);
+
+            // a deque, so that adding components doesn't move the lines of the others
+            std::deque< ComponentLines > fComponentLines;
+            KTThreadPool fThreadPool;
+
             std::set< Nymph::KTDataPtr > fCandidates;
 
 
@@ -225,5 +290,16 @@ namespace Katydid
         return fCandidates;
     }
 
+    inline unsigned KTSequentialTrackFinder::GetNComponentThreads() const
+    {
+        return fThreadPool.GetNThreads();
+    }
+
+    inline void KTSequentialTrackFinder::SetNComponentThreads(unsigned nThreads)
+    {
+        fThreadPool.SetNThreads(nThreads);
+        return;
+    }
+
 } /* namespace Katydid */
 #endif /* KTSEQUENTIALTRACKFinder_HH_ */
@@ -0,0 +1,221 @@
+/*
+ * KTSlidingWindowStats.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "KTSlidingWindowStats.hh"
+
+#include <algorithm>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define KT_SLIDINGWINDOW_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace Katydid
+{
+    namespace
+    {
+        //*************************
+        // Scalar kernels
+        // These are used on CPUs without AVX2, and for the bins left over at the end of the vectorized loops.
+        // The squared norms are updated with (x - old) * (x + old), in the same order as the vectorized kernels,
+        // so that both give identical results.
+        //*************************
+
+        void UpdateRealScalar(double* ring, const double* newValues, double* sums, double* normSums, double* mean, double* meanOfNorms, double invN, size_t begin, size_t end)
+        {
+            for (size_t iBin = begin; iBin < end; ++iBin)
+            {
+                double value = newValues[iBin];
+                double old = ring[iBin];
+                ring[iBin] = value;
+                sums[iBin] += value - old;
+                normSums[iBin] += (value - old) * (value + old);
+                mean[iBin] = sums[iBin] * invN;
+                meanOfNorms[iBin] = normSums[iBin] * invN;
+            }
+            return;
+        }
+
+        void UpdateComplexScalar(double* ring, const double* newValues, double* sums, double* normSums, double* mean, double* meanOfNorms, double invN, size_t begin, size_t end)
+        {
+            for (size_t iBin = begin; iBin < end; ++iBin)
+            {
+                size_t iRe = 2 * iBin, iIm = 2 * iBin + 1;
+                double re = newValues[iRe], im = newValues[iIm];
+                double oldRe = ring[iRe], oldIm = ring[iIm];
+                ring[iRe] = re;
+                ring[iIm] = im;
+                sums[iRe] += re - oldRe;
+                sums[iIm] += im - oldIm;
+                normSums[iBin] += (re - oldRe) * (re + oldRe) + (im - oldIm) * (im + oldIm);
+                mean[iRe] = sums[iRe] * invN;
+                mean[iIm] = sums[iIm] * invN;
+                meanOfNorms[iBin] = normSums[iBin] * invN;
+            }
+            return;
+        }
+
+#ifdef KT_SLIDINGWINDOW_X86_KERNELS
+        //*************************
+        // AVX2 kernels
+        //*************************
+
+        __attribute__((target("avx2")))
+        void UpdateRealAVX2(double* ring, const double* newValues, double* sums, double* normSums, double* mean, double* meanOfNorms, double invN, size_t nBins)
+        {
+            const __m256d scale = _mm256_set1_pd(invN);
+
+            size_t iBin = 0;
+            for (; iBin + 4 <= nBins; iBin += 4)
+            {
+                __m256d value = _mm256_loadu_pd(newValues + iBin);
+                __m256d old = _mm256_loadu_pd(ring + iBin);
+                _mm256_storeu_pd(ring + iBin, value);
+
+                __m256d diff = _mm256_sub_pd(value, old);
+                __m256d sum = _mm256_add_pd(_mm256_loadu_pd(sums + iBin), diff);
+                __m256d normSum = _mm256_add_pd(_mm256_loadu_pd(normSums + iBin), _mm256_mul_pd(diff, _mm256_add_pd(value, old)));
+                _mm256_storeu_pd(sums + iBin, sum);
+                _mm256_storeu_pd(normSums + iBin, normSum);
+                _mm256_storeu_pd(mean + iBin, _mm256_mul_pd(sum, scale));
+                _mm256_storeu_pd(meanOfNorms + iBin, _mm256_mul_pd(normSum, scale));
+            }
+
+            UpdateRealScalar(ring, newValues, sums, normSums, mean, meanOfNorms, invN, iBin, nBins);
+            return;
+        }
+
+        __attribute__((target("avx2")))
+        void UpdateComplexAVX2(double* ring, const double* newValues, double* sums, double* normSums, double* mean, double* meanOfNorms, double invN, size_t nBins)
+        {
+            const __m256d scale = _mm256_set1_pd(invN);
+
+            // four bins (eight values) per iteration
+            size_t iBin = 0;
+            for (; iBin + 4 <= nBins; iBin += 4)
+            {
+                size_t iValue = 2 * iBin;
+                __m256d value0 = _mm256_loadu_pd(newValues + iValue);
+                __m256d value1 = _mm256_loadu_pd(newValues + iValue + 4);
+                __m256d old0 = _mm256_loadu_pd(ring + iValue);
+                __m256d old1 = _mm256_loadu_pd(ring + iValue + 4);
+                _mm256_storeu_pd(ring + iValue, value0);
+                _mm256_storeu_pd(ring + iValue + 4, value1);
+
+                __m256d diff0 = _mm256_sub_pd(value0, old0);
+                __m256d diff1 = _mm256_sub_pd(value1, old1);
+                __m256d sum0 = _mm256_add_pd(_mm256_loadu_pd(sums + iValue), diff0);
+                __m256d sum1 = _mm256_add_pd(_mm256_loadu_pd(sums + iValue + 4), diff1);
+                _mm256_storeu_pd(sums + iValue, sum0);
+                _mm256_storeu_pd(sums + iValue + 4, sum1);
+                _mm256_storeu_pd(mean + iValue, _mm256_mul_pd(sum0, scale));
+                _mm256_storeu_pd(mean + iValue + 4, _mm256_mul_pd(sum1, scale));
+
+                // the pairwise add gives the norm changes of bins (0, 2, 1, 3); the permute puts them in order
+                __m256d normDiff = _mm256_hadd_pd(_mm256_mul_pd(diff0, _mm256_add_pd(value0, old0)), _mm256_mul_pd(diff1, _mm256_add_pd(value1, old1)));
+                normDiff = _mm256_permute4x64_pd(normDiff, _MM_SHUFFLE(3, 1, 2, 0));
+                __m256d normSum = _mm256_add_pd(_mm256_loadu_pd(normSums + iBin), normDiff);
+                _mm256_storeu_pd(normSums + iBin, normSum);
+                _mm256_storeu_pd(meanOfNorms + iBin, _mm256_mul_pd(normSum, scale));
+            }
+
+            UpdateComplexScalar(ring, newValues, sums, normSums, mean, meanOfNorms, invN, iBin, nBins);
+            return;
+        }
+#endif /* KT_SLIDINGWINDOW_X86_KERNELS */
+
+    } /* anonymous namespace */
+
+
+    KTSlidingWindowStats::KTSlidingWindowStats(KTThresholdKernels::InstructionSet instSet) :
+            fWindowSize(1),
+            fNBins(0),
+            fValuesPerBin(1),
+            fNextEntry(0),
+            fNInWindow(0),
+            fRing(),
+            fSums(),
+            fNormSums(),
+            fInstSet(instSet)
+    {
+    }
+
+    KTSlidingWindowStats::~KTSlidingWindowStats()
+    {
+    }
+
+    void KTSlidingWindowStats::Initialize(unsigned windowSize, size_t nBins, unsigned valuesPerBin)
+    {
+        fWindowSize = std::max(windowSize, 1u);
+        fNBins = nBins;
+        fValuesPerBin = valuesPerBin == 2 ? 2 : 1;
+
+        fNextEntry = 0;
+        fNInWindow = 0;
+
+        // the ring starts out as zeros, so filling the window is the same update as sliding it
+        size_t nValues = fNBins * fValuesPerBin;
+        fRing.assign(size_t(fWindowSize) * nValues, 0.);
+        fSums.assign(nValues, 0.);
+        fNormSums.assign(fNBins, 0.);
+        return;
+    }
+
+    void KTSlidingWindowStats::Add(const double* newValues, double* mean, double* meanOfNorms)
+    {
+        if (fNInWindow < fWindowSize) ++fNInWindow;
+        double invN = 1. / double(fNInWindow);
+
+        double* entry = fRing.data() + size_t(fNextEntry) * fNBins * fValuesPerBin;
+#ifdef KT_SLIDINGWINDOW_X86_KERNELS
+        if (fInstSet == KTThresholdKernels::kAVX2)
+        {
+            if (fValuesPerBin == 2) UpdateComplexAVX2(entry, newValues, fSums.data(), fNormSums.data(), mean, meanOfNorms, invN, fNBins);
+            else UpdateRealAVX2(entry, newValues, fSums.data(), fNormSums.data(), mean, meanOfNorms, invN, fNBins);
+        }
+        else
+#endif
+        {
+            if (fValuesPerBin == 2) UpdateComplexScalar(entry, newValues, fSums.data(), fNormSums.data(), mean, meanOfNorms, invN, 0, fNBins);
+            else UpdateRealScalar(entry, newValues, fSums.data(), fNormSums.data(), mean, meanOfNorms, invN, 0, fNBins);
+        }
+
+        if (++fNextEntry == fWindowSize)
+        {
+            fNextEntry = 0;
+            Resum();
+        }
+        return;
+    }
+
+    void KTSlidingWindowStats::Resum()
+    {
+        std::fill(fSums.begin(), fSums.end(), 0.);
+        std::fill(fNormSums.begin(), fNormSums.end(), 0.);
+
+        size_t nValues = fNBins * fValuesPerBin;
+        for (unsigned iEntry = 0; iEntry < fNInWindow; ++iEntry)
+        {
+            const double* entry = fRing.data() + size_t(iEntry) * nValues;
+            for (size_t iValue = 0; iValue < nValues; ++iValue)
+            {
+                fSums[iValue] += entry[iValue];
+            }
+            for (size_t iBin = 0; iBin < fNBins; ++iBin)
+            {
+                double norm = 0.;
+                for (unsigned iPart = 0; iPart < fValuesPerBin; ++iPart)
+                {
+                    norm += entry[iBin * fValuesPerBin + iPart] * entry[iBin * fValuesPerBin + iPart];
+                }
+                fNormSums[iBin] += norm;
+            }
+        }
+        return;
+    }
+
+} /* namespace Katydid */
@@ -0,0 +1,94 @@
+/**
+ @file KTSlidingWindowStats.hh
+ @brief Contains KTSlidingWindowStats
+ @details Exact mean and mean-of-squares over the last N arrays added
+ @author: agent
+ @date: Oct 18, 2026
+ */
+
+#ifndef KTSLIDINGWINDOWSTATS_HH_
+#define KTSLIDINGWINDOWSTATS_HH_
+
+#include "KTThresholdKernels.hh"
+
+#include <cstddef>
+#include <vector>
+
+namespace Katydid
+{
+
+    /*!
+     @class KTSlidingWindowStats
+     @author agent
+
+     @brief Keeps the last N arrays in a ring, and the running sums of their values and squared norms
+
+     @details
+     Each array has nBins bins of valuesPerBin doubles: 1 for real data, or 2 (real, imaginary) for complex data.
+     Add() replaces the oldest array in the ring with the new one, updates the sums by adding the new values and subtracting
+     the old ones, and writes the mean of the values and the mean of the squared norms, all in a single pass over the bins.
+     Until the window is full, the means are over the arrays added so far.
+
+     To keep the rounding error of the add/subtract updates from building up, the sums are recomputed from the ring
+     every time it wraps around; that costs one extra read of the ring per N arrays added.
+
+     The fused update uses AVX2 where the CPU supports it (see KTThresholdKernels::GetInstructionSet()).
+    */
+    class KTSlidingWindowStats
+    {
+        public:
+            KTSlidingWindowStats(KTThresholdKernels::InstructionSet instSet = KTThresholdKernels::GetInstructionSet());
+            ~KTSlidingWindowStats();
+
+            /// Clears the window and sets its dimensions
+            void Initialize(unsigned windowSize, size_t nBins, unsigned valuesPerBin);
+
+            unsigned GetWindowSize() const;
+            size_t GetNBins() const;
+            unsigned GetValuesPerBin() const;
+
+            /// Number of arrays currently in the window
+            unsigned GetNInWindow() const;
+
+            /// Adds nBins * valuesPerBin values; mean gets nBins * valuesPerBin values, and meanOfNorms gets nBins values
+            void Add(const double* newValues, double* mean, double* meanOfNorms);
+
+        private:
+            void Resum();
+
+            unsigned fWindowSize;
+            size_t fNBins;
+            unsigned fValuesPerBin;
+
+            unsigned fNextEntry;
+            unsigned fNInWindow;
+
+            std::vector< double > fRing; // fWindowSize entries of fNBins * fValuesPerBin values
+            std::vector< double > fSums;
+            std::vector< double > fNormSums;
+
+            KTThresholdKernels::InstructionSet fInstSet;
+    };
+
+    inline unsigned KTSlidingWindowStats::GetWindowSize() const
+    {
+        return fWindowSize;
+    }
+
+    inline size_t KTSlidingWindowStats::GetNBins() const
+    {
+        return fNBins;
+    }
+
+    inline unsigned KTSlidingWindowStats::GetValuesPerBin() const
+    {
+        return fValuesPerBin;
+    }
+
+    inline unsigned KTSlidingWindowStats::GetNInWindow() const
+    {
+        return fNInWindow;
+    }
+
+} /* namespace Katydid */
+#endif /* KTSLIDINGWINDOWSTATS_HH_ */
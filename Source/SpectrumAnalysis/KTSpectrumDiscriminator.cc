@@ -15,9 +15,12 @@
 #include "KTFrequencySpectrumFFTW.hh"
 #include "KTPowerSpectrum.hh"
 #include "KTPowerSpectrumData.hh"
+#include "KTPowerSpectrumDataF.hh"
 #include "KTNormalizedFSData.hh"
+#include "KTThresholdKernels.hh"
 #include "KTWignerVilleData.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
@@ -47,6 +50,9 @@ namespace Katydid
             fNeighborhoodRadius(0),
             fCalculateMinBin(true),
             fCalculateMaxBin(true),
+            fValueBuffer(),
+            fPrefixSums(),
+            fAboveThreshold(),
             fDiscrim1DSignal("disc-1d", this),
             fFSPolarSlot("fs-polar", this, &KTSpectrumDiscriminator::Discriminate, &fDiscrim1DSignal),
             fFSFFTWSlot("fs-fftw", this, &KTSpectrumDiscriminator::Discriminate, &fDiscrim1DSignal),
@@ -54,6 +60,7 @@ namespace Katydid
             fNormFSFFTWSlot("norm-fs-fftw", this, &KTSpectrumDiscriminator::Discriminate, &fDiscrim1DSignal),
             fNormPSSlot("norm-ps", this, &KTSpectrumDiscriminator::Discriminate, &fDiscrim1DSignal),
             fPSSlot("ps", this, &KTSpectrumDiscriminator::Discriminate, &fDiscrim1DSignal),
+            fPSFSlot("ps-f", this, &KTSpectrumDiscriminator::Discriminate, &fDiscrim1DSignal),
             fCorrSlot("corr", this, &KTSpectrumDiscriminator::Discriminate, &fDiscrim1DSignal),
             fWVSlot("wv", this, &KTSpectrumDiscriminator::Discriminate, &fDiscrim1DSignal)
     {
@@ -161,6 +168,12 @@ namespace Katydid
         return CoreDiscriminate(data, newData, std::vector< PerComponentInfo >());
     }
 
+    bool KTSpectrumDiscriminator::Discriminate(KTPowerSpectrumDataF& data)
+    {
+        KTDiscriminatedPoints1DData& newData = data.Of< KTDiscriminatedPoints1DData >().SetNComponents(data.GetNComponents());
+        return CoreDiscriminate(data, newData, std::vector< PerComponentInfo >());
+    }
+
     bool KTSpectrumDiscriminator::Discriminate(KTCorrelationData& data)
     {
         KTDiscriminatedPoints1DData& newData = data.Of< KTDiscriminatedPoints1DData >().SetNComponents(data.GetNComponents());
@@ -173,6 +186,44 @@ namespace Katydid
         return CoreDiscriminate(data, newData, std::vector< PerComponentInfo >());
     }
 
+    namespace
+    {
+        // Each of these returns a pointer to the values of bins [firstBin, firstBin + nBins) as contiguous doubles,
+        // either directly from the spectrum or via the buffer
+
+        const double* GetValues(const KTFrequencySpectrumFFTW* spectrum, unsigned firstBin, unsigned nBins, vector< double >& buffer)
+        {
+            buffer.resize(nBins);
+            for (unsigned iBin = 0; iBin < nBins; ++iBin)
+            {
+                buffer[iBin] = spectrum->GetAbs(firstBin + iBin);
+            }
+            return buffer.data();
+        }
+
+        const double* GetValues(const KTFrequencySpectrumPolar* spectrum, unsigned firstBin, unsigned nBins, vector< double >& buffer)
+        {
+            buffer.resize(nBins);
+            for (unsigned iBin = 0; iBin < nBins; ++iBin)
+            {
+                buffer[iBin] = (*spectrum)(firstBin + iBin).abs();
+            }
+            return buffer.data();
+        }
+
+        const double* GetValues(const KTPowerSpectrum* spectrum, unsigned firstBin, unsigned, vector< double >&)
+        {
+            return spectrum->GetData() + firstBin;
+        }
+
+        const double* GetValues(const KTPowerSpectrumF* spectrum, unsigned firstBin, unsigned nBins, vector< double >& buffer)
+        {
+            const float* data = spectrum->GetData() + firstBin;
+            buffer.assign(data, data + nBins);
+            return buffer.data();
+        }
+    }
+
     bool KTSpectrumDiscriminator::CoreDiscriminate(KTFrequencySpectrumDataFFTWCore& data, KTDiscriminatedPoints1DData& newData, std::vector< PerComponentInfo > pcData)
     {
         if (fCalculateMinBin)
@@ -196,9 +247,6 @@ namespace Katydid
         unsigned nBins = fMaxBin - fMinBin + 1;
         double norm = 1. / double(nBins);
 
-        // Temporary storage for magnitude values
-        vector< double > magnitude(data.GetSpectrumFFTW(0)->size());
-
         for (unsigned iComponent=0; iComponent<nComponents; ++iComponent)
         {
             const KTFrequencySpectrumFFTW* spectrum = data.GetSpectrumFFTW(iComponent);
@@ -207,66 +255,12 @@ namespace Katydid
                 KTERROR(sdlog, "Frequency spectrum pointer (component " << iComponent << ") is NULL!");
                 return false;
             }
-            if (spectrum->size() != magnitude.size())
-            {
-                magnitude.resize(spectrum->size());
-            }
-
-            double mean = 0., variance = 0.;
-            if (! pcData.empty())
-            {
-                mean = pcData[iComponent].fMean;
-                variance = pcData[iComponent].fVariance;
-            }
-            else
-            {
-#pragma omp parallel for reduction(+:mean)
-                for (unsigned iBin=fMinBin; iBin<=fMaxBin; ++iBin)
-                {
-                    magnitude[iBin] = spectrum->GetAbs(iBin);
-                    mean += magnitude[iBin];
-                    variance += magnitude[iBin] * magnitude[iBin];
-                }
-                mean *= norm;
-                variance = variance*norm  - mean*mean;
-            }
-
-            double threshold = 0.;
-            if (fThresholdMode == eSNR_Amplitude)
-            {
-                // SNR = P_signal / P_noise = (A_signal / A_noise)^2, A_noise = mean
-                threshold = sqrt(fSNRThreshold) * mean;
-                KTDEBUG(sdlog, "Discriminator threshold for channel " << iComponent << " set at <" << threshold << "> (SNR mode)");
-            }
-            else if (fThresholdMode == eSNR_Power)
-            {
-                // SNR = P_signal / P_noise, P_noise = mean
-                threshold = fSNRThreshold * mean;
-                KTDEBUG(sdlog, "Discriminator threshold for channel " << iComponent << " set at <" << threshold << "> (SNR mode)");
-            }
-            else if (fThresholdMode == eSigma)
-            {
-                threshold = mean + fSigmaThreshold * sqrt(variance);
-                KTDEBUG(sdlog, "Discriminator threshold for channel " << iComponent << " set at <" << threshold << "> (Sigma mode; mean = " << mean << "; variance = " << variance << ")");
-            }
 
-            // loop over bins, checking against the threshold
-#pragma omp parallel for private(value)
-            for (unsigned iBin=fMinBin; iBin<=fMaxBin; ++iBin)
-            {
-                double value = magnitude[iBin];
-                //if (value >= threshold) newData.AddPoint(iBin, KTDiscriminatedPoints1DData::Point(binWidth * ((double)iBin + 0.5), value, threshold), iComponent);
-                if (value >= threshold)
-                {
-                    double neighborhoodAmplitude = 0.;
-                    this->SumAdjacentBinAmplitude(spectrum, neighborhoodAmplitude, iBin);
-                    neighborhoodAmplitude = neighborhoodAmplitude - (2* fNeighborhoodRadius ) * mean;
-
-                    newData.AddPoint(iBin, KTDiscriminatedPoints1DData::Point(binWidth * ((double)iBin), value, threshold, mean, variance, neighborhoodAmplitude), iComponent);
-                }
-            }
-            KTDEBUG(sdlog, "Component " << iComponent << " has " << newData.GetSetOfPoints(iComponent).size() << " points above threshold");
+            unsigned firstValueBin, nValues;
+            GetValueRange(spectrum->size(), firstValueBin, nValues);
+            const double* values = GetValues(spectrum, firstValueBin, nValues, fValueBuffer);
 
+            DiscriminateValues(values, firstValueBin, nValues, norm, pcData, binWidth, newData, iComponent);
         }
         KTINFO(sdlog, "Completed discrimination on " << nComponents << " components");
 
@@ -305,70 +299,22 @@ namespace Katydid
                 return false;
             }
 
-            double mean = 0., variance = 0.;
-            if (! pcData.empty())
-            {
-                mean = pcData[iComponent].fMean;
-                variance = pcData[iComponent].fVariance;
-            }
-            else
-            {
-                for (unsigned iBin=fMinBin; iBin<=fMaxBin; ++iBin)
-                {
-                    mean += (*spectrum)(iBin).abs();
-                    variance += (*spectrum)(iBin).abs() * (*spectrum)(iBin).abs();
-                }
-                mean *= norm;
-                variance = variance*norm - mean*mean;
-            }
-
-            double threshold = 0.;
-            if (fThresholdMode == eSNR_Amplitude)
-            {
-                // SNR = P_signal / P_noise = (A_signal / A_noise)^2, A_noise = mean
-                threshold = sqrt(fSNRThreshold) * mean;
-                KTDEBUG(sdlog, "Discriminator threshold for channel " << iComponent << " set at <" << threshold << "> (SNR mode)");
-            }
-            else if (fThresholdMode == eSNR_Power)
-            {
-                // SNR = P_signal / P_noise, P_noise = mean
-                threshold = fSNRThreshold * mean;
-                KTDEBUG(sdlog, "Discriminator threshold for channel " << iComponent << " set at <" << threshold << "> (SNR mode)");
-            }
-            else if (fThresholdMode == eSigma)
-            {
-                threshold = mean + fSigmaThreshold * sqrt(variance);
-                KTDEBUG(sdlog, "Discriminator threshold for channel " << iComponent << " set at <" << threshold << "> (Sigma mode; mean = " << mean << "; variance = " << variance << ")");
-            }
-
-            // loop over bins, checking against the threshold
-
-            //std::stringstream printer;
-            for (unsigned iBin=fMinBin; iBin<=fMaxBin; ++iBin)
-            {
-                double value = (*spectrum)(iBin).abs();
-                if (value >= threshold)
-                {
-                    //printer << "   " << iBin << " -- " << value;
-                    //newData.AddPoint(iBin, KTDiscriminatedPoints1DData::Point(binWidth * ((double)iBin + 0.5), value, threshold), iComponent);
-                    double neighborhoodAmplitude = 0.;
-                    this->SumAdjacentBinAmplitude(spectrum, neighborhoodAmplitude, iBin);
-                    neighborhoodAmplitude = neighborhoodAmplitude - (2* fNeighborhoodRadius ) * mean;
-
-                    newData.AddPoint(iBin, KTDiscriminatedPoints1DData::Point(binWidth * ((double)iBin), value, threshold, mean, variance, neighborhoodAmplitude), iComponent);
-                }
-            }
+            unsigned firstValueBin, nValues;
+            GetValueRange(spectrum->size(), firstValueBin, nValues);
+            const double* values = GetValues(spectrum, firstValueBin, nValues, fValueBuffer);
 
-            KTDEBUG(sdlog, "Component " << iComponent << " has " << newData.GetSetOfPoints(iComponent).size() << " points above threshold");
-            //KTDEBUG(sdlog, printer.str());
+            DiscriminateValues(values, firstValueBin, nValues, norm, pcData, binWidth, newData, iComponent);
         }
         KTINFO(sdlog, "Completed discrimination on " << nComponents << " components");
 
         return true;
     }
 
-    bool KTSpectrumDiscriminator::CoreDiscriminate(KTPowerSpectrumDataCore& data, KTDiscriminatedPoints1DData& newData, std::vector< PerComponentInfo > pcData)
+    template< class XPowerSpectrumDataCore >
+    bool KTSpectrumDiscriminator::CoreDiscriminatePower(XPowerSpectrumDataCore& data, KTDiscriminatedPoints1DData& newData, const std::vector< PerComponentInfo >& pcData)
     {
+        typedef typename XPowerSpectrumDataCore::spectrum_type spectrum_type;
+
         if (fCalculateMinBin)
         {
             SetMinBin(data.GetSpectrum(0)->FindBin(fMinFrequency));
@@ -392,97 +338,110 @@ namespace Katydid
 
         for (unsigned iComponent=0; iComponent<nComponents; ++iComponent)
         {
-            const KTPowerSpectrum* spectrum = data.GetSpectrum(iComponent);
+            const spectrum_type* spectrum = data.GetSpectrum(iComponent);
             if (spectrum == NULL)
             {
                 KTERROR(sdlog, "Frequency spectrum pointer (component " << iComponent << ") is NULL!");
                 return false;
             }
 
-            double mean = 0., variance = 0.;
-            if (! pcData.empty())
-            {
-                mean = pcData[iComponent].fMean;
-                variance = pcData[iComponent].fVariance;
-            }
-            else
-            {
-#pragma omp parallel for reduction(+:mean)
-                for (unsigned iBin=fMinBin; iBin<=fMaxBin; ++iBin)
-                {
-                    mean += (*spectrum)(iBin);
-                    variance += (*spectrum)(iBin) * (*spectrum)(iBin);
-                }
-                mean *= norm;
-                variance = variance*norm - mean*mean;
-            }
-
-            double threshold = 0.;
-            if (fThresholdMode == eSNR_Amplitude)
-            {
-                // SNR = P_signal / P_noise = (A_signal / A_noise)^2, A_noise = mean
-                threshold = sqrt(fSNRThreshold) * mean;
-                KTDEBUG(sdlog, "Discriminator threshold for channel " << iComponent << " set at <" << threshold << "> (SNR mode)");
-            }
-            else if (fThresholdMode == eSNR_Power)
-            {
-                // SNR = P_signal / P_noise, P_noise = mean
-                threshold = fSNRThreshold * mean;
-                KTDEBUG(sdlog, "Discriminator threshold for channel " << iComponent << " set at <" << threshold << "> (SNR mode)");
-            }
-            else if (fThresholdMode == eSigma)
-            {
-                threshold = mean + fSigmaThreshold * sqrt(variance);
-                KTDEBUG(sdlog, "Discriminator threshold for channel " << iComponent << " set at <" << threshold << "> (Sigma mode; mean = " << mean << "; variance = " << variance << ")");
-            }
-
-            // loop over bins, checking against the threshold
-
-#pragma omp parallel for private(value)
-            for (unsigned iBin=fMinBin; iBin<=fMaxBin; ++iBin)
-            {
-                double value = (*spectrum)(iBin);
-                if (value >= threshold)
-                {
-                    double neighborhoodAmplitude = 0.;
-                    this->SumAdjacentBinAmplitude(spectrum, neighborhoodAmplitude, iBin);
-                    neighborhoodAmplitude = neighborhoodAmplitude - (2* fNeighborhoodRadius ) * mean;
-
-                    newData.AddPoint(iBin, KTDiscriminatedPoints1DData::Point(binWidth * ((double)iBin), value, threshold, mean, variance, neighborhoodAmplitude), iComponent);
-                }
-            }
-            KTDEBUG(sdlog, "Component " << iComponent << " has " << newData.GetSetOfPoints(iComponent).size() << " points above threshold");
+            // statistics are accumulated in double for either precision
+            unsigned firstValueBin, nValues;
+            GetValueRange(spectrum->size(), firstValueBin, nValues);
+            const double* values = GetValues(spectrum, firstValueBin, nValues, fValueBuffer);
 
+            DiscriminateValues(values, firstValueBin, nValues, norm, pcData, binWidth, newData, iComponent);
         }
         KTINFO(sdlog, "Completed discrimination on " << nComponents << " components");
 
         return true;
     }
 
-    void KTSpectrumDiscriminator::SumAdjacentBinAmplitude(const KTPowerSpectrum* spectrum, double& neighborhoodAmplitude, const unsigned& iBin)
+    bool KTSpectrumDiscriminator::CoreDiscriminate(KTPowerSpectrumDataCore& data, KTDiscriminatedPoints1DData& newData, std::vector< PerComponentInfo > pcData)
     {
-        neighborhoodAmplitude = 0;
-        for (unsigned jBin = iBin-fNeighborhoodRadius; jBin<= iBin+fNeighborhoodRadius; ++jBin)
-        {
-            neighborhoodAmplitude += (*spectrum)(jBin);
-        }
+        return CoreDiscriminatePower(data, newData, pcData);
     }
-    void KTSpectrumDiscriminator::SumAdjacentBinAmplitude(const KTFrequencySpectrumFFTW* spectrum, double& neighborhoodAmplitude, const unsigned& iBin)
+
+    bool KTSpectrumDiscriminator::CoreDiscriminate(KTPowerSpectrumDataFCore& data, KTDiscriminatedPoints1DData& newData, std::vector< PerComponentInfo > pcData)
     {
-        neighborhoodAmplitude = 0;
-        for (unsigned jBin = iBin-fNeighborhoodRadius; jBin<= iBin+fNeighborhoodRadius; ++jBin)
-        {
-            neighborhoodAmplitude += spectrum->GetAbs(jBin);
-        }
+        return CoreDiscriminatePower(data, newData, pcData);
     }
-    void KTSpectrumDiscriminator::SumAdjacentBinAmplitude(const KTFrequencySpectrumPolar* spectrum, double& neighborhoodAmplitude, const unsigned& iBin)
+
+    void KTSpectrumDiscriminator::GetValueRange(unsigned spectrumSize, unsigned& firstValueBin, unsigned& nValues) const
     {
-        neighborhoodAmplitude = 0;
-        for (unsigned jBin = iBin-fNeighborhoodRadius; jBin<= iBin+fNeighborhoodRadius; ++jBin)
+        // the neighborhood of each bin in [fMinBin, fMaxBin] is included, clipped to the spectrum
+        unsigned radius = fNeighborhoodRadius > 0 ? unsigned(fNeighborhoodRadius) : 0;
+        firstValueBin = fMinBin > radius ? fMinBin - radius : 0;
+        unsigned lastValueBin = std::min(fMaxBin + radius, spectrumSize - 1);
+        nValues = lastValueBin - firstValueBin + 1;
+        return;
+    }
+
+    void KTSpectrumDiscriminator::DiscriminateValues(const double* values, unsigned firstValueBin, unsigned nValues, double norm, const std::vector< PerComponentInfo >& pcData, double binWidth, KTDiscriminatedPoints1DData& newData, unsigned iComponent)
+    {
+        const double* rangeValues = values + (fMinBin - firstValueBin);
+        unsigned nBins = fMaxBin - fMinBin + 1;
+
+        double mean = 0., variance = 0.;
+        if (! pcData.empty())
         {
-            neighborhoodAmplitude += (*spectrum)(jBin).abs();
+            mean = pcData[iComponent].fMean;
+            variance = pcData[iComponent].fVariance;
         }
-    }
+        else
+        {
+            double sum = 0., sumOfSquares = 0.;
+            KTThresholdKernels::SumAndSumOfSquares(rangeValues, nBins, sum, sumOfSquares);
+            mean = sum * norm;
+            variance = sumOfSquares * norm - mean*mean;
+        }
+
+        double threshold = 0.;
+        if (fThresholdMode == eSNR_Amplitude)
+        {
+            // SNR = P_signal / P_noise = (A_signal / A_noise)^2, A_noise = mean
+            threshold = sqrt(fSNRThreshold) * mean;
+            KTDEBUG(sdlog, "Discriminator threshold for channel " << iComponent << " set at <" << threshold << "> (SNR mode)");
+        }
+        else if (fThresholdMode == eSNR_Power)
+        {
+            // SNR = P_signal / P_noise, P_noise = mean
+            threshold = fSNRThreshold * mean;
+            KTDEBUG(sdlog, "Discriminator threshold for channel " << iComponent << " set at <" << threshold << "> (SNR mode)");
+        }
+        else if (fThresholdMode == eSigma)
+        {
+            threshold = mean + fSigmaThreshold * sqrt(variance);
+            KTDEBUG(sdlog, "Discriminator threshold for channel " << iComponent << " set at <" << threshold << "> (Sigma mode; mean = " << mean << "; variance = " << variance << ")");
+        }
+
+        // indices of the bins above threshold, relative to fMinBin
+        fAboveThreshold.resize(nBins + 4);
+        unsigned nAbove = KTThresholdKernels::FindAboveThreshold(rangeValues, nBins, threshold, fAboveThreshold.data());
+
+        newData.ReservePoints(nAbove, iComponent);
+        if (nAbove != 0)
+        {
+            // neighborhood sums come from the prefix sums: sum of bins [low, high] = prefix[high+1] - prefix[low]
+            fPrefixSums.resize(nValues + 1);
+            KTThresholdKernels::PrefixSums(values, nValues, fPrefixSums.data());
 
+            unsigned radius = fNeighborhoodRadius > 0 ? unsigned(fNeighborhoodRadius) : 0;
+            unsigned lastValueBin = firstValueBin + nValues - 1;
+            for (unsigned iAbove = 0; iAbove < nAbove; ++iAbove)
+            {
+                unsigned iBin = fMinBin + fAboveThreshold[iAbove];
+                unsigned lowBin = iBin > firstValueBin + radius ? iBin - radius : firstValueBin;
+                unsigned highBin = std::min(iBin + radius, lastValueBin);
+                double neighborhoodAmplitude = fPrefixSums[highBin + 1 - firstValueBin] - fPrefixSums[lowBin - firstValueBin];
+                neighborhoodAmplitude = neighborhoodAmplitude - (2* fNeighborhoodRadius ) * mean;
+
+                newData.AddPoint(iBin, KTDiscriminatedPoints1DData::Point(binWidth * ((double)iBin), values[iBin - firstValueBin], threshold, mean, variance, neighborhoodAmplitude), iComponent);
+            }
+        }
+        KTDEBUG(sdlog, "Component " << iComponent << " has " << nAbove << " points above threshold");
+
+        return;
+    }
 
 } /* namespace Katydid */
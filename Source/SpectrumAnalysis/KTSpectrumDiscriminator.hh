@@ -13,6 +13,8 @@
 
 #include "KTSlot.hh"
 
+#include <vector>
+
 
 namespace Katydid
 {
@@ -31,6 +33,9 @@ namespace Katydid
     class KTPowerSpectrum;
     class KTPowerSpectrumData;
     class KTPowerSpectrumDataCore;
+    class KTPowerSpectrumDataF;
+    class KTPowerSpectrumDataFCore;
+    class KTPowerSpectrumF;
     class KTWignerVilleData;
 
 
@@ -64,6 +69,7 @@ namespace Katydid
      - "norm-fs-fftw": void (Nymph::KTDataPtr) -- Discriminates points above a threshold; Requires KTNormalizedFSDataFFTW; Adds KTDiscrimiantedPoints1DData
      - "norm-ps": void (Nymph::KTDataPtr) -- Discriminates points above a threshold; Requires KTNormalizedPSData; Adds KTDiscriminatedPoints1DData
      - "ps": void (Nymph::KTDataPtr) -- Discriminates points above a threshold; Requires KTPowerSpectrumData; Adds KTDiscriminatedPoints1DData
+     - "ps-f": void (Nymph::KTDataPtr) -- Discriminates points above a threshold; Requires KTPowerSpectrumDataF (single precision); Adds KTDiscriminatedPoints1DData
      - "wv": void (Nymph::KTDataPtr) -- Discriminates points above a threshold; Requires KTWignerVilleData; Adds KTDistributedPoints1DData
 
      Signals:
@@ -111,6 +117,7 @@ namespace Katydid
             bool Discriminate(KTFrequencySpectrumDataPolar& data);
             bool Discriminate(KTFrequencySpectrumDataFFTW& data);
             bool Discriminate(KTPowerSpectrumData& data);
+            bool Discriminate(KTPowerSpectrumDataF& data);
             bool Discriminate(KTNormalizedFSDataPolar& data);
             bool Discriminate(KTNormalizedFSDataFFTW& data);
             bool Discriminate(KTNormalizedPSData& data);
@@ -127,10 +134,21 @@ namespace Katydid
             bool CoreDiscriminate(KTFrequencySpectrumDataPolarCore& data, KTDiscriminatedPoints1DData& newData, std::vector< PerComponentInfo > pcData);
             bool CoreDiscriminate(KTFrequencySpectrumDataFFTWCore& data, KTDiscriminatedPoints1DData& newData, std::vector< PerComponentInfo > pcData);
             bool CoreDiscriminate(KTPowerSpectrumDataCore& data, KTDiscriminatedPoints1DData& newData, std::vector< PerComponentInfo > pcData);
+            bool CoreDiscriminate(KTPowerSpectrumDataFCore& data, KTDiscriminatedPoints1DData& newData, std::vector< PerComponentInfo > pcData);
+
+            /// Power spectrum discrimination for either precision; XPowerSpectrumDataCore is KTPowerSpectrumDataCore or KTPowerSpectrumDataFCore
+            template< class XPowerSpectrumDataCore >
+            bool CoreDiscriminatePower(XPowerSpectrumDataCore& data, KTDiscriminatedPoints1DData& newData, const std::vector< PerComponentInfo >& pcData);
+
+            /// Determines the range of bins needed to discriminate [fMinBin, fMaxBin], including the neighborhoods, clipped to the spectrum
+            void GetValueRange(unsigned spectrumSize, unsigned& firstValueBin, unsigned& nValues) const;
+            /// Thresholds bins [fMinBin, fMaxBin] and adds the points to newData; values[0] is the value of bin firstValueBin
+            void DiscriminateValues(const double* values, unsigned firstValueBin, unsigned nValues, double norm, const std::vector< PerComponentInfo >& pcData, double binWidth, KTDiscriminatedPoints1DData& newData, unsigned iComponent);
 
-            void SumAdjacentBinAmplitude(const KTPowerSpectrum* spectrum, double& neighborhoodAmplitude, const unsigned& iBin);
-            void SumAdjacentBinAmplitude(const KTFrequencySpectrumFFTW* spectrum, double& neighborhoodAmplitude, const unsigned& iBin);
-            void SumAdjacentBinAmplitude(const KTFrequencySpectrumPolar* spectrum, double& neighborhoodAmplitude, const unsigned& iBin);
+            // work space, reused from spectrum to spectrum
+            std::vector< double > fValueBuffer;
+            std::vector< double > fPrefixSums;
+            std::vector< unsigned > fAboveThreshold;
 
             //***************
             // Signals
@@ -150,6 +168,7 @@ namespace Katydid
             Nymph::KTSlotDataOneType< KTNormalizedFSDataFFTW > fNormFSFFTWSlot;
             Nymph::KTSlotDataOneType< KTNormalizedPSData > fNormPSSlot;
             Nymph::KTSlotDataOneType< KTPowerSpectrumData > fPSSlot;
+            Nymph::KTSlotDataOneType< KTPowerSpectrumDataF > fPSFSlot;
             Nymph::KTSlotDataOneType< KTCorrelationData > fCorrSlot;
             Nymph::KTSlotDataOneType< KTWignerVilleData > fWVSlot;
 
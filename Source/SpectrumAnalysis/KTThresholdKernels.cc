@@ -0,0 +1,228 @@
+/*
+ * KTThresholdKernels.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "KTThresholdKernels.hh"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define KT_THRESHOLD_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace Katydid
+{
+    namespace
+    {
+        //*************************
+        // Scalar kernels
+        // These are used on CPUs without AVX2, and for the values left over at the end of the vectorized loops
+        //*************************
+
+        void SumAndSumOfSquaresScalar(const double* values, size_t begin, size_t end, double& sum, double& sumOfSquares)
+        {
+            // independent accumulators break the dependency chain on the additions
+            double sums[4] = {0., 0., 0., 0.};
+            double sumsOfSquares[4] = {0., 0., 0., 0.};
+            size_t iValue = begin;
+            for (; iValue + 4 <= end; iValue += 4)
+            {
+                for (unsigned iLane = 0; iLane < 4; ++iLane)
+                {
+                    sums[iLane] += values[iValue + iLane];
+                    sumsOfSquares[iLane] += values[iValue + iLane] * values[iValue + iLane];
+                }
+            }
+            for (; iValue < end; ++iValue)
+            {
+                sums[0] += values[iValue];
+                sumsOfSquares[0] += values[iValue] * values[iValue];
+            }
+            sum += (sums[0] + sums[1]) + (sums[2] + sums[3]);
+            sumOfSquares += (sumsOfSquares[0] + sumsOfSquares[1]) + (sumsOfSquares[2] + sumsOfSquares[3]);
+            return;
+        }
+
+        size_t FindAboveThresholdScalar(const double* values, size_t begin, size_t end, double threshold, unsigned* indices)
+        {
+            // the index is always written, and the output position only advances if the value passes
+            size_t nAbove = 0;
+            for (size_t iValue = begin; iValue < end; ++iValue)
+            {
+                indices[nAbove] = unsigned(iValue);
+                nAbove += values[iValue] >= threshold;
+            }
+            return nAbove;
+        }
+
+        size_t FindAboveThresholdsScalar(const double* values, const double* thresholds, size_t begin, size_t end, unsigned* indices)
+        {
+            size_t nAbove = 0;
+            for (size_t iValue = begin; iValue < end; ++iValue)
+            {
+                indices[nAbove] = unsigned(iValue);
+                nAbove += values[iValue] >= thresholds[iValue];
+            }
+            return nAbove;
+        }
+
+#ifdef KT_THRESHOLD_X86_KERNELS
+        //*************************
+        // AVX2 kernels
+        //*************************
+
+        __attribute__((target("avx2")))
+        void SumAndSumOfSquaresAVX2(const double* values, size_t nValues, double& sum, double& sumOfSquares)
+        {
+            // two sets of accumulators to hide the latency of the additions
+            __m256d sum0 = _mm256_setzero_pd();
+            __m256d sum1 = _mm256_setzero_pd();
+            __m256d sumSq0 = _mm256_setzero_pd();
+            __m256d sumSq1 = _mm256_setzero_pd();
+
+            size_t iValue = 0;
+            for (; iValue + 8 <= nValues; iValue += 8)
+            {
+                __m256d lower = _mm256_loadu_pd(values + iValue);
+                __m256d upper = _mm256_loadu_pd(values + iValue + 4);
+                sum0 = _mm256_add_pd(sum0, lower);
+                sum1 = _mm256_add_pd(sum1, upper);
+                sumSq0 = _mm256_add_pd(sumSq0, _mm256_mul_pd(lower, lower));
+                sumSq1 = _mm256_add_pd(sumSq1, _mm256_mul_pd(upper, upper));
+            }
+
+            double lanes[4];
+            _mm256_storeu_pd(lanes, _mm256_add_pd(sum0, sum1));
+            sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            _mm256_storeu_pd(lanes, _mm256_add_pd(sumSq0, sumSq1));
+            sumOfSquares = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+            SumAndSumOfSquaresScalar(values, iValue, nValues, sum, sumOfSquares);
+            return;
+        }
+
+        // For each 4-bit compare mask, the lanes that passed, packed to the front
+        const int sCompressLanes[16][4] __attribute__((aligned(16))) =
+        {
+            {0, 0, 0, 0}, {0, 0, 0, 0}, {1, 0, 0, 0}, {0, 1, 0, 0},
+            {2, 0, 0, 0}, {0, 2, 0, 0}, {1, 2, 0, 0}, {0, 1, 2, 0},
+            {3, 0, 0, 0}, {0, 3, 0, 0}, {1, 3, 0, 0}, {0, 1, 3, 0},
+            {2, 3, 0, 0}, {0, 2, 3, 0}, {1, 2, 3, 0}, {0, 1, 2, 3}
+        };
+
+        __attribute__((target("avx2,popcnt")))
+        size_t FindAboveThresholdAVX2(const double* values, size_t nValues, double threshold, unsigned* indices)
+        {
+            const __m256d thresholds = _mm256_set1_pd(threshold);
+
+            size_t nAbove = 0;
+            size_t iValue = 0;
+            for (; iValue + 4 <= nValues; iValue += 4)
+            {
+                int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(values + iValue), thresholds, _CMP_GE_OQ));
+                // all four candidate indices are stored; only the ones that passed are kept
+                __m128i passed = _mm_add_epi32(_mm_set1_epi32(int(iValue)), _mm_load_si128(reinterpret_cast< const __m128i* >(sCompressLanes[mask])));
+                _mm_storeu_si128(reinterpret_cast< __m128i* >(indices + nAbove), passed);
+                nAbove += _mm_popcnt_u32(unsigned(mask));
+            }
+            size_t nTail = FindAboveThresholdScalar(values, iValue, nValues, threshold, indices + nAbove);
+            return nAbove + nTail;
+        }
+
+        __attribute__((target("avx2,popcnt")))
+        size_t FindAboveThresholdsAVX2(const double* values, const double* thresholds, size_t nValues, unsigned* indices)
+        {
+            size_t nAbove = 0;
+            size_t iValue = 0;
+            for (; iValue + 4 <= nValues; iValue += 4)
+            {
+                int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(values + iValue), _mm256_loadu_pd(thresholds + iValue), _CMP_GE_OQ));
+                __m128i passed = _mm_add_epi32(_mm_set1_epi32(int(iValue)), _mm_load_si128(reinterpret_cast< const __m128i* >(sCompressLanes[mask])));
+                _mm_storeu_si128(reinterpret_cast< __m128i* >(indices + nAbove), passed);
+                nAbove += _mm_popcnt_u32(unsigned(mask));
+            }
+            size_t nTail = FindAboveThresholdsScalar(values, thresholds, iValue, nValues, indices + nAbove);
+            return nAbove + nTail;
+        }
+#endif /* KT_THRESHOLD_X86_KERNELS */
+
+    } /* anonymous namespace */
+
+
+    namespace KTThresholdKernels
+    {
+        InstructionSet GetInstructionSet()
+        {
+#ifdef KT_THRESHOLD_X86_KERNELS
+            static const InstructionSet instSet = []()
+            {
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) return kAVX2;
+                return kScalar;
+            }();
+            return instSet;
+#else
+            return kScalar;
+#endif
+        }
+
+        std::string GetInstructionSetName(InstructionSet instSet)
+        {
+            switch (instSet)
+            {
+                case kAVX2: return "AVX2";
+                default: return "scalar";
+            }
+        }
+
+        void SumAndSumOfSquares(const double* values, size_t nValues, double& sum, double& sumOfSquares, InstructionSet instSet)
+        {
+#ifdef KT_THRESHOLD_X86_KERNELS
+            if (instSet == kAVX2)
+            {
+                SumAndSumOfSquaresAVX2(values, nValues, sum, sumOfSquares);
+                return;
+            }
+#endif
+            sum = 0.;
+            sumOfSquares = 0.;
+            SumAndSumOfSquaresScalar(values, 0, nValues, sum, sumOfSquares);
+            return;
+        }
+
+        size_t FindAboveThreshold(const double* values, size_t nValues, double threshold, unsigned* indices, InstructionSet instSet)
+        {
+#ifdef KT_THRESHOLD_X86_KERNELS
+            if (instSet == kAVX2)
+            {
+                return FindAboveThresholdAVX2(values, nValues, threshold, indices);
+            }
+#endif
+            return FindAboveThresholdScalar(values, 0, nValues, threshold, indices);
+        }
+
+        size_t FindAboveThresholds(const double* values, const double* thresholds, size_t nValues, unsigned* indices, InstructionSet instSet)
+        {
+#ifdef KT_THRESHOLD_X86_KERNELS
+            if (instSet == kAVX2)
+            {
+                return FindAboveThresholdsAVX2(values, thresholds, nValues, indices);
+            }
+#endif
+            return FindAboveThresholdsScalar(values, thresholds, 0, nValues, indices);
+        }
+
+        void PrefixSums(const double* values, size_t nValues, double* prefixSums)
+        {
+            prefixSums[0] = 0.;
+            for (size_t iValue = 0; iValue < nValues; ++iValue)
+            {
+                prefixSums[iValue + 1] = prefixSums[iValue] + values[iValue];
+            }
+            return;
+        }
+    }
+
+} /* namespace Katydid */
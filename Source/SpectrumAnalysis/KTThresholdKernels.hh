@@ -0,0 +1,47 @@
+/**
+ @file KTThresholdKernels.hh
+ @brief Contains the vectorized kernels used for thresholding spectra
+ @details Running sums, above-threshold index lists and prefix sums, with the instruction set chosen at runtime
+ @author: agent
+ @date: Oct 18, 2026
+ */
+
+#ifndef KTTHRESHOLDKERNELS_HH_
+#define KTTHRESHOLDKERNELS_HH_
+
+#include <cstddef>
+#include <string>
+
+namespace Katydid
+{
+
+    namespace KTThresholdKernels
+    {
+        enum InstructionSet
+        {
+            kScalar,
+            kAVX2
+        };
+
+        /// Returns the best instruction set supported by the CPU we're running on
+        InstructionSet GetInstructionSet();
+        std::string GetInstructionSetName(InstructionSet instSet);
+
+        /// Computes the sum and the sum of squares of nValues values in a single pass
+        void SumAndSumOfSquares(const double* values, size_t nValues, double& sum, double& sumOfSquares, InstructionSet instSet = GetInstructionSet());
+
+        /// Writes the index of every value >= threshold into indices, in increasing order, and returns the number of indices written.
+        /// The compare and compress are branch-free.
+        /// The indices array must have room for nValues + 4 elements (the vectorized version writes past the last index it keeps).
+        size_t FindAboveThreshold(const double* values, size_t nValues, double threshold, unsigned* indices, InstructionSet instSet = GetInstructionSet());
+
+        /// As FindAboveThreshold, but each value has its own threshold: the index of value i is written if values[i] >= thresholds[i].
+        size_t FindAboveThresholds(const double* values, const double* thresholds, size_t nValues, unsigned* indices, InstructionSet instSet = GetInstructionSet());
+
+        /// Fills prefixSums (nValues + 1 elements) such that prefixSums[i] is the sum of the first i values.
+        /// The sum of values [first, last] is then prefixSums[last+1] - prefixSums[first].
+        void PrefixSums(const double* values, size_t nValues, double* prefixSums);
+    }
+
+} /* namespace Katydid */
+#endif /* KTTHRESHOLDKERNELS_HH_ */
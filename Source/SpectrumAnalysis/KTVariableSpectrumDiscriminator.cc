@@ -20,6 +20,7 @@
 #include "KTPowerSpectrumData.hh"
 #include "KTSpectrumCollectionData.hh"
 #include "KTSpline.hh"
+#include "KTThresholdKernels.hh"
 #include "KTWignerVilleData.hh"
 
 #include <cmath>
@@ -53,6 +54,10 @@ namespace Katydid
             fCalculateMinBin(true),
             fCalculateMaxBin(true),
             fNormalize(false),
+            fThresholdCurves(),
+            fNextCurveToReplace(0),
+            fValueBuffer(),
+            fAboveThreshold(),
             fMagnitudeCache(),
             fDiscrim1DSignal("disc-1d", this),
             fDiscrim2DSignal("disc-2d", this),
@@ -281,9 +286,11 @@ namespace Katydid
             KTDEBUG(sdlog, "Spectrogram slice " << sliceNumber << " has " << nPoints << " points above threshold");
 
             // Iterate through the 1D points and add them to the 2D points
-            for( KTDiscriminatedPoints1DData::SetOfPoints::const_iterator pointsIt = newDataSlice.GetSetOfPoints( sliceNumber ).begin(); pointsIt != newDataSlice.GetSetOfPoints( sliceNumber ).end(); ++pointsIt )
+            const KTDiscriminatedPoints1DData::SetOfPoints& slicePoints = newDataSlice.GetSetOfPoints( sliceNumber );
+            for( unsigned iPoint = 0; iPoint < nPoints; ++iPoint )
             {
-                newData.AddPoint( sliceNumber, pointsIt->first, KTDiscriminatedPoints2DData::Point( XbinWidth * ((double)sliceNumber+0.5) + Xmin, YbinWidth * ((double)pointsIt->first+0.5) + Ymin, pointsIt->second.fOrdinate, pointsIt->second.fThreshold, pointsIt->second.fMean, pointsIt->second.fVariance, pointsIt->second.fNeighborhoodAmplitude ), 0 );
+                unsigned bin = slicePoints.GetBin( iPoint );
+                newData.AddPoint( sliceNumber, bin, KTDiscriminatedPoints2DData::Point( XbinWidth * ((double)sliceNumber+0.5) + Xmin, YbinWidth * ((double)bin+0.5) + Ymin, slicePoints.GetOrdinate( iPoint ), slicePoints.GetThreshold( iPoint ), slicePoints.GetMean( iPoint ), slicePoints.GetVariance( iPoint ), slicePoints.GetNeighborhoodAmplitude( iPoint ) ), 0 );
             }
 
             sliceNumber++;
@@ -390,214 +397,195 @@ namespace Katydid
         return true;
     }
 
-    bool KTVariableSpectrumDiscriminator::DiscriminateSpectrum(const KTFrequencySpectrumPolar* spectrum, const KTSpline* spline, const KTSpline* varSpline, KTDiscriminatedPoints1DData& newData, unsigned component)
+    namespace
     {
-        if (spectrum == NULL)
+        // Each of these returns a pointer to the values of bins [firstBin, firstBin + nBins) as contiguous doubles,
+        // either directly from the spectrum or via the buffer
+
+        const double* GetValues(const KTFrequencySpectrumPolar* spectrum, unsigned firstBin, unsigned nBins, vector< double >& buffer)
         {
-            KTERROR(sdlog, "Frequency spectrum pointer (component " << component << ") is NULL!");
-            return false;
+            buffer.resize(nBins);
+            for (unsigned iBin = 0; iBin < nBins; ++iBin)
+            {
+                buffer[iBin] = (*spectrum)(firstBin + iBin).abs();
+            }
+            return buffer.data();
         }
 
-        unsigned nBins = fMaxBin - fMinBin + 1;
-        double binWidth = spectrum->GetBinWidth();
-        double freqMin = spectrum->GetBinLowEdge(fMinBin);
-        double freqMax = spectrum->GetBinLowEdge(fMaxBin) + spectrum->GetBinWidth();
-        std::shared_ptr< KTSpline::Implementation > splineImp = spline->Implement(nBins, freqMin, freqMax);
-        std::shared_ptr< KTSpline::Implementation > varSplineImp = varSpline->Implement(nBins, freqMin, freqMax);
+        const double* GetValues(const KTFrequencySpectrumFFTW* spectrum, unsigned firstBin, unsigned nBins, vector< double >& buffer)
+        {
+            buffer.resize(nBins);
+            for (unsigned iBin = 0; iBin < nBins; ++iBin)
+            {
+                buffer[iBin] = spectrum->GetAbs(firstBin + iBin);
+            }
+            return buffer.data();
+        }
 
-        // Average of each spline
-        double normalizedValue = splineImp->GetMean();
-        double normalizedVariance = varSplineImp->GetMean();
+        const double* GetValues(const KTPowerSpectrum* spectrum, unsigned firstBin, unsigned, vector< double >&)
+        {
+            return spectrum->GetData() + firstBin;
+        }
+    }
 
-        //************
-        // SNR mode
-        //************
-        if (fThresholdMode == eSNR_Amplitude || fThresholdMode == eSNR_Power)
+    const KTVariableSpectrumDiscriminator::ThresholdCurve* KTVariableSpectrumDiscriminator::GetThresholdCurve(const KTSpline* spline, const KTSpline* varSpline, unsigned nBins, double freqMin, double freqMax)
+    {
+        if (spline == NULL)
         {
-            double thresholdMult = 0.;
-            if (fThresholdMode == eSNR_Amplitude)
+            KTERROR(sdlog, "Gain variation spline is NULL!");
+            return NULL;
+        }
+        // the variance is only needed for the threshold in sigma mode, and for normalizing
+        if (varSpline == NULL && (fThresholdMode == eSigma || fNormalize))
+        {
+            KTERROR(sdlog, "Gain variation variance spline is NULL!");
+            return NULL;
+        }
+
+        uint64_t splineID = spline->GetID();
+        uint64_t varSplineID = varSpline == NULL ? 0 : varSpline->GetID();
+        double thresholdSetting = fThresholdMode == eSigma ? fSigmaThreshold : fSNRThreshold;
+
+        for (vector< ThresholdCurve >::const_iterator curveIt = fThresholdCurves.begin(); curveIt != fThresholdCurves.end(); ++curveIt)
+        {
+            if (curveIt->fSplineID == splineID && curveIt->fVarianceSplineID == varSplineID &&
+                curveIt->fThresholds.size() == nBins && curveIt->fFreqMin == freqMin && curveIt->fFreqMax == freqMax &&
+                curveIt->fThresholdMode == fThresholdMode && curveIt->fThresholdSetting == thresholdSetting)
             {
-                // SNR = P_signal / P_noise = (A_signal / A_noise)^2, A_noise = mean
-                thresholdMult = sqrt(fSNRThreshold);
-                KTDEBUG(sdlog, "Discriminator threshold multiplier for component " << component << " set at <" << thresholdMult << "> (SNR-amplitude mode)");
+                return &(*curveIt);
             }
-            else
+        }
+
+        ThresholdCurve* curve = NULL;
+        if (fThresholdCurves.size() < sMaxThresholdCurves)
+        {
+            fThresholdCurves.push_back(ThresholdCurve());
+            curve = &fThresholdCurves.back();
+        }
+        else
+        {
+            curve = &fThresholdCurves[fNextCurveToReplace];
+            fNextCurveToReplace = (fNextCurveToReplace + 1) % sMaxThresholdCurves;
+        }
+
+        KTDEBUG(sdlog, "Calculating threshold curve for splines " << splineID << " and " << varSplineID << " with " << nBins << " bins in [" << freqMin << ", " << freqMax << ")");
+
+        curve->fSplineID = splineID;
+        curve->fVarianceSplineID = varSplineID;
+        curve->fFreqMin = freqMin;
+        curve->fFreqMax = freqMax;
+        curve->fThresholdMode = fThresholdMode;
+        curve->fThresholdSetting = thresholdSetting;
+
+        std::shared_ptr< KTSpline::Implementation > splineImp = spline->Implement(nBins, freqMin, freqMax);
+        curve->fNormalizedValue = splineImp->GetMean();
+        curve->fMeans.resize(nBins);
+        for (unsigned iBin = 0; iBin < nBins; ++iBin)
+        {
+            curve->fMeans[iBin] = (*splineImp)(iBin);
+        }
+
+        curve->fVariances.assign(nBins, 0.);
+        curve->fNormScales.assign(nBins, 0.);
+        curve->fNormalizedVariance = 0.;
+        if (varSpline != NULL)
+        {
+            std::shared_ptr< KTSpline::Implementation > varSplineImp = varSpline->Implement(nBins, freqMin, freqMax);
+            curve->fNormalizedVariance = varSplineImp->GetMean();
+            for (unsigned iBin = 0; iBin < nBins; ++iBin)
             {
-                // SNR = P_signal / P_noise, P_noise = mean
-                thresholdMult = fSNRThreshold;
-                KTDEBUG(sdlog, "Discriminator threshold multiplier for component " << component << " set at <" << thresholdMult << "> (SNR-power mode)");
+                curve->fVariances[iBin] = (*varSplineImp)(iBin);
+                curve->fNormScales[iBin] = sqrt( curve->fNormalizedVariance / curve->fVariances[iBin] );
             }
+        }
 
-            // loop over bins, checking against the threshold
-#pragma omp parallel for private(value)
-            for (unsigned iBin=fMinBin; iBin<=fMaxBin; ++iBin)
+        curve->fThresholds.resize(nBins);
+        if (fThresholdMode == eSNR_Amplitude || fThresholdMode == eSNR_Power)
+        {
+            // SNR-amplitude: SNR = P_signal / P_noise = (A_signal / A_noise)^2, A_noise = mean
+            // SNR-power: SNR = P_signal / P_noise, P_noise = mean
+            double thresholdMult = fThresholdMode == eSNR_Amplitude ? sqrt(fSNRThreshold) : fSNRThreshold;
+            KTDEBUG(sdlog, "Discriminator threshold multiplier set at <" << thresholdMult << "> (" << (fThresholdMode == eSNR_Amplitude ? "SNR-amplitude" : "SNR-power") << " mode)");
+            for (unsigned iBin = 0; iBin < nBins; ++iBin)
             {
-                double value = (*spectrum)(iBin).abs();
-                double threshold = thresholdMult * (*splineImp)(iBin - fMinBin);
-                double mean = (*splineImp)(iBin - fMinBin);
-                double variance = (*varSplineImp)(iBin - fMinBin);
-                if (value >= threshold)
-                {
-                    double neighborhoodAmplitude = 0.;
-                    this->SumAdjacentBinAmplitude(spectrum, neighborhoodAmplitude, iBin);
-
-                    if( fNormalize )
-                    {
-                        value = normalizedValue + (value - mean) * sqrt( normalizedVariance / variance );
-                        neighborhoodAmplitude = normalizedValue + ( neighborhoodAmplitude - ( 2 * fNeighborhoodRadius+1 ) * mean ) * sqrt( normalizedVariance / variance );
-                        mean = normalizedValue;
-                        variance = normalizedVariance;
-                    }
-                    else
-                    {
-                        neighborhoodAmplitude = neighborhoodAmplitude - ( 2 * fNeighborhoodRadius ) * mean;
-                    }
-
-                    newData.AddPoint(iBin, KTDiscriminatedPoints1DData::Point(binWidth * ((double)iBin), value, threshold, mean, variance, neighborhoodAmplitude), component);
-                }
+                curve->fThresholds[iBin] = thresholdMult * curve->fMeans[iBin];
             }
         }
-        //**************
-        // Sigma mode
-        //**************
         else if (fThresholdMode == eSigma)
         {
-#pragma omp parallel for private(value)
-            for (unsigned iBin=fMinBin; iBin<=fMaxBin; ++iBin)
+            for (unsigned iBin = 0; iBin < nBins; ++iBin)
             {
-                double mean = (*splineImp)(iBin - fMinBin);
-                double variance = (*varSplineImp)(iBin - fMinBin);
-                double threshold = mean + fSigmaThreshold * sqrt( variance );
-                double value = (*spectrum)(iBin).abs();
-
-                if (value >= threshold)
-                {
-                    double neighborhoodAmplitude = 0.;
-                    this->SumAdjacentBinAmplitude(spectrum, neighborhoodAmplitude, iBin);
-                    if( fNormalize )
-                    {
-                        value = normalizedValue + (value - mean) * sqrt( normalizedVariance / variance );
-                        neighborhoodAmplitude = normalizedValue + ( neighborhoodAmplitude - ( 2 * fNeighborhoodRadius+1 ) * mean ) * sqrt( normalizedVariance / variance );
-                        mean = normalizedValue;
-                        variance = normalizedVariance;
-                    }
-                    else
-                    {
-                        neighborhoodAmplitude = neighborhoodAmplitude - ( 2 * fNeighborhoodRadius ) * mean;
-                    }
-
-                    newData.AddPoint(iBin, KTDiscriminatedPoints1DData::Point(binWidth * ((double)iBin), value, threshold, mean, variance, neighborhoodAmplitude), component);
-                }
+                curve->fThresholds[iBin] = curve->fMeans[iBin] + fSigmaThreshold * sqrt( curve->fVariances[iBin] );
             }
         }
 
-        return true;
+        return curve;
     }
 
-    bool KTVariableSpectrumDiscriminator::DiscriminateSpectrum(const KTFrequencySpectrumFFTW* spectrum, const KTSpline* spline, const KTSpline* varSpline, KTDiscriminatedPoints1DData& newData, unsigned component)
+    template< class XSpectrum >
+    void KTVariableSpectrumDiscriminator::AddPointsAboveThreshold(const XSpectrum* spectrum, const double* values, const ThresholdCurve& curve, KTDiscriminatedPoints1DData& newData, unsigned component)
     {
-        if (spectrum == NULL)
-        {
-            KTERROR(sdlog, "Frequency spectrum pointer (component " << component << ") is NULL!");
-            return false;
-        }
-
-        unsigned nBins = fMaxBin - fMinBin + 1;
+        unsigned nBins = curve.fThresholds.size();
         double binWidth = spectrum->GetBinWidth();
-        double freqMin = spectrum->GetBinLowEdge(fMinBin);
-        double freqMax = spectrum->GetBinLowEdge(fMaxBin) + binWidth;
-        std::shared_ptr< KTSpline::Implementation > splineImp = spline->Implement(nBins, freqMin, freqMax);
-        std::shared_ptr< KTSpline::Implementation > varSplineImp = varSpline->Implement(nBins, freqMin, freqMax);
 
-        // Average of each spline
-        double normalizedValue = splineImp->GetMean();
-        double normalizedVariance = varSplineImp->GetMean();
+        // indices of the bins above threshold, relative to fMinBin
+        fAboveThreshold.resize(nBins + 4);
+        unsigned nAbove = KTThresholdKernels::FindAboveThresholds(values, curve.fThresholds.data(), nBins, fAboveThreshold.data());
 
-        //************
-        // SNR mode
-        //************
-        if (fThresholdMode == eSNR_Amplitude || fThresholdMode == eSNR_Power)
+        newData.ReservePoints(nAbove, component);
+        for (unsigned iAbove = 0; iAbove < nAbove; ++iAbove)
         {
-            double thresholdMult = 0.;
-            if (fThresholdMode == eSNR_Amplitude)
+            unsigned iCurveBin = fAboveThreshold[iAbove];
+            unsigned iBin = fMinBin + iCurveBin;
+            double value = values[iCurveBin];
+            double mean = curve.fMeans[iCurveBin];
+            double variance = curve.fVariances[iCurveBin];
+
+            double neighborhoodAmplitude = 0.;
+            this->SumAdjacentBinAmplitude(spectrum, neighborhoodAmplitude, iBin);
+            if( fNormalize )
             {
-                // SNR = P_signal / P_noise = (A_signal / A_noise)^2, A_noise = mean
-                thresholdMult = sqrt(fSNRThreshold);
-                KTDEBUG(sdlog, "Discriminator threshold multiplier for component " << component << " set at <" << thresholdMult << "> (SNR-amplitude mode)");
+                value = curve.fNormalizedValue + (value - mean) * curve.fNormScales[iCurveBin];
+                neighborhoodAmplitude = curve.fNormalizedValue + ( neighborhoodAmplitude - ( 2 * fNeighborhoodRadius+1 ) * mean ) * curve.fNormScales[iCurveBin];
+                mean = curve.fNormalizedValue;
+                variance = curve.fNormalizedVariance;
             }
             else
             {
-                // SNR = P_signal / P_noise, P_noise = mean
-                thresholdMult = fSNRThreshold;
-                KTDEBUG(sdlog, "Discriminator threshold multiplier for component " << component << " set at <" << thresholdMult << "> (SNR-power mode)");
+                neighborhoodAmplitude = neighborhoodAmplitude - ( 2 * fNeighborhoodRadius ) * mean;
             }
 
-            // loop over bins, checking against the threshold
-#pragma omp parallel for private(value)
-            for (unsigned iBin=fMinBin; iBin<=fMaxBin; ++iBin)
-            {
-                double value = spectrum->GetAbs(iBin);
-                double threshold = thresholdMult * (*splineImp)(iBin - fMinBin);
-                double mean = (*splineImp)(iBin - fMinBin);
-                double variance = (*varSplineImp)(iBin - fMinBin);
-
-                if (value >= threshold)
-                {
-                    double neighborhoodAmplitude = 0.;
-                    this->SumAdjacentBinAmplitude(spectrum, neighborhoodAmplitude, iBin);
-                    if( fNormalize )
-                    {
-                        value = normalizedValue + (value - mean) * sqrt( normalizedVariance / variance );
-                        neighborhoodAmplitude = normalizedValue + ( neighborhoodAmplitude - ( 2 * fNeighborhoodRadius+1 ) * mean ) * sqrt( normalizedVariance / variance );
-                        mean = normalizedValue;
-                        variance = normalizedVariance;
-                    }
-                    else
-                    {
-                        neighborhoodAmplitude = neighborhoodAmplitude - ( 2 * fNeighborhoodRadius ) * mean;
-                    }
-
-                    newData.AddPoint(iBin, KTDiscriminatedPoints1DData::Point(binWidth * ((double)iBin), value, threshold, mean, variance, neighborhoodAmplitude), component);
-                }
-            }
+            newData.AddPoint(iBin, KTDiscriminatedPoints1DData::Point(binWidth * ((double)iBin), value, curve.fThresholds[iCurveBin], mean, variance, neighborhoodAmplitude), component);
         }
-        //**************
-        // Sigma mode
-        //**************
-        else if (fThresholdMode == eSigma)
+
+        return;
+    }
+
+    bool KTVariableSpectrumDiscriminator::DiscriminateSpectrum(const KTFrequencySpectrumPolar* spectrum, const KTSpline* spline, const KTSpline* varSpline, KTDiscriminatedPoints1DData& newData, unsigned component)
+    {
+        if (spectrum == NULL)
         {
-#pragma omp parallel for private(value)
-            for (unsigned iBin=fMinBin; iBin<=fMaxBin; ++iBin)
-            {
-                double mean = (*splineImp)(iBin - fMinBin);
-                double variance = (*varSplineImp)(iBin - fMinBin);
-                double threshold = mean + fSigmaThreshold * sqrt( variance );
-                double value = spectrum->GetAbs(iBin);
-                if (value >= threshold)
-                {
-                    double neighborhoodAmplitude = 0.;
-                    this->SumAdjacentBinAmplitude(spectrum, neighborhoodAmplitude, iBin);
-                    if( fNormalize )
-                    {
-                        value = normalizedValue + (value - mean) * sqrt( normalizedVariance / variance );
-                        neighborhoodAmplitude = normalizedValue + ( neighborhoodAmplitude - ( 2 * fNeighborhoodRadius+1 ) * mean ) * sqrt( normalizedVariance / variance );
-                        mean = normalizedValue;
-                        variance = normalizedVariance;
-                    }
-                    else
-                    {
-                        neighborhoodAmplitude = neighborhoodAmplitude - ( 2 * fNeighborhoodRadius ) * mean;
-                    }
-
-                    newData.AddPoint(iBin, KTDiscriminatedPoints1DData::Point(binWidth * ((double)iBin), value, threshold, mean, variance, neighborhoodAmplitude), component);
-                }
-            }
+            KTERROR(sdlog, "Frequency spectrum pointer (component " << component << ") is NULL!");
+            return false;
+        }
+
+        unsigned nBins = fMaxBin - fMinBin + 1;
+        double freqMin = spectrum->GetBinLowEdge(fMinBin);
+        double freqMax = spectrum->GetBinLowEdge(fMaxBin) + spectrum->GetBinWidth();
+        const ThresholdCurve* curve = GetThresholdCurve(spline, varSpline, nBins, freqMin, freqMax);
+        if (curve == NULL)
+        {
+            KTERROR(sdlog, "Unable to calculate the threshold for component " << component);
+            return false;
         }
 
+        const double* values = GetValues(spectrum, fMinBin, nBins, fValueBuffer);
+        AddPointsAboveThreshold(spectrum, values, *curve, newData, component);
+
         return true;
     }
 
-    bool KTVariableSpectrumDiscriminator::DiscriminateSpectrum(const KTPowerSpectrum* spectrum, const KTSpline* spline, const KTSpline* varSpline, KTDiscriminatedPoints1DData& newData, unsigned component)
+    bool KTVariableSpectrumDiscriminator::DiscriminateSpectrum(const KTFrequencySpectrumFFTW* spectrum, const KTSpline* spline, const KTSpline* varSpline, KTDiscriminatedPoints1DData& newData, unsigned component)
     {
         if (spectrum == NULL)
         {
@@ -606,99 +594,43 @@ namespace Katydid
         }
 
         unsigned nBins = fMaxBin - fMinBin + 1;
-        double binWidth = spectrum->GetBinWidth();
         double freqMin = spectrum->GetBinLowEdge(fMinBin);
         double freqMax = spectrum->GetBinLowEdge(fMaxBin) + spectrum->GetBinWidth();
-        std::shared_ptr< KTSpline::Implementation > splineImp = spline->Implement(nBins, freqMin, freqMax);
-        std::shared_ptr< KTSpline::Implementation > varSplineImp = varSpline->Implement(nBins, freqMin, freqMax);
+        const ThresholdCurve* curve = GetThresholdCurve(spline, varSpline, nBins, freqMin, freqMax);
+        if (curve == NULL)
+        {
+            KTERROR(sdlog, "Unable to calculate the threshold for component " << component);
+            return false;
+        }
 
-        // Average of each spline
-        double normalizedValue = splineImp->GetMean();
-        double normalizedVariance = varSplineImp->GetMean();
+        const double* values = GetValues(spectrum, fMinBin, nBins, fValueBuffer);
+        AddPointsAboveThreshold(spectrum, values, *curve, newData, component);
 
-        //************
-        // SNR mode
-        //************
-        if (fThresholdMode == eSNR_Amplitude || fThresholdMode == eSNR_Power)
-        {
-            double thresholdMult = 0.;
-            if (fThresholdMode == eSNR_Amplitude)
-            {
-                // SNR = P_signal / P_noise = (A_signal / A_noise)^2, A_noise = mean
-                thresholdMult = sqrt(fSNRThreshold);
-                KTDEBUG(sdlog, "Discriminator threshold multiplier for component " << component << " set at <" << thresholdMult << "> (SNR-amplitude mode)");
-            }
-            else
-            {
-                // SNR = P_signal / P_noise, P_noise = mean
-                thresholdMult = fSNRThreshold;
-                KTDEBUG(sdlog, "Discriminator threshold multiplier for component " << component << " set at <" << thresholdMult << "> (SNR-power mode)");
-            }
+        return true;
+    }
 
-            // loop over bins, checking against the threshold
-#pragma omp parallel for private(value)
-            for (unsigned iBin=fMinBin; iBin<=fMaxBin; ++iBin)
-            {
-                double value = (*spectrum)(iBin);
-                double mean = (*splineImp)(iBin - fMinBin);
-                double threshold = thresholdMult * mean;
-                double variance = (*varSplineImp)(iBin - fMinBin);
-                if (value >= threshold)
-                {
-                    double neighborhoodAmplitude = 0.;
-                    this->SumAdjacentBinAmplitude(spectrum, neighborhoodAmplitude, iBin);
-                    if( fNormalize )
-                    {
-                        value = normalizedValue + (value - mean) * sqrt( normalizedVariance / variance );
-                        neighborhoodAmplitude = normalizedValue + ( neighborhoodAmplitude - ( 2 * fNeighborhoodRadius+1 ) * mean ) * sqrt( normalizedVariance / variance );
-                        mean = normalizedValue;
-                        variance = normalizedVariance;
-                    }
-                    else
-                    {
-                        neighborhoodAmplitude = neighborhoodAmplitude - ( 2 * fNeighborhoodRadius ) * mean;
-                    }
-
-                    newData.AddPoint(iBin, KTDiscriminatedPoints1DData::Point(binWidth * ((double)iBin), value, threshold, mean, variance, neighborhoodAmplitude), component);
-                }
-            }
+    bool KTVariableSpectrumDiscriminator::DiscriminateSpectrum(const KTPowerSpectrum* spectrum, const KTSpline* spline, const KTSpline* varSpline, KTDiscriminatedPoints1DData& newData, unsigned component)
+    {
+        if (spectrum == NULL)
+        {
+            KTERROR(sdlog, "Frequency spectrum pointer (component " << component << ") is NULL!");
+            return false;
         }
 
-        //**************
-        // Sigma mode
-        //**************
-        else if (fThresholdMode == eSigma)
+        unsigned nBins = fMaxBin - fMinBin + 1;
+        double freqMin = spectrum->GetBinLowEdge(fMinBin);
+        double freqMax = spectrum->GetBinLowEdge(fMaxBin) + spectrum->GetBinWidth();
+        const ThresholdCurve* curve = GetThresholdCurve(spline, varSpline, nBins, freqMin, freqMax);
+        if (curve == NULL)
         {
-#pragma omp parallel for private(value)
-            for (unsigned iBin=fMinBin; iBin<=fMaxBin; ++iBin)
-            {
-                double mean = (*splineImp)(iBin - fMinBin);
-                double variance = (*varSplineImp)(iBin - fMinBin);
-                double threshold = mean + fSigmaThreshold * sqrt( variance );
-                double value = (*spectrum)(iBin);
-                if (value >= threshold)
-                {
-                    double neighborhoodAmplitude = 0.;
-                    this->SumAdjacentBinAmplitude(spectrum, neighborhoodAmplitude, iBin);
-                    if( fNormalize )
-                    {
-                        value = normalizedValue + (value - mean) * sqrt( normalizedVariance / variance );
-                        neighborhoodAmplitude = normalizedValue + ( neighborhoodAmplitude - ( 2 * fNeighborhoodRadius+1 ) * mean ) * sqrt( normalizedVariance / variance );
-                        mean = normalizedValue;
-                        variance = normalizedVariance;
-                    }
-                    else
-                    {
-                        neighborhoodAmplitude = neighborhoodAmplitude - ( 2 * fNeighborhoodRadius ) * mean;
-                    }
-
-                    newData.AddPoint(iBin, KTDiscriminatedPoints1DData::Point(binWidth * ((double)iBin), value, threshold, mean, variance, neighborhoodAmplitude), component);
-                }
-            }
+            KTERROR(sdlog, "Unable to calculate the threshold for component " << component);
+            return false;
         }
 
-        return true;
+        const double* values = GetValues(spectrum, fMinBin, nBins, fValueBuffer);
+        AddPointsAboveThreshold(spectrum, values, *curve, newData, component);
 
+        return true;
     }
 
     void KTVariableSpectrumDiscriminator::SumAdjacentBinAmplitude(const KTPowerSpectrum* spectrum, double& neighborhoodAmplitude, const unsigned& iBin)
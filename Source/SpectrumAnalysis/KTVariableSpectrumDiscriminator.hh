@@ -57,6 +57,10 @@ namespace Katydid
      For (2), set the gain variation data with SetPreCalcGainVar (slot "gv"), and the Discriminate functions with one argument (slots with "-pre").
 
      Abscissa values in the output data are the bin centers on the frequency axis.
+
+     The per-bin thresholds are calculated from the gain-variation splines once, and cached.  The cache is keyed on the identity
+     of the splines (KTSpline::GetID()), the frequency range, and the threshold settings, so as long as the same gain-variation data
+     is in use (e.g. with the "-pre" slots, or for every slice of a spectrogram), the splines are not evaluated again.
   
      Configuration name: "variable-spectrum-discriminator"
 
@@ -166,6 +170,42 @@ namespace Katydid
             void SumAdjacentBinAmplitude(const KTFrequencySpectrumFFTW* spectrum, double& neighborhoodAmplitude, const unsigned& iBin);
             void SumAdjacentBinAmplitude(const KTFrequencySpectrumPolar* spectrum, double& neighborhoodAmplitude, const unsigned& iBin);
 
+            /// Gain-variation mean, variance and threshold for each bin in [fMinBin, fMaxBin], evaluated from one pair of splines
+            struct ThresholdCurve
+            {
+                // cache key
+                uint64_t fSplineID;
+                uint64_t fVarianceSplineID;
+                double fFreqMin;
+                double fFreqMax;
+                ThresholdMode fThresholdMode;
+                double fThresholdSetting;
+
+                double fNormalizedValue; // average of the mean curve
+                double fNormalizedVariance; // average of the variance curve
+                std::vector< double > fMeans;
+                std::vector< double > fVariances;
+                std::vector< double > fThresholds;
+                std::vector< double > fNormScales; // sqrt(fNormalizedVariance / variance), used to normalize
+            };
+
+            /// Returns the cached threshold curve for the splines, binning and current threshold settings, calculating it if necessary.
+            /// The pointer is valid until the next call.  Returns NULL if the curve can't be calculated.
+            const ThresholdCurve* GetThresholdCurve(const KTSpline* spline, const KTSpline* varSpline, unsigned nBins, double freqMin, double freqMax);
+
+            /// Compares values (bins [fMinBin, fMaxBin] of spectrum) to the threshold curve and adds the points above threshold to newData
+            template< class XSpectrum >
+            void AddPointsAboveThreshold(const XSpectrum* spectrum, const double* values, const ThresholdCurve& curve, KTDiscriminatedPoints1DData& newData, unsigned component);
+
+            /// Enough for a few channels with their own gain variation; the oldest curve is replaced beyond this
+            static const unsigned sMaxThresholdCurves = 16;
+            std::vector< ThresholdCurve > fThresholdCurves;
+            unsigned fNextCurveToReplace;
+
+            // work space, reused from spectrum to spectrum
+            std::vector< double > fValueBuffer;
+            std::vector< unsigned > fAboveThreshold;
+
 
             KTGainVariationData fGVData;
             std::vector< double > fMagnitudeCache;
@@ -32,18 +32,21 @@ namespace Katydid
             fWindowSize(1),
             fWindowStride(1),
             fNWindowsToAverage(1),
+            fNPairThreads(1),
             fFirstHeader(),
             fSecondHeader(),
             fReceivedLastData(false),
             fBuffer(),
             fSliceSampleOffset(0),
-            fAdvanceStartIteratorOnNewSlice(false),
+            fAdvanceStartOnNewSlice(false),
             fSliceBreak(),
-            fInputArray(new KTTimeSeriesFFTW({0., 0.}, 1,0.,1.)),
+            fThreadPool(1),
+            fInputArrays(),
             fUseWindowFunction(false),
             fWindower(new KTWindower()),
             fFFT(new KTForwardFFTW()),
             fOutputArrays(),
+            fNewSpectra(),
             fOutputData(new Nymph::KTData()),
             fOutputSHData(NULL),
             fOutputWVData(NULL),
@@ -59,7 +62,11 @@ namespace Katydid
 
     KTWignerVille::~KTWignerVille()
     {
-        delete fInputArray;
+        while (! fInputArrays.empty())
+        {
+            delete fInputArrays.back();
+            fInputArrays.pop_back();
+        }
         delete fFFT;
         while (! fOutputArrays.empty())
         {
@@ -98,6 +105,7 @@ namespace Katydid
         SetWindowSize(node->get_value< unsigned >("window-size", fWindowSize));
         SetWindowStride(node->get_value< unsigned >("window-stride", fWindowStride));
         SetNWindowsToAverage(node->get_value< unsigned >("n-windows-to-average", fNWindowsToAverage));
+        SetNPairThreads(node->get_value< unsigned >("n-pair-threads", fNPairThreads));
 
         return true;
     }
@@ -125,9 +133,19 @@ namespace Katydid
 
         double timeBW = 1. / acqRate;
 
-        // initialize the input array
-        delete fInputArray;
-        fInputArray = new KTTimeSeriesFFTW({0., 0.}, fWindowSize, 0., double(fWindowSize) * timeBW);
+        // initialize the threads, and an input array for each of them
+        if (fNPairThreads == 0) fNPairThreads = 1;
+        fThreadPool.SetNThreads(fNPairThreads);
+        while (! fInputArrays.empty())
+        {
+            delete fInputArrays.back();
+            fInputArrays.pop_back();
+        }
+        for (unsigned iThread = 0; iThread < fNPairThreads; ++iThread)
+        {
+            fInputArrays.push_back(new KTTimeSeriesFFTW({0., 0.}, fWindowSize, 0., double(fWindowSize) * timeBW));
+        }
+        fNewSpectra.assign(nPairs, NULL);
 
         // initialize the output arrays
         if (fNWindowsToAverage > 1)
@@ -144,18 +162,19 @@ namespace Katydid
             }
         }
 
-        // initialize the circular buffer
+        // initialize the ring buffers
+        // at most a window's worth of samples is left over from one slice when the next arrives
         fBuffer.resize(nComponents);
         fSliceBreak.resize(nComponents);
         for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
         {
-            fBuffer[iComponent].clear();
-            fBuffer[iComponent].set_capacity(inputSliceSize + fWindowSize);
-            fSliceBreak[iComponent] = fBuffer[iComponent].end();
+            fBuffer[iComponent].Clear();
+            fBuffer[iComponent].Reserve(inputSliceSize + fWindowSize);
+            fSliceBreak[iComponent] = 0;
         }
 
         fSliceSampleOffset = 0;
-        fAdvanceStartIteratorOnNewSlice = false;
+        fAdvanceStartOnNewSlice = false;
 
         // initialize the output data
         fOutputData.reset(new Nymph::KTData());
@@ -217,37 +236,26 @@ namespace Katydid
         return TransformFFTWBasedData(data, header);
     }
 
-    void KTWignerVille::CalculateACF(Buffer::iterator data1It, const Buffer::iterator& data2End, unsigned /*iWindow*/)
+    void KTWignerVille::CalculateACF(const Complex* data1, const Complex* data2, KTTimeSeriesFFTW* inputArray) const
     {
-        // data2It will be decremented before it's used
-        Buffer::iterator data2It = data2End + fWindowSize;
-
-        double t1_real;
-        double t1_imag;
-        double t2_real;
-        double t2_imag;
+        // the second window is used in reverse order
+        const Complex* data2Rev = data2 + (fWindowSize - 1);
 
-        //KTERROR(wvlog, "iWindow = " << iWindow);
-
-        for (unsigned fftBin = 0; fftBin < fWindowSize; fftBin++)
+        Complex* input = inputArray->GetData().data();
+        for (unsigned fftBin = 0; fftBin < fWindowSize; ++fftBin)
         {
-            // decrement data2It first so that it doesn't run past begin() on the first window
-            --data2It;
-            t1_real = data1It->real();
-            t1_imag = data1It->imag();
-            t2_real = data2It->real();
-            t2_imag = data2It->imag();
-
-            fInputArray->SetRect(fftBin, 
-                                    t1_real * t2_real + t1_imag * t2_imag,
+            double t1_real = data1[fftBin].real();
+            double t1_imag = data1[fftBin].imag();
+            double t2_real = data2Rev[-int(fftBin)].real();
+            double t2_imag = data2Rev[-int(fftBin)].imag();
+
+            input[fftBin] = Complex(t1_real * t2_real + t1_imag * t2_imag,
                                     t1_imag * t2_real - t1_real * t2_imag);
-            //KTWARN(wvlog, "  " << fftBin << " -- " << t1_real << "  " << t1_imag << " -- " << t2_real << "  " << t2_imag << " -- " << (*fInputArray)(fftBin)[0] << "  " << (*fInputArray)(fftBin)[1]);
-            ++data1It;
         }
 
         if (fUseWindowFunction)
         {
-            fWindower->ApplyWindow(fInputArray);
+            fWindower->ApplyWindow(inputArray);
         }
 
         return;
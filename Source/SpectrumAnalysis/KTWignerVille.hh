@@ -15,14 +15,14 @@
 #include "KTFrequencySpectrumDataFFTW.hh"
 #include "KTLogger.hh"
 #include "KTMath.hh"
+#include "KTMirroredRingBuffer.hh"
 #include "KTSlot.hh"
 #include "KTSliceHeader.hh"
+#include "KTThreadPool.hh"
 #include "KTTimeSeriesFFTW.hh"
 #include "KTWignerVilleData.hh"
 //#include "KTWV2DData.hh"
 
-#include <boost/circular_buffer.hpp>
-
 #include <complex>
 #include <utility>
 
@@ -47,9 +47,16 @@ namespace Katydid
      @details
 
 
+     The samples of each component are kept in a KTMirroredRingBuffer, so every window is a contiguous run of samples
+     that's read directly when forming the cross products for the FFT input.
+
+     The channel pairs are independent of one another, so each window can have its pairs shared out over a KTThreadPool.
+     Each thread has its own FFT input array, and the spectra are stored in the output data in the order of the pairs,
+     so the output doesn't depend on the number of threads.
+
      Recommendations:
      - There should not be any overlap between the slices produced by the EggProcessor (or whatever source of time series is used).
-       Overlap is not checked for when copying the data from the slices to the circular buffer.
+       Overlap is not checked for when copying the data from the slices to the ring buffer.
      - The slice size produced by the EggProcessor (or other slice source) must be larger than the window size.
      - The Wigner-Ville transform technically has no negative frequency components in the output; This implementation does because
        of the type of DFT that is used. You should follow the WV transform with a switch to polar format that drops the negative
@@ -64,6 +71,8 @@ namespace Katydid
      - "window-size": unsigned -- number of bins to use for the WV window
      - "window-stride": unsigned -- number of bins to skip between WV windows
      - "n-windows-to-average": unsigned -- number of windows to average together into a single WV window
+     - "n-pair-threads": unsigned -- number of threads over which the channel pairs are shared out (default: 1, i.e. the pairs are transformed in order on the calling thread);
+                                     takes effect when the transform is initialized
 
      Slots:
      - "header": void (Nymph::KTDataPtr) -- Initializes the transform using an Egg header; Requires KTEggHeader
@@ -81,7 +90,7 @@ namespace Katydid
             typedef std::vector< UIntPair > PairVector;
 
             typedef std::complex< double > Complex;
-            typedef boost::circular_buffer< Complex > Buffer;
+            typedef KTMirroredRingBuffer< Complex > Buffer;
 
         public:
             KTWignerVille(const std::string& name = "wigner-ville");
@@ -103,6 +112,9 @@ namespace Katydid
             unsigned GetNWindowsToAverage() const;
             void SetNWindowsToAverage(unsigned nAvg);
 
+            unsigned GetNPairThreads() const;
+            void SetNPairThreads(unsigned nThreads);
+
             bool GetUseWindowFunction() const;
             void SetUseWindowFunction(bool flag);
 
@@ -121,6 +133,7 @@ namespace Katydid
             unsigned fWindowSize;
             unsigned fWindowStride;
             unsigned fNWindowsToAverage;
+            unsigned fNPairThreads;
 
         public:
             /// Performs the W-V transform on the given time series data.
@@ -133,8 +146,8 @@ namespace Katydid
             bool TransformFFTWBasedData(XDataType& data, KTSliceHeader& header);
 
             //void CrossMultiplyToInputArray(const KTTimeSeriesFFTW* data1, const KTTimeSeriesFFTW* data2, unsigned offset);
-            // TODO: remove iWindow argument
-            void CalculateACF(Buffer::iterator data1It, const Buffer::iterator& data2End, unsigned iWindow);
+            /// Fills inputArray with the cross products of a window from each channel; both windows are fWindowSize contiguous samples
+            void CalculateACF(const Complex* data1, const Complex* data2, KTTimeSeriesFFTW* inputArray) const;
             void CalculateLaggedACF(const KTTimeSeriesFFTW* data1, const KTTimeSeriesFFTW* data2, unsigned offset);
 
             KTSliceHeader fFirstHeader;
@@ -144,11 +157,12 @@ namespace Katydid
 
             std::vector< Buffer > fBuffer;
             unsigned fSliceSampleOffset;
-            bool fAdvanceStartIteratorOnNewSlice;
+            bool fAdvanceStartOnNewSlice;
 
-            std::vector< Buffer::iterator > fSliceBreak;
+            std::vector< size_t > fSliceBreak; // position in the buffer of the first sample of the most recent slice
 
-            KTTimeSeriesFFTW* fInputArray;
+            KTThreadPool fThreadPool;
+            std::vector< KTTimeSeriesFFTW* > fInputArrays; // one FFT input array per thread
 
             bool fUseWindowFunction;
             KTWindower* fWindower;
@@ -156,6 +170,7 @@ namespace Katydid
             KTForwardFFTW* fFFT;
 
             std::vector< KTFrequencySpectrumFFTW* > fOutputArrays;
+            std::vector< KTFrequencySpectrumFFTW* > fNewSpectra; // results of the first window of a sum, before they're stored in the output data
 
             Nymph::KTDataPtr fOutputData;
             KTSliceHeader* fOutputSHData; // pointer to object that is part of fOutputData
@@ -244,6 +259,17 @@ namespace Katydid
         return;
     }
 
+    inline unsigned KTWignerVille::GetNPairThreads() const
+    {
+        return fNPairThreads;
+    }
+
+    inline void KTWignerVille::SetNPairThreads(unsigned nThreads)
+    {
+        fNPairThreads = nThreads;
+        return;
+    }
+
     inline bool KTWignerVille::GetUseWindowFunction() const
     {
         return fUseWindowFunction;
@@ -315,11 +341,11 @@ namespace Katydid
 
             unsigned nPairs = fOutputWVData->GetNComponents();
 
-            std::vector< unsigned > preCopyBufferSize(nComponents);
+            // the slice that just arrived starts where the buffered data ends
             for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
             {
-                preCopyBufferSize[iComponent] = fBuffer[iComponent].size();
-                KTDEBUG(wvlog, "Pre-copy buffer " << iComponent << " size: " << preCopyBufferSize[iComponent]);
+                fSliceBreak[iComponent] = fBuffer[iComponent].Size();
+                KTDEBUG(wvlog, "Pre-copy buffer " << iComponent << " size: " << fSliceBreak[iComponent]);
             }
 
             // copy the arriving header into fSecondHeader
@@ -332,49 +358,41 @@ namespace Katydid
                 localIsNewAcquisition = true;
                 for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
                 {
-                    fBuffer[iComponent].clear();
+                    fBuffer[iComponent].Clear();
+                    fSliceBreak[iComponent] = 0;
                 }
+                // windows don't carry over from the previous acquisition
+                fSliceSampleOffset = 0;
+                fAdvanceStartOnNewSlice = false;
             }
 
-            // iterators to track where to start the next window
-            std::vector< Buffer::iterator > windowStartIterator(nComponents);
-            // iterators to track where this window ends
-            std::vector< Buffer::iterator > endOfCurrentWindow(nComponents);
+            // positions in the buffer where the next window starts
+            std::vector< size_t > windowStart(nComponents);
+            // positions in the buffer of the last sample in this window
+            std::vector< size_t > endOfCurrentWindow(nComponents);
 
-            // copy the data into the circular buffer
-            for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+            // we should only need to advance the start position if the start of this window
+            // didn't fit in the last slice during the previous iteration
+            size_t firstWindowStart = 0;
+            if (fAdvanceStartOnNewSlice)
             {
-                const KTTimeSeriesFFTW* ts = static_cast< const KTTimeSeriesFFTW* >(data.GetTimeSeries(iComponent));
-                unsigned tsSize = ts->size();
-                for (unsigned iBin = 0; iBin < tsSize; ++iBin)
-                {
-                    fBuffer[iComponent].push_back((*ts)(iBin));
-                }
-                // we should only need to advance the start iterator if the start of this window
-                // didn't fit in the last slice during the previous iteration
-                if (fAdvanceStartIteratorOnNewSlice)
-                {
-                    windowStartIterator[iComponent] = fBuffer[iComponent].begin() + fSliceSampleOffset;
-                    fAdvanceStartIteratorOnNewSlice = false;
-                }
-                else
-                {
-                    windowStartIterator[iComponent] = fBuffer[iComponent].begin();
-                }
+                firstWindowStart = fSliceSampleOffset;
+                fAdvanceStartOnNewSlice = false;
             }
 
-            // set the iterators that point to the break between the slices
+            // copy the data into the ring buffer
             for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
             {
-                fSliceBreak[iComponent] = fBuffer[iComponent].begin() + preCopyBufferSize[iComponent];
-                KTDEBUG(wvlog, "Slice break " << iComponent << " offset: " << fSliceBreak[iComponent] - fBuffer[iComponent].begin());
+                const KTTimeSeriesFFTW* ts = static_cast< const KTTimeSeriesFFTW* >(data.GetTimeSeries(iComponent));
+                fBuffer[iComponent].Append(ts->GetData().data(), ts->size());
+                windowStart[iComponent] = firstWindowStart;
             }
 
             // This is declared outside of the buffer loop so that after the loop we know which slice the last window started in
             bool windowStartInFirstSlice = false;
 
             // loop over the buffer until we get too close to the end to fit another window
-            bool exitBufferLoop = false;
+            bool exitBufferLoop = fBuffer[0].Size() < windowStart[0] + fWindowSize;
             while (! exitBufferLoop)
             {
                 KTDEBUG(wvlog, "Slice sample offset: " << fSliceSampleOffset);
@@ -383,12 +401,12 @@ namespace Katydid
 
                 for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
                 {
-                    endOfCurrentWindow[iComponent] = windowStartIterator[iComponent] + (fWindowSize - 1);
-                    KTDEBUG(wvlog, "End of current window " << iComponent << " offset: " << endOfCurrentWindow[iComponent] - fBuffer[iComponent].begin());
+                    endOfCurrentWindow[iComponent] = windowStart[iComponent] + (fWindowSize - 1);
+                    KTDEBUG(wvlog, "End of current window " << iComponent << " offset: " << endOfCurrentWindow[iComponent]);
                 }
 
                 // a few things need to be done depending on if the window starts in the first slice or the second slice
-                if (windowStartIterator[0] < fSliceBreak[0])
+                if (windowStart[0] < fSliceBreak[0])
                 {
                     windowStartInFirstSlice = true;
                     // set the slice header information if necessary
@@ -430,27 +448,40 @@ namespace Katydid
 
 
                 // analyze the data in the buffer
-                for (unsigned iPair = 0; iPair < nPairs; ++iPair)
+                // each pair is an independent task, using the FFT input array of whichever thread runs it
+                bool startNewSum = fWindowAverageCounter == 0;
+                double timeBW = fInputArrays[0]->GetTimeBinWidth();
+                double freqMin = fFFT->GetMinFrequency(timeBW);
+                double freqMax = fFFT->GetMaxFrequency(timeBW);
+                fThreadPool.ParallelFor(nPairs, [&](unsigned iPair, unsigned iWorker)
                 {
                     unsigned firstChannel = fPairs[iPair].first;
                     unsigned secondChannel =  fPairs[iPair].second;
+                    KTTimeSeriesFFTW* inputArray = fInputArrays[iWorker];
 
-                    Buffer::iterator startWindowFC = windowStartIterator[firstChannel];
-                    Buffer::iterator startWindowSC = windowStartIterator[secondChannel];
-
-                    KTDEBUG(wvlog, "Data remaining in buffer before transform -- ch " << firstChannel << ": " << fBuffer[firstChannel].end() - startWindowFC << "    ch " << secondChannel << ": " << fBuffer[secondChannel].end() - startWindowSC);
-                    CalculateACF(startWindowFC, startWindowSC, fWindowCounter);
-                    //fOutputWVData->SetSpectrum(fFFT->Transform(fInputArray), iWindowInLoop, iPair);
-                    if (fWindowAverageCounter == 0)
+                    // the windows are read straight out of the ring buffers
+                    CalculateACF(fBuffer[firstChannel].GetData(windowStart[firstChannel]), fBuffer[secondChannel].GetData(windowStart[secondChannel]), inputArray);
+                    if (startNewSum)
                     {
-                        fOutputWVData->SetSpectrum(fFFT->Transform(fInputArray), iPair);
+                        fNewSpectra[iPair] = new KTFrequencySpectrumFFTW(fWindowSize, freqMin, freqMax, true);
+                        fFFT->DoTransform(inputArray, fNewSpectra[iPair]);
+                        fNewSpectra[iPair]->SetNTimeBins(fWindowSize);
                     }
                     else
                     {
                         // this is done here with DoTransform to avoid the repeated allocation of new memory
-                        fFFT->DoTransform(fInputArray, fOutputArrays[iPair]);
+                        fFFT->DoTransform(inputArray, fOutputArrays[iPair]);
                         *(fOutputWVData->GetSpectrumFFTW(iPair)) += *(fOutputArrays[iPair]);
                     }
+                });
+
+                if (startNewSum)
+                {
+                    for (unsigned iPair = 0; iPair < nPairs; ++iPair)
+                    {
+                        fOutputWVData->SetSpectrum(fNewSpectra[iPair], iPair);
+                        fNewSpectra[iPair] = NULL;
+                    }
                 }
 
                 ++fWindowCounter;
@@ -480,22 +511,22 @@ namespace Katydid
                 }
 
 
-                // Move the iterators and sample offset counters
+                // Move the start positions and sample offset counters
                 // if this next if statement is true, then we have enough space to move the start of the next window forward
                 // otherwise we'll need to exit (which will happen at the next if statement)
                 // it may still be, of course, that the window itself won't fit
                 // but that's okay; we want to answer that question separately
-                if (fBuffer[0].end() - windowStartIterator[0] > fWindowStride) // (note: this is a comparison to fWindowSTRIDE)
+                if (fBuffer[0].Size() - windowStart[0] > fWindowStride) // (note: this is a comparison to fWindowSTRIDE)
                 {
-                    // the beginning of the next window fits in the buffer, so just move the iterators up by fWindowStride
+                    // the beginning of the next window fits in the buffer, so just move the start positions up by fWindowStride
                     for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
                     {
-                        windowStartIterator[iComponent] += fWindowStride;
+                        windowStart[iComponent] += fWindowStride;
                     }
                     // update fSliceSampleOffset based on component 0
                     // if we're still on the first slice in the buffer, advance the offset
                     // if we're on the second slice, set the offset based on distance from the slice break
-                    if (windowStartIterator[0] < fSliceBreak[0])
+                    if (windowStart[0] < fSliceBreak[0])
                     {
                         // move fSliceSampleOffset along in the first slice
                         fSliceSampleOffset += fWindowStride;
@@ -503,7 +534,7 @@ namespace Katydid
                     else
                     {
                         // the offset we will have in the second slice
-                        fSliceSampleOffset = windowStartIterator[0] - fSliceBreak[0];
+                        fSliceSampleOffset = windowStart[0] - fSliceBreak[0];
                     }
 
                 }
@@ -511,21 +542,21 @@ namespace Katydid
                 {
                     // we are unable to move the start of the next window forward within the buffer.
                     // this offset is how far into the next slice, when its received, we need to start
-                    fSliceSampleOffset = fWindowStride - (fBuffer[0].end() - windowStartIterator[0]);
-                    fAdvanceStartIteratorOnNewSlice = true;
-                    // this change to futureStarWindow will guarantee that the next if statement will cause the buffer loop to exit
-                    // we'll need to update windowStartIterator the next time this method is called; we haven't received the next slice yet, so we can't set pointers to the buffer
+                    fSliceSampleOffset = fWindowStride - (fBuffer[0].Size() - windowStart[0]);
+                    fAdvanceStartOnNewSlice = true;
+                    // everything that's buffered has been used, so it will all be consumed;
+                    // the start position of the next window is set when the next slice arrives
                     for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
                     {
-                        windowStartIterator[iComponent] = fBuffer[iComponent].end();
+                        windowStart[iComponent] = fBuffer[iComponent].Size();
                     }
                 }
 
-                // at this point, windowStartIterator has been updated for the next window
+                // at this point, windowStart has been updated for the next window
 
                 // determine if we need to exit the loop
                 // if this next if statement is true, then we can't fit the next window in what remains of the buffer
-                if (fBuffer[0].end() - windowStartIterator[0] < fWindowSize) // (note: this is a comparison to fWindowSIZE)
+                if (fBuffer[0].Size() - windowStart[0] < fWindowSize) // (note: this is a comparison to fWindowSIZE)
                     exitBufferLoop = true;
 
             } // end of the loop over windows in the buffer
@@ -535,17 +566,8 @@ namespace Katydid
             // remove data that has now been analyzed completely
             for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
             {
-                // just in case the windowStartIterator iterator is beyond the end of the buffer
-                if (! (windowStartIterator[iComponent] < fBuffer[iComponent].end()))
-                    windowStartIterator[iComponent] = fBuffer[iComponent].end();
-
-                // pop from the front until the front reaches windowStartIterator
-                while (fBuffer[iComponent].begin() != windowStartIterator[iComponent])
-                {
-                    fBuffer[iComponent].pop_front();
-                }
-
-                KTDEBUG(wvlog, "Data removed from circular buffer (ch. " << iComponent << "); samples remaining: " << fBuffer[iComponent].end() - fBuffer[iComponent].begin());
+                fBuffer[iComponent].Consume(windowStart[iComponent]);
+                KTDEBUG(wvlog, "Data removed from ring buffer (ch. " << iComponent << "); samples remaining: " << fBuffer[iComponent].Size());
             }
 
             // copy second header data into first header
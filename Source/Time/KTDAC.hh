@@ -49,6 +49,7 @@ namespace Katydid
      - "min-voltage": double -- Set the minimum voltage for the digitizer
      - "voltage-range": double -- Set the full-scale voltage range for the digitizer
      - "n-bits-emulated": unsigned -- Set the number of bits to emulate
+     - "simd-kernels": bool -- Use the vectorized (AVX2/SSE4.1, chosen at runtime) conversion kernels for 8- and 16-bit data; default: true
 
      Slots:
      - "header": void (KTEggHeader*) -- Sets up the DACs with the header information and then updates the contents if the bit depths are being changed; Emits signal "header"
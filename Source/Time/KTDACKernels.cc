@@ -0,0 +1,262 @@
+/*
+ * KTDACKernels.cc
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "KTDACKernels.hh"
+
+#include "KTConstants.hh"
+
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define KT_DAC_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace Katydid
+{
+    namespace
+    {
+        //*************************
+        // Scalar kernels
+        // These are used on CPUs without SSE4.1, and for the samples left over at the end of the vectorized loops
+        //*************************
+
+        template< typename XSampleType, bool XWeighted >
+        inline void LookupScalarRange(const XSampleType* samples, double* output, size_t begin, size_t end, const KTDACKernelParams& params)
+        {
+            // the level offset is 0 for unsigned samples
+            const double* voltages = params.fVoltages + params.fIntLevelOffset;
+            for (size_t iSample = begin; iSample < end; ++iSample)
+            {
+                output[iSample] = XWeighted ? voltages[samples[iSample]] * params.fWeights[iSample] : voltages[samples[iSample]];
+            }
+            return;
+        }
+
+        template< typename XSampleType, bool XWeighted >
+        inline void AffineScalarRange(const XSampleType* samples, double* output, size_t begin, size_t end, const KTDACKernelParams& params)
+        {
+            for (size_t iSample = begin; iSample < end; ++iSample)
+            {
+                double voltage = params.fOffset + params.fGain * double(samples[iSample]);
+                output[iSample] = XWeighted ? voltage * params.fWeights[iSample] : voltage;
+            }
+            return;
+        }
+
+        template< typename XSampleType, bool XWeighted >
+        void LookupScalar(const uint8_t* raw, double* output, size_t nSamples, const KTDACKernelParams& params)
+        {
+            LookupScalarRange< XSampleType, XWeighted >(reinterpret_cast< const XSampleType* >(raw), output, 0, nSamples, params);
+            return;
+        }
+
+        template< typename XSampleType, bool XWeighted >
+        void AffineScalar(const uint8_t* raw, double* output, size_t nSamples, const KTDACKernelParams& params)
+        {
+            AffineScalarRange< XSampleType, XWeighted >(reinterpret_cast< const XSampleType* >(raw), output, 0, nSamples, params);
+            return;
+        }
+
+#ifdef KT_DAC_X86_KERNELS
+        //*************************
+        // Widening: 4 samples --> 4 x int32
+        //*************************
+
+        __attribute__((target("sse4.1")))
+        inline __m128i Widen4(const uint8_t* samples)
+        {
+            int32_t packed;
+            memcpy(&packed, samples, sizeof(packed));
+            return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(packed));
+        }
+
+        __attribute__((target("sse4.1")))
+        inline __m128i Widen4(const int8_t* samples)
+        {
+            int32_t packed;
+            memcpy(&packed, samples, sizeof(packed));
+            return _mm_cvtepi8_epi32(_mm_cvtsi32_si128(packed));
+        }
+
+        __attribute__((target("sse4.1")))
+        inline __m128i Widen4(const uint16_t* samples)
+        {
+            return _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast< const __m128i* >(samples)));
+        }
+
+        __attribute__((target("sse4.1")))
+        inline __m128i Widen4(const int16_t* samples)
+        {
+            return _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast< const __m128i* >(samples)));
+        }
+
+        //*************************
+        // SSE4.1 kernels
+        // There's no gather instruction, so only the affine conversion is vectorized
+        //*************************
+
+        template< typename XSampleType, bool XWeighted >
+        __attribute__((target("sse4.1")))
+        void AffineSSE41(const uint8_t* raw, double* output, size_t nSamples, const KTDACKernelParams& params)
+        {
+            const XSampleType* samples = reinterpret_cast< const XSampleType* >(raw);
+            const __m128d gain = _mm_set1_pd(params.fGain);
+            const __m128d offset = _mm_set1_pd(params.fOffset);
+
+            size_t iSample = 0;
+            for (; iSample + 4 <= nSamples; iSample += 4)
+            {
+                __m128i levels = Widen4(samples + iSample);
+                __m128d lower = _mm_cvtepi32_pd(levels);
+                __m128d upper = _mm_cvtepi32_pd(_mm_unpackhi_epi64(levels, levels));
+                lower = _mm_add_pd(offset, _mm_mul_pd(gain, lower));
+                upper = _mm_add_pd(offset, _mm_mul_pd(gain, upper));
+                if (XWeighted)
+                {
+                    lower = _mm_mul_pd(lower, _mm_loadu_pd(params.fWeights + iSample));
+                    upper = _mm_mul_pd(upper, _mm_loadu_pd(params.fWeights + iSample + 2));
+                }
+                _mm_storeu_pd(output + iSample, lower);
+                _mm_storeu_pd(output + iSample + 2, upper);
+            }
+            AffineScalarRange< XSampleType, XWeighted >(samples, output, iSample, nSamples, params);
+            return;
+        }
+
+        //*************************
+        // AVX2 kernels
+        // FMA is deliberately not enabled, so that offset + gain * sample rounds the same way as the scalar version
+        //*************************
+
+        template< typename XSampleType, bool XWeighted >
+        __attribute__((target("avx2")))
+        void AffineAVX2(const uint8_t* raw, double* output, size_t nSamples, const KTDACKernelParams& params)
+        {
+            const XSampleType* samples = reinterpret_cast< const XSampleType* >(raw);
+            const __m256d gain = _mm256_set1_pd(params.fGain);
+            const __m256d offset = _mm256_set1_pd(params.fOffset);
+
+            size_t iSample = 0;
+            for (; iSample + 8 <= nSamples; iSample += 8)
+            {
+                __m256d lower = _mm256_cvtepi32_pd(Widen4(samples + iSample));
+                __m256d upper = _mm256_cvtepi32_pd(Widen4(samples + iSample + 4));
+                lower = _mm256_add_pd(offset, _mm256_mul_pd(gain, lower));
+                upper = _mm256_add_pd(offset, _mm256_mul_pd(gain, upper));
+                if (XWeighted)
+                {
+                    lower = _mm256_mul_pd(lower, _mm256_loadu_pd(params.fWeights + iSample));
+                    upper = _mm256_mul_pd(upper, _mm256_loadu_pd(params.fWeights + iSample + 4));
+                }
+                _mm256_storeu_pd(output + iSample, lower);
+                _mm256_storeu_pd(output + iSample + 4, upper);
+            }
+            AffineScalarRange< XSampleType, XWeighted >(samples, output, iSample, nSamples, params);
+            return;
+        }
+
+        template< typename XSampleType, bool XWeighted >
+        __attribute__((target("avx2")))
+        void LookupAVX2(const uint8_t* raw, double* output, size_t nSamples, const KTDACKernelParams& params)
+        {
+            const XSampleType* samples = reinterpret_cast< const XSampleType* >(raw);
+            const __m128i levelOffset = _mm_set1_epi32(int32_t(params.fIntLevelOffset));
+            // the masked form of the gather, with every lane enabled, avoids an uninitialized source register
+            const __m256d zero = _mm256_setzero_pd();
+            const __m256d allLanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+
+            size_t iSample = 0;
+            for (; iSample + 8 <= nSamples; iSample += 8)
+            {
+                __m128i lowerIndices = _mm_add_epi32(Widen4(samples + iSample), levelOffset);
+                __m128i upperIndices = _mm_add_epi32(Widen4(samples + iSample + 4), levelOffset);
+                __m256d lower = _mm256_mask_i32gather_pd(zero, params.fVoltages, lowerIndices, allLanes, 8);
+                __m256d upper = _mm256_mask_i32gather_pd(zero, params.fVoltages, upperIndices, allLanes, 8);
+                if (XWeighted)
+                {
+                    lower = _mm256_mul_pd(lower, _mm256_loadu_pd(params.fWeights + iSample));
+                    upper = _mm256_mul_pd(upper, _mm256_loadu_pd(params.fWeights + iSample + 4));
+                }
+                _mm256_storeu_pd(output + iSample, lower);
+                _mm256_storeu_pd(output + iSample + 4, upper);
+            }
+            LookupScalarRange< XSampleType, XWeighted >(samples, output, iSample, nSamples, params);
+            return;
+        }
+#endif /* KT_DAC_X86_KERNELS */
+
+        template< typename XSampleType, bool XWeighted >
+        KTDACKernel SelectKernelForType(bool isAffine, KTDACKernels::InstructionSet instSet)
+        {
+#ifdef KT_DAC_X86_KERNELS
+            if (instSet == KTDACKernels::kAVX2)
+            {
+                return isAffine ? &AffineAVX2< XSampleType, XWeighted > : &LookupAVX2< XSampleType, XWeighted >;
+            }
+            if (instSet == KTDACKernels::kSSE41)
+            {
+                return isAffine ? &AffineSSE41< XSampleType, XWeighted > : &LookupScalar< XSampleType, XWeighted >;
+            }
+#endif
+            return isAffine ? &AffineScalar< XSampleType, XWeighted > : &LookupScalar< XSampleType, XWeighted >;
+        }
+
+        template< typename XSampleType >
+        KTDACKernel SelectKernelForType(bool isAffine, bool isWeighted, KTDACKernels::InstructionSet instSet)
+        {
+            return isWeighted ? SelectKernelForType< XSampleType, true >(isAffine, instSet) : SelectKernelForType< XSampleType, false >(isAffine, instSet);
+        }
+
+    } /* anonymous namespace */
+
+
+    namespace KTDACKernels
+    {
+        InstructionSet GetInstructionSet()
+        {
+#ifdef KT_DAC_X86_KERNELS
+            static const InstructionSet instSet = []()
+            {
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx2")) return kAVX2;
+                if (__builtin_cpu_supports("sse4.1")) return kSSE41;
+                return kScalar;
+            }();
+            return instSet;
+#else
+            return kScalar;
+#endif
+        }
+
+        std::string GetInstructionSetName(InstructionSet instSet)
+        {
+            switch (instSet)
+            {
+                case kAVX2: return "AVX2";
+                case kSSE41: return "SSE4.1";
+                default: return "scalar";
+            }
+        }
+
+        KTDACKernel SelectKernel(unsigned dataTypeSize, uint32_t dataFormat, bool isAffine, bool isWeighted, InstructionSet instSet)
+        {
+            if (dataFormat == sDigitizedUS)
+            {
+                if (dataTypeSize == 1) return SelectKernelForType< uint8_t >(isAffine, isWeighted, instSet);
+                if (dataTypeSize == 2) return SelectKernelForType< uint16_t >(isAffine, isWeighted, instSet);
+            }
+            else if (dataFormat == sDigitizedS)
+            {
+                if (dataTypeSize == 1) return SelectKernelForType< int8_t >(isAffine, isWeighted, instSet);
+                if (dataTypeSize == 2) return SelectKernelForType< int16_t >(isAffine, isWeighted, instSet);
+            }
+            return NULL;
+        }
+    }
+
+} /* namespace Katydid */
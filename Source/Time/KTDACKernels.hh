@@ -0,0 +1,60 @@
+/**
+ @file KTDACKernels.hh
+ @brief Contains the vectorized DAC conversion kernels
+ @details Converts raw 8- and 16-bit digitized samples to voltages, with the instruction set chosen at runtime
+ @author: agent
+ @date: Oct 17, 2026
+ */
+
+#ifndef KTDACKERNELS_HH_
+#define KTDACKERNELS_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Katydid
+{
+
+    /*!
+     @struct KTDACKernelParams
+     @brief Conversion parameters shared by all of the DAC kernels
+
+     @details
+     The lookup kernels use the voltage table directly; the affine kernels use voltage = fOffset + fGain * sample,
+     and are only selected when that reproduces the table exactly.
+    */
+    struct KTDACKernelParams
+    {
+        const double* fVoltages; // voltage lookup table; must cover every value of the sample type
+        int64_t fIntLevelOffset; // added to signed samples to get the table index
+        double fGain;
+        double fOffset;
+        const double* fWeights; // used by the weighted kernels only: each output value is multiplied by the corresponding weight (e.g. a window function)
+    };
+
+    /// Converts nSamples raw samples of one fixed type into nSamples doubles.
+    /// Interleaved I/Q samples can be written straight into an fftw_complex array of nSamples/2 elements.
+    typedef void (*KTDACKernel)(const uint8_t* raw, double* output, size_t nSamples, const KTDACKernelParams& params);
+
+    namespace KTDACKernels
+    {
+        enum InstructionSet
+        {
+            kScalar,
+            kSSE41,
+            kAVX2
+        };
+
+        /// Returns the best instruction set supported by the CPU we're running on
+        InstructionSet GetInstructionSet();
+        std::string GetInstructionSetName(InstructionSet instSet);
+
+        /// Returns the kernel for the given sample format, or NULL if there isn't one (i.e. data types other than 1 or 2 bytes)
+        /// Use isAffine = true if the voltage table is exactly offset + gain * sample.
+        /// Use isWeighted = true to get a kernel that multiplies each output value by KTDACKernelParams::fWeights.
+        KTDACKernel SelectKernel(unsigned dataTypeSize, uint32_t dataFormat, bool isAffine, bool isWeighted = false, InstructionSet instSet = GetInstructionSet());
+    }
+
+} /* namespace Katydid */
+#endif /* KTDACKERNELS_HH_ */
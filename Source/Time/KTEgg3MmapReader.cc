@@ -0,0 +1,510 @@
+/*
+ * KTEgg3MmapReader.cc
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "KTEgg3MmapReader.hh"
+
+#include "KTEggHeader.hh"
+#include "KTLogger.hh"
+#include "KTRawTimeSeries.hh"
+#include "KTRawTimeSeriesData.hh"
+#include "KTSliceHeader.hh"
+
+#include "M3Constants.hh"
+
+#include "H5Cpp.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using std::string;
+using std::vector;
+
+namespace Katydid
+{
+    KTLOGGER(eggreadlog, "KTEgg3MmapReader");
+
+    KT_REGISTER_EGGREADER(KTEgg3MmapReader, "egg3-mmap");
+
+    KTEgg3MmapReader::MappedFile::MappedFile() :
+            fAddress(nullptr),
+            fLength(0)
+    {
+    }
+
+    KTEgg3MmapReader::MappedFile::~MappedFile()
+    {
+        if (fAddress != nullptr)
+        {
+            munmap(fAddress, fLength);
+        }
+    }
+
+
+    KTEgg3MmapReader::KTEgg3MmapReader() :
+            KTEgg3Reader(),
+            fIsMapped(false),
+            fFileAcquisitions(),
+            fFileIndex(0),
+            fMappedFile(),
+            fAcqIndex(0),
+            fSamplePos(0),
+            fLastRecordCounted(-1),
+            fNChannels(0),
+            fDataTypeSize(0),
+            fSampleSize(0),
+            fDataFormat(sInvalidFormat),
+            fChannelFormat(monarch3::sSeparate),
+            fStreamNumber(0),
+            fNBytesInSample(0),
+            fNBytesInRow(0)
+    {
+    }
+
+    KTEgg3MmapReader::~KTEgg3MmapReader()
+    {
+    }
+
+    Nymph::KTDataPtr KTEgg3MmapReader::BreakEgg(const path_vec& filenames)
+    {
+        fIsMapped = false;
+        fMappedFile.reset();
+        fFileAcquisitions.clear();
+
+        // the header is parsed by KTEgg3Reader, which leaves the first file open with Monarch
+        Nymph::KTDataPtr headerPtr = KTEgg3Reader::BreakEgg(filenames);
+        if (! headerPtr) return headerPtr;
+
+        fNChannels = fM3StreamHeader->GetNChannels();
+        fDataTypeSize = fM3StreamHeader->GetDataTypeSize();
+        fSampleSize = fM3StreamHeader->GetSampleSize();
+        fDataFormat = ConvertMonarch3DataFormat(fM3StreamHeader->GetDataFormat());
+        fChannelFormat = fM3StreamHeader->GetChannelFormat();
+        fStreamNumber = fM3StreamHeader->GetNumber();
+        fNBytesInSample = fDataTypeSize * fSampleSize;
+        fNBytesInRow = size_t(fNChannels) * size_t(fRecordSize) * size_t(fNBytesInSample);
+
+        // all of the files have to be mappable; otherwise we use the HDF5 read path for the whole run
+        fFileAcquisitions.resize(fFilenames.size());
+        for (unsigned iFile = 0; iFile < fFilenames.size(); ++iFile)
+        {
+            string reason;
+            if (! ProbeFile(fFilenames[iFile].first, fFileAcquisitions[iFile], reason))
+            {
+                KTWARN(eggreadlog, "File <" << fFilenames[iFile].first << "> cannot be memory-mapped (" << reason << "); falling back to the HDF5 read path");
+                fFileAcquisitions.clear();
+                return headerPtr;
+            }
+        }
+
+        // Monarch is no longer needed
+        KTEgg3Reader::CloseEgg();
+
+        fFileIndex = 0;
+        if (! MapFile(fFilenames[0].first))
+        {
+            return Nymph::KTDataPtr();
+        }
+        fIsMapped = true;
+
+        fAcqIndex = 0;
+        fSamplePos = 0;
+        fLastRecordCounted = -1;
+        ApplyStartOffset();
+
+        // fReadState.fStatus was set to kAtStartOfRun by KTEgg3Reader::BreakEgg
+        return headerPtr;
+    }
+
+    Nymph::KTDataPtr KTEgg3MmapReader::HatchNextSlice()
+    {
+        if (! fIsMapped)
+        {
+            return KTEgg3Reader::HatchNextSlice();
+        }
+
+        if (fReadState.fStatus == MonarchReadState::kInvalid)
+        {
+            KTERROR(eggreadlog, "Read state status is <invalid>. Did you hatch the egg first?");
+            return Nymph::KTDataPtr();
+        }
+
+        bool isNewAcquisition = false;
+        if (fReadState.fStatus == MonarchReadState::kAtStartOfRun)
+        {
+            // the read position was set in BreakEgg
+            isNewAcquisition = true;
+            fSliceNumber = 0;
+        }
+        else
+        {
+            fSamplePos += fStride;
+            ++fSliceNumber;
+        }
+
+        // find an acquisition with enough samples left for the slice; slices do not span acquisitions
+        while (true)
+        {
+            if (fAcqIndex >= fFileAcquisitions[fFileIndex].size())
+            {
+                if (! MapNextFile())
+                {
+                    KTINFO(eggreadlog, "End of egg file reached");
+                    return Nymph::KTDataPtr();
+                }
+                isNewAcquisition = true;
+                continue;
+            }
+            const Acquisition& acq = fFileAcquisitions[fFileIndex][fAcqIndex];
+            if (fSamplePos + fSliceSize <= acq.fNRecords * fRecordSize) break;
+
+            KTDEBUG(eggreadlog, "Reached the end of acquisition " << acq.fAcquisitionId << "; moving to the next acquisition");
+            ++fAcqIndex;
+            fSamplePos = 0;
+            fLastRecordCounted = -1;
+            isNewAcquisition = true;
+        }
+
+        const Acquisition& acq = fFileAcquisitions[fFileIndex][fAcqIndex];
+
+        unsigned startRecordInAcq = fSamplePos / fRecordSize;
+        unsigned startSampleInRecord = fSamplePos % fRecordSize;
+        unsigned lastSample = fSamplePos + fSliceSize - 1;
+        unsigned endRecordInAcq = lastSample / fRecordSize;
+
+        // records are counted the first time any of their samples are used
+        if ((int)endRecordInAcq > fLastRecordCounted)
+        {
+            fRecordsProcessed += endRecordInAcq - std::max((int)startRecordInAcq - 1, fLastRecordCounted);
+            fLastRecordCounted = endRecordInAcq;
+        }
+
+        fReadState.fStatus = MonarchReadState::kContinueReading;
+        fReadState.fCurrentRecord = acq.fFirstRecordId + startRecordInAcq;
+        fReadState.fStartOfLastSliceRecord = fReadState.fCurrentRecord;
+        fReadState.fStartOfLastSliceReadPtr = startSampleInRecord;
+        fReadState.fStartOfSliceAcquisitionId = acq.fAcquisitionId;
+
+        // ask the kernel to start loading the records that the next slice will use
+        Advise(acq, lastSample + 1, fStride, MADV_WILLNEED);
+
+        double timeInRun = TimeInRun(acq, fSamplePos);
+        if (isNewAcquisition)
+        {
+            fAcqTimeInRun = timeInRun;
+        }
+
+        // create the new data object
+        Nymph::KTDataPtr newData(new Nymph::KTData());
+
+        KTSliceHeader& sliceHeader = newData->Of< KTSliceHeader >();
+        sliceHeader = fMasterSliceHeader;
+        sliceHeader.SetIsNewAcquisition(isNewAcquisition);
+        sliceHeader.SetTimeInRun(timeInRun);
+        sliceHeader.SetTimeInAcq(timeInRun - fAcqTimeInRun);
+        sliceHeader.SetSliceNumber(fSliceNumber);
+        sliceHeader.SetStartRecordNumber(acq.fFirstRecordId + startRecordInAcq);
+        sliceHeader.SetStartSampleNumber(startSampleInRecord);
+        sliceHeader.SetEndRecordNumber(acq.fFirstRecordId + endRecordInAcq);
+        sliceHeader.SetEndSampleNumber(lastSample % fRecordSize);
+
+        // the channel's samples are contiguous in the file if there's only one channel, or if the slice stays within one record of a separate-format stream
+        bool sliceIsView = fNChannels == 1 || (fChannelFormat == monarch3::sSeparate && startRecordInAcq == endRecordInAcq);
+
+        uint64_t recordTime = acq.fFirstRecordTime + uint64_t(double(startRecordInAcq * fRecordSize) * fBinWidth / SEC_PER_NSEC);
+
+        KTRawTimeSeriesData& tsData = newData->Of< KTRawTimeSeriesData >().SetNComponents(fNChannels);
+        for (unsigned iChan = 0; iChan < fNChannels; ++iChan)
+        {
+            KTRawTimeSeries* newSlice = nullptr;
+            // nBins = fSliceSize * fSampleSize to allow for real and complex samples
+            if (sliceIsView)
+            {
+                newSlice = new KTRawTimeSeries(fDataTypeSize, fDataFormat, SamplePointer(acq, fSamplePos, iChan),
+                        fSliceSize * fSampleSize, 0., double(fSliceSize) * sliceHeader.GetBinWidth(), fMappedFile);
+            }
+            else
+            {
+                newSlice = new KTRawTimeSeries(fDataTypeSize, fDataFormat,
+                        fSliceSize * fSampleSize, 0., double(fSliceSize) * sliceHeader.GetBinWidth());
+                CopyChannel(acq, fSamplePos, iChan, newSlice->GetStorage());
+            }
+            newSlice->SetSampleSize(fSampleSize);
+            tsData.SetTimeSeries(newSlice, iChan);
+
+            sliceHeader.SetAcquisitionID(acq.fAcquisitionId, iChan);
+            sliceHeader.SetRecordID(acq.fFirstRecordId + startRecordInAcq, iChan);
+            sliceHeader.SetTimeStamp(recordTime, iChan);
+            sliceHeader.SetRawDataFormatType(fHeader.GetChannelHeader( iChan )->GetDataFormat(), iChan);
+        }
+
+        KTDEBUG(eggreadlog, sliceHeader);
+
+        return newData;
+    }
+
+    bool KTEgg3MmapReader::CloseEgg()
+    {
+        if (! fIsMapped)
+        {
+            if (fMonarch == nullptr) return true;
+            return KTEgg3Reader::CloseEgg();
+        }
+        // slices that are still views onto the mapping keep it alive
+        fMappedFile.reset();
+        fIsMapped = false;
+        return true;
+    }
+
+    bool KTEgg3MmapReader::ProbeFile(const scarab::path& filename, vector< Acquisition >& acquisitions, string& reason) const
+    {
+        acquisitions.clear();
+        try
+        {
+            H5::Exception::dontPrint();
+            H5::H5File file(filename.native().c_str(), H5F_ACC_RDONLY);
+            H5::Group acqGroup(file.openGroup("/streams/stream" + std::to_string(fStreamNumber) + "/acquisitions"));
+
+            for (hsize_t iObj = 0; iObj < acqGroup.getNumObjs(); ++iObj)
+            {
+                string acqName = acqGroup.getObjnameByIdx(iObj);
+                H5::DataSet dataset(acqGroup.openDataSet(acqName));
+
+                H5::DSetCreatPropList plist(dataset.getCreatePlist());
+                if (plist.getLayout() != H5D_CONTIGUOUS)
+                {
+                    reason = "acquisition " + acqName + " is not stored contiguously";
+                    return false;
+                }
+                if (plist.getNfilters() != 0)
+                {
+                    reason = "acquisition " + acqName + " is compressed or filtered";
+                    return false;
+                }
+                if (dataset.getDataType().getSize() != fDataTypeSize)
+                {
+                    reason = "acquisition " + acqName + " has an unexpected data type size";
+                    return false;
+                }
+
+                Acquisition acq;
+                acq.fAcquisitionId = std::stoul(acqName);
+
+                uint64_t value = 0;
+                H5::Attribute nRecAttr(dataset.openAttribute("n_records"));
+                nRecAttr.read(H5::PredType::NATIVE_UINT64, &value);
+                acq.fNRecords = (unsigned)value;
+                H5::Attribute recIdAttr(dataset.openAttribute("first_record_id"));
+                recIdAttr.read(H5::PredType::NATIVE_UINT64, &acq.fFirstRecordId);
+                H5::Attribute recTimeAttr(dataset.openAttribute("first_record_time"));
+                recTimeAttr.read(H5::PredType::NATIVE_UINT64, &acq.fFirstRecordTime);
+
+                if (acq.fNRecords == 0) continue;
+
+                hsize_t dims[2] = {0, 0};
+                H5::DataSpace dataspace(dataset.getSpace());
+                if (dataspace.getSimpleExtentNdims() != 2)
+                {
+                    reason = "acquisition " + acqName + " does not have 2 dimensions";
+                    return false;
+                }
+                dataspace.getSimpleExtentDims(dims);
+                if (dims[0] < acq.fNRecords || dims[1] * fDataTypeSize != fNBytesInRow)
+                {
+                    reason = "acquisition " + acqName + " has unexpected dimensions";
+                    return false;
+                }
+
+                acq.fFileOffset = dataset.getOffset();
+                if (acq.fFileOffset == HADDR_UNDEF)
+                {
+                    reason = "acquisition " + acqName + " has no storage allocated";
+                    return false;
+                }
+
+                acquisitions.push_back(acq);
+            }
+        }
+        catch (H5::Exception& e)
+        {
+            reason = e.getDetailMsg();
+            return false;
+        }
+        catch (std::exception& e)
+        {
+            reason = e.what();
+            return false;
+        }
+
+        std::sort(acquisitions.begin(), acquisitions.end(),
+                [](const Acquisition& lhs, const Acquisition& rhs){ return lhs.fAcquisitionId < rhs.fAcquisitionId; });
+        return true;
+    }
+
+    bool KTEgg3MmapReader::MapFile(const scarab::path& filename)
+    {
+        KTINFO(eggreadlog, "Mapping egg file <" << filename << ">");
+
+        int fd = open(filename.native().c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            KTERROR(eggreadlog, "Unable to open file <" << filename << ">: " << strerror(errno));
+            return false;
+        }
+
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0)
+        {
+            KTERROR(eggreadlog, "Unable to determine the size of file <" << filename << ">: " << strerror(errno));
+            close(fd);
+            return false;
+        }
+
+        std::shared_ptr< MappedFile > mapped = std::make_shared< MappedFile >();
+        mapped->fLength = fileStat.st_size;
+        // MAP_PRIVATE + PROT_WRITE makes the mapping copy-on-write, so nothing downstream can modify the file through a slice view
+        void* address = mmap(nullptr, mapped->fLength, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        // the mapping remains valid after the file is closed
+        close(fd);
+        if (address == MAP_FAILED)
+        {
+            KTERROR(eggreadlog, "Unable to map file <" << filename << ">: " << strerror(errno));
+            return false;
+        }
+        mapped->fAddress = static_cast< uint8_t* >(address);
+
+        madvise(mapped->fAddress, mapped->fLength, MADV_SEQUENTIAL);
+
+        // replacing the mapping only drops the reader's reference; slices from the previous file keep it alive
+        fMappedFile = mapped;
+
+        if (! fFileAcquisitions[fFileIndex].empty())
+        {
+            Advise(fFileAcquisitions[fFileIndex][0], 0, std::max(fSliceSize, fStride), MADV_WILLNEED);
+        }
+        return true;
+    }
+
+    bool KTEgg3MmapReader::MapNextFile()
+    {
+        if (fFileIndex + 1 >= fFileAcquisitions.size())
+        {
+            KTINFO(eggreadlog, "There are no more files to open");
+            return false;
+        }
+        ++fFileIndex;
+        ++fCurrentFileIt;
+        fAcqIndex = 0;
+        fSamplePos = 0;
+        fLastRecordCounted = -1;
+        return MapFile(fFilenames[fFileIndex].first);
+    }
+
+    void KTEgg3MmapReader::Advise(const Acquisition& acq, unsigned firstSample, unsigned nSamples, int advice) const
+    {
+        unsigned firstRecord = firstSample / fRecordSize;
+        if (firstRecord >= acq.fNRecords || nSamples == 0) return;
+        unsigned lastRecord = std::min((firstSample + nSamples - 1) / fRecordSize, acq.fNRecords - 1);
+
+        // madvise requires a page-aligned address
+        static const size_t sPageSize = sysconf(_SC_PAGESIZE);
+        size_t begin = acq.fFileOffset + size_t(firstRecord) * fNBytesInRow;
+        size_t end = acq.fFileOffset + size_t(lastRecord + 1) * fNBytesInRow;
+        begin -= begin % sPageSize;
+        if (end > fMappedFile->fLength) end = fMappedFile->fLength;
+        if (end <= begin) return;
+
+        madvise(fMappedFile->fAddress + begin, end - begin, advice);
+        return;
+    }
+
+    void KTEgg3MmapReader::ApplyStartOffset()
+    {
+        uint64_t samplesToSkip = 0;
+        if (fStartRecord == 0 && fStartTime > 0.)
+        {
+            samplesToSkip = uint64_t(fStartTime / fBinWidth);
+        }
+        else if (fStartRecord != 0)
+        {
+            samplesToSkip = uint64_t(fStartRecord) * uint64_t(fRecordSize);
+        }
+        if (samplesToSkip == 0) return;
+
+        KTINFO(eggreadlog, "Starting offset into the run: " << samplesToSkip << " samples");
+        const vector< Acquisition >& acqs = fFileAcquisitions[fFileIndex];
+        while (fAcqIndex < acqs.size() && samplesToSkip >= uint64_t(acqs[fAcqIndex].fNRecords) * uint64_t(fRecordSize))
+        {
+            samplesToSkip -= uint64_t(acqs[fAcqIndex].fNRecords) * uint64_t(fRecordSize);
+            ++fAcqIndex;
+        }
+        fSamplePos = (unsigned)samplesToSkip;
+        return;
+    }
+
+    uint8_t* KTEgg3MmapReader::SamplePointer(const Acquisition& acq, unsigned sample, unsigned channel) const
+    {
+        size_t row = sample / fRecordSize;
+        size_t sampleInRecord = sample % fRecordSize;
+        size_t offset = acq.fFileOffset + row * fNBytesInRow;
+        if (fChannelFormat == monarch3::sInterleaved)
+        {
+            offset += (sampleInRecord * fNChannels + channel) * fNBytesInSample;
+        }
+        else
+        {
+            offset += (size_t(channel) * fRecordSize + sampleInRecord) * fNBytesInSample;
+        }
+        return fMappedFile->fAddress + offset;
+    }
+
+    void KTEgg3MmapReader::CopyChannel(const Acquisition& acq, unsigned firstSample, unsigned channel, uint8_t* dest) const
+    {
+        unsigned sample = firstSample;
+        unsigned samplesRemaining = fSliceSize;
+        while (samplesRemaining > 0)
+        {
+            // copy up to the end of the record
+            unsigned samplesInThisRecord = std::min(samplesRemaining, fRecordSize - sample % fRecordSize);
+            if (fChannelFormat == monarch3::sInterleaved)
+            {
+                const uint8_t* source = SamplePointer(acq, sample, channel);
+                size_t sourceStride = size_t(fNChannels) * fNBytesInSample;
+                for (unsigned iSample = 0; iSample < samplesInThisRecord; ++iSample)
+                {
+                    memcpy(dest, source, fNBytesInSample);
+                    dest += fNBytesInSample;
+                    source += sourceStride;
+                }
+            }
+            else
+            {
+                memcpy(dest, SamplePointer(acq, sample, channel), samplesInThisRecord * fNBytesInSample);
+                dest += samplesInThisRecord * fNBytesInSample;
+            }
+            sample += samplesInThisRecord;
+            samplesRemaining -= samplesInThisRecord;
+        }
+        return;
+    }
+
+    double KTEgg3MmapReader::TimeInRun(const Acquisition& acq, unsigned sample) const
+    {
+        if (fGetTimeInRun == &KTEgg3Reader::GetTimeInRunManually)
+        {
+            // older egg files: assume there are no gaps between records
+            return fBinWidth * (double(acq.fFirstRecordId) * double(fRecordSize) + double(sample));
+        }
+        return double(acq.fFirstRecordTime) * SEC_PER_NSEC + fBinWidth * double(sample);
+    }
+
+} /* namespace Katydid */
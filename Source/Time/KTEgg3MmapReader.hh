@@ -0,0 +1,119 @@
+/**
+ @file KTEgg3MmapReader.hh
+ @brief Contains KTEgg3MmapReader
+ @details Reads Egg3 data files by memory-mapping the record datasets.
+ @author: agent
+ @date: Oct 17, 2026
+ */
+
+#ifndef KTEGG3MMAPREADER_HH_
+#define KTEGG3MMAPREADER_HH_
+
+#include "KTEgg3Reader.hh"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Katydid
+{
+
+    /*!
+     @class KTEgg3MmapReader
+     @author agent
+
+     @brief Egg3 reader that serves slices directly out of a memory-mapped file.
+
+     @details
+     The header is parsed the same way as KTEgg3Reader.  Then each file's acquisition datasets are inspected with HDF5;
+     if every dataset in every file is stored contiguously and without filters (e.g. compression), the files are mapped with mmap
+     and slices are taken straight from the page cache, without going through the HDF5 read path.
+     Otherwise the reader falls back to the regular KTEgg3Reader behavior for the whole run.
+
+     Slices are views onto the mapping (no copy) when the channel's samples for the slice are contiguous in the file:
+     that's always the case for a single channel, and for multiple channels in the "separate" format if the slice lies within one record.
+     Other slices (e.g. interleaved multi-channel data) are copied out of the mapping.
+
+     The mapping is advised with MADV_SEQUENTIAL, and the records covering the next stride are advised with MADV_WILLNEED as each slice is hatched.
+
+     Like KTEgg3Reader, only the stream that contains channel 0 is read.
+
+     Egg reader name: "egg3-mmap"
+    */
+    class KTEgg3MmapReader : public KTEgg3Reader
+    {
+        protected:
+            struct Acquisition
+            {
+                unsigned fAcquisitionId;
+                uint64_t fFirstRecordId;
+                uint64_t fFirstRecordTime; // ns
+                unsigned fNRecords;
+                uint64_t fFileOffset; // byte offset of the dataset in the file
+            };
+
+            struct MappedFile
+            {
+                MappedFile();
+                ~MappedFile();
+                uint8_t* fAddress;
+                size_t fLength;
+            };
+
+        public:
+            KTEgg3MmapReader();
+            virtual ~KTEgg3MmapReader();
+
+        public:
+            /// Opens the egg file(s), and maps them if possible; returns a new copy of the header information.
+            Nymph::KTDataPtr BreakEgg(const path_vec& filenames);
+            /// Returns the next slice's time series data.
+            Nymph::KTDataPtr HatchNextSlice();
+            /// Unmaps (or closes) the file.
+            bool CloseEgg();
+
+            /// Returns true if the files were mapped; false if the reader has fallen back to the HDF5 read path
+            bool GetIsMapped() const;
+
+        private:
+            /// Checks that all of the acquisition datasets in a file can be mapped, and fills in the acquisition information
+            bool ProbeFile(const scarab::path& filename, std::vector< Acquisition >& acquisitions, std::string& reason) const;
+            bool MapFile(const scarab::path& filename);
+            bool MapNextFile();
+            void Advise(const Acquisition& acq, unsigned firstSample, unsigned nSamples, int advice) const;
+            /// Skips the read position ahead according to the start time or start record
+            void ApplyStartOffset();
+
+            uint8_t* SamplePointer(const Acquisition& acq, unsigned sample, unsigned channel) const;
+            void CopyChannel(const Acquisition& acq, unsigned firstSample, unsigned channel, uint8_t* dest) const;
+            double TimeInRun(const Acquisition& acq, unsigned sample) const;
+
+            bool fIsMapped;
+
+            std::vector< std::vector< Acquisition > > fFileAcquisitions;
+            unsigned fFileIndex;
+            std::shared_ptr< MappedFile > fMappedFile;
+
+            unsigned fAcqIndex;
+            unsigned fSamplePos; // per-channel sample position in the current acquisition
+            int fLastRecordCounted; // record in the current acquisition up to which records have been counted as processed
+
+            // stream layout, cached from the first file's header
+            unsigned fNChannels;
+            unsigned fDataTypeSize;
+            unsigned fSampleSize;
+            uint32_t fDataFormat;
+            uint32_t fChannelFormat;
+            unsigned fStreamNumber;
+            unsigned fNBytesInSample;
+            size_t fNBytesInRow; // one row of a dataset holds one record for every channel
+    };
+
+    inline bool KTEgg3MmapReader::GetIsMapped() const
+    {
+        return fIsMapped;
+    }
+
+} /* namespace Katydid */
+
+#endif /* KTEGG3MMAPREADER_HH_ */
@@ -44,6 +44,7 @@ namespace Katydid
             fStartTime(0.),
             fStartRecord(0),
             fRequireMetadata(false),
+            fZeroCopySlices(false),
             //fHatchNextSlicePtr(NULL),
             fFilenames(),
             fCurrentFileIt(),
@@ -54,6 +55,10 @@ namespace Katydid
             fHeader(fHeaderPtr->Of< KTEggHeader >()),
             fMasterSliceHeader(),
             fReadState(),
+            fPinnedRecords(),
+            fPinnedRecordNBytes(0),
+            fPinnedRecordNumber(0),
+            fRecordIsPinned(false),
             fSampleRateUnitsInHz(1.e6),
             fRecordSize(0),
             fBinWidth(0.),
@@ -85,6 +90,7 @@ namespace Katydid
         SetStartTime(eggProc.GetStartTime());
         SetStartRecord(eggProc.GetStartRecord());
         SetRequireMetadata(eggProc.GetRequireMetadata());
+        SetZeroCopySlices(eggProc.GetZeroCopySlices());
         return true;
     }
 
@@ -223,6 +229,8 @@ namespace Katydid
 
         fSliceNumber = 0;
 
+        UnpinRecord();
+
         // set a few values in the master slice header that don't change with each slice
         fMasterSliceHeader.SetSampleRate(fHeader.GetAcquisitionRate());
         fMasterSliceHeader.SetRawSliceSize(fSliceSize);
@@ -235,7 +243,7 @@ namespace Katydid
     }
 
 
-    inline Nymph::KTDataPtr KTEgg3Reader::HatchNextSlice()
+    Nymph::KTDataPtr KTEgg3Reader::HatchNextSlice()
     {
         if (fMonarch == NULL)
         {
@@ -390,15 +398,34 @@ namespace Katydid
             sliceHeader.SetStartRecordNumber(fReadState.fCurrentRecord);
             sliceHeader.SetStartSampleNumber(readPos);
 
-            // create the raw time series objects that will contain the new copies of slices
+            // if the slice lies entirely within the current record, and zero-copy slices were requested,
+            // the new slices will be views onto the pinned record, and nothing needs to be copied below
+            bool sliceIsView = fZeroCopySlices && readPos + fSliceSize <= recordSize;
+            if (sliceIsView)
+            {
+                PinCurrentRecord();
+            }
+
+            // create the raw time series objects that will contain the new copies of slices (or views onto the pinned record)
             // and set some channel-specific slice header info
             vector< KTRawTimeSeries* > newSlices(nChannels);
             for (unsigned iChan = 0; iChan < nChannels; ++iChan)
             {
                 // nBins = fSliceSize * sampleSize to allow for real and complex samples
-                newSlices[iChan] = new KTRawTimeSeries(fM3Stream->GetDataTypeSize(),
-                        ConvertMonarch3DataFormat(fM3StreamHeader->GetDataFormat()),
-                        fSliceSize * sampleSize, 0., double(fSliceSize) * sliceHeader.GetBinWidth());
+                if (sliceIsView)
+                {
+                    newSlices[iChan] = new KTRawTimeSeries(fM3Stream->GetDataTypeSize(),
+                            ConvertMonarch3DataFormat(fM3StreamHeader->GetDataFormat()),
+                            fPinnedRecords[iChan].get() + readPos * nBytesInSample,
+                            fSliceSize * sampleSize, 0., double(fSliceSize) * sliceHeader.GetBinWidth(),
+                            fPinnedRecords[iChan]);
+                }
+                else
+                {
+                    newSlices[iChan] = new KTRawTimeSeries(fM3Stream->GetDataTypeSize(),
+                            ConvertMonarch3DataFormat(fM3StreamHeader->GetDataFormat()),
+                            fSliceSize * sampleSize, 0., double(fSliceSize) * sliceHeader.GetBinWidth());
+                }
                 newSlices[iChan]->SetSampleSize(sampleSize);
 
                 sliceHeader.SetAcquisitionID(fM3Stream->GetAcquisitionId(), iChan);
@@ -412,12 +439,12 @@ namespace Katydid
             // the write position on the new slice
             unsigned writePos = 0;
 
-            // the number of samples still to copy to the new slice
-            unsigned samplesRemainingToCopy = fSliceSize;
+            // the number of samples still to copy to the new slice (none if the slice is a view)
+            unsigned samplesRemainingToCopy = sliceIsView ? 0 : fSliceSize;
 
             // the last sample that will be copied in a record, for each copy
             // the motivation for calculating this (at least initially) is to know the last (record, sample) pair for the slice
-            unsigned lastSampleCopied = 0;
+            unsigned lastSampleCopied = sliceIsView ? readPos + fSliceSize - 1 : 0;
 
             fReadState.fStatus = MonarchReadState::kContinueReading;
 
@@ -574,6 +601,8 @@ namespace Katydid
         {
             return false;
         }
+        // the record numbering may start over in the next file
+        UnpinRecord();
 
         // open the next file
         KTINFO(eggreadlog, "Opening next egg file <" << fCurrentFileIt->first << ">");
@@ -618,6 +647,44 @@ namespace Katydid
     }
 
 
+    void KTEgg3Reader::PinCurrentRecord()
+    {
+        if (fRecordIsPinned && fPinnedRecordNumber == fReadState.fCurrentRecord)
+        {
+            // already pinned; views can share the existing buffers
+            return;
+        }
+
+        unsigned nChannels = fM3Stream->GetNChannels();
+        unsigned nBytesInRecord = fM3Stream->GetChannelRecordSize() * fM3Stream->GetSampleSize() * fM3Stream->GetDataTypeSize();
+
+        fPinnedRecords.resize(nChannels);
+        for (unsigned iChan = 0; iChan < nChannels; ++iChan)
+        {
+            // a buffer can only be reused if no slice view still refers to it
+            if (! fPinnedRecords[iChan] || fPinnedRecords[iChan].use_count() != 1 || fPinnedRecordNBytes != nBytesInRecord)
+            {
+                fPinnedRecords[iChan].reset(new uint8_t[nBytesInRecord], std::default_delete< uint8_t[] >());
+            }
+            memcpy( fPinnedRecords[iChan].get(), fM3Stream->GetChannelRecord( iChan )->GetData(), nBytesInRecord );
+        }
+        KTDEBUG(eggreadlog, "Pinned record " << fReadState.fCurrentRecord << " (" << nBytesInRecord << " bytes per channel)");
+
+        fPinnedRecordNBytes = nBytesInRecord;
+        fPinnedRecordNumber = fReadState.fCurrentRecord;
+        fRecordIsPinned = true;
+        return;
+    }
+
+    void KTEgg3Reader::UnpinRecord()
+    {
+        fPinnedRecords.clear();
+        fPinnedRecordNBytes = 0;
+        fRecordIsPinned = false;
+        return;
+    }
+
+
     bool KTEgg3Reader::CloseEgg()
     {
         try
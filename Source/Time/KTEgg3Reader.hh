@@ -16,6 +16,7 @@
 #include "M3Types.hh"
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -36,6 +37,10 @@ namespace Katydid
     // NOTE: the first version of this KTEgg3Reader operates in much the same way as KTEgg2Reader, and does not take advantage of
     // the flexibility of the full egg3 file format.  In particular, it only uses the channels in stream0 (though it uses as
     // many channels as exist in that stream).
+    //
+    // Zero-copy slices: if ZeroCopySlices is true, a slice that lies entirely within one record is a view onto a pinned copy of that record.
+    // Monarch reuses its record buffer on every read, so the record is copied once into a reference-counted buffer per channel,
+    // and every slice that falls within that record shares the buffer.  Slices that span a record boundary are still copied.
     class KTEgg3Reader : public KTEggReader
     {
         protected:
@@ -73,20 +78,21 @@ namespace Katydid
             MEMBERVARIABLE(double, StartTime);
             MEMBERVARIABLE(unsigned, StartRecord);
             MEMBERVARIABLE(bool, RequireMetadata);
+            MEMBERVARIABLE(bool, ZeroCopySlices);
 
         public:
             bool Configure(const KTEggProcessor& eggProc);
 
             /// Opens the egg file and returns a new copy of the header information.
-            Nymph::KTDataPtr BreakEgg(const path_vec& filenames);
+            virtual Nymph::KTDataPtr BreakEgg(const path_vec& filenames);
             /// Returns the next slice's time series data.
-            Nymph::KTDataPtr HatchNextSlice();
+            virtual Nymph::KTDataPtr HatchNextSlice();
             /// Closes the file.
-            bool CloseEgg();
+            virtual bool CloseEgg();
 
             static unsigned GetMaxChannels();
 
-        private:
+        protected:
             /// Copy header information from the M3Header object
             void CopyHeader(const monarch3::M3Header* monarchHeader);
 
@@ -97,6 +103,11 @@ namespace Katydid
 
             bool LoadNextFile();
 
+            /// Makes sure the currently-loaded record is pinned, so that slice views can refer to it
+            void PinCurrentRecord();
+            /// Drops the reader's reference to the pinned record (views that already exist keep it alive)
+            void UnpinRecord();
+
             //Nymph::KTDataPtr (KTEgg3Reader::*fHatchNextSlicePtr)();
             //Nymph::KTDataPtr HatchNextSliceRealUnsigned();
             //Nymph::KTDataPtr HatchNextSliceRealSigned();
@@ -115,6 +126,11 @@ namespace Katydid
 
             MonarchReadState fReadState;
 
+            std::vector< std::shared_ptr< uint8_t > > fPinnedRecords; // one buffer per channel
+            unsigned fPinnedRecordNBytes;
+            unsigned fPinnedRecordNumber;
+            bool fRecordIsPinned;
+
         public:
             MEMBERVARIABLE_NOSET(double, SampleRateUnitsInHz);
             MEMBERVARIABLE_NOSET(unsigned, RecordSize);
@@ -140,7 +156,7 @@ namespace Katydid
             /// Returns the time since the run started in seconds of the current acquisition
             double GetAcqTimeInRun() const;
 
-        private:
+        protected:
             mutable GetTIRFunction fGetTimeInRun;
             double GetTimeInRunFromMonarch() const;
             double GetTimeInRunManually() const;
@@ -13,6 +13,8 @@
 #include "KTData.hh"
 #include "KTEggHeader.hh"
 #include "KTEggReader.hh"
+#include "KTParallelEggReader.hh"
+#include "KTPrefetchEggReader.hh"
 #include "KTProcSummary.hh"
 #include "KTRawTimeSeriesData.hh"
 #include "KTTimeSeriesData.hh"
@@ -32,6 +34,8 @@ namespace Katydid
 
     KT_REGISTER_PROCESSOR(KTEggProcessor, "egg-processor");
 
+    const unsigned KTEggProcessor::sDefaultParallelQueueDepth = 16;
+
     KTEggProcessor::KTEggProcessor(const std::string& name) :
             KTPrimaryProcessor(name),
             fNSlices(0),
@@ -43,6 +47,9 @@ namespace Katydid
             fStride(1024),
             fStartTime(0.),
             fStartRecord(0),
+            fZeroCopySlices(false),
+            fReadAheadDepth(0),
+            fNParallelFiles(1),
             fDAC(new KTDAC()),
             fNormalizeVoltages(true),
             fHeaderSignal("header", this),
@@ -126,6 +133,12 @@ namespace Katydid
             // specify the time in the run to start
             fStartTime = node->get_value< double >("start-time", fStartTime);
             fStartRecord = node->get_value< unsigned >("start-record", fStartRecord);
+            // whether or not slices can be views onto pinned records
+            fZeroCopySlices = node->get_value< bool >("zero-copy-slices", fZeroCopySlices);
+            // how many slices to read ahead on a background thread (0 to hatch synchronously)
+            fReadAheadDepth = node->get_value< unsigned >("read-ahead-depth", fReadAheadDepth);
+            // how many files of a multi-file run to hatch at once
+            fNParallelFiles = node->get_value< unsigned >("n-parallel-files", fNParallelFiles);
 
             if (fSliceSize == 0)
             {
@@ -170,8 +183,24 @@ namespace Katydid
 
     bool KTEggProcessor::ProcessEgg()
     {
+        if (fFilenames.size() == 0)
+        {
+            KTERROR(egglog, "No files have been specified");
+            return false;
+        }
+
         // Create egg reader and transfer information
-        KTEggReader* reader = scarab::factory< KTEggReader >::get_instance()->create(fEggReaderType);
+        KTEggReader* reader = nullptr;
+        if (fNParallelFiles > 1 && fFilenames.size() > 1)
+        {
+            // the parallel reader creates a reader of type fEggReaderType for each file
+            KTINFO(egglog, "Up to " << fNParallelFiles << " files will be hatched in parallel");
+            reader = new KTParallelEggReader(fEggReaderType, fNParallelFiles, fReadAheadDepth > 0 ? fReadAheadDepth : sDefaultParallelQueueDepth);
+        }
+        else
+        {
+            reader = scarab::factory< KTEggReader >::get_instance()->create(fEggReaderType);
+        }
         if (reader == NULL)
         {
             KTERROR(egglog, "Invalid egg reader type: " << fEggReaderType);
@@ -179,10 +208,14 @@ namespace Katydid
         }
         reader->Configure(*this);
 
-        if (fFilenames.size() == 0)
+        // if requested, slices are hatched on a background thread; the prefetch reader takes ownership of the reader
+        // (the parallel reader already hatches each file on its own thread)
+        KTPrefetchEggReader* prefetchReader = nullptr;
+        if (fReadAheadDepth > 0 && dynamic_cast< KTParallelEggReader* >(reader) == nullptr)
         {
-            KTERROR(egglog, "No files have been specified");
-            return false;
+            KTINFO(egglog, "Slices will be read ahead on a separate thread; queue depth: " << fReadAheadDepth);
+            prefetchReader = new KTPrefetchEggReader(reader, fReadAheadDepth);
+            reader = prefetchReader;
         }
 
         // ******************************************************************** //
@@ -201,6 +234,7 @@ namespace Katydid
         if (! fDAC->InitializeWithHeader(header))
         {
             KTERROR(egglog, "Unable to initialize the DAC");
+            delete reader;
             return false;
         }
 
@@ -230,6 +264,16 @@ namespace Katydid
         fSummarySignal(summary);
         delete summary;
 
+        if (prefetchReader != nullptr)
+        {
+            KTPrefetchEggReader::BackpressureStats stats = prefetchReader->GetBackpressureStats();
+            KTINFO(egglog, "Read-ahead statistics:\n" <<
+                    "\tSlices read ahead: " << stats.fNSlicesQueued << '\n' <<
+                    "\tMaximum queue occupancy: " << stats.fMaxOccupancy << " / " << prefetchReader->GetQueueDepth() << '\n' <<
+                    "\tReader waits (queue full): " << stats.fNProducerWaits << " (" << stats.fProducerWaitTime << " s)\n" <<
+                    "\tProcessing waits (queue empty): " << stats.fNConsumerWaits << " (" << stats.fConsumerWaitTime << " s)");
+        }
+
         delete reader;
 
         return true;
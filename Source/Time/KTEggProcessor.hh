@@ -44,8 +44,10 @@ namespace Katydid
      - "metadata": string or array of strings -- Metadata filenames to use (if present, number of files must match the number of egg files specified)
      - "require-metadata": bool -- Flag to determine whether metadata is required or not (default)
      - "egg-reader": string -- Egg reader to use.
-        Options: "egg3", "egg2", "egg1", "rsamat"
+        Options: "egg3", "egg3-mmap", "egg2", "egg1", "rsamat"
         - "egg3" - Uses the monarch3 library to read Egg files
+        - "egg3-mmap" - Like "egg3", but memory-maps the files and serves slices from the page cache
+           when the record datasets are contiguous and uncompressed (falls back to "egg3" otherwise)
         - "egg2" - Uses the monarch2 library to read Egg files
         - "egg1" - uses the old style Egg reader, which opens and reads the
            contents of the Egg file directly
@@ -58,6 +60,13 @@ namespace Katydid
          between slices)
      - "start-time": double -- Specify how far into the file to start (in seconds); if "start-record" is non-zero, this will be ignored
      - "start-record": unsigned -- Specify which record to start on; if "start-time" is present and this is non-zero, start-time will be ignored
+     - "zero-copy-slices": bool -- If true, slices that lie entirely within one record refer to a shared, pinned copy of that record
+        instead of being copied out individually (default: false); currently only used by the "egg3" reader
+     - "read-ahead-depth": unsigned -- If non-zero, slices are hatched on a background thread and up to this many
+        slices are read ahead of the processing chain (default: 0, i.e. slices are hatched synchronously)
+     - "n-parallel-files": unsigned -- For multi-file runs, the number of files to open and hatch concurrently, each on its own thread;
+        slices are merged in time order (default: 1, i.e. files are read one after another).
+        Each file's queue depth is "read-ahead-depth", or 16 if that's not set.
      - "normalize-voltages": bool -- Flag to toggle the normalization of ADC
         values from the egg file (default: true)
      - "dac": object -- configure the DAC
@@ -104,12 +113,17 @@ namespace Katydid
             MEMBERVARIABLE(unsigned, Stride);
             MEMBERVARIABLE(double, StartTime); // will only be used if fStartRecord is 0
             MEMBERVARIABLE(unsigned, StartRecord);
+            MEMBERVARIABLE(bool, ZeroCopySlices);
+            MEMBERVARIABLE(unsigned, ReadAheadDepth);
+            MEMBERVARIABLE(unsigned, NParallelFiles);
 
             MEMBERVARIABLE(bool, NormalizeVoltages);
 
         private:
             KTDAC* fDAC;
 
+            static const unsigned sDefaultParallelQueueDepth;
+
         public:
             bool Run();
 
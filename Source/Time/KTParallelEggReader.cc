@@ -0,0 +1,225 @@
+/*
+ * KTParallelEggReader.cc
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "KTParallelEggReader.hh"
+
+#include "KTLogger.hh"
+#include "KTPrefetchEggReader.hh"
+#include "KTSliceHeader.hh"
+
+#ifdef USE_MONARCH3
+#include "KTEgg3Reader.hh"
+#endif
+
+namespace Katydid
+{
+    KTLOGGER(parallellog, "KTParallelEggReader");
+
+    KTParallelEggReader::KTParallelEggReader(const std::string& readerType, unsigned nParallelFiles, unsigned queueDepth) :
+            KTEggReader(),
+            fReaderType(readerType),
+            fNParallelFiles(nParallelFiles == 0 ? 1 : nParallelFiles),
+            fQueueDepth(queueDepth == 0 ? 1 : queueDepth),
+            fEggProc(nullptr),
+            fFilenames(),
+            fNextFile(0),
+            fSources(),
+            fNSlicesProcessed(0),
+            fRetiredRecords(0),
+            fRetiredTime(0.)
+    {
+    }
+
+    KTParallelEggReader::~KTParallelEggReader()
+    {
+        CloseEgg();
+    }
+
+    bool KTParallelEggReader::Configure(const KTEggProcessor& eggProc)
+    {
+        fEggProc = &eggProc;
+        return true;
+    }
+
+    Nymph::KTDataPtr KTParallelEggReader::BreakEgg(const path_vec& filenames)
+    {
+        CloseEgg();
+
+        if (fEggProc == nullptr)
+        {
+            KTERROR(parallellog, "The parallel egg reader has not been configured");
+            return Nymph::KTDataPtr();
+        }
+
+        fFilenames = filenames;
+        fNextFile = 0;
+        fNSlicesProcessed = 0;
+        fRetiredRecords = 0;
+        fRetiredTime = 0.;
+
+        KTINFO(parallellog, "Hatching " << fFilenames.size() << " files with up to " << fNParallelFiles << " open at once");
+
+        // the header of the run comes from the first file
+        Nymph::KTDataPtr headerPtr = OpenNextFile();
+        if (! headerPtr) return headerPtr;
+
+        while (fSources.size() < fNParallelFiles && fNextFile < fFilenames.size())
+        {
+            if (! OpenNextFile()) return Nymph::KTDataPtr();
+        }
+
+        return headerPtr;
+    }
+
+    Nymph::KTDataPtr KTParallelEggReader::HatchNextSlice()
+    {
+        // every open file needs a head slice before we can know which slice is the earliest
+        unsigned iSource = 0;
+        while (iSource < fSources.size())
+        {
+            Source& source = fSources[iSource];
+            if (! source.fHead)
+            {
+                source.fHead = source.fReader->HatchNextSlice();
+                if (! source.fHead)
+                {
+                    // this file is done; replace it with the next file, if there is one
+                    RetireSource(iSource);
+                    if (fNextFile < fFilenames.size())
+                    {
+                        OpenNextFile();
+                    }
+                    continue;
+                }
+            }
+            ++iSource;
+        }
+
+        if (fSources.empty())
+        {
+            KTINFO(parallellog, "All files have been hatched");
+            return Nymph::KTDataPtr();
+        }
+
+        // find the earliest slice: time in run, then acquisition ID, then file order
+        unsigned iEarliest = 0;
+        for (iSource = 1; iSource < fSources.size(); ++iSource)
+        {
+            const KTSliceHeader& candidate = fSources[iSource].fHead->Of< KTSliceHeader >();
+            const KTSliceHeader& earliest = fSources[iEarliest].fHead->Of< KTSliceHeader >();
+            if (candidate.GetTimeInRun() < earliest.GetTimeInRun() ||
+                (candidate.GetTimeInRun() == earliest.GetTimeInRun() &&
+                 (candidate.GetAcquisitionID() < earliest.GetAcquisitionID() ||
+                  (candidate.GetAcquisitionID() == earliest.GetAcquisitionID() && fSources[iSource].fFileIndex < fSources[iEarliest].fFileIndex))))
+            {
+                iEarliest = iSource;
+            }
+        }
+
+        Nymph::KTDataPtr data = fSources[iEarliest].fHead;
+        fSources[iEarliest].fHead.reset();
+
+        // each file's reader numbers its slices from 0
+        data->Of< KTSliceHeader >().SetSliceNumber(fNSlicesProcessed);
+        ++fNSlicesProcessed;
+
+        return data;
+    }
+
+    bool KTParallelEggReader::CloseEgg()
+    {
+        while (! fSources.empty())
+        {
+            RetireSource(fSources.size() - 1);
+        }
+        return true;
+    }
+
+    unsigned KTParallelEggReader::GetNSlicesProcessed() const
+    {
+        return fNSlicesProcessed;
+    }
+
+    unsigned KTParallelEggReader::GetNRecordsProcessed() const
+    {
+        unsigned nRecords = fRetiredRecords;
+        for (const Source& source : fSources)
+        {
+            nRecords += source.fReader->GetNRecordsProcessed();
+        }
+        return nRecords;
+    }
+
+    double KTParallelEggReader::GetIntegratedTime() const
+    {
+        double time = fRetiredTime;
+        for (const Source& source : fSources)
+        {
+            time += source.fReader->GetIntegratedTime();
+        }
+        return time;
+    }
+
+    Nymph::KTDataPtr KTParallelEggReader::OpenNextFile()
+    {
+        if (fNextFile >= fFilenames.size()) return Nymph::KTDataPtr();
+
+        unsigned fileIndex = fNextFile++;
+
+        KTEggReader* reader = scarab::factory< KTEggReader >::get_instance()->create(fReaderType);
+        if (reader == nullptr)
+        {
+            KTERROR(parallellog, "Invalid egg reader type: " << fReaderType);
+            return Nymph::KTDataPtr();
+        }
+        reader->Configure(*fEggProc);
+
+#ifdef USE_MONARCH3
+        // the start time and start record are offsets into the run, so they only apply to the first file
+        if (fileIndex != 0)
+        {
+            KTEgg3Reader* egg3Reader = dynamic_cast< KTEgg3Reader* >(reader);
+            if (egg3Reader != nullptr)
+            {
+                egg3Reader->SetStartTime(0.);
+                egg3Reader->SetStartRecord(0);
+            }
+        }
+#endif
+
+        // the prefetch reader takes ownership of the reader, and runs it on its own thread
+        Source source;
+        source.fReader = new KTPrefetchEggReader(reader, fQueueDepth);
+        source.fFileIndex = fileIndex;
+
+        path_vec thisFile(1, fFilenames[fileIndex]);
+        KTDEBUG(parallellog, "Opening file " << fileIndex << ": <" << thisFile[0].first << ">");
+        Nymph::KTDataPtr headerPtr = source.fReader->BreakEgg(thisFile);
+        if (! headerPtr)
+        {
+            KTERROR(parallellog, "Unable to open file <" << thisFile[0].first << ">");
+            delete source.fReader;
+            return headerPtr;
+        }
+
+        fSources.push_back(source);
+        return headerPtr;
+    }
+
+    void KTParallelEggReader::RetireSource(unsigned iSource)
+    {
+        Source& source = fSources[iSource];
+        KTDEBUG(parallellog, "Closing file " << source.fFileIndex);
+        fRetiredRecords += source.fReader->GetNRecordsProcessed();
+        fRetiredTime += source.fReader->GetIntegratedTime();
+        // deleting the prefetch reader stops its thread and deletes the wrapped reader
+        delete source.fReader;
+        fSources.erase(fSources.begin() + iSource);
+        return;
+    }
+
+} /* namespace Katydid */
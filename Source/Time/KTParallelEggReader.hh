@@ -0,0 +1,92 @@
+/**
+ @file KTParallelEggReader.hh
+ @brief Contains KTParallelEggReader
+ @details Hatches slices from several egg files concurrently and merges them in time order.
+ @author: agent
+ @date: Oct 17, 2026
+ */
+
+#ifndef KTPARALLELEGGREADER_HH_
+#define KTPARALLELEGGREADER_HH_
+
+#include "KTEggReader.hh"
+
+#include "KTMemberVariable.hh"
+
+#include <string>
+#include <vector>
+
+namespace Katydid
+{
+    class KTPrefetchEggReader;
+
+    /*!
+     @class KTParallelEggReader
+     @author agent
+
+     @brief Egg reader that opens several files of a multi-file run at once, and hatches them in parallel.
+
+     @details
+     Up to NParallelFiles files are open at any time.  Each file gets its own egg reader (of type ReaderType), wrapped in a
+     KTPrefetchEggReader, so each file is decoded on its own thread into its own bounded queue of depth QueueDepth.
+
+     Slices are handed out in global time order: the next slice is the one with the earliest time-in-run among the files that are open,
+     with ties broken by acquisition ID and then by the order of the files.  Slice numbers are reassigned so that they're sequential over the run.
+     When a file runs out of slices, it's closed and the next file in the list is opened.
+
+     A start time or start record only applies to the first file.
+
+     Configuration is done through KTEggProcessor: "n-parallel-files" sets the number of concurrently open files,
+     and "read-ahead-depth" sets the per-file queue depth.
+    */
+    class KTParallelEggReader : public KTEggReader
+    {
+        public:
+            KTParallelEggReader(const std::string& readerType, unsigned nParallelFiles, unsigned queueDepth);
+            virtual ~KTParallelEggReader();
+
+            MEMBERVARIABLE_NOSET(std::string, ReaderType);
+            MEMBERVARIABLE_NOSET(unsigned, NParallelFiles);
+            MEMBERVARIABLE_NOSET(unsigned, QueueDepth);
+
+        public:
+            bool Configure(const KTEggProcessor& eggProc);
+
+            /// Opens the first NParallelFiles files; returns the header of the first file
+            Nymph::KTDataPtr BreakEgg(const path_vec& filenames);
+            /// Returns the earliest slice among the open files
+            Nymph::KTDataPtr HatchNextSlice();
+            /// Closes all open files
+            bool CloseEgg();
+
+            virtual unsigned GetNSlicesProcessed() const;
+            virtual unsigned GetNRecordsProcessed() const;
+            virtual double GetIntegratedTime() const;
+
+        private:
+            struct Source
+            {
+                KTPrefetchEggReader* fReader;
+                Nymph::KTDataPtr fHead; // next slice from this file; empty if it has not been hatched yet
+                unsigned fFileIndex;
+            };
+
+            /// Opens the next file in the list; returns an empty pointer if there are no more files (or if it failed to open)
+            Nymph::KTDataPtr OpenNextFile();
+            void RetireSource(unsigned iSource);
+
+            const KTEggProcessor* fEggProc;
+
+            path_vec fFilenames;
+            unsigned fNextFile;
+
+            std::vector< Source > fSources;
+
+            unsigned fNSlicesProcessed;
+            // totals from files that have been closed
+            unsigned fRetiredRecords;
+            double fRetiredTime;
+    };
+
+} /* namespace Katydid */
+#endif /* KTPARALLELEGGREADER_HH_ */
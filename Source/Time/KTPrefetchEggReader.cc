@@ -0,0 +1,215 @@
+/*
+ * KTPrefetchEggReader.cc
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "KTPrefetchEggReader.hh"
+
+#include "KTLogger.hh"
+
+#include <chrono>
+#include <exception>
+
+namespace Katydid
+{
+    KTLOGGER(prefetchlog, "KTPrefetchEggReader");
+
+    KTPrefetchEggReader::KTPrefetchEggReader(KTEggReader* reader, unsigned queueDepth) :
+            KTEggReader(),
+            fQueueDepth(queueDepth == 0 ? 1 : queueDepth),
+            fReader(reader),
+            fThread(),
+            fMutex(),
+            fSliceReadyCV(),
+            fSpaceReadyCV(),
+            fRing(fQueueDepth),
+            fRingStart(0),
+            fRingCount(0),
+            fReaderDone(false),
+            fStopRequested(false),
+            fLastEntry(),
+            fStats()
+    {
+        fLastEntry.fNSlicesProcessed = 0;
+        fLastEntry.fNRecordsProcessed = 0;
+        fLastEntry.fIntegratedTime = 0.;
+
+        fStats.fNSlicesQueued = 0;
+        fStats.fNProducerWaits = 0;
+        fStats.fNConsumerWaits = 0;
+        fStats.fProducerWaitTime = 0.;
+        fStats.fConsumerWaitTime = 0.;
+        fStats.fMaxOccupancy = 0;
+    }
+
+    KTPrefetchEggReader::~KTPrefetchEggReader()
+    {
+        StopReading();
+        delete fReader;
+    }
+
+    bool KTPrefetchEggReader::Configure(const KTEggProcessor& eggProc)
+    {
+        return fReader->Configure(eggProc);
+    }
+
+    Nymph::KTDataPtr KTPrefetchEggReader::BreakEgg(const path_vec& filenames)
+    {
+        StopReading();
+
+        Nymph::KTDataPtr headerPtr = fReader->BreakEgg(filenames);
+        if (! headerPtr) return headerPtr;
+
+        fRingStart = 0;
+        fRingCount = 0;
+        fReaderDone = false;
+        fStopRequested = false;
+
+        KTDEBUG(prefetchlog, "Starting the read-ahead thread with a queue depth of " << fQueueDepth);
+        fThread = std::thread(&KTPrefetchEggReader::ReadAhead, this);
+
+        return headerPtr;
+    }
+
+    Nymph::KTDataPtr KTPrefetchEggReader::HatchNextSlice()
+    {
+        std::unique_lock< std::mutex > lock(fMutex);
+
+        if (fRingCount == 0 && ! fReaderDone)
+        {
+            ++fStats.fNConsumerWaits;
+            auto waitStart = std::chrono::steady_clock::now();
+            fSliceReadyCV.wait(lock, [this]{ return fRingCount > 0 || fReaderDone; });
+            fStats.fConsumerWaitTime += std::chrono::duration< double >(std::chrono::steady_clock::now() - waitStart).count();
+        }
+
+        if (fRingCount == 0)
+        {
+            // the reader is done and everything has been handed out
+            return Nymph::KTDataPtr();
+        }
+
+        QueueEntry& entry = fRing[fRingStart];
+        fLastEntry = entry;
+        entry.fData.reset();
+        fRingStart = (fRingStart + 1) % fQueueDepth;
+        --fRingCount;
+
+        lock.unlock();
+        fSpaceReadyCV.notify_one();
+
+        return fLastEntry.fData;
+    }
+
+    bool KTPrefetchEggReader::CloseEgg()
+    {
+        StopReading();
+        return fReader->CloseEgg();
+    }
+
+    unsigned KTPrefetchEggReader::GetNSlicesProcessed() const
+    {
+        std::unique_lock< std::mutex > lock(fMutex);
+        return fLastEntry.fNSlicesProcessed;
+    }
+
+    unsigned KTPrefetchEggReader::GetNRecordsProcessed() const
+    {
+        std::unique_lock< std::mutex > lock(fMutex);
+        return fLastEntry.fNRecordsProcessed;
+    }
+
+    double KTPrefetchEggReader::GetIntegratedTime() const
+    {
+        std::unique_lock< std::mutex > lock(fMutex);
+        return fLastEntry.fIntegratedTime;
+    }
+
+    KTPrefetchEggReader::BackpressureStats KTPrefetchEggReader::GetBackpressureStats() const
+    {
+        std::unique_lock< std::mutex > lock(fMutex);
+        return fStats;
+    }
+
+    void KTPrefetchEggReader::ReadAhead()
+    {
+        while (true)
+        {
+            // hatch outside of the lock; this is the I/O that overlaps with the processing chain
+            QueueEntry entry;
+            try
+            {
+                entry.fData = fReader->HatchNextSlice();
+            }
+            catch (std::exception& e)
+            {
+                KTERROR(prefetchlog, "Exception thrown while reading ahead: " << e.what());
+                entry.fData.reset();
+            }
+
+            std::unique_lock< std::mutex > lock(fMutex);
+
+            if (! entry.fData || fStopRequested)
+            {
+                fReaderDone = true;
+                lock.unlock();
+                fSliceReadyCV.notify_all();
+                return;
+            }
+
+            entry.fNSlicesProcessed = fReader->GetNSlicesProcessed();
+            entry.fNRecordsProcessed = fReader->GetNRecordsProcessed();
+            entry.fIntegratedTime = fReader->GetIntegratedTime();
+
+            if (fRingCount == fQueueDepth)
+            {
+                ++fStats.fNProducerWaits;
+                auto waitStart = std::chrono::steady_clock::now();
+                fSpaceReadyCV.wait(lock, [this]{ return fRingCount < fQueueDepth || fStopRequested; });
+                fStats.fProducerWaitTime += std::chrono::duration< double >(std::chrono::steady_clock::now() - waitStart).count();
+                if (fStopRequested)
+                {
+                    fReaderDone = true;
+                    lock.unlock();
+                    fSliceReadyCV.notify_all();
+                    return;
+                }
+            }
+
+            fRing[(fRingStart + fRingCount) % fQueueDepth] = entry;
+            ++fRingCount;
+            ++fStats.fNSlicesQueued;
+            if (fRingCount > fStats.fMaxOccupancy) fStats.fMaxOccupancy = fRingCount;
+
+            lock.unlock();
+            fSliceReadyCV.notify_one();
+        }
+        return;
+    }
+
+    void KTPrefetchEggReader::StopReading()
+    {
+        if (! fThread.joinable()) return;
+
+        {
+            std::unique_lock< std::mutex > lock(fMutex);
+            fStopRequested = true;
+        }
+        fSpaceReadyCV.notify_all();
+        fThread.join();
+
+        // drop any slices that were read ahead but never handed out
+        for (QueueEntry& entry : fRing)
+        {
+            entry.fData.reset();
+        }
+        fRingStart = 0;
+        fRingCount = 0;
+
+        KTDEBUG(prefetchlog, "Read-ahead thread stopped");
+        return;
+    }
+
+} /* namespace Katydid */
@@ -0,0 +1,111 @@
+/**
+ @file KTPrefetchEggReader.hh
+ @brief Contains KTPrefetchEggReader
+ @details Wraps another egg reader and hatches slices on a background thread.
+ @author: agent
+ @date: Oct 17, 2026
+ */
+
+#ifndef KTPREFETCHEGGREADER_HH_
+#define KTPREFETCHEGGREADER_HH_
+
+#include "KTEggReader.hh"
+
+#include "KTMemberVariable.hh"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Katydid
+{
+
+    /*!
+     @class KTPrefetchEggReader
+     @author agent
+
+     @brief Egg reader that reads ahead of the processing chain on a background thread.
+
+     @details
+     The prefetch reader owns another egg reader (e.g. KTEgg3Reader), and calls that reader's HatchNextSlice on a background thread.
+     Hatched slices are placed in a bounded ring of depth QueueDepth; HatchNextSlice on the prefetch reader takes slices from the ring.
+     Disk I/O in the wrapped reader therefore overlaps with whatever the caller does with each slice.
+
+     When the ring is full the reader thread waits (the processing chain is the bottleneck);
+     when the ring is empty the caller waits (I/O is the bottleneck).  Both are counted in the backpressure statistics.
+
+     The slice, record, and integrated-time counters reflect the slices that have been handed out, not the ones that were read ahead.
+
+     Configuration is done through KTEggProcessor: the "read-ahead-depth" option sets the queue depth.
+    */
+    class KTPrefetchEggReader : public KTEggReader
+    {
+        public:
+            struct BackpressureStats
+            {
+                unsigned fNSlicesQueued;
+                unsigned fNProducerWaits; /// number of times the reader thread found the ring full
+                unsigned fNConsumerWaits; /// number of times the caller found the ring empty
+                double fProducerWaitTime; /// total time the reader thread spent waiting (s)
+                double fConsumerWaitTime; /// total time the caller spent waiting (s)
+                unsigned fMaxOccupancy; /// largest number of slices that were waiting in the ring at once
+            };
+
+        public:
+            /// The prefetch reader takes ownership of the wrapped reader
+            KTPrefetchEggReader(KTEggReader* reader, unsigned queueDepth);
+            virtual ~KTPrefetchEggReader();
+
+            MEMBERVARIABLE_NOSET(unsigned, QueueDepth);
+
+        public:
+            bool Configure(const KTEggProcessor& eggProc);
+
+            /// Opens the egg file with the wrapped reader and starts the reader thread
+            Nymph::KTDataPtr BreakEgg(const path_vec& filenames);
+            /// Returns the next slice from the ring; waits if the reader thread has not hatched it yet
+            Nymph::KTDataPtr HatchNextSlice();
+            /// Stops the reader thread and closes the file
+            bool CloseEgg();
+
+            virtual unsigned GetNSlicesProcessed() const;
+            virtual unsigned GetNRecordsProcessed() const;
+            virtual double GetIntegratedTime() const;
+
+            BackpressureStats GetBackpressureStats() const;
+
+        private:
+            struct QueueEntry
+            {
+                Nymph::KTDataPtr fData;
+                unsigned fNSlicesProcessed;
+                unsigned fNRecordsProcessed;
+                double fIntegratedTime;
+            };
+
+            void ReadAhead();
+            void StopReading();
+
+            KTEggReader* fReader;
+
+            std::thread fThread;
+            mutable std::mutex fMutex;
+            std::condition_variable fSliceReadyCV;
+            std::condition_variable fSpaceReadyCV;
+
+            // ring of hatched slices; fRingStart is the next entry to hand out
+            std::vector< QueueEntry > fRing;
+            unsigned fRingStart;
+            unsigned fRingCount;
+
+            bool fReaderDone; // set by the reader thread when the wrapped reader runs out of slices
+            bool fStopRequested;
+
+            QueueEntry fLastEntry; // counters for the most recent slice handed out
+
+            BackpressureStats fStats;
+    };
+
+} /* namespace Katydid */
+#endif /* KTPREFETCHEGGREADER_HH_ */
@@ -31,10 +31,14 @@ namespace Katydid
             fTimeSeriesType(kUnknownTimeSeries),
             fBitDepthMode(kNoChange),
             fEmulatedNBits(fNBits),
+            fUseSIMDKernels(true),
             fShouldRunInitialize(true),
             fVoltages(),
             fIntLevelOffset(0),
             fConvertTSFunc(NULL),
+            fKernel(NULL),
+            fWeightedKernel(NULL),
+            fKernelParams(),
             fOversamplingBins(1),
             fOversamplingScaleFactor(1.)
     {
@@ -51,13 +55,19 @@ namespace Katydid
             fTimeSeriesType(orig.fTimeSeriesType),
             fBitDepthMode(orig.fBitDepthMode),
             fEmulatedNBits(orig.fEmulatedNBits),
+            fUseSIMDKernels(orig.fUseSIMDKernels),
             fShouldRunInitialize(orig.fShouldRunInitialize),
             fVoltages(orig.fVoltages),
             fIntLevelOffset(orig.fIntLevelOffset),
             fConvertTSFunc(orig.fConvertTSFunc),
+            fKernel(orig.fKernel),
+            fWeightedKernel(orig.fWeightedKernel),
+            fKernelParams(orig.fKernelParams),
             fOversamplingBins(orig.fOversamplingBins),
             fOversamplingScaleFactor(orig.fOversamplingScaleFactor)
     {
+        // the kernel has to use this DAC's copy of the voltage table
+        fKernelParams.fVoltages = fVoltages.empty() ? NULL : &fVoltages[0];
     }
 
     KTSingleChannelDAC::~KTSingleChannelDAC()
@@ -102,6 +112,8 @@ namespace Katydid
             SetEmulatedNBits(node->get_value< unsigned >("n-bits-emulated", fEmulatedNBits));
         }
 
+        SetUseSIMDKernels(node->get_value< bool >("simd-kernels", fUseSIMDKernels));
+
         return true;
     }
 
@@ -112,6 +124,7 @@ namespace Katydid
 
         SetTimeSeriesType(master.GetTimeSeriesType());
         SetEmulatedNBits(master.GetEmulatedNBits());
+        SetUseSIMDKernels(master.GetUseSIMDKernels());
 
         return true;
     }
@@ -290,10 +303,17 @@ namespace Katydid
             }
         }
 
+        SetupKernel();
+
         // setting the convert function
         if (fTimeSeriesType == kFFTWTimeSeries)
         {
-            if (fBitDepthMode != kIncreasing)
+            if (fKernel != NULL)
+            {
+                fConvertTSFunc = &KTSingleChannelDAC::ConvertToFFTWWithKernel;
+                KTDEBUG(egglog_scdac, "Convert function set to kernel --> FFTW");
+            }
+            else if (fBitDepthMode != kIncreasing)
             {
                 if (fDigitizedDataFormat == sDigitizedS)
                 {
@@ -322,7 +342,12 @@ namespace Katydid
         }
         else //(fTimeSeriesType == kRealTimeSeries)
         {
-            if (fBitDepthMode != kIncreasing)
+            if (fKernel != NULL)
+            {
+                fConvertTSFunc = &KTSingleChannelDAC::ConvertToRealWithKernel;
+                KTDEBUG(egglog_scdac, "Convert function set to kernel --> real");
+            }
+            else if (fBitDepthMode != kIncreasing)
             {
                 if (fDigitizedDataFormat == sDigitizedS)
                 {
@@ -354,6 +379,123 @@ namespace Katydid
         return true;
     }
 
+    void KTSingleChannelDAC::SetupKernel()
+    {
+        fKernel = NULL;
+        fWeightedKernel = NULL;
+        fKernelParams.fVoltages = NULL;
+
+        // the oversampled conversions average over samples, so they're left to the generic path
+        if (! fUseSIMDKernels || fBitDepthMode == kIncreasing || fVoltages.size() < 2) return;
+
+        double gain = 0., offset = 0.;
+        bool isAffine = FindAffineConversion(gain, offset);
+
+        // a lookup kernel indexes the table with every possible sample value, so the table has to cover the whole data type
+        if (! isAffine && (fDataTypeSize > 2 || fVoltages.size() != (size_t(1) << (8 * fDataTypeSize)))) return;
+
+        fKernel = KTDACKernels::SelectKernel(fDataTypeSize, fDigitizedDataFormat, isAffine);
+        if (fKernel == NULL) return;
+        fWeightedKernel = KTDACKernels::SelectKernel(fDataTypeSize, fDigitizedDataFormat, isAffine, true);
+
+        fKernelParams.fVoltages = &fVoltages[0];
+        fKernelParams.fIntLevelOffset = fIntLevelOffset;
+        fKernelParams.fGain = gain;
+        fKernelParams.fOffset = offset;
+
+        KTDEBUG(egglog_scdac, "Using the " << KTDACKernels::GetInstructionSetName(KTDACKernels::GetInstructionSet()) << " " << (isAffine ? "affine" : "lookup") << " conversion kernel");
+        return;
+    }
+
+    bool KTSingleChannelDAC::FindAffineConversion(double& gain, double& offset) const
+    {
+        // try the DAC gain first, and then the spacing of the first two levels
+        offset = fVoltages[fIntLevelOffset];
+        gain = fDACGain;
+        if (IsAffine(gain, offset)) return true;
+
+        if (size_t(fIntLevelOffset + 1) >= fVoltages.size()) return false;
+        gain = fVoltages[fIntLevelOffset + 1] - offset;
+        return IsAffine(gain, offset);
+    }
+
+    bool KTSingleChannelDAC::IsAffine(double gain, double offset) const
+    {
+        // the comparison is exact so that the affine kernels give the same voltages as the table
+        for (size_t index = 0; index < fVoltages.size(); ++index)
+        {
+            if (fVoltages[index] != offset + gain * double(int64_t(index) - fIntLevelOffset)) return false;
+        }
+        return true;
+    }
+
+    KTTimeSeries* KTSingleChannelDAC::ConvertToFFTWWithKernel(KTRawTimeSeries* ts)
+    {
+        if (fShouldRunInitialize || ts->GetDataTypeSize() != fDataTypeSize || ts->GetDataFormat() != fDigitizedDataFormat)
+        {
+            // the generic conversion re-initializes if needed, and handles any data type
+            return fDigitizedDataFormat == sDigitizedS ? ConvertSignedToFFTW(ts) : ConvertUnsignedToFFTW(ts);
+        }
+
+        KTDEBUG(egglog_scdac, "Converting raw-ts to ts-fftw with the conversion kernel");
+
+        // ts.size() is divided by 2 because we have complex samples, and the raw time series sees each sample as 2 bins
+        unsigned nBins = ts->size() / 2;
+        KTTimeSeriesFFTW* newTS = new KTTimeSeriesFFTW(nBins, ts->GetRangeMin(), ts->GetRangeMax());
+        // the I/Q samples are interleaved, as are the real and imaginary parts of the (fftw_complex-compatible) output array
+        fKernel(ts->GetStorage(), reinterpret_cast< double* >(newTS->GetData()), 2 * nBins, fKernelParams);
+        return newTS;
+    }
+
+    KTTimeSeries* KTSingleChannelDAC::ConvertToRealWithKernel(KTRawTimeSeries* ts)
+    {
+        if (fShouldRunInitialize || ts->GetDataTypeSize() != fDataTypeSize || ts->GetDataFormat() != fDigitizedDataFormat)
+        {
+            return fDigitizedDataFormat == sDigitizedS ? ConvertSignedToReal(ts) : ConvertUnsignedToReal(ts);
+        }
+
+        KTDEBUG(egglog_scdac, "Converting raw-ts to ts-real with the conversion kernel");
+
+        unsigned nBins = ts->size();
+        KTTimeSeriesReal* newTS = new KTTimeSeriesReal(nBins, ts->GetRangeMin(), ts->GetRangeMax());
+        fKernel(ts->GetStorage(), newTS->GetData(), nBins, fKernelParams);
+        return newTS;
+    }
+
+    bool KTSingleChannelDAC::ConvertToArray(KTRawTimeSeries* ts, double* output, const double* weights)
+    {
+        if (fShouldRunInitialize)
+        {
+            if (! Initialize())
+            {
+                KTERROR(egglog_scdac, "Failed to initialize single-channel DAC");
+                return false;
+            }
+        }
+
+        if (fBitDepthMode == kIncreasing)
+        {
+            KTERROR(egglog_scdac, "Oversampled conversion cannot be done into an array");
+            return false;
+        }
+
+        if (fKernel != NULL && ts->GetDataTypeSize() == fDataTypeSize && ts->GetDataFormat() == fDigitizedDataFormat)
+        {
+            KTDACKernelParams params = fKernelParams;
+            params.fWeights = weights;
+            (weights == NULL ? fKernel : fWeightedKernel)(ts->GetStorage(), output, ts->size(), params);
+        }
+        else if (fDigitizedDataFormat == sDigitizedS)
+        {
+            DoConvertToArray(KTVarTypePhysicalArray< int64_t >(*ts, false), output, weights);
+        }
+        else //(fDigitizedDataFormat == sDigitizedUS)
+        {
+            DoConvertToArray(*ts, output, weights);
+        }
+        return true;
+    }
+
     bool KTSingleChannelDAC::SetEmulatedNBits(unsigned nBits)
     {
         if (nBits == fNBits)
@@ -12,6 +12,7 @@
 #include "param.hh"
 
 #include "KTConstants.hh"
+#include "KTDACKernels.hh"
 #include "KTLogger.hh"
 #include "KTMemberVariable.hh"
 #include "KTRawTimeSeries.hh"
@@ -78,6 +79,10 @@ namespace Katydid
             MEMBERVARIABLE_NOSET(unsigned, EmulatedNBits);
             MEMBERVARIABLE_NOSET(unsigned, BitAlignment);
 
+            /// Use the vectorized kernels (see KTDACKernels) for 8- and 16-bit data when possible
+            MEMBERVARIABLE_NOSET(bool, UseSIMDKernels);
+            void SetUseSIMDKernels(bool flag);
+
         public:
             bool InitializeWithHeader(KTChannelHeader* header);
             bool Initialize();
@@ -97,6 +102,14 @@ namespace Katydid
             KTTimeSeries* ConvertSignedToFFTWOversampled(KTRawTimeSeries* ts);
             KTTimeSeries* ConvertSignedToRealOversampled(KTRawTimeSeries* ts);
 
+            KTTimeSeries* ConvertToFFTWWithKernel(KTRawTimeSeries* ts);
+            KTTimeSeries* ConvertToRealWithKernel(KTRawTimeSeries* ts);
+
+            /// Converts every raw sample of ts into output (which must hold ts->size() values), optionally multiplying each value by the corresponding weight.
+            /// For complex data the I/Q samples stay interleaved, so output can be an fftw_complex array of ts->size()/2 elements.
+            /// Oversampled conversion (increased bit depth) is not supported.
+            bool ConvertToArray(KTRawTimeSeries* ts, double* output, const double* weights = NULL);
+
             double Convert(uint64_t level);
             double Convert(int64_t level);
 
@@ -106,11 +119,20 @@ namespace Katydid
             template< typename XInterfaceType >
             KTTimeSeries* DoConvertToReal(const KTVarTypePhysicalArray< XInterfaceType >& ts);
 
+            template< typename XInterfaceType >
+            void DoConvertToArray(const KTVarTypePhysicalArray< XInterfaceType >& ts, double* output, const double* weights);
+
             template< typename XInterfaceType >
             KTTimeSeries* DoConvertToFFTWOversampled(const KTVarTypePhysicalArray< XInterfaceType >& ts);
             template< typename XInterfaceType >
             KTTimeSeries* DoConvertToRealOversampled(const KTVarTypePhysicalArray< XInterfaceType >& ts);
 
+            /// Chooses the conversion kernel for the current data format and voltage table; sets fKernel to NULL if none applies
+            void SetupKernel();
+            /// Checks whether the voltage table is exactly offset + gain * level (i.e. no bit-depth reduction)
+            bool FindAffineConversion(double& gain, double& offset) const;
+            bool IsAffine(double gain, double offset) const;
+
             bool fShouldRunInitialize;
 
             std::vector< double > fVoltages;
@@ -118,6 +140,10 @@ namespace Katydid
 
             KTTimeSeries* (KTSingleChannelDAC::*fConvertTSFunc)(KTRawTimeSeries*);
 
+            KTDACKernel fKernel;
+            KTDACKernel fWeightedKernel;
+            KTDACKernelParams fKernelParams;
+
             MEMBERVARIABLE_NOSET(unsigned, OversamplingBins);
             MEMBERVARIABLE_NOSET(double, OversamplingScaleFactor);
 
@@ -135,6 +161,13 @@ namespace Katydid
         return true;
     }
 
+    inline void KTSingleChannelDAC::SetUseSIMDKernels(bool flag)
+    {
+        fUseSIMDKernels = flag;
+        fShouldRunInitialize = true;
+        return;
+    }
+
     inline KTTimeSeries* KTSingleChannelDAC::ConvertTimeSeries(KTRawTimeSeries* ts)
     {
         return (this->*fConvertTSFunc)(ts);
@@ -246,6 +279,27 @@ namespace Katydid
         return newTS;
     }
 
+    template< typename XInterfaceType >
+    void KTSingleChannelDAC::DoConvertToArray(const KTVarTypePhysicalArray< XInterfaceType >& ts, double* output, const double* weights)
+    {
+        unsigned nSamples = ts.size();
+        if (weights == NULL)
+        {
+            for (unsigned iSample = 0; iSample < nSamples; ++iSample)
+            {
+                output[iSample] = Convert(ts(iSample));
+            }
+        }
+        else
+        {
+            for (unsigned iSample = 0; iSample < nSamples; ++iSample)
+            {
+                output[iSample] = Convert(ts(iSample)) * weights[iSample];
+            }
+        }
+        return;
+    }
+
     template< typename XInterfaceType >
     KTTimeSeries* KTSingleChannelDAC::DoConvertToFFTWOversampled(const KTVarTypePhysicalArray< XInterfaceType >& ts)
     {
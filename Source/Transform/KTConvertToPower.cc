@@ -9,6 +9,7 @@
 
 #include "KTFrequencySpectrumFFTW.hh"
 #include "KTFrequencySpectrumDataFFTW.hh"
+#include "KTFrequencySpectrumDataFFTWF.hh"
 #include "KTFrequencySpectrumDataPolar.hh"
 #include "KTFrequencySpectrumPolar.hh"
 #include "KTChannelAggregatedData.hh"
@@ -16,6 +17,7 @@
 
 #include "KTPowerSpectrum.hh"
 #include "KTPowerSpectrumData.hh"
+#include "KTPowerSpectrumDataF.hh"
 
 using boost::shared_ptr;
 
@@ -36,8 +38,14 @@ namespace Katydid
             fAggFSFToPSDSlot("aggfs-fftw-to-psd", this, &KTConvertToPower::ToPowerSpectralDensity, &fPowerSpectralDensitySignal),
             fPSDToPSSlot("psd-to-ps", this, &KTConvertToPower::ToPowerSpectrum, &fPowerSpectrumSignal),
             fPSToPSDSlot("ps-to-psd", this, &KTConvertToPower::ToPowerSpectralDensity, &fPowerSpectralDensitySignal),
+            fFSFFToPSSlot("fs-fftwf-to-ps", this, &KTConvertToPower::ToPowerSpectrum, &fPowerSpectrumFSignal),
+            fFSFFToPSDSlot("fs-fftwf-to-psd", this, &KTConvertToPower::ToPowerSpectralDensity, &fPowerSpectralDensityFSignal),
+            fPSDFToPSSlot("psd-f-to-ps", this, &KTConvertToPower::ToPowerSpectrum, &fPowerSpectrumFSignal),
+            fPSFToPSDSlot("ps-f-to-psd", this, &KTConvertToPower::ToPowerSpectralDensity, &fPowerSpectralDensityFSignal),
             fPowerSpectrumSignal("ps", this),
-            fPowerSpectralDensitySignal("psd", this)
+            fPowerSpectralDensitySignal("psd", this),
+            fPowerSpectrumFSignal("ps-f", this),
+            fPowerSpectralDensityFSignal("psd-f", this)
     {
     }
 
@@ -168,4 +176,50 @@ namespace Katydid
         return true;
     }
 
+    bool KTConvertToPower::ToPowerSpectrum(KTFrequencySpectrumDataFFTWF& data)
+    {
+        unsigned nComponents = data.GetNComponents();
+        KTPowerSpectrumDataF& psData = data.Of< KTPowerSpectrumDataF >().SetNComponents(nComponents);
+        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+        {
+            KTPowerSpectrumF* spectrum = data.GetSpectrumFFTWF(iComponent)->CreatePowerSpectrumF();
+            spectrum->ConvertToPowerSpectrum();
+            psData.SetSpectrum(spectrum, iComponent);
+        }
+        return true;
+    }
+
+    bool KTConvertToPower::ToPowerSpectralDensity(KTFrequencySpectrumDataFFTWF& data)
+    {
+        unsigned nComponents = data.GetNComponents();
+        KTPowerSpectrumDataF& psData = data.Of< KTPowerSpectrumDataF >().SetNComponents(nComponents);
+        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+        {
+            KTPowerSpectrumF* spectrum = data.GetSpectrumFFTWF(iComponent)->CreatePowerSpectrumF();
+            spectrum->ConvertToPowerSpectralDensity();
+            psData.SetSpectrum(spectrum, iComponent);
+        }
+        return true;
+    }
+
+    bool KTConvertToPower::ToPowerSpectrum(KTPowerSpectrumDataF& data)
+    {
+        unsigned nComponents = data.GetNComponents();
+        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+        {
+            data.GetSpectrum(iComponent)->ConvertToPowerSpectrum();
+        }
+        return true;
+    }
+
+    bool KTConvertToPower::ToPowerSpectralDensity(KTPowerSpectrumDataF& data)
+    {
+        unsigned nComponents = data.GetNComponents();
+        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+        {
+            data.GetSpectrum(iComponent)->ConvertToPowerSpectralDensity();
+        }
+        return true;
+    }
+
 } /* namespace Katydid */
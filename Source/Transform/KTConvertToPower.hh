@@ -18,8 +18,10 @@ namespace Katydid
 {
     
     class KTFrequencySpectrumDataFFTW;
+    class KTFrequencySpectrumDataFFTWF;
     class KTFrequencySpectrumDataPolar;
     class KTPowerSpectrumData;
+    class KTPowerSpectrumDataF;
     class KTAggregatedFrequencySpectrumDataFFTW;
 
     /*!
@@ -29,6 +31,8 @@ namespace Katydid
      @brief Converts to power spectra and power spectral densities
 
      @details
+     Single-precision spectra (KTFrequencySpectrumDataFFTWF, from KTForwardFFTWF) are converted to single-precision power spectra (KTPowerSpectrumDataF),
+     which are emitted with the "ps-f" and "psd-f" signals.
 
      Configuration name: "convert-to-power"
 
@@ -44,10 +48,16 @@ namespace Katydid
      - "aggfs-fftw-to-psd": void (Nymph::KTDataPtr) -- Converts an FFTW FS to a PSD; Requires KTAggregatedFrequencySpectrumDataFFTW; Adds KTPowerSpectrumData; Emits signal "psd"
      - "psd-to-ps": void (Nymph::KTDataPtr) -- Converts a PSD to a PS (in place); Requires KTPowerSpectrumData; Does not add additional data; Emits signal "ps"
      - "ps-to-psd": void (Nymph::KTDataPtr) -- Converts a PS to a PSD (in place); Requires KTPowerSpectrumData; Does not add additional data; Emits signal "psd"
+     - "fs-fftwf-to-ps": void (Nymph::KTDataPtr) -- Converts a single-precision FFTW FS to a PS; Requires KTFrequencySpectrumDataFFTWF; Adds KTPowerSpectrumDataF; Emits signal "ps-f"
+     - "fs-fftwf-to-psd": void (Nymph::KTDataPtr) -- Converts a single-precision FFTW FS to a PSD; Requires KTFrequencySpectrumDataFFTWF; Adds KTPowerSpectrumDataF; Emits signal "psd-f"
+     - "psd-f-to-ps": void (Nymph::KTDataPtr) -- Converts a single-precision PSD to a PS (in place); Requires KTPowerSpectrumDataF; Does not add additional data; Emits signal "ps-f"
+     - "ps-f-to-psd": void (Nymph::KTDataPtr) -- Converts a single-precision PS to a PSD (in place); Requires KTPowerSpectrumDataF; Does not add additional data; Emits signal "psd-f"
 
      Signals:
      - "ps": void (Nymph::KTDataPtr) -- Emitted upon creation of / conversion to a power spectrum; Guarantees KTPowerSpectrumData.
      - "psd": void (Nymph::KTDataPtr) -- Emitted upon creation of / conversion to a power spectral density; Guarantees KTPowerSpectrumData.
+     - "ps-f": void (Nymph::KTDataPtr) -- Emitted upon creation of / conversion to a single-precision power spectrum; Guarantees KTPowerSpectrumDataF.
+     - "psd-f": void (Nymph::KTDataPtr) -- Emitted upon creation of / conversion to a single-precision power spectral density; Guarantees KTPowerSpectrumDataF.
     */
 
     class KTConvertToPower : public Nymph::KTProcessor
@@ -74,6 +84,12 @@ namespace Katydid
             bool ToPowerSpectrum(KTPowerSpectrumData& data);
             bool ToPowerSpectralDensity(KTPowerSpectrumData& data);
 
+            bool ToPowerSpectrum(KTFrequencySpectrumDataFFTWF& data);
+            bool ToPowerSpectralDensity(KTFrequencySpectrumDataFFTWF& data);
+
+            bool ToPowerSpectrum(KTPowerSpectrumDataF& data);
+            bool ToPowerSpectralDensity(KTPowerSpectrumDataF& data);
+
         private:
 
             //***************
@@ -83,6 +99,8 @@ namespace Katydid
         private:
             Nymph::KTSignalData fPowerSpectrumSignal;
             Nymph::KTSignalData fPowerSpectralDensitySignal;
+            Nymph::KTSignalData fPowerSpectrumFSignal;
+            Nymph::KTSignalData fPowerSpectralDensityFSignal;
 
             //***************
             // Slots
@@ -97,6 +115,10 @@ namespace Katydid
             Nymph::KTSlotDataOneType< KTAggregatedFrequencySpectrumDataFFTW > fAggFSFToPSDSlot;
             Nymph::KTSlotDataOneType< KTPowerSpectrumData > fPSDToPSSlot;
             Nymph::KTSlotDataOneType< KTPowerSpectrumData > fPSToPSDSlot;
+            Nymph::KTSlotDataOneType< KTFrequencySpectrumDataFFTWF > fFSFFToPSSlot;
+            Nymph::KTSlotDataOneType< KTFrequencySpectrumDataFFTWF > fFSFFToPSDSlot;
+            Nymph::KTSlotDataOneType< KTPowerSpectrumDataF > fPSDFToPSSlot;
+            Nymph::KTSlotDataOneType< KTPowerSpectrumDataF > fPSFToPSDSlot;
     };
 }
  /* namespace Katydid */
@@ -0,0 +1,260 @@
+/*
+ * KTDACWindowFFTW.cc
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "KTDACWindowFFTW.hh"
+
+#include "KTEggHeader.hh"
+#include "KTFrequencySpectrumDataFFTW.hh"
+#include "KTLogger.hh"
+#include "KTRawTimeSeries.hh"
+#include "KTRawTimeSeriesData.hh"
+#include "KTTimeSeriesData.hh"
+#include "KTTimeSeriesFFTW.hh"
+#include "KTTimeSeriesReal.hh"
+#include "KTWindowFunction.hh"
+
+#include <algorithm>
+
+using std::string;
+
+
+namespace Katydid
+{
+    KTLOGGER(dwflog, "KTDACWindowFFTW");
+
+    KT_REGISTER_PROCESSOR(KTDACWindowFFTW, "dac-window-fftw");
+
+    KTDACWindowFFTW::KTDACWindowFFTW(const std::string& name) :
+            KTProcessor(name),
+            fSaveTimeSeries(false),
+            fDAC(),
+            fWindowFunction(NULL),
+            fForwardFFT(),
+            fWeights(),
+            fFFTSignal("fft", this),
+            fHeaderSlot("header", this, &KTDACWindowFFTW::InitializeWithHeader),
+            fRawTSSlot("raw-ts", this, &KTDACWindowFFTW::TransformRawData, &fFFTSignal)
+    {
+    }
+
+    KTDACWindowFFTW::~KTDACWindowFFTW()
+    {
+        delete fWindowFunction;
+    }
+
+    bool KTDACWindowFFTW::Configure(const scarab::param_node* node)
+    {
+        if (node == NULL) return false;
+
+        SetSaveTimeSeries(node->get_value< bool >("save-time-series", fSaveTimeSeries));
+
+        if (node->has("dac"))
+        {
+            if (! fDAC.Configure(node->node_at("dac")))
+            {
+                return false;
+            }
+        }
+
+        if (! SelectWindowFunction(node->get_value("window-function-type", "rectangular")))
+        {
+            return false;
+        }
+        if (! fWindowFunction->Configure(node->node_at("window-function")))
+        {
+            return false;
+        }
+
+        if (! fForwardFFT.Configure(node->node_at("forward-fftw")))
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    bool KTDACWindowFFTW::SelectWindowFunction(const string& windowType)
+    {
+        KTWindowFunction* tempWF = scarab::factory< KTWindowFunction >::get_instance()->create(windowType);
+        if (tempWF == NULL)
+        {
+            KTERROR(dwflog, "Invalid window function type given: <" << windowType << ">.");
+            return false;
+        }
+        SetWindowFunction(tempWF);
+        return true;
+    }
+
+    void KTDACWindowFFTW::SetWindowFunction(KTWindowFunction* wf)
+    {
+        delete fWindowFunction;
+        fWindowFunction = wf;
+        fWeights.clear();
+        return;
+    }
+
+    bool KTDACWindowFFTW::InitializeWithHeader(KTEggHeader& header)
+    {
+        if (! fDAC.InitializeWithHeader(header))
+        {
+            KTERROR(dwflog, "Unable to initialize the DAC");
+            return false;
+        }
+
+        if (fWindowFunction == NULL && ! SelectWindowFunction("rectangular"))
+        {
+            return false;
+        }
+        fWindowFunction->SetBinWidth(1. / header.GetAcquisitionRate());
+        fWindowFunction->SetSize(header.GetChannelHeader(0)->GetSliceSize());
+        fWindowFunction->RebuildWindowFunction();
+
+        if (! fForwardFFT.InitializeWithHeader(header))
+        {
+            KTERROR(dwflog, "Unable to initialize the FFT");
+            return false;
+        }
+        if (fForwardFFT.GetState() != KTForwardFFTW::kR2C && fForwardFFT.GetState() != KTForwardFFTW::kC2C)
+        {
+            KTERROR(dwflog, "Only R2C and C2C transforms are supported");
+            return false;
+        }
+
+        BuildWeights();
+
+        KTDEBUG(dwflog, "DAC, window function and FFT initialized with header");
+        return true;
+    }
+
+    bool KTDACWindowFFTW::TransformRawData(KTRawTimeSeriesData& rawData)
+    {
+        KTForwardFFTW::State state = fForwardFFT.GetState();
+        if (state != KTForwardFFTW::kR2C && state != KTForwardFFTW::kC2C)
+        {
+            KTERROR(dwflog, "The FFT must be initialized for an R2C or C2C transform (current state: <" << state << ">)");
+            return false;
+        }
+
+        unsigned nComponents = rawData.GetNComponents();
+        if (nComponents > fDAC.GetNChannels())
+        {
+            KTERROR(dwflog, "There are more components (" << nComponents << ") than DAC channels (" << fDAC.GetNChannels() << ")");
+            return false;
+        }
+
+        // complex samples take up two bins of the raw time series
+        unsigned valuesPerBin = state == KTForwardFFTW::kC2C ? 2 : 1;
+        const KTRawTimeSeries* firstTS = rawData.GetTimeSeries(0);
+        unsigned nTimeBins = firstTS->size() / valuesPerBin;
+        double timeBinWidth = (firstTS->GetRangeMax() - firstTS->GetRangeMin()) / (double)nTimeBins;
+
+        if (! CheckTimeSize(nTimeBins, timeBinWidth))
+        {
+            return false;
+        }
+
+        KTFrequencySpectrumDataFFTW& newData = rawData.Of< KTFrequencySpectrumDataFFTW >().SetNComponents(nComponents);
+        KTTimeSeriesData* tsData = NULL;
+        if (fSaveTimeSeries)
+        {
+            tsData = &(rawData.Of< KTTimeSeriesData >().SetNComponents(nComponents));
+        }
+
+        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+        {
+            KTRawTimeSeries* nextInput = rawData.GetTimeSeries(iComponent);
+            if (nextInput->size() != fWeights.size())
+            {
+                KTERROR(dwflog, "Component <" << iComponent << "> has " << nextInput->size() << " raw bins; expected " << fWeights.size());
+                return false;
+            }
+
+            // DAC and window, straight into the FFT input array
+            double* fftInput = fForwardFFT.GetInputArray();
+            if (! fDAC.GetChannelDAC(iComponent).ConvertToArray(nextInput, fftInput, &fWeights[0]))
+            {
+                KTERROR(dwflog, "Component <" << iComponent << "> was not converted correctly.");
+                return false;
+            }
+
+            if (tsData != NULL)
+            {
+                if (state == KTForwardFFTW::kR2C)
+                {
+                    KTTimeSeriesReal* newTS = new KTTimeSeriesReal(nTimeBins, nextInput->GetRangeMin(), nextInput->GetRangeMax());
+                    std::copy(fftInput, fftInput + nTimeBins, newTS->GetData());
+                    tsData->SetTimeSeries(newTS, iComponent);
+                }
+                else
+                {
+                    KTTimeSeriesFFTW* newTS = new KTTimeSeriesFFTW(nTimeBins, nextInput->GetRangeMin(), nextInput->GetRangeMax());
+                    std::copy(fftInput, fftInput + 2 * nTimeBins, reinterpret_cast< double* >(newTS->GetData()));
+                    tsData->SetTimeSeries(newTS, iComponent);
+                }
+            }
+
+            KTFrequencySpectrumFFTW* nextResult = fForwardFFT.TransformInputArray(timeBinWidth);
+            KTDEBUG(dwflog, "FFT computed; size: " << nextResult->size() << "; range: " << nextResult->GetRangeMin() << " - " << nextResult->GetRangeMax());
+            newData.SetSpectrum(nextResult, iComponent);
+        }
+
+        KTINFO(dwflog, "DAC, windowing and FFT complete; " << nComponents << " channel(s) transformed");
+
+        return true;
+    }
+
+    bool KTDACWindowFFTW::CheckTimeSize(unsigned nTimeBins, double timeBinWidth)
+    {
+        if (fWindowFunction == NULL && ! SelectWindowFunction("rectangular"))
+        {
+            return false;
+        }
+
+        if (fWindowFunction->GetSize() != nTimeBins)
+        {
+            fWindowFunction->SetBinWidth(timeBinWidth);
+            fWindowFunction->SetSize(nTimeBins);
+            fWindowFunction->RebuildWindowFunction();
+            fWeights.clear();
+        }
+
+        if (! fForwardFFT.GetIsInitialized() || fForwardFFT.GetTimeSize() != nTimeBins)
+        {
+            bool initialized = fForwardFFT.GetState() == KTForwardFFTW::kR2C ?
+                    fForwardFFT.InitializeForRealTDD(nTimeBins) : fForwardFFT.InitializeForComplexTDD(nTimeBins);
+            if (! initialized)
+            {
+                KTERROR(dwflog, "Unable to initialize the FFT for " << nTimeBins << " time bins");
+                return false;
+            }
+        }
+
+        if (fWeights.empty())
+        {
+            BuildWeights();
+        }
+        return true;
+    }
+
+    void KTDACWindowFFTW::BuildWeights()
+    {
+        // the FFT input array is interleaved for complex data, so each weight is used twice
+        unsigned valuesPerBin = fForwardFFT.GetState() == KTForwardFFTW::kC2C ? 2 : 1;
+        unsigned nBins = fWindowFunction->GetSize();
+        fWeights.resize(nBins * valuesPerBin);
+        for (unsigned iBin = 0; iBin < nBins; ++iBin)
+        {
+            double weight = fWindowFunction->GetWeight(iBin);
+            for (unsigned iValue = 0; iValue < valuesPerBin; ++iValue)
+            {
+                fWeights[iBin * valuesPerBin + iValue] = weight;
+            }
+        }
+        return;
+    }
+
+} /* namespace Katydid */
@@ -0,0 +1,132 @@
+/**
+ @file KTDACWindowFFTW.hh
+ @brief Contains KTDACWindowFFTW
+ @details Fused digital-to-analog conversion, windowing, and forward FFT
+ @author: agent
+ @date: Oct 17, 2026
+ */
+
+#ifndef KTDACWINDOWFFTW_HH_
+#define KTDACWINDOWFFTW_HH_
+
+#include "KTProcessor.hh"
+
+#include "KTDAC.hh"
+#include "KTForwardFFTW.hh"
+#include "KTMemberVariable.hh"
+#include "KTSlot.hh"
+
+#include <string>
+#include <vector>
+
+
+namespace Katydid
+{
+
+    class KTEggHeader;
+    class KTRawTimeSeriesData;
+    class KTWindowFunction;
+
+    /*!
+     @class KTDACWindowFFTW
+     @author agent
+
+     @brief Converts raw time series to voltages, applies a window function, and performs a forward FFT, in one pass.
+
+     @details
+     This does the same thing as the chain KTDAC --> KTWindower --> KTForwardFFTW, but the DAC output is written,
+     already multiplied by the window weights, directly into the FFT's aligned input array.
+     The intermediate time series are not created unless "save-time-series" is set.
+
+     The egg processor should be run with "normalize-voltages" set to false, and its "raw-ts" signal should be connected to the "raw-ts" slot.
+
+     Real data is transformed with an R2C transform, and complex (IQ) data with a C2C transform.
+     The real-as-complex transform is not supported.
+     Oversampled DAC conversion (i.e. emulating a larger number of bits) is not supported.
+
+     Configuration name: "dac-window-fftw"
+
+     Available configuration values:
+     - "save-time-series": bool -- Option to also add the (converted and windowed) time series to the data object as KTTimeSeriesData
+     - "dac": nested config -- See KTDAC
+     - "window-function-type": string -- sets the type of window function to be used (see KTWindower)
+     - "window-function": nested config -- window function configuration
+     - "forward-fftw": nested config -- See KTForwardFFTW
+
+     Slots:
+     - "header": void (Nymph::KTDataPtr) -- Initializes the DAC, window function, and FFT; Requires KTEggHeader
+     - "raw-ts": void (Nymph::KTDataPtr) -- Converts, windows and transforms the raw time series; Requires KTRawTimeSeriesData; Adds KTFrequencySpectrumDataFFTW; Optionally adds KTTimeSeriesData; Emits signal "fft"
+
+     Signals:
+     - "fft": void (Nymph::KTDataPtr) -- Emitted upon performance of a forward transform; Guarantees KTFrequencySpectrumDataFFTW.
+    */
+
+    class KTDACWindowFFTW : public Nymph::KTProcessor
+    {
+        public:
+            KTDACWindowFFTW(const std::string& name = "dac-window-fftw");
+            virtual ~KTDACWindowFFTW();
+
+            bool Configure(const scarab::param_node* node);
+
+            MEMBERVARIABLE(bool, SaveTimeSeries);
+
+            KTDAC& GetDAC();
+            KTForwardFFTW& GetForwardFFT();
+
+            KTWindowFunction* GetWindowFunction() const;
+            void SetWindowFunction(KTWindowFunction* wf);
+            bool SelectWindowFunction(const std::string& windowType);
+
+        private:
+            KTDAC fDAC;
+            KTWindowFunction* fWindowFunction;
+            KTForwardFFTW fForwardFFT;
+
+        public:
+            bool InitializeWithHeader(KTEggHeader& header);
+
+            bool TransformRawData(KTRawTimeSeriesData& rawData);
+
+        private:
+            /// Re-initializes the window and the FFT if the number of time bins has changed
+            bool CheckTimeSize(unsigned nTimeBins, double timeBinWidth);
+            /// Fills fWeights with the window weights, one per value in the FFT input array
+            void BuildWeights();
+
+            std::vector< double > fWeights;
+
+            //***************
+            // Signals
+            //***************
+
+        private:
+            Nymph::KTSignalData fFFTSignal;
+
+            //***************
+            // Slots
+            //***************
+
+        private:
+            Nymph::KTSlotDataOneType< KTEggHeader > fHeaderSlot;
+            Nymph::KTSlotDataOneType< KTRawTimeSeriesData > fRawTSSlot;
+
+    };
+
+    inline KTDAC& KTDACWindowFFTW::GetDAC()
+    {
+        return fDAC;
+    }
+
+    inline KTForwardFFTW& KTDACWindowFFTW::GetForwardFFT()
+    {
+        return fForwardFFT;
+    }
+
+    inline KTWindowFunction* KTDACWindowFFTW::GetWindowFunction() const
+    {
+        return fWindowFunction;
+    }
+
+} /* namespace Katydid */
+#endif /* KTDACWINDOWFFTW_HH_ */
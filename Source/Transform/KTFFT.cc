@@ -26,36 +26,80 @@ namespace Katydid
     }
 
     KTFFTW::KTFFTW() :
-            KTFFT()
+            KTFFT(),
+#ifdef FFTW_NTHREADS
+            fNThreads(FFTW_NTHREADS)
+#else
+            fNThreads(1)
+#endif
     {
         sInstanceCount++;
     }
 
     KTFFTW::~KTFFTW()
     {
-#ifdef FFTW_NTHREADS
-        if (sInstanceCount == 1)
+        // FFTW's thread data isn't released here, since the plans outlive the FFT objects (see KTFFTWPlanCache)
+        sInstanceCount--;
+    }
+
+    void KTFFTW::SetNThreads(unsigned nThreads)
+    {
+        if (nThreads == 0) nThreads = 1;
+#ifndef FFTW_NTHREADS
+        if (nThreads > 1)
         {
-            fftw_cleanup_threads();
+            KTWARN(fftlog, "Katydid was built without threaded FFTW; " << nThreads << " threads were requested, but only 1 will be used");
         }
 #endif
-        sInstanceCount--;
+        fNThreads = nThreads;
+        return;
     }
 
     void KTFFTW::InitializeMultithreaded()
+    {
+        SetPlannerThreads(fNThreads);
+        return;
+    }
+
+    void KTFFTW::SetPlannerThreads(unsigned nThreads)
     {
 #ifdef FFTW_NTHREADS
         if (! sMultithreadedIsInitialized)
         {
-            fftw_init_threads();
-            fftw_plan_with_nthreads(FFTW_NTHREADS);
-            KTDEBUG(fftlog, "Configuring FFTW to use up to " << FFTW_NTHREADS << " threads.");
+            if (fftw_init_threads() == 0)
+            {
+                KTERROR(fftlog, "Unable to initialize threaded FFTW; plans will be single-threaded");
+                return;
+            }
             sMultithreadedIsInitialized = true;
         }
+        fftw_plan_with_nthreads(nThreads);
+        KTDEBUG(fftlog, "Configuring FFTW to use up to " << nThreads << " threads.");
 #endif
         return;
     }
 
+    void KTFFTW::CleanupThreads()
+    {
+#ifdef FFTW_NTHREADS
+        if (sMultithreadedIsInitialized)
+        {
+            fftw_cleanup_threads();
+            sMultithreadedIsInitialized = false;
+        }
+#endif
+        return;
+    }
+
+    bool KTFFTW::GetThreadsAvailable()
+    {
+#ifdef FFTW_NTHREADS
+        return true;
+#else
+        return false;
+#endif
+    }
+
 
     unsigned KTFFTW::sInstanceCount = 0;
     bool KTFFTW::sMultithreadedIsInitialized = false;
@@ -63,12 +63,36 @@ namespace Katydid
             KTFFTW();
             virtual ~KTFFTW();
 
+            /// Number of threads used by this object's FFTW plans; takes effect the next time a plan is made.
+            /// If FFTW was built without threads, plans are always single-threaded.
+            unsigned GetNThreads() const;
+            void SetNThreads(unsigned nThreads);
+
+            /// Initializes threaded FFTW (once per process), and sets the number of threads for the next plan that's made.
+            /// Call this immediately before making each plan, since the number of threads is global FFTW state.
             void InitializeMultithreaded();
 
+            /// Returns true if Katydid was built with threaded FFTW
+            static bool GetThreadsAvailable();
+
+            /// Static version of InitializeMultithreaded(); used by KTFFTWPlanCache
+            static void SetPlannerThreads(unsigned nThreads);
+            /// Releases FFTW's thread data; all plans must have been destroyed first, so this is done by KTFFTWPlanCache at exit
+            static void CleanupThreads();
+
+        protected:
+            unsigned fNThreads;
+
+        public:
             static unsigned sInstanceCount;
             static bool sMultithreadedIsInitialized;
     };
 
+    inline unsigned KTFFTW::GetNThreads() const
+    {
+        return fNThreads;
+    }
+
 
 
 } /* namespace Katydid */
@@ -0,0 +1,187 @@
+/*
+ * KTFFTWPlanCache.cc
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "KTFFTWPlanCache.hh"
+
+#include "KTFFT.hh"
+#include "KTLogger.hh"
+
+namespace Katydid
+{
+    KTLOGGER(pclog, "KTFFTWPlanCache");
+
+    KTFFTWPlanCache::PlanKey::PlanKey(Type type, unsigned size, unsigned flags, int direction) :
+            fType(type),
+            fDirection(type == kC2C ? direction : 0),
+            fSize(size),
+            fHowMany(1),
+            fInPlace(false),
+            fAligned(true),
+            fFlags(flags),
+            fNThreads(1)
+    {
+    }
+
+    bool KTFFTWPlanCache::PlanKey::operator<(const PlanKey& rhs) const
+    {
+        if (fType != rhs.fType) return fType < rhs.fType;
+        if (fDirection != rhs.fDirection) return fDirection < rhs.fDirection;
+        if (fSize != rhs.fSize) return fSize < rhs.fSize;
+        if (fHowMany != rhs.fHowMany) return fHowMany < rhs.fHowMany;
+        if (fInPlace != rhs.fInPlace) return fInPlace < rhs.fInPlace;
+        if (fAligned != rhs.fAligned) return fAligned < rhs.fAligned;
+        if (fFlags != rhs.fFlags) return fFlags < rhs.fFlags;
+        return fNThreads < rhs.fNThreads;
+    }
+
+
+    KTFFTWPlanCache::KTFFTWPlanCache() :
+            fPlans(),
+            fWisdomFiles(),
+            fMutex()
+    {
+    }
+
+    KTFFTWPlanCache::~KTFFTWPlanCache()
+    {
+        std::unique_lock< std::mutex > lock(fMutex);
+
+        ExportWisdomUnlocked();
+
+        KTDEBUG(pclog, "Destroying " << fPlans.size() << " FFTW plans");
+        for (PlanMap::iterator planIt = fPlans.begin(); planIt != fPlans.end(); ++planIt)
+        {
+            fftw_destroy_plan(planIt->second);
+        }
+        fPlans.clear();
+
+        // all plans have to be gone before the threads are cleaned up
+        KTFFTW::CleanupThreads();
+    }
+
+    fftw_plan KTFFTWPlanCache::GetPlan(const PlanKey& key)
+    {
+        std::unique_lock< std::mutex > lock(fMutex);
+
+        PlanMap::const_iterator planIt = fPlans.find(key);
+        if (planIt != fPlans.end())
+        {
+            KTDEBUG(pclog, "Using cached plan for size " << key.fSize << " (x" << key.fHowMany << ")");
+            return planIt->second;
+        }
+
+        fftw_plan newPlan = MakePlan(key);
+        if (newPlan == NULL)
+        {
+            KTERROR(pclog, "Unable to make the FFTW plan for size " << key.fSize << " (x" << key.fHowMany << ")");
+            return NULL;
+        }
+        fPlans.insert(PlanMap::value_type(key, newPlan));
+        return newPlan;
+    }
+
+    fftw_plan KTFFTWPlanCache::MakePlan(const PlanKey& key)
+    {
+        int size = key.fSize;
+        int howMany = key.fHowMany;
+        int nComplex = key.fType == kC2C ? size : size / 2 + 1;
+        // padded length of the real array for in-place real transforms
+        int nReal = key.fInPlace ? 2 * nComplex : size;
+
+        unsigned flags = key.fFlags;
+        if (! key.fAligned) flags |= FFTW_UNALIGNED;
+
+        KTFFTW::SetPlannerThreads(key.fNThreads);
+
+        // planning can overwrite the arrays, so the plan is made with scratch arrays
+        double* realArray = NULL;
+        fftw_complex* complexIn = NULL;
+        fftw_complex* complexOut = NULL;
+        if (key.fType == kC2C)
+        {
+            complexIn = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * nComplex * howMany);
+            complexOut = key.fInPlace ? complexIn : (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * nComplex * howMany);
+        }
+        else
+        {
+            complexOut = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * nComplex * howMany);
+            realArray = key.fInPlace ? reinterpret_cast< double* >(complexOut) : (double*) fftw_malloc(sizeof(double) * nReal * howMany);
+        }
+
+        fftw_plan newPlan = NULL;
+        if (key.fType == kC2C)
+        {
+            KTDEBUG(pclog, "Creating C2C plan: " << size << " bins x " << howMany << "; direction " << key.fDirection);
+            newPlan = fftw_plan_many_dft(1, &size, howMany, complexIn, NULL, 1, nComplex, complexOut, NULL, 1, nComplex, key.fDirection, flags);
+        }
+        else if (key.fType == kR2C)
+        {
+            KTDEBUG(pclog, "Creating R2C plan: " << size << " bins x " << howMany);
+            newPlan = fftw_plan_many_dft_r2c(1, &size, howMany, realArray, NULL, 1, nReal, complexOut, NULL, 1, nComplex, flags);
+        }
+        else // kC2R
+        {
+            KTDEBUG(pclog, "Creating C2R plan: " << size << " bins x " << howMany);
+            newPlan = fftw_plan_many_dft_c2r(1, &size, howMany, complexOut, NULL, 1, nComplex, realArray, NULL, 1, nReal, flags);
+        }
+
+        if (key.fType == kC2C)
+        {
+            if (! key.fInPlace) fftw_free(complexOut);
+            fftw_free(complexIn);
+        }
+        else
+        {
+            if (! key.fInPlace) fftw_free(realArray);
+            fftw_free(complexOut);
+        }
+
+        return newPlan;
+    }
+
+    bool KTFFTWPlanCache::UseWisdomFile(const std::string& filename)
+    {
+        std::unique_lock< std::mutex > lock(fMutex);
+
+        if (! fWisdomFiles.insert(filename).second) return true;
+
+        KTDEBUG(pclog, "Reading wisdom from file <" << filename << ">");
+        if (fftw_import_wisdom_from_filename(filename.c_str()) == 0)
+        {
+            KTWARN(pclog, "Unable to read FFTW wisdom from file <" << filename << ">");
+            return false;
+        }
+        return true;
+    }
+
+    void KTFFTWPlanCache::ExportWisdom()
+    {
+        std::unique_lock< std::mutex > lock(fMutex);
+        ExportWisdomUnlocked();
+        return;
+    }
+
+    void KTFFTWPlanCache::ExportWisdomUnlocked()
+    {
+        for (std::set< std::string >::const_iterator fileIt = fWisdomFiles.begin(); fileIt != fWisdomFiles.end(); ++fileIt)
+        {
+            KTDEBUG(pclog, "Writing wisdom to file <" << *fileIt << ">");
+            if (fftw_export_wisdom_to_filename(fileIt->c_str()) == 0)
+            {
+                KTWARN(pclog, "Unable to write FFTW wisdom to file <" << *fileIt << ">");
+            }
+        }
+        return;
+    }
+
+    unsigned KTFFTWPlanCache::GetNPlans() const
+    {
+        std::unique_lock< std::mutex > lock(fMutex);
+        return fPlans.size();
+    }
+
+} /* namespace Katydid */
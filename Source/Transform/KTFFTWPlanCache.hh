@@ -0,0 +1,103 @@
+/*
+ * KTFFTWPlanCache.hh
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#ifndef KTFFTWPLANCACHE_HH_
+#define KTFFTWPLANCACHE_HH_
+
+#include "singleton.hh"
+
+#include <fftw3.h>
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace Katydid
+{
+
+    /*!
+       @class KTFFTWPlanCache
+       @author agent
+
+       @brief Process-wide registry of FFTW plans and wisdom
+
+       @details
+       Processors that do FFTs (KTForwardFFTW, KTReverseFFTW, and those built on them, plus KTConvolution1D) get their plans from here
+       instead of planning for themselves.  A plan is made once for each distinct set of plan parameters (see PlanKey),
+       and is then shared by every processor asking for the same transform.
+
+       Plans are made with scratch arrays owned by the cache, so they must be executed with the new-array execute functions
+       (fftw_execute_dft(), fftw_execute_dft_r2c(), and fftw_execute_dft_c2r()), never with fftw_execute().
+       The arrays used must match the plan: same in-place/out-of-place layout, and SIMD-aligned (e.g. from fftw_malloc) unless the plan was made unaligned.
+
+       Plans belong to the cache; do not call fftw_destroy_plan() on them.  They're destroyed when the cache is destroyed at program exit.
+
+       Wisdom: each wisdom file is read the first time it's requested with UseWisdomFile().
+       FFTW merges all of the wisdom it has into one set, and at program exit (or when ExportWisdom() is called) that set is written to every wisdom file that was used.
+
+       Planning is protected by a mutex, so plans can be requested from multiple threads; executing a plan is thread-safe in FFTW.
+      */
+    class KTFFTWPlanCache : public scarab::singleton< KTFFTWPlanCache >
+    {
+        public:
+            enum Type
+            {
+                kC2C,
+                kR2C,
+                kC2R
+            };
+
+            struct PlanKey
+            {
+                PlanKey(Type type, unsigned size, unsigned flags, int direction = FFTW_FORWARD);
+
+                Type fType;
+                int fDirection; // only used for C2C transforms
+                unsigned fSize; // number of time bins (i.e. the logical size of the transform)
+                unsigned fHowMany; // number of contiguous transforms done with one execution
+                bool fInPlace;
+                bool fAligned; // if false, the plan is made with FFTW_UNALIGNED
+                unsigned fFlags;
+                unsigned fNThreads;
+
+                bool operator<(const PlanKey& rhs) const;
+            };
+
+        private:
+            KTFFTWPlanCache();
+            virtual ~KTFFTWPlanCache();
+
+        public:
+            /// Returns the plan for the given parameters, making it if it doesn't exist yet; returns NULL if planning fails
+            fftw_plan GetPlan(const PlanKey& key);
+
+            /// Reads wisdom from the file the first time that file is requested; the file will be updated with the merged wisdom at exit
+            bool UseWisdomFile(const std::string& filename);
+            /// Writes the merged wisdom to every wisdom file that's been used
+            void ExportWisdom();
+
+            unsigned GetNPlans() const;
+
+        private:
+            friend class scarab::singleton< KTFFTWPlanCache >;
+            friend class scarab::destroyer< KTFFTWPlanCache >;
+
+            fftw_plan MakePlan(const PlanKey& key); // not thread-safe
+            void ExportWisdomUnlocked(); // not thread-safe
+
+            typedef std::map< PlanKey, fftw_plan > PlanMap;
+            PlanMap fPlans;
+
+            std::set< std::string > fWisdomFiles;
+
+            mutable std::mutex fMutex;
+    };
+
+} /* namespace Katydid */
+
+#endif /* KTFFTWPLANCACHE_HH_ */
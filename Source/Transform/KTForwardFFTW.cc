@@ -10,6 +10,7 @@
 #include "KTAnalyticAssociateData.hh"
 #include "KTCacheDirectory.hh"
 #include "KTEggHeader.hh"
+#include "KTFFTWPlanCache.hh"
 #include "KTFrequencySpectrumDataFFTW.hh"
 #include "KTLogger.hh"
 #include "KTTimeSeriesData.hh"
@@ -38,6 +39,7 @@ namespace Katydid
             fTimeSize(0),
             fFrequencySize(0),
             fTransformFlag("ESTIMATE"),
+            fBatchSize(1),
             fTransformFlagMap(),
             fState(kNone),
             fIsInitialized(false),
@@ -45,20 +47,29 @@ namespace Katydid
             fRInputArray(NULL),
             fCInputArray(NULL),
             fOutputArray(NULL),
+            fBatchPlan(NULL),
+            fBatchRInputArray(NULL),
+            fBatchCInputArray(NULL),
+            fBatchOutputArray(NULL),
+            fPendingSlices(),
+            fBatchEntries(),
             fFFTSignal("fft", this),
             fHeaderSlot("header", this, &KTForwardFFTW::InitializeWithHeader),
             fTSRealSlot("ts-real", this, &KTForwardFFTW::TransformRealData, &fFFTSignal),
             fTSComplexSlot("ts-fftw", this, &KTForwardFFTW::TransformComplexData, &fFFTSignal),
             fAASlot("aa", this, &KTForwardFFTW::TransformComplexData, &fFFTSignal),
-            fTSRealAsComplexSlot("ts-real-as-complex", this, &KTForwardFFTW::TransformRealDataAsComplex, &fFFTSignal)
+            fTSRealAsComplexSlot("ts-real-as-complex", this, &KTForwardFFTW::TransformRealDataAsComplex, &fFFTSignal),
+            fTSBatchSlot("ts-batch", this, &KTForwardFFTW::QueueSliceForBatch),
+            fFlushBatchSlot("flush-batch", this, &KTForwardFFTW::FlushBatch)
     {
         SetupInternalMaps();
     }
 
     KTForwardFFTW::~KTForwardFFTW()
     {
+        // the plans belong to the plan cache
         FreeArrays();
-        if (fForwardPlan != NULL) fftw_destroy_plan(fForwardPlan);
+        FreeBatch();
     }
 
     bool KTForwardFFTW::Configure(const scarab::param_node* node)
@@ -71,8 +82,12 @@ namespace Katydid
             SetUseWisdom(node->get_value<bool>("use-wisdom", fUseWisdom));
             SetWisdomFilename(node->get_value("wisdom-filename", fWisdomFilename));
 
+            SetNThreads(node->get_value< unsigned >("n-threads", fNThreads));
+
             SetComplexAsIQ(node->get_value("transform-complex-as-iq", fComplexAsIQ));
 
+            SetBatchSize(node->get_value< unsigned >("batch-size", fBatchSize));
+
             if( node->has("transform-state") )
             {
                 string intendedState(node->get_value("transform-state"));
@@ -150,22 +165,20 @@ namespace Katydid
             return false;
         }
 
+        // the wisdom file is only read the first time it's used, and is written when the program exits
+        KTFFTWPlanCache* planCache = KTFFTWPlanCache::get_instance();
         if (fUseWisdom)
         {
-            KTDEBUG(fftwlog, "Reading wisdom from file <" << fWisdomFilename << ">");
-            if (fftw_import_wisdom_from_filename(fWisdomFilename.c_str()) == 0)
-            {
-                KTWARN(fftwlog, "Unable to read FFTW wisdom from file <" << fWisdomFilename << ">");
-            }
+            planCache->UseWisdomFile(fWisdomFilename);
         }
 
-        InitializeMultithreaded();
-
         if (intendedState == kR2C)
         {
-            KTDEBUG(fftwlog, "Creating R2C plan: " << fTimeSize << " time bins; forward FFT");
+            KTDEBUG(fftwlog, "Getting R2C plan: " << fTimeSize << " time bins; forward FFT");
             // No FFTW_PRESERVE_INPUT, since the input array contents are replaced for each FFT
-            fForwardPlan = fftw_plan_dft_r2c_1d(fTimeSize, fRInputArray, fOutputArray, transformFlag);
+            KTFFTWPlanCache::PlanKey key(KTFFTWPlanCache::kR2C, fTimeSize, transformFlag);
+            key.fNThreads = fNThreads;
+            fForwardPlan = planCache->GetPlan(key);
             // deleting arrays to save space
             // input array is required; output array is not needed
             KTDEBUG(fftwlog, "Freeing output array");
@@ -174,17 +187,21 @@ namespace Katydid
         }
         else if (intendedState == kC2C)
         {
-            KTDEBUG(fftwlog, "Creating C2C plan: " << fTimeSize << " time bins; forward FFT");
+            KTDEBUG(fftwlog, "Getting C2C plan: " << fTimeSize << " time bins; forward FFT");
             // Add FFTW_PRESERVE_INPUT so that the input array content is not destroyed during the FFT
-            fForwardPlan = fftw_plan_dft_1d(fTimeSize, fCInputArray, fOutputArray, FFTW_FORWARD, transformFlag | FFTW_PRESERVE_INPUT);
+            KTFFTWPlanCache::PlanKey key(KTFFTWPlanCache::kC2C, fTimeSize, transformFlag | FFTW_PRESERVE_INPUT, FFTW_FORWARD);
+            key.fNThreads = fNThreads;
+            fForwardPlan = planCache->GetPlan(key);
             // deleting arrays to save space
             FreeArrays();
         }
         else // intendedState == kRasC2C
         {
-            KTDEBUG(fftwlog, "Creating RasC2C plan: " << fTimeSize << " time bins; forward FFT");
+            KTDEBUG(fftwlog, "Getting RasC2C plan: " << fTimeSize << " time bins; forward FFT");
             // No FFTW_PRESERVE_INPUT, since the input array contents are replaced for each FFT
-            fForwardPlan = fftw_plan_dft_1d(fTimeSize, fCInputArray, fOutputArray, FFTW_FORWARD, transformFlag);
+            KTFFTWPlanCache::PlanKey key(KTFFTWPlanCache::kC2C, fTimeSize, transformFlag, FFTW_FORWARD);
+            key.fNThreads = fNThreads;
+            fForwardPlan = planCache->GetPlan(key);
             // deleting arrays to save space
             // input array not required for C2C, but is for kRasC2C; output array not needed in either case
             KTDEBUG(fftwlog, "Freeing output array");
@@ -192,17 +209,17 @@ namespace Katydid
             fOutputArray = NULL;
         }
 
+        if (fForwardPlan != NULL && ! InitializeBatch(intendedState, transformFlag))
+        {
+            fIsInitialized = false;
+            KTERROR(fftwlog, "Unable to create the batched forward FFT plan! FFT is not initialized.");
+            return false;
+        }
+
         if (fForwardPlan != NULL)
         {
             fIsInitialized = true;
-            if (fUseWisdom)
-            {
-                if (fftw_export_wisdom_to_filename(fWisdomFilename.c_str()) == 0)
-                {
-                    KTWARN(fftwlog, "Unable to write FFTW wisdom to file <" << fWisdomFilename << ">");
-                }
-            }
-            KTDEBUG(fftwlog, "FFTW plan created; Initialization complete.");
+            KTDEBUG(fftwlog, "FFTW plan ready; Initialization complete.");
         }
         else
         {
@@ -264,7 +281,10 @@ namespace Katydid
 
         KTFrequencySpectrumDataFFTW& newData = tsData.Of< KTFrequencySpectrumDataFFTW >().SetNComponents(nComponents);
 
-        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+        // components are transformed K at a time if batching is on; the remainder is done one at a time
+        unsigned nBatched = TransformComponentsInBatches(tsData, newData);
+
+        for (unsigned iComponent = nBatched; iComponent < nComponents; ++iComponent)
         {
             const KTTimeSeriesReal* nextInput = dynamic_cast< const KTTimeSeriesReal* >(tsData.GetTimeSeries(iComponent));
             if (nextInput == NULL)
@@ -368,7 +388,10 @@ namespace Katydid
 
         KTFrequencySpectrumDataFFTW& newData = tsData.Of< KTFrequencySpectrumDataFFTW >().SetNComponents(nComponents);
 
-        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+        // components are transformed K at a time if batching is on; the remainder is done one at a time
+        unsigned nBatched = TransformComponentsInBatches(tsData, newData);
+
+        for (unsigned iComponent = nBatched; iComponent < nComponents; ++iComponent)
         {
             const KTTimeSeriesFFTW* nextInput = dynamic_cast< const KTTimeSeriesFFTW* >(tsData.GetTimeSeries(iComponent));
             if (nextInput == NULL)
@@ -553,6 +576,318 @@ namespace Katydid
         return;
     }
 
+    double* KTForwardFFTW::GetInputArray()
+    {
+        if (! fIsInitialized) return NULL;
+
+        if (fState == kR2C) return fRInputArray;
+
+        // the C2C initialization frees the input array, since that transform normally works on the time series' own array
+        if (fCInputArray == NULL)
+        {
+            KTDEBUG(fftwlog, "Allocating complex input array");
+            fCInputArray = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * fTimeSize);
+        }
+        return reinterpret_cast< double* >(fCInputArray);
+    }
+
+    KTFrequencySpectrumFFTW* KTForwardFFTW::TransformInputArray(double timeBinWidth) const
+    {
+        UpdateBinningCache(timeBinWidth);
+
+        KTFrequencySpectrumFFTW* newFS = new KTFrequencySpectrumFFTW(fFrequencySize, fFreqMinCache, fFreqMaxCache, fState != kR2C);
+        fftw_complex* dataOut = reinterpret_cast< fftw_complex* >(newFS->GetData().data());
+        if (fState == kR2C)
+        {
+            fftw_execute_dft_r2c(fForwardPlan, fRInputArray, dataOut);
+            (*newFS) *= sqrt(2. / (double)fTimeSize);
+        }
+        else
+        {
+            fftw_execute_dft(fForwardPlan, fCInputArray, dataOut);
+            (*newFS) *= sqrt(1. / (double)fTimeSize);
+        }
+        newFS->SetNTimeBins(fTimeSize);
+        return newFS;
+    }
+
+    void KTForwardFFTW::QueueSliceForBatch(Nymph::KTDataPtr data)
+    {
+        if (! data->Has< KTTimeSeriesData >())
+        {
+            KTERROR(fftwlog, "Data not found with type < KTTimeSeriesData >!");
+            return;
+        }
+        KTTimeSeriesData& tsData = data->Of< KTTimeSeriesData >();
+
+        if (fState != kR2C && fState != kC2C)
+        {
+            KTERROR(fftwlog, "Batched transforms can only be done in the R2C and C2C states (current state: <" << fState << ">)");
+            return;
+        }
+
+        if (tsData.GetTimeSeries(0)->GetNTimeBins() != GetTimeSize())
+        {
+            // anything already in the batch has the old size; it's transformed before the plans are remade
+            SetTimeSize(tsData.GetTimeSeries(0)->GetNTimeBins());
+            InitializeFFT(fState);
+        }
+
+        if (! fIsInitialized)
+        {
+            KTERROR(fftwlog, "FFT must be initialized before the transform is performed\n"
+                    << "\tPlease initialize the FFT first, then perform the transform.");
+            return;
+        }
+
+        // without a batch plan, the slice is just transformed on its own
+        if (fBatchPlan == NULL)
+        {
+            bool success = fState == kR2C ? TransformRealData(tsData) : TransformComplexData(tsData);
+            if (success) fFFTSignal(data);
+            return;
+        }
+
+        unsigned nComponents = tsData.GetNComponents();
+        data->Of< KTFrequencySpectrumDataFFTW >().SetNComponents(nComponents);
+
+        PendingSlice newSlice;
+        newSlice.fData = data;
+        newSlice.fNComponents = nComponents;
+        newSlice.fNTransformed = 0;
+        fPendingSlices.push_back(newSlice);
+        PendingSlice* slice = &fPendingSlices.back();
+
+        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+        {
+            const KTTimeSeries* nextInput = tsData.GetTimeSeries(iComponent);
+            if (! GatherIntoBatch(nextInput, fBatchEntries.size()))
+            {
+                KTERROR(fftwlog, "Component <" << iComponent << "> could not be added to the batch; the slice will not be transformed");
+                // the slice's components that are already in the batch are dropped, along with the slice
+                while (! fBatchEntries.empty() && fBatchEntries.back().fSlice == slice) fBatchEntries.pop_back();
+                fPendingSlices.pop_back();
+                return;
+            }
+
+            BatchEntry entry;
+            entry.fSlice = slice;
+            entry.fComponent = iComponent;
+            entry.fTimeBinWidth = tsData.GetTimeSeries(iComponent)->GetTimeBinWidth();
+            fBatchEntries.push_back(entry);
+
+            if (fBatchEntries.size() == fBatchSize)
+            {
+                ExecuteQueuedBatch();
+            }
+        }
+
+        return;
+    }
+
+    void KTForwardFFTW::FlushBatch()
+    {
+        if (fBatchEntries.empty()) return;
+
+        KTDEBUG(fftwlog, "Flushing a partial batch of " << fBatchEntries.size() << " time series");
+        // the full plan is used; the unused positions in the batch are ignored
+        ExecuteQueuedBatch();
+        return;
+    }
+
+    void KTForwardFFTW::ExecuteQueuedBatch()
+    {
+        ExecuteBatchPlan();
+
+        for (unsigned iPos = 0; iPos < fBatchEntries.size(); ++iPos)
+        {
+            const BatchEntry& entry = fBatchEntries[iPos];
+            KTFrequencySpectrumFFTW* nextResult = ScatterFromBatch(iPos, entry.fTimeBinWidth);
+            entry.fSlice->fData->Of< KTFrequencySpectrumDataFFTW >().SetSpectrum(nextResult, entry.fComponent);
+            ++(entry.fSlice->fNTransformed);
+        }
+        KTDEBUG(fftwlog, "Batched FFT computed; " << fBatchEntries.size() << " time series transformed");
+        fBatchEntries.clear();
+
+        // slices are completed in the order they were queued
+        while (! fPendingSlices.empty() && fPendingSlices.front().fNTransformed == fPendingSlices.front().fNComponents)
+        {
+            Nymph::KTDataPtr completed = fPendingSlices.front().fData;
+            fPendingSlices.pop_front();
+            KTINFO(fftwlog, "FFT complete; " << fPendingSlices.size() << " slice(s) still waiting for the next batch");
+            fFFTSignal(completed);
+        }
+        return;
+    }
+
+    unsigned KTForwardFFTW::TransformComponentsInBatches(KTTimeSeriesData& tsData, KTFrequencySpectrumDataFFTW& fsData)
+    {
+        // the batch arrays are in use if slices are waiting in the "ts-batch" queue
+        if (fBatchPlan == NULL || ! fBatchEntries.empty()) return 0;
+
+        unsigned nComponents = tsData.GetNComponents();
+        unsigned nBatched = 0;
+        while (nBatched + fBatchSize <= nComponents)
+        {
+            for (unsigned iPos = 0; iPos < fBatchSize; ++iPos)
+            {
+                // if a time series has the wrong type, it's left for the one-at-a-time loop to report
+                if (! GatherIntoBatch(tsData.GetTimeSeries(nBatched + iPos), iPos)) return nBatched;
+            }
+
+            ExecuteBatchPlan();
+
+            for (unsigned iPos = 0; iPos < fBatchSize; ++iPos)
+            {
+                fsData.SetSpectrum(ScatterFromBatch(iPos, tsData.GetTimeSeries(nBatched + iPos)->GetTimeBinWidth()), nBatched + iPos);
+            }
+            nBatched += fBatchSize;
+            KTDEBUG(fftwlog, "Batched FFT computed; components " << nBatched - fBatchSize << " - " << nBatched - 1);
+        }
+        return nBatched;
+    }
+
+    bool KTForwardFFTW::GatherIntoBatch(const KTTimeSeries* ts, unsigned batchPos)
+    {
+        if (fState == kR2C)
+        {
+            const KTTimeSeriesReal* realTS = dynamic_cast< const KTTimeSeriesReal* >(ts);
+            if (realTS == NULL)
+            {
+                KTERROR(fftwlog, "Incorrect time series type: time series did not cast to KTTimeSeriesReal.");
+                return false;
+            }
+            if (realTS->size() != fTimeSize)
+            {
+                KTERROR(fftwlog, "Time series has " << realTS->size() << " bins; the batch was set up for " << fTimeSize);
+                return false;
+            }
+            std::copy(realTS->begin(), realTS->end(), fBatchRInputArray + batchPos * fTimeSize);
+        }
+        else
+        {
+            const KTTimeSeriesFFTW* complexTS = dynamic_cast< const KTTimeSeriesFFTW* >(ts);
+            if (complexTS == NULL)
+            {
+                KTERROR(fftwlog, "Incorrect time series type: time series did not cast to KTTimeSeriesFFTW.");
+                return false;
+            }
+            if (complexTS->size() != fTimeSize)
+            {
+                KTERROR(fftwlog, "Time series has " << complexTS->size() << " bins; the batch was set up for " << fTimeSize);
+                return false;
+            }
+            const double* tsArray = reinterpret_cast< const double* >(complexTS->GetData().data());
+            std::copy(tsArray, tsArray + 2 * fTimeSize, reinterpret_cast< double* >(fBatchCInputArray + batchPos * fTimeSize));
+        }
+        return true;
+    }
+
+    KTFrequencySpectrumFFTW* KTForwardFFTW::ScatterFromBatch(unsigned batchPos, double timeBinWidth) const
+    {
+        UpdateBinningCache(timeBinWidth);
+
+        KTFrequencySpectrumFFTW* newFS = new KTFrequencySpectrumFFTW(fFrequencySize, fFreqMinCache, fFreqMaxCache, fState != kR2C);
+
+        // the normalization is applied while copying out of the batch
+        double norm = fState == kR2C ? sqrt(2. / (double)fTimeSize) : sqrt(1. / (double)fTimeSize);
+        const double* batchOut = reinterpret_cast< const double* >(fBatchOutputArray + batchPos * fFrequencySize);
+        double* fsOut = reinterpret_cast< double* >(newFS->GetData().data());
+        for (unsigned iValue = 0; iValue < 2 * fFrequencySize; ++iValue)
+        {
+            fsOut[iValue] = batchOut[iValue] * norm;
+        }
+
+        newFS->SetNTimeBins(fTimeSize);
+        return newFS;
+    }
+
+    bool KTForwardFFTW::InitializeBatch(KTForwardFFTW::State intendedState, unsigned transformFlag)
+    {
+        FreeBatch();
+        if (fBatchSize <= 1) return true;
+
+        if (intendedState != kR2C && intendedState != kC2C)
+        {
+            KTWARN(fftwlog, "Batched transforms are only available in the R2C and C2C states; batching will not be used");
+            return true;
+        }
+
+        KTDEBUG(fftwlog, "Allocating batch arrays for " << fBatchSize << " time series");
+        fBatchOutputArray = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * fFrequencySize * fBatchSize);
+        if (intendedState == kR2C)
+        {
+            fBatchRInputArray = (double*) fftw_malloc(sizeof(double) * fTimeSize * fBatchSize);
+        }
+        else // intendedState == kC2C
+        {
+            fBatchCInputArray = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * fTimeSize * fBatchSize);
+        }
+
+        // the batch plan is made for fBatchSize contiguous time series (see KTFFTWPlanCache)
+        KTDEBUG(fftwlog, "Getting batched plan: " << fBatchSize << " x " << fTimeSize << " time bins; forward FFT");
+        KTFFTWPlanCache::PlanKey key(intendedState == kR2C ? KTFFTWPlanCache::kR2C : KTFFTWPlanCache::kC2C, fTimeSize, transformFlag, FFTW_FORWARD);
+        key.fHowMany = fBatchSize;
+        key.fNThreads = fNThreads;
+        fBatchPlan = KTFFTWPlanCache::get_instance()->GetPlan(key);
+
+        if (fBatchPlan == NULL)
+        {
+            FreeBatch();
+            return false;
+        }
+        return true;
+    }
+
+    void KTForwardFFTW::ExecuteBatchPlan()
+    {
+        if (fState == kR2C)
+        {
+            fftw_execute_dft_r2c(fBatchPlan, fBatchRInputArray, fBatchOutputArray);
+        }
+        else
+        {
+            fftw_execute_dft(fBatchPlan, fBatchCInputArray, fBatchOutputArray);
+        }
+        return;
+    }
+
+    void KTForwardFFTW::FreeBatch()
+    {
+        // the plan belongs to the plan cache
+        fBatchPlan = NULL;
+        if (fBatchRInputArray != NULL)
+        {
+            fftw_free(fBatchRInputArray);
+            fBatchRInputArray = NULL;
+        }
+        if (fBatchCInputArray != NULL)
+        {
+            fftw_free(fBatchCInputArray);
+            fBatchCInputArray = NULL;
+        }
+        if (fBatchOutputArray != NULL)
+        {
+            fftw_free(fBatchOutputArray);
+            fBatchOutputArray = NULL;
+        }
+        return;
+    }
+
+    void KTForwardFFTW::SetBatchSize(unsigned nTS)
+    {
+        if (nTS == 0) nTS = 1;
+        if (nTS == fBatchSize) return;
+
+        // anything already in the batch was gathered for the old plan
+        FlushBatch();
+        FreeBatch();
+
+        fBatchSize = nTS;
+        fIsInitialized = false;
+        return;
+    }
+
     void KTForwardFFTW::SetTimeSize(unsigned nBins)
     {
         SetTimeSizeForState(nBins, fState);
@@ -561,6 +896,10 @@ namespace Katydid
 
     void KTForwardFFTW::SetTimeSizeForState(unsigned nBins, KTForwardFFTW::State intendedState)
     {
+        // time series waiting in the batch have to be transformed with the current plan
+        FlushBatch();
+        FreeBatch();
+
         fTimeSize = nBins;
         if (intendedState == kR2C)
         {
@@ -591,8 +930,10 @@ namespace Katydid
             return;
         }
 
-        // delete the plan
-        if (fForwardPlan != NULL) fftw_destroy_plan(fForwardPlan);
+        // release the plans; they'll be replaced when the FFT is initialized
+        FlushBatch();
+        FreeBatch();
+        fForwardPlan = NULL;
 
         fTransformFlag = flag;
         fIsInitialized = false;
@@ -17,6 +17,7 @@
 
 #include <fftw3.h>
 
+#include <list>
 #include <map>
 #include <string>
 #include <vector>
@@ -27,7 +28,10 @@ namespace Katydid
     
     class KTAnalyticAssociateData;
     class KTEggHeader;
+    class KTFrequencySpectrumDataFFTW;
     class KTFrequencySpectrumFFTW;
+    class KTTimeSeries;
+    class KTTimeSeriesData;
     class KTTimeSeriesFFTW;
     class KTTimeSeriesReal;
 
@@ -65,8 +69,10 @@ namespace Katydid
      - "transform_flag": string -- flag that determines how much planning is done prior to any transforms (see below)
      - "use-wisdom": bool -- whether or not to use FFTW wisdom to improve FFT performance
      - "wisdom-filename": string -- filename for loading/saving FFTW wisdom
+     - "n-threads": unsigned -- number of threads FFTW may use for each transform; only has an effect if Katydid was built with threaded FFTW (the default is set by the FFTW_NTHREADS CMake variable)
      - "transform-state": string -- "r2c", "c2c", or "rasc2c"; specify the transform state, regardless of the time domain type listed in the egg header; this is useful when a new time domain data type (e.g. aa) has been added to the data object and is being transformed.
      - "transform-complex-as-iq": bool -- specify whether to treat complex data as IQ: the negative frequency bins are assumed to be a continuous extension of the positive frequency bins, and the whole spectrum is shifted so that it starts at DC; this is only used if the transform state has also been specified.
+     - "batch-size": unsigned -- number of time series (K) to transform together with a single fftw_plan_many_dft execution; 1 (the default) disables batching. See "Batched transforms" below.
 
      Transform flags control how FFTW performs the FFT.
      Currently only the following "rigor" flags are available:
@@ -78,12 +84,24 @@ namespace Katydid
 
      FFTW_PRESERVE_INPUT is automatically added to the transform flag when necessary so that the input data is not destroyed.
 
+     Plans are shared with any other FFT using the same parameters, and wisdom files are read once and written at exit (see KTFFTWPlanCache).
+
+     Batched transforms (R2C and C2C only):
+     If the batch size K is greater than 1, a second plan is made that transforms K time series at once.
+     The time series are copied into one contiguous input array, and the results are copied out into separate frequency spectra.
+     - Slices with K or more components (channels) are transformed K components at a time through the usual slots.
+     - The "ts-batch" slot collects time series from consecutive slices; once K have been collected they're transformed together,
+       and signal "fft" is emitted for each of the completed slices, in the order they were received.
+       Use the "flush-batch" slot at the end of the run to transform any time series left in a partial batch.
+
      Slots:
      - "header": void (Nymph::KTDataPtr) -- Initialize the FFT from an Egg header; Requires KTEggHeader
      - "ts-real": void (Nymph::KTDataPtr) -- Perform a forward FFT on a real time series; Requires KTTimeSeriesData; Adds KTFrequencySpectrumFFTW; Emits signal "fft"
      - "ts-fftw": void (Nymph::KTDataPtr) -- Perform a forward FFT on a complex time series; Requires KTTimeSeriesData; Adds KTFrequencySpectrumFFTW; Emits signal "fft"
      - "aa": void (Nymph::KTDataPtr) -- Perform a forward FFT on an analytic associate data; Requires KTAnalyticAssociateData; Adds KTFrequencySpectrumFFTW; Emits signal "fft"
      - "ts-real-as-complex": void (Nymph::KTDataPtr) -- Perform a forward FFT on a real time series; Requires KTTimeSeriesData; Adds KTFrequencySpectrumFFTW; Emits signal "fft"
+     - "ts-batch": void (Nymph::KTDataPtr) -- Add a slice's time series to the current batch, and transform the batch if it's full; Requires KTTimeSeriesData; Adds KTFrequencySpectrumFFTW; Emits signal "fft" for each completed slice
+     - "flush-batch": void () -- Transform the time series in a partially filled batch; Emits signal "fft" for each completed slice
 
      Signals:
      - "fft": void (Nymph::KTDataPtr) -- Emitted upon performance of a forward transform; Guarantees KTFrequencySpectrumDataFFTW.
@@ -119,9 +137,13 @@ namespace Katydid
 
             MEMBERVARIABLEREF_NOSET(std::string, TransformFlag);
 
+            MEMBERVARIABLE_NOSET(unsigned, BatchSize);
+
         public:
             /// Set the number of time bins; FFT must be initialized after calling this.
             void SetTimeSize(unsigned nBins);
+            /// Set the number of time series transformed together; FFT must be initialized after calling this.
+            void SetBatchSize(unsigned nTS);
             /// Change the transform flag; FFT must be initialized after calling this.
             void SetTransformFlag(const std::string& flag);
 
@@ -180,6 +202,18 @@ namespace Katydid
             /// Forward FFT - Complex Time Series - Output must exist - No size or bin width checks
             void DoTransform(const KTTimeSeriesFFTW* tsIn, KTFrequencySpectrumFFTW* fsOut) const;
 
+            /// Returns the aligned input array for the current state, so that a preceding stage can write into it directly (see KTDACWindowFFTW)
+            /// R2C: TimeSize doubles; C2C and RasC2C: TimeSize fftw_complex values (i.e. 2 * TimeSize interleaved doubles)
+            /// Returns NULL if the FFT is not initialized; the pointer is invalidated when the FFT is re-initialized.
+            double* GetInputArray();
+            /// Forward FFT - Contents of the input array - No size checks
+            KTFrequencySpectrumFFTW* TransformInputArray(double timeBinWidth) const;
+
+            /// Batched forward FFT - Adds the slice's time series to the batch; transforms the batch when it's full, and emits the completed slices
+            void QueueSliceForBatch(Nymph::KTDataPtr data);
+            /// Batched forward FFT - Transforms a partially filled batch, and emits the completed slices
+            void FlushBatch();
+
         private:
             // binning cache
             void UpdateBinningCache(double timeBinWidth) const;
@@ -199,6 +233,45 @@ namespace Katydid
             fftw_complex* fCInputArray;
             fftw_complex* fOutputArray;
 
+            //***************
+            // Batched transforms
+            //***************
+
+            struct PendingSlice
+            {
+                Nymph::KTDataPtr fData;
+                unsigned fNComponents;
+                unsigned fNTransformed;
+            };
+
+            struct BatchEntry
+            {
+                PendingSlice* fSlice;
+                unsigned fComponent;
+                double fTimeBinWidth;
+            };
+
+            bool InitializeBatch(KTForwardFFTW::State intendedState, unsigned transformFlag);
+            void FreeBatch();
+            /// Transforms the components of a slice K at a time; returns the number of components that were transformed
+            unsigned TransformComponentsInBatches(KTTimeSeriesData& tsData, KTFrequencySpectrumDataFFTW& fsData);
+            /// Copies a time series into its place in the batch input array
+            bool GatherIntoBatch(const KTTimeSeries* ts, unsigned batchPos);
+            /// Creates a new spectrum from the batch output array
+            KTFrequencySpectrumFFTW* ScatterFromBatch(unsigned batchPos, double timeBinWidth) const;
+            /// Transforms the queued time series and emits the slices that are complete
+            void ExecuteQueuedBatch();
+            void ExecuteBatchPlan();
+
+            fftw_plan fBatchPlan;
+
+            double*       fBatchRInputArray;
+            fftw_complex* fBatchCInputArray;
+            fftw_complex* fBatchOutputArray;
+
+            std::list< PendingSlice > fPendingSlices;
+            std::vector< BatchEntry > fBatchEntries;
+
             //***************
             // Signals
             //***************
@@ -216,6 +289,8 @@ namespace Katydid
             Nymph::KTSlotDataOneType< KTTimeSeriesData > fTSComplexSlot;
             Nymph::KTSlotDataOneType< KTAnalyticAssociateData > fAASlot;
             Nymph::KTSlotDataOneType< KTTimeSeriesData > fTSRealAsComplexSlot;
+            Nymph::KTSlotOneArg< void (Nymph::KTDataPtr) > fTSBatchSlot;
+            Nymph::KTSlotNoArg< void () > fFlushBatchSlot;
 
     };
 
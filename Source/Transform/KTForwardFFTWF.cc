@@ -0,0 +1,401 @@
+/*
+ * KTForwardFFTWF.cc
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "KTForwardFFTWF.hh"
+
+#include "KTEggHeader.hh"
+#include "KTFrequencySpectrumDataFFTWF.hh"
+#include "KTLogger.hh"
+#include "KTTimeSeriesData.hh"
+#include "KTTimeSeriesFFTW.hh"
+#include "KTTimeSeriesReal.hh"
+#include "KTTimeSeriesRealF.hh"
+
+#include <algorithm>
+#include <cmath>
+
+using std::string;
+
+
+namespace Katydid
+{
+    KTLOGGER(fftwlog, "KTForwardFFTWF");
+
+    KT_REGISTER_PROCESSOR(KTForwardFFTWF, "forward-fftwf");
+
+    KTForwardFFTWF::KTForwardFFTWF(const std::string& name) :
+            KTFFT(),
+            KTProcessor(name),
+            fComplexAsIQ(false),
+            fTimeSize(0),
+            fFrequencySize(0),
+            fTransformFlag("ESTIMATE"),
+            fTransformFlagMap(),
+            fState(kNone),
+            fIsInitialized(false),
+            fTimeBinWidthCache(-1.),
+            fFreqMinCache(0.),
+            fFreqMaxCache(0.),
+            fForwardPlan(NULL),
+            fRInputArray(NULL),
+            fCInputArray(NULL),
+            fOutputArray(NULL),
+            fFFTSignal("fft", this),
+            fHeaderSlot("header", this, &KTForwardFFTWF::InitializeWithHeader),
+            fTSRealSlot("ts-real", this, &KTForwardFFTWF::TransformRealData, &fFFTSignal),
+            fTSComplexSlot("ts-fftw", this, &KTForwardFFTWF::TransformComplexData, &fFFTSignal)
+    {
+        SetupInternalMaps();
+    }
+
+    KTForwardFFTWF::~KTForwardFFTWF()
+    {
+        DestroyPlan();
+        FreeArrays();
+    }
+
+    bool KTForwardFFTWF::Configure(const scarab::param_node* node)
+    {
+        if (node == NULL) return true;
+
+        SetTransformFlag(node->get_value("transform-flag", fTransformFlag));
+
+        SetComplexAsIQ(node->get_value("transform-complex-as-iq", fComplexAsIQ));
+
+        if (node->has("transform-state"))
+        {
+            string intendedState(node->get_value("transform-state"));
+            if (intendedState == "r2c") fState = kR2C;
+            else if (intendedState == "c2c") fState = kC2C;
+            else
+            {
+                KTERROR(fftwlog, "Invalid transform state requested: <" << intendedState << ">");
+                return false;
+            }
+        }
+        else if (node->has("transform-complex-as-iq"))
+        {
+            KTWARN(fftwlog, "Transform-complex-as-iq was requested, but the transform-state was not specified; the former setting will be ignored");
+        }
+
+        return true;
+    }
+
+    bool KTForwardFFTWF::InitializeForRealTDD(unsigned timeSize)
+    {
+        return InitializeFFT(kR2C, timeSize);
+    }
+
+    bool KTForwardFFTWF::InitializeForComplexTDD(unsigned timeSize)
+    {
+        return InitializeFFT(kC2C, timeSize);
+    }
+
+    bool KTForwardFFTWF::InitializeFFT(KTForwardFFTWF::State intendedState, unsigned timeSize)
+    {
+        if (intendedState == kNone)
+        {
+            KTERROR(fftwlog, "Cannot initialize FFT for state <" << intendedState << ">");
+            return false;
+        }
+
+        if (timeSize == 0) timeSize = fTimeSize;
+
+        SetTimeSizeForState(timeSize, intendedState);
+
+        // fTransformFlag is guaranteed to be valid in the Set method.
+        unsigned transformFlag = fTransformFlagMap.find(fTransformFlag)->second;
+
+        if (! AllocateArrays(intendedState))
+        {
+            KTERROR(fftwlog, "Unable to allocate arrays");
+            return false;
+        }
+
+        // the input array contents are replaced for each FFT, so FFTW_PRESERVE_INPUT isn't needed
+        if (intendedState == kR2C)
+        {
+            KTDEBUG(fftwlog, "Creating single-precision R2C plan: " << fTimeSize << " time bins; forward FFT");
+            fForwardPlan = fftwf_plan_dft_r2c_1d(fTimeSize, fRInputArray, fOutputArray, transformFlag);
+        }
+        else
+        {
+            KTDEBUG(fftwlog, "Creating single-precision C2C plan: " << fTimeSize << " time bins; forward FFT");
+            fForwardPlan = fftwf_plan_dft_1d(fTimeSize, fCInputArray, fOutputArray, FFTW_FORWARD, transformFlag);
+        }
+
+        if (fForwardPlan == NULL)
+        {
+            fIsInitialized = false;
+            KTERROR(fftwlog, "Unable to create the forward FFT plan! FFT is not initialized.");
+            return false;
+        }
+
+        fIsInitialized = true;
+        fState = intendedState;
+        KTDEBUG(fftwlog, "FFTW plan ready; Initialization complete.");
+        return true;
+    }
+
+    bool KTForwardFFTWF::InitializeWithHeader(KTEggHeader& header)
+    {
+        if (fState == kNone)
+        {
+            if (header.GetChannelHeader(0)->GetTSDataType() == KTChannelHeader::kReal)
+            {
+                return InitializeForRealTDD(header.GetChannelHeader(0)->GetSliceSize());
+            }
+            else // == KTChannelHeader::kComplex || KTChannelHeader::kIQ
+            {
+                fComplexAsIQ = header.GetChannelHeader(0)->GetTSDataType() == KTChannelHeader::kIQ;
+                return InitializeForComplexTDD(header.GetChannelHeader(0)->GetSliceSize());
+            }
+        }
+        return InitializeFFT(fState, header.GetChannelHeader(0)->GetSliceSize());
+    }
+
+    bool KTForwardFFTWF::TransformRealData(KTTimeSeriesData& tsData)
+    {
+        if (fState != kR2C)
+        {
+            KTERROR(fftwlog, "Cannot do transform of real data in state <" << fState << ">");
+            return false;
+        }
+
+        if (tsData.GetTimeSeries(0)->GetNTimeBins() != GetTimeSize() || ! fIsInitialized)
+        {
+            if (! InitializeForRealTDD(tsData.GetTimeSeries(0)->GetNTimeBins()))
+            {
+                KTERROR(fftwlog, "FFT could not be initialized for " << tsData.GetTimeSeries(0)->GetNTimeBins() << " time bins");
+                return false;
+            }
+        }
+
+        UpdateBinningCache(tsData.GetTimeSeries(0)->GetTimeBinWidth());
+
+        unsigned nComponents = tsData.GetNComponents();
+
+        KTFrequencySpectrumDataFFTWF& newData = tsData.Of< KTFrequencySpectrumDataFFTWF >().SetNComponents(nComponents);
+
+        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+        {
+            KTFrequencySpectrumFFTWF* nextResult = NULL;
+            const KTTimeSeries* nextInput = tsData.GetTimeSeries(iComponent);
+            const KTTimeSeriesRealF* nextInputF = dynamic_cast< const KTTimeSeriesRealF* >(nextInput);
+            if (nextInputF != NULL)
+            {
+                nextResult = FastTransform(nextInputF);
+            }
+            else
+            {
+                const KTTimeSeriesReal* nextInputD = dynamic_cast< const KTTimeSeriesReal* >(nextInput);
+                if (nextInputD == NULL)
+                {
+                    KTERROR(fftwlog, "Incorrect time series type: time series did not cast to KTTimeSeriesRealF or KTTimeSeriesReal.");
+                    return false;
+                }
+                nextResult = FastTransform(nextInputD);
+            }
+
+            KTDEBUG(fftwlog, "FFT computed; size: " << nextResult->size() << "; range: " << nextResult->GetRangeMin() << " -> " << nextResult->GetRangeMax());
+            newData.SetSpectrum(nextResult, iComponent);
+        }
+
+        KTINFO(fftwlog, "FFT complete; " << nComponents << " channel(s) transformed");
+
+        return true;
+    }
+
+    bool KTForwardFFTWF::TransformComplexData(KTTimeSeriesData& tsData)
+    {
+        if (fState != kC2C)
+        {
+            KTERROR(fftwlog, "Cannot do transform of complex data in state <" << fState << ">");
+            return false;
+        }
+
+        if (tsData.GetTimeSeries(0)->GetNTimeBins() != GetTimeSize() || ! fIsInitialized)
+        {
+            if (! InitializeForComplexTDD(tsData.GetTimeSeries(0)->GetNTimeBins()))
+            {
+                KTERROR(fftwlog, "FFT could not be initialized for " << tsData.GetTimeSeries(0)->GetNTimeBins() << " time bins");
+                return false;
+            }
+        }
+
+        UpdateBinningCache(tsData.GetTimeSeries(0)->GetTimeBinWidth());
+
+        unsigned nComponents = tsData.GetNComponents();
+
+        KTFrequencySpectrumDataFFTWF& newData = tsData.Of< KTFrequencySpectrumDataFFTWF >().SetNComponents(nComponents);
+
+        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+        {
+            const KTTimeSeriesFFTW* nextInput = dynamic_cast< const KTTimeSeriesFFTW* >(tsData.GetTimeSeries(iComponent));
+            if (nextInput == NULL)
+            {
+                KTERROR(fftwlog, "Incorrect time series type: time series did not cast to KTTimeSeriesFFTW.");
+                return false;
+            }
+
+            KTFrequencySpectrumFFTWF* nextResult = FastTransform(nextInput);
+            KTDEBUG(fftwlog, "FFT computed; size: " << nextResult->size() << "; range: " << nextResult->GetRangeMin() << " - " << nextResult->GetRangeMax());
+            newData.SetSpectrum(nextResult, iComponent);
+        }
+
+        KTINFO(fftwlog, "FFT complete; " << nComponents << " channel(s) transformed");
+
+        return true;
+    }
+
+    KTFrequencySpectrumFFTWF* KTForwardFFTWF::FastTransform(const KTTimeSeriesRealF* ts) const
+    {
+        std::copy(ts->begin(), ts->begin() + fTimeSize, fRInputArray);
+        return TransformInputArray();
+    }
+
+    KTFrequencySpectrumFFTWF* KTForwardFFTWF::FastTransform(const KTTimeSeriesReal* ts) const
+    {
+        // narrowing copy
+        std::copy(ts->begin(), ts->begin() + fTimeSize, fRInputArray);
+        return TransformInputArray();
+    }
+
+    KTFrequencySpectrumFFTWF* KTForwardFFTWF::FastTransform(const KTTimeSeriesFFTW* ts) const
+    {
+        // narrowing copy of the interleaved real and imaginary parts
+        const double* input = reinterpret_cast< const double* >(ts->GetData().data());
+        std::copy(input, input + 2 * fTimeSize, reinterpret_cast< float* >(fCInputArray));
+        return TransformInputArray();
+    }
+
+    KTFrequencySpectrumFFTWF* KTForwardFFTWF::TransformInputArray() const
+    {
+        fftwf_execute(fForwardPlan);
+
+        KTFrequencySpectrumFFTWF* newFS = new KTFrequencySpectrumFFTWF(fFrequencySize, fFreqMinCache, fFreqMaxCache, fState == kC2C);
+        float norm = fState == kR2C ? sqrt(2. / (double)fTimeSize) : sqrt(1. / (double)fTimeSize);
+        const float* output = reinterpret_cast< const float* >(fOutputArray);
+        float* spectrum = reinterpret_cast< float* >(newFS->GetData());
+        for (unsigned iValue = 0; iValue < 2 * fFrequencySize; ++iValue)
+        {
+            spectrum[iValue] = output[iValue] * norm;
+        }
+        newFS->SetNTimeBins(fTimeSize);
+        return newFS;
+    }
+
+    void KTForwardFFTWF::SetTimeSize(unsigned nBins)
+    {
+        SetTimeSizeForState(nBins, fState);
+        return;
+    }
+
+    void KTForwardFFTWF::SetTimeSizeForState(unsigned nBins, KTForwardFFTWF::State intendedState)
+    {
+        fTimeSize = nBins;
+        if (intendedState == kR2C)
+        {
+            fFrequencySize = nBins / 2 + 1;
+        }
+        else if (intendedState == kC2C)
+        {
+            fFrequencySize = nBins;
+        }
+        else
+        {
+            KTDEBUG(fftwlog, "Time size set while in state <" << fState << ">; frequency size not changed");
+        }
+        KTDEBUG(fftwlog, "Time size set to " << fTimeSize << "; frequency size set to " << fFrequencySize);
+
+        // the plan is tied to the arrays, so both are replaced
+        DestroyPlan();
+        FreeArrays();
+
+        fIsInitialized = false;
+        return;
+    }
+
+    void KTForwardFFTWF::SetTransformFlag(const std::string& flag)
+    {
+        if (fTransformFlagMap.find(flag) == fTransformFlagMap.end())
+        {
+            KTWARN(fftwlog, "Invalid transform flag requested: " << flag << "\n\tNo change was made.");
+            return;
+        }
+
+        DestroyPlan();
+
+        fTransformFlag = flag;
+        fIsInitialized = false;
+        return;
+    }
+
+    void KTForwardFFTWF::SetupInternalMaps()
+    {
+        // transform flag map
+        fTransformFlagMap.clear();
+        fTransformFlagMap["ESTIMATE"] = FFTW_ESTIMATE;
+        fTransformFlagMap["MEASURE"] = FFTW_MEASURE;
+        fTransformFlagMap["PATIENT"] = FFTW_PATIENT;
+        fTransformFlagMap["EXHAUSTIVE"] = FFTW_EXHAUSTIVE;
+        return;
+    }
+
+    bool KTForwardFFTWF::AllocateArrays(State intendedState)
+    {
+        FreeArrays();
+        if (intendedState == kR2C)
+        {
+            KTDEBUG(fftwlog, "Allocating real input array");
+            fRInputArray = (float*) fftwf_malloc(sizeof(float) * fTimeSize);
+        }
+        else
+        {
+            KTDEBUG(fftwlog, "Allocating complex input array");
+            fCInputArray = (fftwf_complex*) fftwf_malloc(sizeof(fftwf_complex) * fTimeSize);
+        }
+        KTDEBUG(fftwlog, "Allocating output array");
+        fOutputArray = (fftwf_complex*) fftwf_malloc(sizeof(fftwf_complex) * fFrequencySize);
+
+        return (fRInputArray != NULL || fCInputArray != NULL) && fOutputArray != NULL;
+    }
+
+    void KTForwardFFTWF::FreeArrays()
+    {
+        if (fRInputArray != NULL)
+        {
+            KTDEBUG(fftwlog, "Freeing real input array");
+            fftwf_free(fRInputArray);
+            fRInputArray = NULL;
+        }
+        if (fCInputArray != NULL)
+        {
+            KTDEBUG(fftwlog, "Freeing complex input array");
+            fftwf_free(fCInputArray);
+            fCInputArray = NULL;
+        }
+        if (fOutputArray != NULL)
+        {
+            KTDEBUG(fftwlog, "Freeing output array");
+            fftwf_free(fOutputArray);
+            fOutputArray = NULL;
+        }
+        return;
+    }
+
+    void KTForwardFFTWF::DestroyPlan()
+    {
+        if (fForwardPlan != NULL)
+        {
+            fftwf_destroy_plan(fForwardPlan);
+            fForwardPlan = NULL;
+        }
+        return;
+    }
+
+} /* namespace Katydid */
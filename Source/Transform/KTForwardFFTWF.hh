@@ -0,0 +1,213 @@
+/**
+ @file KTForwardFFTWF.hh
+ @brief Contains KTForwardFFTWF
+ @details Calculates a 1-dimensional single-precision FFT on a set of real or complex data.
+ @author: agent
+ @date: Oct 17, 2026
+ */
+
+#ifndef KTFORWARDFFTWF_HH_
+#define KTFORWARDFFTWF_HH_
+
+#include "KTFFT.hh"
+#include "KTProcessor.hh"
+
+#include "KTMemberVariable.hh"
+#include "KTSlot.hh"
+
+#include <fftw3.h>
+
+#include <map>
+#include <string>
+
+
+namespace Katydid
+{
+
+    class KTEggHeader;
+    class KTFrequencySpectrumFFTWF;
+    class KTTimeSeriesData;
+    class KTTimeSeriesFFTW;
+    class KTTimeSeriesReal;
+    class KTTimeSeriesRealF;
+
+    /*!
+     @class KTForwardFFTWF
+     @author agent
+
+     @brief A single-precision forward FFT class.
+
+     @details
+     KTForwardFFTWF is the float counterpart of KTForwardFFTW, using the fftwf_ API.
+     It performs real-to-complex and complex-to-complex FFTs, and produces KTFrequencySpectrumDataFFTWF,
+     which uses half the memory bandwidth of the double-precision spectrum.
+     Downstream, use the "fs-fftwf-to-ps" and "fs-fftwf-to-psd" slots of KTConvertToPower, and the "ps-f" slot of KTSpectrumDiscriminator.
+
+     The input time series can be single precision (KTTimeSeriesRealF) or double precision (KTTimeSeriesReal and KTTimeSeriesFFTW);
+     double-precision data are narrowed to float as they're copied into the FFT input array.
+
+     Real-as-complex transforms, batching, threads and wisdom are not available; use KTForwardFFTW for those.
+
+     Configuration name: "forward-fftwf"
+
+     Available configuration values:
+     - "transform-flag": string -- flag that determines how much planning is done prior to any transforms (see KTForwardFFTW)
+     - "transform-state": string -- "r2c" or "c2c"; specify the transform state, regardless of the time domain type listed in the egg header
+     - "transform-complex-as-iq": bool -- specify whether to treat complex data as IQ (see KTForwardFFTW); this is only used if the transform state has also been specified.
+
+     Slots:
+     - "header": void (Nymph::KTDataPtr) -- Initialize the FFT from an Egg header; Requires KTEggHeader
+     - "ts-real": void (Nymph::KTDataPtr) -- Perform a forward FFT on a real time series (KTTimeSeriesRealF or KTTimeSeriesReal); Requires KTTimeSeriesData; Adds KTFrequencySpectrumDataFFTWF; Emits signal "fft"
+     - "ts-fftw": void (Nymph::KTDataPtr) -- Perform a forward FFT on a complex time series (KTTimeSeriesFFTW); Requires KTTimeSeriesData; Adds KTFrequencySpectrumDataFFTWF; Emits signal "fft"
+
+     Signals:
+     - "fft": void (Nymph::KTDataPtr) -- Emitted upon performance of a forward transform; Guarantees KTFrequencySpectrumDataFFTWF.
+    */
+
+    class KTForwardFFTWF : public KTFFT, public Nymph::KTProcessor
+    {
+        private:
+            typedef std::map< std::string, unsigned > TransformFlagMap;
+
+        public:
+            enum State
+            {
+                kNone,
+                kR2C,
+                kC2C
+            };
+
+        public:
+            KTForwardFFTWF(const std::string& name = "forward-fftwf");
+            virtual ~KTForwardFFTWF();
+
+            bool Configure(const scarab::param_node* node);
+
+            MEMBERVARIABLE(bool, ComplexAsIQ);
+
+            MEMBERVARIABLE_NOSET(unsigned, TimeSize);
+            MEMBERVARIABLE_NOSET(unsigned, FrequencySize);
+
+            MEMBERVARIABLEREF_NOSET(std::string, TransformFlag);
+
+        public:
+            /// Set the number of time bins; FFT must be initialized after calling this.
+            void SetTimeSize(unsigned nBins);
+            /// Change the transform flag; FFT must be initialized after calling this.
+            void SetTransformFlag(const std::string& flag);
+
+        private:
+            /// note: does not change the state
+            void SetTimeSizeForState(unsigned nBins, KTForwardFFTWF::State intendedState);
+
+            TransformFlagMap fTransformFlagMap;
+
+        public:
+            /// Initialize the FFT for real time domain data; optionally specify a new time size (the default value of 0 will leave it unchanged)
+            bool InitializeForRealTDD(unsigned timeSize = 0);
+            /// Initialize the FFT for complex time domain data; optionally specify a new time size (the default value of 0 will leave it unchanged)
+            bool InitializeForComplexTDD(unsigned timeSize = 0);
+            /// Initialize the FFT using a KTEggHeader object.
+            bool InitializeWithHeader(KTEggHeader& header);
+
+            virtual double GetMinFrequency(double timeBinWidth) const;
+            virtual double GetMaxFrequency(double timeBinWidth) const;
+
+            MEMBERVARIABLE_NOSET(KTForwardFFTWF::State, State);
+            MEMBERVARIABLE_NOSET(bool, IsInitialized);
+
+        private:
+            bool InitializeFFT(KTForwardFFTWF::State intendedState, unsigned timeSize = 0);
+
+        public:
+            /// Forward FFT - Real Time Data (single or double precision)
+            bool TransformRealData(KTTimeSeriesData& tsData);
+            /// Forward FFT - Real Time Series - No size or bin width checks
+            KTFrequencySpectrumFFTWF* FastTransform(const KTTimeSeriesRealF* ts) const;
+            /// Forward FFT - Real Time Series (narrowed to float) - No size or bin width checks
+            KTFrequencySpectrumFFTWF* FastTransform(const KTTimeSeriesReal* ts) const;
+
+            /// Forward FFT - Complex Time Data
+            bool TransformComplexData(KTTimeSeriesData& tsData);
+            /// Forward FFT - Complex Time Series (narrowed to float) - No size or bin width checks
+            KTFrequencySpectrumFFTWF* FastTransform(const KTTimeSeriesFFTW* ts) const;
+
+        private:
+            /// Transforms the contents of the input array into a new spectrum; the normalization is applied as the output is copied
+            KTFrequencySpectrumFFTWF* TransformInputArray() const;
+
+            // binning cache
+            void UpdateBinningCache(double timeBinWidth) const;
+            mutable double fTimeBinWidthCache;
+            mutable double fFreqMinCache;
+            mutable double fFreqMaxCache;
+
+            /// Allocate memory in the i/o arrays for an intended state
+            bool AllocateArrays(State intendedState);
+            void FreeArrays();
+            void DestroyPlan();
+            void SetupInternalMaps(); // do not make this virtual (called from the constructor)
+
+            fftwf_plan fForwardPlan;
+
+            float* fRInputArray;
+            fftwf_complex* fCInputArray;
+            fftwf_complex* fOutputArray;
+
+            //***************
+            // Signals
+            //***************
+
+        private:
+            Nymph::KTSignalData fFFTSignal;
+
+            //***************
+            // Slots
+            //***************
+
+        private:
+            Nymph::KTSlotDataOneType< KTEggHeader > fHeaderSlot;
+            Nymph::KTSlotDataOneType< KTTimeSeriesData > fTSRealSlot;
+            Nymph::KTSlotDataOneType< KTTimeSeriesData > fTSComplexSlot;
+
+    };
+
+
+    inline double KTForwardFFTWF::GetMinFrequency(double timeBinWidth) const
+    {
+        if (fState == kR2C || (fState == kC2C && fComplexAsIQ))
+        {
+            // DC bin is centered at 0, with half a bin width on either side
+            return -0.5 * GetFrequencyBinWidth(timeBinWidth);
+        }
+        else // frequencies symmetric about DC
+        {
+            return -GetFrequencyBinWidth(timeBinWidth) * (double(fFrequencySize/2) + 0.5);
+        }
+    }
+
+    inline double KTForwardFFTWF::GetMaxFrequency(double timeBinWidth) const
+    {
+        if (fState == kR2C || (fState == kC2C && fComplexAsIQ))
+        {
+            return GetFrequencyBinWidth(timeBinWidth) * ((double)fFrequencySize - 0.5);
+        }
+        else // frequencies symmetric about DC
+        {
+            unsigned nBinsToSide = fFrequencySize / 2;
+            return GetFrequencyBinWidth(timeBinWidth) * (double(nBinsToSide*2 == fFrequencySize ? nBinsToSide - 1 : nBinsToSide) + 0.5);
+        }
+    }
+
+    inline void KTForwardFFTWF::UpdateBinningCache(double timeBinWidth) const
+    {
+        if (timeBinWidth == fTimeBinWidthCache) return;
+        fTimeBinWidthCache = timeBinWidth;
+        fFreqMinCache = GetMinFrequency(timeBinWidth);
+        fFreqMaxCache = GetMaxFrequency(timeBinWidth);
+        return;
+    }
+
+} /* namespace Katydid */
+
+#endif /* KTFORWARDFFTWF_HH_ */
@@ -54,6 +54,9 @@ namespace Katydid
         SetSlope(node->get_value< double >("slope", fSlope));
         SetTransformFlag(node->get_value("transform-flag", fTransformFlag));
 
+        fForwardFFT.SetNThreads(node->get_value< unsigned >("n-threads", fForwardFFT.GetNThreads()));
+        fReverseFFT.SetNThreads(fForwardFFT.GetNThreads());
+
         return true;
     }
 
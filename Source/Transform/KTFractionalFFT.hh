@@ -53,6 +53,7 @@ namespace Katydid
      - "alpha": double -- rotation angle for fractional FFT, in radians
      - "slope": double -- track slope for chirp transform, in Hz/s
      - "transform-flag": string -- flag that determines how much planning is done prior to any transforms (see KTForwardFFTW.hh)
+     - "n-threads": unsigned -- number of threads used by the forward and reverse FFTs (see KTForwardFFTW.hh)
 
      Slots:
      - "track": void (Nymph::KTDataPtr) -- Sets the value of slope and alpha from a track; Requires KTProcessedTrackData; Adds nothing
@@ -10,6 +10,7 @@
 #include "KTAnalyticAssociateData.hh"
 #include "KTCacheDirectory.hh"
 #include "KTEggHeader.hh"
+#include "KTFFTWPlanCache.hh"
 #include "KTFrequencySpectrumDataFFTW.hh"
 #include "KTLogger.hh"
 #include "KTTimeSeriesData.hh"
@@ -55,8 +56,8 @@ namespace Katydid
 
     KTReverseFFTW::~KTReverseFFTW()
     {
+        // the plan belongs to the plan cache
         FreeArrays();
-        if (fReversePlan != NULL) fftw_destroy_plan(fReversePlan);
     }
 
     bool KTReverseFFTW::Configure(const scarab::param_node* node)
@@ -69,6 +70,8 @@ namespace Katydid
             SetUseWisdom(node->get_value<bool>("use-wisdom", fUseWisdom));
             SetWisdomFilename(node->get_value("wisdom-filename", fWisdomFilename));
 
+            SetNThreads(node->get_value< unsigned >("n-threads", fNThreads));
+
             if (node->has("transform-to"))
             {
                 string request(node->get_value("transform-to"));
@@ -149,22 +152,20 @@ namespace Katydid
             return false;
         }
 
+        // the wisdom file is only read the first time it's used, and is written when the program exits
+        KTFFTWPlanCache* planCache = KTFFTWPlanCache::get_instance();
         if (fUseWisdom)
         {
-            KTDEBUG(fftwlog, "Reading wisdom from file <" << fWisdomFilename << ">");
-            if (fftw_import_wisdom_from_filename(fWisdomFilename.c_str()) == 0)
-            {
-                KTWARN(fftwlog, "Unable to read FFTW wisdom from file <" << fWisdomFilename << ">");
-            }
+            planCache->UseWisdomFile(fWisdomFilename);
         }
 
-        InitializeMultithreaded();
-
         if (intendedState == kC2R)
         {
-            KTDEBUG(fftwlog, "Creating C2R plan: " << fTimeSize << " time bins; reverse FFT");
+            KTDEBUG(fftwlog, "Getting C2R plan: " << fTimeSize << " time bins; reverse FFT");
             // Add FFTW_PRESERVE_INPUT so that the input array content is not destroyed during the FFT
-            fReversePlan = fftw_plan_dft_c2r_1d(fTimeSize, fInputArray, fROutputArray, transformFlag | FFTW_PRESERVE_INPUT);
+            KTFFTWPlanCache::PlanKey key(KTFFTWPlanCache::kC2R, fTimeSize, transformFlag | FFTW_PRESERVE_INPUT);
+            key.fNThreads = fNThreads;
+            fReversePlan = planCache->GetPlan(key);
             // deleting arrays to save space
             // output array (fROutputArray) is required; input array is not needed
             fftw_free(fInputArray);
@@ -172,9 +173,11 @@ namespace Katydid
         }
         else // intendedState == kC2C || kRasC2C
         {
-            KTDEBUG(fftwlog, "Creating C2C plan: " << fTimeSize << " time bins; forward FFT");
+            KTDEBUG(fftwlog, "Getting C2C plan: " << fTimeSize << " time bins; reverse FFT");
             // Add FFTW_PRESERVE_INPUT so that the input array content is not destroyed during the FFT
-            fReversePlan = fftw_plan_dft_1d(fTimeSize, fInputArray, fCOutputArray, FFTW_BACKWARD, transformFlag | FFTW_PRESERVE_INPUT);
+            KTFFTWPlanCache::PlanKey key(KTFFTWPlanCache::kC2C, fTimeSize, transformFlag | FFTW_PRESERVE_INPUT, FFTW_BACKWARD);
+            key.fNThreads = fNThreads;
+            fReversePlan = planCache->GetPlan(key);
             // deleting arrays to save space; neither input nor output are needed
             FreeArrays();
         }
@@ -182,14 +185,7 @@ namespace Katydid
         if (fReversePlan != NULL)
         {
             fIsInitialized = true;
-            if (fUseWisdom)
-            {
-                if (fftw_export_wisdom_to_filename(fWisdomFilename.c_str()) == 0)
-                {
-                    KTWARN(fftwlog, "Unable to write FFTW wisdom to file <" << fWisdomFilename << ">");
-                }
-            }
-            KTDEBUG(fftwlog, "FFTW plan created; Initialization complete.");
+            KTDEBUG(fftwlog, "FFTW plan ready; Initialization complete.");
         }
         else
         {
@@ -444,8 +440,8 @@ namespace Katydid
             return;
         }
 
-        // delete the plan
-        if (fReversePlan != NULL) fftw_destroy_plan(fReversePlan);
+        // release the plan; it'll be replaced when the FFT is initialized
+        fReversePlan = NULL;
 
         fTransformFlag = flag;
         fIsInitialized = false;
@@ -49,6 +49,7 @@ namespace Katydid
      - "transform_flag": string -- flag that determines how much planning is done prior to any transforms (see below)
      - "use-wisdom": bool -- whether or not to use FFTW wisdom to improve FFT performance
      - "wisdom-filename": string -- filename for loading/saving FFTW wisdom
+     - "n-threads": unsigned -- number of threads FFTW may use for each transform; only has an effect if Katydid was built with threaded FFTW (the default is set by the FFTW_NTHREADS CMake variable)
 
      Transform flags control how FFTW performs the FFT.
      Currently only the following "rigor" flags are available:
@@ -60,6 +61,8 @@ namespace Katydid
 
      FFTW_PRESERVE_INPUT is automatically added to the transform flag when necessary so that the input data is not destroyed.
 
+     Plans are shared with any other FFT using the same parameters, and wisdom files are read once and written at exit (see KTFFTWPlanCache).
+
      Slots:
      - "header": void (Nymph::KTDataPtr) -- Initialize the FFT from an Egg header; Requires KTEggHeader
      - "fs-fftw-to-real": void (Nymph::KTDataPtr) -- Perform a reverse FFT on the frequency spectrum; Requires KTFrequencySpectrumDataFFTW; Adds KTTimeSeriesData; Emits signal "fft"
@@ -0,0 +1,240 @@
+/*
+ * KTReverseFFTWF.cc
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: agent
+ */
+
+#include "KTReverseFFTWF.hh"
+
+#include "KTEggHeader.hh"
+#include "KTFrequencySpectrumDataFFTWF.hh"
+#include "KTLogger.hh"
+#include "KTTimeSeriesData.hh"
+#include "KTTimeSeriesRealF.hh"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace Katydid
+{
+    KTLOGGER(fftwlog, "KTReverseFFTWF");
+
+    KT_REGISTER_PROCESSOR(KTReverseFFTWF, "reverse-fftwf");
+
+    KTReverseFFTWF::KTReverseFFTWF(const std::string& name) :
+            KTFFT(),
+            KTProcessor(name),
+            fTimeSize(0),
+            fFrequencySize(0),
+            fTransformFlag("ESTIMATE"),
+            fIsInitialized(false),
+            fFreqBinWidthCache(-1.),
+            fTimeMinCache(0.),
+            fTimeMaxCache(0.),
+            fTransformFlagMap(),
+            fReversePlan(NULL),
+            fInputArray(NULL),
+            fOutputArray(NULL),
+            fFFTSignal("fft", this),
+            fHeaderSlot("header", this, &KTReverseFFTWF::InitializeWithHeader),
+            fFSFFTWFToRealSlot("fs-fftwf-to-real", this, &KTReverseFFTWF::TransformDataToReal, &fFFTSignal)
+    {
+        SetupInternalMaps();
+    }
+
+    KTReverseFFTWF::~KTReverseFFTWF()
+    {
+        DestroyPlan();
+        FreeArrays();
+    }
+
+    bool KTReverseFFTWF::Configure(const scarab::param_node* node)
+    {
+        if (node == NULL) return true;
+
+        SetTransformFlag(node->get_value("transform-flag", fTransformFlag));
+
+        return true;
+    }
+
+    bool KTReverseFFTWF::InitializeWithHeader(KTEggHeader& header)
+    {
+        return InitializeForRealTDD(header.GetChannelHeader(0)->GetSliceSize());
+    }
+
+    bool KTReverseFFTWF::InitializeForRealTDD(unsigned timeSize)
+    {
+        if (timeSize != 0) SetTimeSize(timeSize);
+        else
+        {
+            DestroyPlan();
+            fIsInitialized = false;
+        }
+
+        // fTransformFlag is guaranteed to be valid in the Set method.
+        unsigned transformFlag = fTransformFlagMap.find(fTransformFlag)->second;
+
+        if (! AllocateArrays())
+        {
+            KTERROR(fftwlog, "Unable to allocate arrays");
+            return false;
+        }
+
+        // the input array contents are replaced for each FFT, so FFTW_PRESERVE_INPUT isn't needed
+        KTDEBUG(fftwlog, "Creating single-precision C2R plan: " << fTimeSize << " time bins; reverse FFT");
+        fReversePlan = fftwf_plan_dft_c2r_1d(fTimeSize, fInputArray, fOutputArray, transformFlag);
+
+        if (fReversePlan == NULL)
+        {
+            fIsInitialized = false;
+            KTERROR(fftwlog, "Unable to create the reverse FFT plan! FFT is not initialized.");
+            return false;
+        }
+
+        fIsInitialized = true;
+        KTDEBUG(fftwlog, "FFTW plan ready; Initialization complete.");
+        return true;
+    }
+
+    bool KTReverseFFTWF::TransformDataToReal(KTFrequencySpectrumDataFFTWF& fsData)
+    {
+        if (fsData.GetSpectrumFFTWF(0)->size() != GetFrequencySize() || ! fIsInitialized)
+        {
+            SetFrequencySize(fsData.GetSpectrumFFTWF(0)->size());
+            if (! InitializeForRealTDD())
+            {
+                KTERROR(fftwlog, "FFT could not be initialized for " << fFrequencySize << " frequency bins");
+                return false;
+            }
+        }
+
+        UpdateBinningCache(fsData.GetSpectrumFFTWF(0)->GetFrequencyBinWidth());
+
+        unsigned nComponents = fsData.GetNComponents();
+
+        KTTimeSeriesData& newData = fsData.Of< KTTimeSeriesData >().SetNComponents(nComponents);
+
+        for (unsigned iComponent = 0; iComponent < nComponents; ++iComponent)
+        {
+            const KTFrequencySpectrumFFTWF* nextInput = fsData.GetSpectrumFFTWF(iComponent);
+            if (nextInput == NULL)
+            {
+                KTERROR(fftwlog, "Frequency spectrum <" << iComponent << "> does not appear to be present.");
+                return false;
+            }
+
+            newData.SetTimeSeries(FastTransformToReal(nextInput), iComponent);
+        }
+
+        KTDEBUG(fftwlog, "FFT complete; " << nComponents << " component(s) transformed");
+
+        return true;
+    }
+
+    KTTimeSeriesRealF* KTReverseFFTWF::FastTransformToReal(const KTFrequencySpectrumFFTWF* fs) const
+    {
+        const std::complex<float>* input = fs->GetData();
+        std::copy(input, input + fFrequencySize, reinterpret_cast< std::complex<float>* >(fInputArray));
+
+        fftwf_execute(fReversePlan);
+
+        KTTimeSeriesRealF* newTS = new KTTimeSeriesRealF(fTimeSize, fTimeMinCache, fTimeMaxCache);
+        float norm = sqrt(1. / double(fTimeSize));
+        float* output = newTS->GetData();
+        for (unsigned iBin = 0; iBin < fTimeSize; ++iBin)
+        {
+            output[iBin] = fOutputArray[iBin] * norm;
+        }
+        return newTS;
+    }
+
+    void KTReverseFFTWF::SetTimeSize(unsigned nBins)
+    {
+        fTimeSize = nBins;
+        fFrequencySize = nBins / 2 + 1;
+
+        // the plan is tied to the arrays, so both are replaced
+        DestroyPlan();
+        FreeArrays();
+
+        fIsInitialized = false;
+        return;
+    }
+
+    void KTReverseFFTWF::SetFrequencySize(unsigned nBins)
+    {
+        SetTimeSize((nBins - 1) * 2);
+        return;
+    }
+
+    void KTReverseFFTWF::SetTransformFlag(const std::string& flag)
+    {
+        if (fTransformFlagMap.find(flag) == fTransformFlagMap.end())
+        {
+            KTWARN(fftwlog, "Invalid transform flag requested: " << flag << "\n\tNo change was made.");
+            return;
+        }
+
+        DestroyPlan();
+
+        fTransformFlag = flag;
+        fIsInitialized = false;
+        return;
+    }
+
+    void KTReverseFFTWF::SetupInternalMaps()
+    {
+        // transform flag map
+        fTransformFlagMap.clear();
+        fTransformFlagMap["ESTIMATE"] = FFTW_ESTIMATE;
+        fTransformFlagMap["MEASURE"] = FFTW_MEASURE;
+        fTransformFlagMap["PATIENT"] = FFTW_PATIENT;
+        fTransformFlagMap["EXHAUSTIVE"] = FFTW_EXHAUSTIVE;
+        return;
+    }
+
+    bool KTReverseFFTWF::AllocateArrays()
+    {
+        if (fInputArray == NULL)
+        {
+            KTDEBUG(fftwlog, "Allocating input array");
+            fInputArray = (fftwf_complex*) fftwf_malloc(sizeof(fftwf_complex) * fFrequencySize);
+        }
+        if (fOutputArray == NULL)
+        {
+            KTDEBUG(fftwlog, "Allocating output array");
+            fOutputArray = (float*) fftwf_malloc(sizeof(float) * fTimeSize);
+        }
+        return fInputArray != NULL && fOutputArray != NULL;
+    }
+
+    void KTReverseFFTWF::FreeArrays()
+    {
+        if (fInputArray != NULL)
+        {
+            KTDEBUG(fftwlog, "Freeing input array");
+            fftwf_free(fInputArray);
+            fInputArray = NULL;
+        }
+        if (fOutputArray != NULL)
+        {
+            KTDEBUG(fftwlog, "Freeing output array");
+            fftwf_free(fOutputArray);
+            fOutputArray = NULL;
+        }
+        return;
+    }
+
+    void KTReverseFFTWF::DestroyPlan()
+    {
+        if (fReversePlan != NULL)
+        {
+            fftwf_destroy_plan(fReversePlan);
+            fReversePlan = NULL;
+        }
+        return;
+    }
+
+} /* namespace Katydid */
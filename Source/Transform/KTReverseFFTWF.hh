@@ -0,0 +1,156 @@
+/**
+ @file KTReverseFFTWF.hh
+ @brief Contains KTReverseFFTWF
+ @details Calculates a 1-dimensional single-precision reverse FFT to real data.
+ @author: agent
+ @date: Oct 17, 2026
+ */
+
+#ifndef KTREVERSEFFTWF_HH_
+#define KTREVERSEFFTWF_HH_
+
+#include "KTFFT.hh"
+#include "KTProcessor.hh"
+
+#include "KTMemberVariable.hh"
+#include "KTSlot.hh"
+
+#include <fftw3.h>
+
+#include <map>
+#include <string>
+
+
+namespace Katydid
+{
+
+    class KTEggHeader;
+    class KTFrequencySpectrumDataFFTWF;
+    class KTFrequencySpectrumFFTWF;
+    class KTTimeSeriesRealF;
+
+    /*!
+     @class KTReverseFFTWF
+     @author agent
+
+     @brief A single-precision reverse FFT class.
+
+     @details
+     KTReverseFFTWF is the float counterpart of KTReverseFFTW, using the fftwf_ API.
+     It performs complex-to-real transforms of KTFrequencySpectrumDataFFTWF (i.e. the output of KTForwardFFTWF in the R2C state),
+     and produces KTTimeSeriesRealF.
+     Complex-to-complex reverse transforms are not available in single precision; use KTReverseFFTW.
+
+     Configuration name: "reverse-fftwf"
+
+     Available configuration values:
+     - "transform-flag": string -- flag that determines how much planning is done prior to any transforms (see KTReverseFFTW)
+
+     Slots:
+     - "header": void (Nymph::KTDataPtr) -- Initialize the FFT from an Egg header; Requires KTEggHeader
+     - "fs-fftwf-to-real": void (Nymph::KTDataPtr) -- Perform a reverse FFT on the frequency spectrum; Requires KTFrequencySpectrumDataFFTWF; Adds KTTimeSeriesData (holding KTTimeSeriesRealF); Emits signal "fft"
+
+     Signals:
+     - "fft": void (Nymph::KTDataPtr) -- Emitted upon performance of a reverse transform; Guarantees KTTimeSeriesData.
+    */
+
+    class KTReverseFFTWF : public KTFFT, public Nymph::KTProcessor
+    {
+        private:
+            typedef std::map< std::string, unsigned > TransformFlagMap;
+
+        public:
+            KTReverseFFTWF(const std::string& name = "reverse-fftwf");
+            virtual ~KTReverseFFTWF();
+
+            bool Configure(const scarab::param_node* node);
+
+            MEMBERVARIABLE_NOSET(unsigned, TimeSize);
+            MEMBERVARIABLE_NOSET(unsigned, FrequencySize);
+
+            MEMBERVARIABLEREF_NOSET(std::string, TransformFlag);
+
+            MEMBERVARIABLE_NOSET(bool, IsInitialized);
+
+        public:
+            /// Set the number of time bins; FFT must be initialized after calling this.
+            void SetTimeSize(unsigned nBins);
+            /// Set the number of frequency bins; FFT must be initialized after calling this.
+            void SetFrequencySize(unsigned nBins);
+            /// Change the transform flag; FFT must be initialized after calling this.
+            void SetTransformFlag(const std::string& flag);
+
+            /// Initialize the FFT for real time domain data; optionally specify a new time size (the default value of 0 will leave it unchanged)
+            bool InitializeForRealTDD(unsigned timeSize = 0);
+            /// Initialize the FFT using a KTEggHeader object.
+            bool InitializeWithHeader(KTEggHeader& header);
+
+            virtual double GetMinFrequency(double timeBinWidth) const;
+            virtual double GetMaxFrequency(double timeBinWidth) const;
+
+        public:
+            /// Reverse FFT - Real Time Data
+            bool TransformDataToReal(KTFrequencySpectrumDataFFTWF& fsData);
+            /// Reverse FFT - Real Time Series - No size or bin width checks
+            KTTimeSeriesRealF* FastTransformToReal(const KTFrequencySpectrumFFTWF* fs) const;
+
+        private:
+            // binning cache
+            void UpdateBinningCache(double freqBinWidth) const;
+            mutable double fFreqBinWidthCache;
+            mutable double fTimeMinCache;
+            mutable double fTimeMaxCache;
+
+            bool AllocateArrays();
+            void FreeArrays();
+            void DestroyPlan();
+            void SetupInternalMaps(); // do not make this virtual (called from the constructor)
+
+            TransformFlagMap fTransformFlagMap;
+
+            fftwf_plan fReversePlan;
+
+            fftwf_complex* fInputArray;
+            float* fOutputArray;
+
+            //***************
+            // Signals
+            //***************
+
+        private:
+            Nymph::KTSignalData fFFTSignal;
+
+            //***************
+            // Slots
+            //***************
+
+        private:
+            Nymph::KTSlotDataOneType< KTEggHeader > fHeaderSlot;
+            Nymph::KTSlotDataOneType< KTFrequencySpectrumDataFFTWF > fFSFFTWFToRealSlot;
+
+    };
+
+
+    inline double KTReverseFFTWF::GetMinFrequency(double timeBinWidth) const
+    {
+        // DC bin is centered at 0, with half a bin width on either side
+        return -0.5 * GetFrequencyBinWidth(timeBinWidth);
+    }
+
+    inline double KTReverseFFTWF::GetMaxFrequency(double timeBinWidth) const
+    {
+        return GetFrequencyBinWidth(timeBinWidth) * ((double)fFrequencySize - 0.5);
+    }
+
+    inline void KTReverseFFTWF::UpdateBinningCache(double freqBinWidth) const
+    {
+        if (freqBinWidth == fFreqBinWidthCache) return;
+        fFreqBinWidthCache = freqBinWidth;
+        fTimeMinCache = GetMinTime();
+        fTimeMaxCache = GetMaxTime(freqBinWidth);
+        return;
+    }
+
+} /* namespace Katydid */
+
+#endif /* KTREVERSEFFTWF_HH_ */
@@ -9,10 +9,13 @@
 #ifndef KTDBSCAN_HH_
 #define KTDBSCAN_HH_
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <vector>
 
 #include "KTLogger.hh"
+#include "KTThreadPool.hh"
 
 namespace Katydid
 {
@@ -31,6 +34,19 @@ namespace Katydid
      http://codingplayground.blogspot.com/2009/11/dbscan-clustering-algorithm.html
      Accessed on 6/5/2014.
      Code was provided without a license.
+
+     With more than one thread (SetNThreads()), DoClustering() uses DoParallelClustering(), which gives the same results as
+     DoSerialClustering(), cluster for cluster and point for point:
+     1. The radius queries are made for all points, in batches, with each batch shared out over a KTThreadPool.
+        Only the neighbors of core points (those with at least min-points neighbors) are kept.
+     2. Core points that are neighbors are merged with a union-find; each set of merged core points is a cluster.
+        Clusters are numbered in order of their lowest core point, which is where the serial loop starts each cluster.
+     3. A border point (a non-core neighbor of a core point) goes to the first cluster that reaches it, and is flagged as noise
+        if the serial loop would have visited it before any cluster did.
+     4. The order of the points in each cluster is found by replaying the serial expansion with a frontier that holds each
+        point once; the clusters are independent at this point, so they're replayed in parallel.
+     DistanceData::NearestNeighborsByRadius has to be safe to call from several threads at once, and the distance has to be
+     symmetric; both are true for the k-d tree indices and the distance matrices.
      */
 
     template< typename DistanceData >
@@ -70,6 +86,9 @@ namespace Katydid
             unsigned GetMinPoints() const;
             void SetMinPoints(unsigned pts);
 
+            unsigned GetNThreads() const;
+            void SetNThreads(unsigned nThreads);
+
         private:
             // Two points are neighbors if the distance
             // between them does not exceed radius value.
@@ -79,21 +98,30 @@ namespace Katydid
             unsigned fMinPoints;
 
         public:
+            /// Uses DoParallelClustering() if there's more than one thread, and DoSerialClustering() otherwise
             bool DoClustering(const DistanceData& dist, DBSResults& results);
 
+            bool DoSerialClustering(const DistanceData& dist, DBSResults& results);
+            bool DoParallelClustering(const DistanceData& dist, DBSResults& results);
+
         private:
             void InitializeArrays(size_t nPoints, DBSResults& results);
 
+            static PointId FindRoot(std::vector< PointId >& parents, PointId pid);
+
             // visited-point vector
             std::vector< bool > fVisited;
 
+            KTThreadPool fThreadPool;
+
     };
 
     template< typename DistanceData >
     KTDBSCAN< DistanceData >::KTDBSCAN(double radius, unsigned minPoints) :
             fRadius(radius),
             fMinPoints(minPoints),
-            fVisited()
+            fVisited(),
+            fThreadPool(1)
     {
     }
 
@@ -129,6 +157,20 @@ namespace Katydid
     }
 
 
+    template< typename DistanceData >
+    inline unsigned KTDBSCAN< DistanceData >::GetNThreads() const
+    {
+        return fThreadPool.GetNThreads();
+    }
+
+    template< typename DistanceData >
+    inline void KTDBSCAN< DistanceData >::SetNThreads(unsigned nThreads)
+    {
+        fThreadPool.SetNThreads(nThreads);
+        return;
+    }
+
+
     template< typename DistanceData >
     void KTDBSCAN< DistanceData >::InitializeArrays(size_t nPoints, DBSResults& results)
     {
@@ -137,17 +179,24 @@ namespace Katydid
         results.fClusters.clear();
         results.fClusters.reserve(nPoints);
 
-        results.fNoise.resize(nPoints, false);
+        results.fNoise.assign(nPoints, false);
 
-        results.fPointIdToClusterId.resize(nPoints, -1);
+        results.fPointIdToClusterId.assign(nPoints, -1);
 
-        fVisited.resize(nPoints, false);
+        fVisited.assign(nPoints, false);
 
         return;
     }
 
     template< typename DistanceData >
     bool KTDBSCAN< DistanceData >::DoClustering(const DistanceData& dist, DBSResults& results)
+    {
+        if (fThreadPool.GetNThreads() > 1) return DoParallelClustering(dist, results);
+        return DoSerialClustering(dist, results);
+    }
+
+    template< typename DistanceData >
+    bool KTDBSCAN< DistanceData >::DoSerialClustering(const DistanceData& dist, DBSResults& results)
     {
         KTDEBUG(dbslog_h, "Starting DBSCAN; min points: " << fMinPoints << "; radius: " << fRadius);
         PointId nPoints = dist.size();
@@ -227,5 +276,162 @@ namespace Katydid
         return true;
     }
 
+    template< typename DistanceData >
+    typename KTDBSCAN< DistanceData >::PointId KTDBSCAN< DistanceData >::FindRoot(std::vector< PointId >& parents, PointId pid)
+    {
+        PointId root = pid;
+        while (parents[root] != root) root = parents[root];
+        // compress the path
+        while (parents[pid] != root)
+        {
+            PointId next = parents[pid];
+            parents[pid] = root;
+            pid = next;
+        }
+        return root;
+    }
+
+    template< typename DistanceData >
+    bool KTDBSCAN< DistanceData >::DoParallelClustering(const DistanceData& dist, DBSResults& results)
+    {
+        KTDEBUG(dbslog_h, "Starting parallel DBSCAN; min points: " << fMinPoints << "; radius: " << fRadius << "; threads: " << fThreadPool.GetNThreads());
+        PointId nPoints = dist.size();
+
+        InitializeArrays(nPoints, results);
+
+        // 1. radius queries, in batches; the neighbors of core points are kept in one array, in order of point ID
+        const PointId batchSize = 16384;
+        const PointId chunkSize = 64;
+
+        std::vector< char > isCore(nPoints, false);
+        std::vector< size_t > neighborsBegin(nPoints + 1, 0);
+        std::vector< PointId > coreNeighbors;
+
+        std::vector< Neighbors > batchNeighbors(std::min(batchSize, nPoints));
+        for (PointId batchBegin = 0; batchBegin < nPoints; batchBegin += batchSize)
+        {
+            PointId batchEnd = std::min(batchBegin + batchSize, nPoints);
+            unsigned nChunks = unsigned((batchEnd - batchBegin + chunkSize - 1) / chunkSize);
+            fThreadPool.ParallelFor(nChunks, [&](unsigned iChunk, unsigned)
+            {
+                PointId chunkBegin = batchBegin + iChunk * chunkSize;
+                PointId chunkEnd = std::min(chunkBegin + chunkSize, batchEnd);
+                for (PointId pid = chunkBegin; pid < chunkEnd; ++pid)
+                {
+                    batchNeighbors[pid - batchBegin] = dist.NearestNeighborsByRadius(pid, fRadius);
+                }
+            });
+
+            for (PointId pid = batchBegin; pid < batchEnd; ++pid)
+            {
+                Neighbors& ne = batchNeighbors[pid - batchBegin];
+                if (ne.size() >= fMinPoints)
+                {
+                    isCore[pid] = true;
+                    for (unsigned int i = 0; i < ne.size(); ++i)
+                    {
+                        coreNeighbors.push_back(ne[i]);
+                    }
+                }
+                neighborsBegin[pid + 1] = coreNeighbors.size();
+                ne = Neighbors();
+            }
+        }
+
+        // 2. merge neighboring core points, and number the clusters in order of their first core point
+        std::vector< PointId > parents(nPoints);
+        for (PointId pid = 0; pid < nPoints; ++pid) parents[pid] = pid;
+        for (PointId pid = 0; pid < nPoints; ++pid)
+        {
+            if (! isCore[pid]) continue;
+            for (size_t iNe = neighborsBegin[pid]; iNe < neighborsBegin[pid + 1]; ++iNe)
+            {
+                if (! isCore[coreNeighbors[iNe]]) continue;
+                PointId root = FindRoot(parents, pid);
+                PointId neRoot = FindRoot(parents, coreNeighbors[iNe]);
+                if (root != neRoot) parents[std::max(root, neRoot)] = std::min(root, neRoot);
+            }
+        }
+
+        std::vector< PointId > seeds;
+        for (PointId pid = 0; pid < nPoints; ++pid)
+        {
+            if (! isCore[pid]) continue;
+            PointId root = FindRoot(parents, pid);
+            // the root is the lowest core point in its set, so it's seen before the rest of the set
+            if (root == pid)
+            {
+                results.fPointIdToClusterId[pid] = ClusterId(seeds.size());
+                seeds.push_back(pid);
+            }
+            else
+            {
+                results.fPointIdToClusterId[pid] = results.fPointIdToClusterId[root];
+            }
+        }
+        KTDEBUG(dbslog_h, "Found " << seeds.size() << " clusters");
+
+        // 3. border points go to the earliest cluster that has them as neighbors; they're noise if the serial loop gets to them first
+        const ClusterId noCluster = std::numeric_limits< ClusterId >::max();
+        std::vector< ClusterId > borderCluster(nPoints, noCluster);
+        for (PointId pid = 0; pid < nPoints; ++pid)
+        {
+            if (! isCore[pid]) continue;
+            ClusterId cid = results.fPointIdToClusterId[pid];
+            for (size_t iNe = neighborsBegin[pid]; iNe < neighborsBegin[pid + 1]; ++iNe)
+            {
+                PointId nPid = coreNeighbors[iNe];
+                if (! isCore[nPid] && cid < borderCluster[nPid]) borderCluster[nPid] = cid;
+            }
+        }
+        for (PointId pid = 0; pid < nPoints; ++pid)
+        {
+            if (isCore[pid]) continue;
+            if (borderCluster[pid] != noCluster) results.fPointIdToClusterId[pid] = borderCluster[pid];
+            results.fNoise[pid] = borderCluster[pid] == noCluster || seeds[borderCluster[pid]] > pid;
+        }
+
+        // 4. replay the expansion of each cluster to get its points in the serial order;
+        // only the points assigned to a cluster are queued in it, so each cluster writes to its own points' flags
+        results.fClusters.resize(seeds.size());
+        std::vector< char > queued(nPoints, false);
+        fThreadPool.ParallelFor(unsigned(seeds.size()), [&](unsigned iCluster, unsigned)
+        {
+            ClusterId cid = ClusterId(iCluster);
+            Cluster& cluster = results.fClusters[iCluster];
+            std::vector< PointId > frontier;
+
+            PointId seed = seeds[iCluster];
+            queued[seed] = true;
+            cluster.push_back(seed);
+
+            PointId expanding = seed;
+            size_t iFrontier = 0;
+            while (true)
+            {
+                for (size_t iNe = neighborsBegin[expanding]; iNe < neighborsBegin[expanding + 1]; ++iNe)
+                {
+                    PointId nPid = coreNeighbors[iNe];
+                    if (results.fPointIdToClusterId[nPid] == cid && ! queued[nPid])
+                    {
+                        queued[nPid] = true;
+                        frontier.push_back(nPid);
+                    }
+                }
+
+                // the next point to add; core points also have their neighbors added to the frontier
+                while (iFrontier < frontier.size() && ! isCore[frontier[iFrontier]])
+                {
+                    cluster.push_back(frontier[iFrontier++]);
+                }
+                if (iFrontier == frontier.size()) break;
+                expanding = frontier[iFrontier++];
+                cluster.push_back(expanding);
+            }
+        });
+
+        return true;
+    }
+
 } /* namespace Katydid */
 #endif /* KTDBSCAN_HH_ */
@@ -7,6 +7,12 @@
  *     created: 12/30/2012
  *  KTECDF provides an empirical cumulative distribution function which can
  *  be used for hypothesis testing.
+ *
+ *  The function is stored as a set of (value, cumulative fraction) points in
+ *  increasing order, and is interpolated linearly between them; it's 0 below
+ *  the first point and holds the last fraction above the last point.
+ *  The points can come from sorted data, or from a summary of the data such as
+ *  a KTTDigest (see KTAmplitudeSketchData).
  */
 
 // We use the BOOST accumulator framework as the backbone of the ecdf.
@@ -14,14 +20,45 @@
 #include <boost/accumulators/statistics/stats.hpp>
 #include <boost/accumulators/statistics/mean.hpp>
 #include <boost/accumulators/statistics/moment.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
 using namespace boost::accumulators;
 
 namespace Katydid {
 
   template <typename T>
   class KTECDF {
+  public:
+    KTECDF() : fData(), fValues(), fCumulative() {}
+
+    // Points must be added in increasing order of both value and fraction
+    void AddPoint(T value, double cumulative) {
+      fValues.push_back(value);
+      fCumulative.push_back(cumulative);
+    }
+    void Clear() {
+      fValues.clear();
+      fCumulative.clear();
+    }
+
+    size_t GetNPoints() const { return fValues.size(); }
+    T GetValue(size_t iPoint) const { return fValues[iPoint]; }
+    double GetCumulative(size_t iPoint) const { return fCumulative[iPoint]; }
+
+    // Fraction of the distribution below value
+    double operator()(T value) const {
+      if (fValues.empty() || value < fValues.front()) return 0.;
+      if (value >= fValues.back()) return fCumulative.back();
+      size_t upper = std::upper_bound(fValues.begin(), fValues.end(), value) - fValues.begin();
+      size_t lower = upper - 1;
+      return fCumulative[lower] + (fCumulative[upper] - fCumulative[lower]) * double(value - fValues[lower]) / double(fValues[upper] - fValues[lower]);
+    }
+
   private:
     accumulator_set<T, stats<tag::mean, tag::moment<2> > > fData;
+    std::vector<T> fValues;
+    std::vector<double> fCumulative;
   }; // class KTECDF
 
 }; // namespace katydid
@@ -0,0 +1,176 @@
+/**
+ @file KTMirroredRingBuffer.hh
+ @brief Contains KTMirroredRingBuffer
+ @details A power-of-two ring buffer in which any run of buffered samples is contiguous in memory
+ @author: agent
+ @date: Oct 18, 2026
+ */
+
+#ifndef KTMIRROREDRINGBUFFER_HH_
+#define KTMIRROREDRINGBUFFER_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace Katydid
+{
+    /*!
+     @class KTMirroredRingBuffer
+     @author agent
+
+     @brief A FIFO sample buffer whose contents can always be read as one contiguous array.
+
+     @details
+     The capacity is a power of two, so positions in the ring are found with a mask.
+     The storage is twice the capacity, and every sample is written both at its ring position and one capacity later (the mirror).
+     A run of up to Capacity() samples starting anywhere in the ring is therefore contiguous, and GetData() can hand out a plain pointer to it.
+     This is the same layout as mapping the same memory twice in a row, done with an extra store per sample instead of with virtual-memory tricks.
+
+     Samples are added in blocks with Append() and removed from the front with Consume(); neither does any per-sample container operations.
+     If an Append() would overfill the buffer, the capacity is doubled until it fits (the buffered samples are kept).
+     Pointers from GetData() are invalidated by Append() if the buffer grows, and by Clear() and Reserve().
+    */
+    template< typename XValueType >
+    class KTMirroredRingBuffer
+    {
+        public:
+            KTMirroredRingBuffer();
+            ~KTMirroredRingBuffer();
+
+            /// Makes sure the capacity is at least minCapacity; the contents are kept
+            void Reserve(size_t minCapacity);
+            /// Removes all of the samples; the capacity is unchanged
+            void Clear();
+
+            size_t Size() const;
+            size_t Capacity() const;
+            bool Empty() const;
+
+            /// Adds nValues samples to the back of the buffer
+            void Append(const XValueType* values, size_t nValues);
+            /// Removes nValues samples from the front of the buffer
+            void Consume(size_t nValues);
+
+            /// Pointer to the sample at position offset from the front; all of the buffered samples after it follow contiguously
+            const XValueType* GetData(size_t offset = 0) const;
+
+        private:
+            void CopyIn(size_t position, const XValueType* values, size_t nValues);
+
+            std::vector< XValueType > fStorage;
+            size_t fCapacity;
+            size_t fMask;
+            size_t fFront;
+            size_t fSize;
+    };
+
+    template< typename XValueType >
+    KTMirroredRingBuffer< XValueType >::KTMirroredRingBuffer() :
+            fStorage(),
+            fCapacity(0),
+            fMask(0),
+            fFront(0),
+            fSize(0)
+    {
+    }
+
+    template< typename XValueType >
+    KTMirroredRingBuffer< XValueType >::~KTMirroredRingBuffer()
+    {
+    }
+
+    template< typename XValueType >
+    void KTMirroredRingBuffer< XValueType >::Reserve(size_t minCapacity)
+    {
+        if (minCapacity <= fCapacity) return;
+
+        size_t newCapacity = 1;
+        while (newCapacity < minCapacity) newCapacity <<= 1;
+
+        // unwrap the current contents to the front of the new storage
+        std::vector< XValueType > newStorage(2 * newCapacity);
+        if (fSize != 0)
+        {
+            const XValueType* contents = GetData();
+            std::copy(contents, contents + fSize, newStorage.begin());
+            std::copy(contents, contents + fSize, newStorage.begin() + newCapacity);
+        }
+
+        fStorage.swap(newStorage);
+        fCapacity = newCapacity;
+        fMask = newCapacity - 1;
+        fFront = 0;
+        return;
+    }
+
+    template< typename XValueType >
+    inline void KTMirroredRingBuffer< XValueType >::Clear()
+    {
+        fFront = 0;
+        fSize = 0;
+        return;
+    }
+
+    template< typename XValueType >
+    inline size_t KTMirroredRingBuffer< XValueType >::Size() const
+    {
+        return fSize;
+    }
+
+    template< typename XValueType >
+    inline size_t KTMirroredRingBuffer< XValueType >::Capacity() const
+    {
+        return fCapacity;
+    }
+
+    template< typename XValueType >
+    inline bool KTMirroredRingBuffer< XValueType >::Empty() const
+    {
+        return fSize == 0;
+    }
+
+    template< typename XValueType >
+    void KTMirroredRingBuffer< XValueType >::Append(const XValueType* values, size_t nValues)
+    {
+        if (fSize + nValues > fCapacity) Reserve(fSize + nValues);
+
+        size_t position = (fFront + fSize) & fMask;
+        // the part that fits before the end of the ring, then the part that wraps around to the start
+        size_t nBeforeWrap = std::min(nValues, fCapacity - position);
+        CopyIn(position, values, nBeforeWrap);
+        CopyIn(0, values + nBeforeWrap, nValues - nBeforeWrap);
+
+        fSize += nValues;
+        return;
+    }
+
+    template< typename XValueType >
+    inline void KTMirroredRingBuffer< XValueType >::Consume(size_t nValues)
+    {
+        if (nValues >= fSize)
+        {
+            Clear();
+            return;
+        }
+        fFront = (fFront + nValues) & fMask;
+        fSize -= nValues;
+        return;
+    }
+
+    template< typename XValueType >
+    inline const XValueType* KTMirroredRingBuffer< XValueType >::GetData(size_t offset) const
+    {
+        return fStorage.data() + ((fFront + offset) & fMask);
+    }
+
+    template< typename XValueType >
+    inline void KTMirroredRingBuffer< XValueType >::CopyIn(size_t position, const XValueType* values, size_t nValues)
+    {
+        std::copy(values, values + nValues, fStorage.begin() + position);
+        std::copy(values, values + nValues, fStorage.begin() + position + fCapacity);
+        return;
+    }
+
+} /* namespace Katydid */
+#endif /* KTMIRROREDRINGBUFFER_HH_ */
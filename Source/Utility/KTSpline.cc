@@ -10,34 +10,45 @@
 #include "KTLogger.hh"
 #include "KTPhysicalArray.hh"
 
+#include <algorithm>
+#include <atomic>
+
 KTLOGGER(splinelog, "KTSpline");
 
 namespace Katydid
 {
 
-#ifdef ROOT_FOUND
-
     KTSpline::KTSpline() :
-            fSpline(),
+            fKnots(),
+            fCubics(),
             fXMin(0.),
             fXMax(0.),
-            fCache()
+            fID(NextID()),
+            fCache(),
+            fCacheMutex()
     {
     }
 
-    KTSpline::KTSpline(double* xVals, double* yVals, unsigned nVals) :
-            fSpline("spline", xVals, yVals, nVals),
-            fXMin(xVals[0]),
-            fXMax(xVals[nVals-1]),
-            fCache()
+    KTSpline::KTSpline(const double* xVals, const double* yVals, unsigned nVals) :
+            fKnots(xVals, xVals + nVals),
+            fCubics(),
+            fXMin(nVals > 0 ? xVals[0] : 0.),
+            fXMax(nVals > 0 ? xVals[nVals-1] : 0.),
+            fID(NextID()),
+            fCache(),
+            fCacheMutex()
     {
+        CalculateCubics(xVals, yVals, nVals);
     }
 
     KTSpline::KTSpline(const KTSpline& orig) :
-            fSpline(orig.fSpline),
+            fKnots(orig.fKnots),
+            fCubics(orig.fCubics),
             fXMin(orig.fXMin),
             fXMax(orig.fXMax),
-            fCache()
+            fID(NextID()),
+            fCache(),
+            fCacheMutex()
     {}
 
     KTSpline::~KTSpline()
@@ -47,105 +58,172 @@ namespace Katydid
 
     KTSpline& KTSpline::operator=(const KTSpline& rhs)
     {
-        fSpline = rhs.fSpline;
+        fKnots = rhs.fKnots;
+        fCubics = rhs.fCubics;
         fXMin = rhs.fXMin;
         fXMax = rhs.fXMax;
-        fCache.clear();
+        fID = NextID();
+        ClearCache();
         return *this;
     }
 
-    double KTSpline::Evaluate(double xValue)
+    void KTSpline::CalculateCubics(const double* xVals, const double* yVals, unsigned nVals)
     {
-        return fSpline.Eval(xValue);
-    }
+        fCubics.clear();
+        if (nVals == 0)
+        {
+            KTWARN(splinelog, "Spline has no points; it will evaluate to 0");
+            return;
+        }
+        if (nVals == 1)
+        {
+            Cubic constant = {yVals[0], 0., 0., 0.};
+            fCubics.push_back(constant);
+            return;
+        }
 
-    double KTSpline::Evaluate(double xValue) const
-    {
-        return fSpline.Eval(xValue);
-    }
+        unsigned nIntervals = nVals - 1;
+        std::vector< double > widths(nIntervals);
+        std::vector< double > slopes(nIntervals);
+        for (unsigned iInterval = 0; iInterval < nIntervals; ++iInterval)
+        {
+            widths[iInterval] = xVals[iInterval+1] - xVals[iInterval];
+            slopes[iInterval] = (yVals[iInterval+1] - yVals[iInterval]) / widths[iInterval];
+        }
 
-    std::shared_ptr< KTSpline::Implementation > KTSpline::Implement(unsigned nBins, double xMin, double xMax) const
-    {
-        std::shared_ptr< Implementation > imp = GetFromCache(nBins, xMin, xMax);
-        if (imp != NULL) return imp;
+        // Second derivatives at the points; they're 0 at the end points for a natural spline.
+        // The interior ones are the solution of a tridiagonal system, solved with the Thomas algorithm:
+        //   h[i-1] M[i-1] + 2 (h[i-1] + h[i]) M[i] + h[i] M[i+1] = 6 (slope[i] - slope[i-1])
+        std::vector< double > secondDerivs(nVals, 0.);
+        if (nVals > 2)
+        {
+            std::vector< double > modUpper(nVals, 0.);
+            std::vector< double > modRHS(nVals, 0.);
+            for (unsigned iPoint = 1; iPoint < nVals - 1; ++iPoint)
+            {
+                double lower = widths[iPoint-1];
+                double diag = 2. * (widths[iPoint-1] + widths[iPoint]) - lower * modUpper[iPoint-1];
+                modUpper[iPoint] = widths[iPoint] / diag;
+                modRHS[iPoint] = (6. * (slopes[iPoint] - slopes[iPoint-1]) - lower * modRHS[iPoint-1]) / diag;
+            }
+            for (unsigned iPoint = nVals - 2; iPoint > 0; --iPoint)
+            {
+                secondDerivs[iPoint] = modRHS[iPoint] - modUpper[iPoint] * secondDerivs[iPoint+1];
+            }
+        }
 
-        KTDEBUG(splinelog, "Creating new spline implementation for (" << nBins << ", " << xMin << ", " << xMax << ")");
-        imp = std::make_shared< Implementation >(nBins, xMin, xMax);
-        double mean = 0.;
-        for (unsigned iBin=0; iBin < nBins; iBin++)
+        fCubics.resize(nIntervals);
+        for (unsigned iInterval = 0; iInterval < nIntervals; ++iInterval)
         {
-            (*imp)(iBin) = Evaluate(imp->GetBinCenter(iBin));
-            mean += (*imp)(iBin);
-            //KTWARN(splinelog, (*imp)(iBin) << "  " << mean);
+            double width = widths[iInterval];
+            fCubics[iInterval].fA = yVals[iInterval];
+            fCubics[iInterval].fB = slopes[iInterval] - width * (2. * secondDerivs[iInterval] + secondDerivs[iInterval+1]) / 6.;
+            fCubics[iInterval].fC = 0.5 * secondDerivs[iInterval];
+            fCubics[iInterval].fD = (secondDerivs[iInterval+1] - secondDerivs[iInterval]) / (6. * width);
         }
-        imp->SetMean(mean / (double)nBins);
-        KTDEBUG(splinelog, "Calculated implementation mean: " << imp->GetMean());
-        AddToCache(imp);
-        return imp;
+        return;
     }
 
-
-#else
-
-    KTSpline::KTSpline() :
-            fXMin(0.),
-            fXMax(0.)
+    unsigned KTSpline::FindInterval(double xValue) const
     {
-        KTERROR(splinelog, "Non-ROOT version of KTSpline is not fully functional. Stop now, or else!!!");
+        if (fCubics.size() <= 1) return 0;
+        // only the interior points separate intervals; values beyond the end points use the first or last interval
+        return unsigned(std::upper_bound(fKnots.begin() + 1, fKnots.end() - 1, xValue) - (fKnots.begin() + 1));
     }
 
-    KTSpline::KTSpline(double* xVals, double* yVals, unsigned nVals) :
-            fXMin(xVals[0]),
-            fXMax(xVals[nVals-1])
+    double KTSpline::EvaluateCubic(unsigned interval, double xValue) const
     {
-        KTERROR(splinelog, "Non-ROOT version of KTSpline is not fully functional. Stop now, or else!!!");
+        const Cubic& cubic = fCubics[interval];
+        double t = xValue - fKnots[interval];
+        return cubic.fA + t * (cubic.fB + t * (cubic.fC + t * cubic.fD));
     }
 
-    KTSpline::KTSpline(const KTSpline& orig) :
-            fXMin(orig.fXMin),
-            fXMax(orig.fXMax)
+    double KTSpline::Evaluate(double xValue)
     {
+        return static_cast< const KTSpline* >(this)->Evaluate(xValue);
     }
 
-    KTSpline::~KTSpline()
+    double KTSpline::Evaluate(double xValue) const
     {
+        if (fCubics.empty()) return 0.;
+        return EvaluateCubic(FindInterval(xValue), xValue);
     }
 
-    KTSpline& KTSpline::operator=(const KTSpline& rhs)
+    std::shared_ptr< KTSpline::Implementation > KTSpline::Implement(unsigned nBins, double xMin, double xMax) const
     {
-        fXMin = rhs.fXMin;
-        fXMax = rhs.fXMax;
-        return *this;
-    }
+        std::shared_ptr< Implementation > imp = GetFromCache(nBins, xMin, xMax);
+        if (imp != NULL) return imp;
 
-    double KTSpline::Evaluate(double xValue)
-    {
-      return 1.;
-    }
+        KTDEBUG(splinelog, "Creating new spline implementation for (" << nBins << ", " << xMin << ", " << xMax << ")");
+        imp = std::make_shared< Implementation >(nBins, xMin, xMax);
+        if (nBins == 0) return imp;
+        if (fCubics.empty())
+        {
+            for (unsigned iBin = 0; iBin < nBins; ++iBin) (*imp)(iBin) = 0.;
+            return AddToCache(imp);
+        }
 
-    double KTSpline::Evaluate(double xValue) const
-    {
-        return 1.;
+        double binWidth = imp->GetBinWidth();
+        double sum = 0.;
+        unsigned interval = FindInterval(imp->GetBinCenter(0));
+        unsigned iBin = 0;
+        while (iBin < nBins)
+        {
+            // the bins before the next point use this interval's cubic; the last interval is used for all of the remaining bins
+            unsigned endBin = nBins;
+            if (interval + 1 < fCubics.size())
+            {
+                endBin = iBin;
+                while (endBin < nBins && imp->GetBinCenter(endBin) < fKnots[interval+1]) ++endBin;
+            }
+
+            if (endBin > iBin)
+            {
+                // forward differences of the cubic, starting from the first bin center in the interval:
+                // each successive bin is reached with three additions
+                const Cubic& cubic = fCubics[interval];
+                double t = imp->GetBinCenter(iBin) - fKnots[interval];
+                double h = binWidth;
+                double value = cubic.fA + t * (cubic.fB + t * (cubic.fC + t * cubic.fD));
+                double diff1 = h * (cubic.fB + cubic.fC * (2.*t + h) + cubic.fD * (3.*t*t + 3.*t*h + h*h));
+                double diff2 = h * h * (2. * cubic.fC + cubic.fD * (6.*t + 6.*h));
+                double diff3 = 6. * cubic.fD * h * h * h;
+                for (; iBin < endBin; ++iBin)
+                {
+                    (*imp)(iBin) = value;
+                    sum += value;
+                    value += diff1;
+                    diff1 += diff2;
+                    diff2 += diff3;
+                }
+            }
+            ++interval;
+        }
+
+        imp->SetMean(sum / (double)nBins);
+        KTDEBUG(splinelog, "Calculated implementation mean: " << imp->GetMean());
+        return AddToCache(imp);
     }
 
-    KTPhysicalArray< 1, double >* KTSpline::Implement(unsigned nBins, double xMin, double xMax) const
+    uint64_t KTSpline::NextID()
     {
-        return NULL;
+        static std::atomic< uint64_t > sNextID(1);
+        return sNextID++;
     }
 
-#endif
-
-    void KTSpline::AddToCache(std::shared_ptr< Implementation > imp) const
+    std::shared_ptr< KTSpline::Implementation > KTSpline::AddToCache(std::shared_ptr< Implementation > imp) const
     {
+        std::lock_guard< std::mutex > lock(fCacheMutex);
         ImplementationCache::iterator it = FindInCache(imp->size(), imp->GetRangeMin(), imp->GetRangeMax());
-        if (it != fCache.end()) fCache.erase(it);
+        if (it != fCache.end()) return *it;
 
         fCache.insert(imp);
-        return;
+        return imp;
     }
 
     std::shared_ptr< KTSpline::Implementation > KTSpline::GetFromCache(unsigned nBins, double xMin, double xMax) const
     {
+        std::lock_guard< std::mutex > lock(fCacheMutex);
         ImplementationCache::iterator it = FindInCache(nBins, xMin, xMax);
         if (it != fCache.end())
         {
@@ -157,6 +235,7 @@ namespace Katydid
 
     void KTSpline::ClearCache() const
     {
+        std::lock_guard< std::mutex > lock(fCacheMutex);
         fCache.clear();
     }
 
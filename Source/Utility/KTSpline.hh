@@ -10,16 +10,30 @@
 
 #include "KTPhysicalArray.hh"
 
-#ifdef ROOT_FOUND
-#include "TSpline.h"
-#endif
-
 #include <set>
 #include <cstddef>
 #include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <vector>
 
 namespace Katydid
 {
+    /*!
+     @class KTSpline
+     @author N. S. Oblath
+
+     @brief Natural cubic spline through a set of points.
+
+     @details
+     The x values must be strictly increasing.  Outside of the range of the points the spline is extrapolated
+     with the cubic of the first or last interval.
+
+     Implement() evaluates the spline at the centers of a uniform set of bins.  The bins are swept interval by interval,
+     and within an interval the cubic is evaluated by forward differencing, so each bin costs three additions.
+     Implementations are cached, so asking for the same binning again is free.  The cache is guarded by a mutex,
+     so a spline that is shared between threads can be implemented concurrently.
+    */
     class KTSpline
     {
         public:
@@ -44,7 +58,7 @@ namespace Katydid
 
         public:
             KTSpline();
-            KTSpline(double* xVals, double* yVals, unsigned nVals);
+            KTSpline(const double* xVals, const double* yVals, unsigned nVals);
             KTSpline(const KTSpline& orig);
             virtual ~KTSpline();
 
@@ -61,18 +75,37 @@ namespace Katydid
             double GetXMax() const;
             void SetXMax(double max);
 
-#ifdef ROOT_FOUND
-            TSpline3* GetSpline();
-#endif
+            unsigned GetNPoints() const;
+
+            /// Identifies the contents of this spline: every constructed or assigned spline gets a new ID, which is never reused.
+            /// Unlike the spline's address, this can be used as a cache key for quantities derived from the spline.
+            uint64_t GetID() const;
 
         private:
-#ifdef ROOT_FOUND
-            TSpline3 fSpline;
-#endif
+            /// Cubic for one interval: y = fA + fB*t + fC*t^2 + fD*t^3, with t = x - (x of the start of the interval)
+            struct Cubic
+            {
+                double fA;
+                double fB;
+                double fC;
+                double fD;
+            };
+
+            /// Solves for the natural-spline coefficients of each interval
+            void CalculateCubics(const double* xVals, const double* yVals, unsigned nVals);
+            /// Index of the interval whose cubic is used at xValue
+            unsigned FindInterval(double xValue) const;
+            double EvaluateCubic(unsigned interval, double xValue) const;
+
+            std::vector< double > fKnots;
+            std::vector< Cubic > fCubics;
 
             double fXMin;
             double fXMax;
 
+            uint64_t fID;
+            static uint64_t NextID();
+
         public:
             /// Retrieves a matching implementation from the cache; returns NULL if one does not exist. The matching implementation is removed from the cache and ownership is transferred to the caller.
             std::shared_ptr< Implementation > GetFromCache(unsigned nBins, double xMin, double xMax) const;
@@ -80,11 +113,13 @@ namespace Katydid
             void ClearCache() const;
 
         private:
-            /// Adds a new spline implementation to the cache. If a matching implementation already exists in the cache, the older implementation is deleted.
-            void AddToCache(std::shared_ptr< Implementation > imp) const;
+            /// Adds a new spline implementation to the cache. If a matching implementation already exists in the cache (i.e. another thread implemented the same binning first), that one is kept and returned instead.
+            std::shared_ptr< Implementation > AddToCache(std::shared_ptr< Implementation > imp) const;
+            /// Must be called with fCacheMutex locked
             ImplementationCache::iterator FindInCache(unsigned nBins, double xMin, double XMax) const;
 
             mutable ImplementationCache fCache;
+            mutable std::mutex fCacheMutex;
 
     };
 
@@ -110,12 +145,15 @@ namespace Katydid
         return;
     }
 
-#ifdef ROOT_FOUND
-    inline TSpline3* KTSpline::GetSpline()
+    inline unsigned KTSpline::GetNPoints() const
+    {
+        return unsigned(fKnots.size());
+    }
+
+    inline uint64_t KTSpline::GetID() const
     {
-        return &fSpline;
+        return fID;
     }
-#endif
 
 } /* namespace Katydid */
 #endif /* KTSPLINE_HH_ */
@@ -0,0 +1,183 @@
+/*
+ * KTTDigest.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "KTTDigest.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Katydid
+{
+    namespace
+    {
+        bool CentroidIsBefore(const KTTDigest::Centroid& lhs, const KTTDigest::Centroid& rhs)
+        {
+            return lhs.fMean < rhs.fMean;
+        }
+    }
+
+    KTTDigest::KTTDigest(double compression) :
+            fCompression(compression > 10. ? compression : 10.),
+            fBufferCapacity(size_t(fCompression)),
+            fCentroids(),
+            fBuffer(),
+            fTotalWeight(0.),
+            fMin(std::numeric_limits< double >::max()),
+            fMax(-std::numeric_limits< double >::max())
+    {
+    }
+
+    KTTDigest::~KTTDigest()
+    {
+    }
+
+    void KTTDigest::Add(double value, double weight)
+    {
+        if (weight <= 0. || std::isnan(value)) return;
+
+        Centroid newValue = {value, weight};
+        fBuffer.push_back(newValue);
+        fTotalWeight += weight;
+        if (value < fMin) fMin = value;
+        if (value > fMax) fMax = value;
+
+        if (fBuffer.size() >= fBufferCapacity) Flush();
+        return;
+    }
+
+    void KTTDigest::Merge(const KTTDigest& other)
+    {
+        if (other.Empty()) return;
+        MergeCentroids(other.GetCentroids(), other.GetMin(), other.GetMax());
+        return;
+    }
+
+    void KTTDigest::MergeCentroids(const std::vector< Centroid >& centroids, double min, double max)
+    {
+        for (std::vector< Centroid >::const_iterator cIt = centroids.begin(); cIt != centroids.end(); ++cIt)
+        {
+            if (cIt->fWeight <= 0.) continue;
+            fBuffer.push_back(*cIt);
+            fTotalWeight += cIt->fWeight;
+        }
+        if (min < fMin) fMin = min;
+        if (max > fMax) fMax = max;
+
+        Flush();
+        return;
+    }
+
+    void KTTDigest::Clear()
+    {
+        fCentroids.clear();
+        fBuffer.clear();
+        fTotalWeight = 0.;
+        fMin = std::numeric_limits< double >::max();
+        fMax = -std::numeric_limits< double >::max();
+        return;
+    }
+
+    void KTTDigest::Flush() const
+    {
+        if (fBuffer.empty()) return;
+
+        fBuffer.insert(fBuffer.end(), fCentroids.begin(), fCentroids.end());
+        std::sort(fBuffer.begin(), fBuffer.end(), CentroidIsBefore);
+
+        // the scale function is k(q) = normalizer * log(q / (1 - q)), and a centroid may span at most one unit of k;
+        // the normalizer keeps the number of centroids at about the compression, independent of the total weight
+        double normalizer = fCompression / (4. * std::log(std::max(fTotalWeight / fCompression, 1.)) + 24.);
+        double weightSoFar = 0.;
+        double weightLimit = 0.; // the first centroid (the minimum) is always on its own
+        fCentroids.clear();
+        Centroid current = fBuffer[0];
+        for (std::vector< Centroid >::const_iterator bIt = fBuffer.begin() + 1; bIt != fBuffer.end(); ++bIt)
+        {
+            if (weightSoFar + current.fWeight + bIt->fWeight <= weightLimit)
+            {
+                // the weighted mean is updated incrementally, to avoid cancellation with large weights
+                current.fWeight += bIt->fWeight;
+                current.fMean += (bIt->fMean - current.fMean) * bIt->fWeight / current.fWeight;
+            }
+            else
+            {
+                fCentroids.push_back(current);
+                weightSoFar += current.fWeight;
+                double q = weightSoFar / fTotalWeight;
+                if (q >= 1.)
+                {
+                    weightLimit = fTotalWeight;
+                }
+                else
+                {
+                    double k = normalizer * std::log(q / (1. - q)) + 1.;
+                    weightLimit = fTotalWeight / (1. + std::exp(-k / normalizer));
+                }
+                current = *bIt;
+            }
+        }
+        fCentroids.push_back(current);
+
+        fBuffer.clear();
+        return;
+    }
+
+    double KTTDigest::Quantile(double q) const
+    {
+        if (Empty()) return 0.;
+        Flush();
+
+        if (q <= 0.) return fMin;
+        if (q >= 1.) return fMax;
+
+        // the centers of the centroids, with the min and max at the ends, are interpolated linearly in cumulative weight
+        double target = q * fTotalWeight;
+        double lowerWeight = 0.;
+        double lowerValue = fMin;
+        double weightSoFar = 0.;
+        for (std::vector< Centroid >::const_iterator cIt = fCentroids.begin(); cIt != fCentroids.end(); ++cIt)
+        {
+            double center = weightSoFar + 0.5 * cIt->fWeight;
+            if (target < center)
+            {
+                return lowerValue + (cIt->fMean - lowerValue) * (target - lowerWeight) / (center - lowerWeight);
+            }
+            lowerWeight = center;
+            lowerValue = cIt->fMean;
+            weightSoFar += cIt->fWeight;
+        }
+        return lowerValue + (fMax - lowerValue) * (target - lowerWeight) / (fTotalWeight - lowerWeight);
+    }
+
+    double KTTDigest::CDF(double value) const
+    {
+        if (Empty()) return 0.;
+        Flush();
+
+        if (value < fMin) return 0.;
+        if (value >= fMax) return 1.;
+
+        // the inverse of the interpolation used in Quantile()
+        double lowerWeight = 0.;
+        double lowerValue = fMin;
+        double weightSoFar = 0.;
+        for (std::vector< Centroid >::const_iterator cIt = fCentroids.begin(); cIt != fCentroids.end(); ++cIt)
+        {
+            double center = weightSoFar + 0.5 * cIt->fWeight;
+            if (value < cIt->fMean)
+            {
+                return (lowerWeight + (center - lowerWeight) * (value - lowerValue) / (cIt->fMean - lowerValue)) / fTotalWeight;
+            }
+            lowerWeight = center;
+            lowerValue = cIt->fMean;
+            weightSoFar += cIt->fWeight;
+        }
+        return (lowerWeight + (fTotalWeight - lowerWeight) * (value - lowerValue) / (fMax - lowerValue)) / fTotalWeight;
+    }
+
+} /* namespace Katydid */
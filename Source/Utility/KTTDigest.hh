@@ -0,0 +1,121 @@
+/**
+ @file KTTDigest.hh
+ @brief Contains KTTDigest
+ @details A mergeable streaming sketch of a distribution, for quantile and CDF estimates in bounded memory
+ @author: agent
+ @date: Oct 18, 2026
+ */
+
+#ifndef KTTDIGEST_HH_
+#define KTTDIGEST_HH_
+
+#include <cstddef>
+#include <vector>
+
+namespace Katydid
+{
+    /*!
+     @class KTTDigest
+     @author agent
+
+     @brief Approximates a distribution with a bounded number of weighted centroids (a merging t-digest).
+
+     @details
+     Values are collected in a buffer, and when the buffer is full they're merged with the existing centroids in a single
+     sorted pass. Neighboring values are merged into a centroid only while the centroid spans less than one unit of the
+     logistic scale function k(q) ~ log(q / (1 - q)), which keeps the centroids small (down to single values) in the tails
+     of the distribution, where quantiles need the most resolution, and large in the middle.
+     The number of centroids is bounded by about the compression, regardless of how many values are added,
+     so a digest with the default compression of 100, including its buffer of 100 values, takes a few kB.
+
+     Two digests are merged by merging one's centroids into the other, so sketches made from different files
+     (or different threads) can be combined; the result is about as accurate as a single digest of all of the values.
+
+     Quantiles and CDF values are interpolated linearly between the centroid centers, with the minimum and maximum
+     values added at the ends, so the CDF is continuous and monotonic.
+
+     The const accessors merge any buffered values first, so they modify the (mutable) internal state.
+    */
+    class KTTDigest
+    {
+        public:
+            struct Centroid
+            {
+                double fMean;
+                double fWeight;
+            };
+
+        public:
+            KTTDigest(double compression = 100.);
+            ~KTTDigest();
+
+            double GetCompression() const;
+
+            /// Adds a value (or a group of identical values with the given total weight)
+            void Add(double value, double weight = 1.);
+            /// Adds all of the values summarized by another digest
+            void Merge(const KTTDigest& other);
+            /// Adds centroids that summarize values in [min, max]; used to restore a digest that was written to a file
+            void MergeCentroids(const std::vector< Centroid >& centroids, double min, double max);
+
+            void Clear();
+
+            double GetTotalWeight() const;
+            double GetMin() const;
+            double GetMax() const;
+            bool Empty() const;
+
+            /// The value below which a fraction q of the weight lies
+            double Quantile(double q) const;
+            /// The fraction of the weight below value
+            double CDF(double value) const;
+
+            /// The centroids, in increasing order of mean
+            const std::vector< Centroid >& GetCentroids() const;
+
+        private:
+            void Flush() const;
+
+            double fCompression;
+            size_t fBufferCapacity;
+
+            mutable std::vector< Centroid > fCentroids;
+            mutable std::vector< Centroid > fBuffer;
+            double fTotalWeight;
+            double fMin;
+            double fMax;
+    };
+
+    inline double KTTDigest::GetCompression() const
+    {
+        return fCompression;
+    }
+
+    inline double KTTDigest::GetTotalWeight() const
+    {
+        return fTotalWeight;
+    }
+
+    inline double KTTDigest::GetMin() const
+    {
+        return fMin;
+    }
+
+    inline double KTTDigest::GetMax() const
+    {
+        return fMax;
+    }
+
+    inline bool KTTDigest::Empty() const
+    {
+        return fTotalWeight == 0.;
+    }
+
+    inline const std::vector< KTTDigest::Centroid >& KTTDigest::GetCentroids() const
+    {
+        Flush();
+        return fCentroids;
+    }
+
+} /* namespace Katydid */
+#endif /* KTTDIGEST_HH_ */
@@ -0,0 +1,160 @@
+/*
+ * KTThreadPool.cc
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ */
+
+#include "KTThreadPool.hh"
+
+namespace Katydid
+{
+
+    KTThreadPool::KTThreadPool(unsigned nThreads) :
+            fNThreads(1),
+            fWorkers(),
+            fMutex(),
+            fStartCondition(),
+            fDoneCondition(),
+            fTask(NULL),
+            fNTasks(0),
+            fNextTask(0),
+            fNWorkersBusy(0),
+            fGeneration(0),
+            fStopping(false),
+            fException()
+    {
+        SetNThreads(nThreads);
+    }
+
+    KTThreadPool::~KTThreadPool()
+    {
+        StopWorkers();
+    }
+
+    void KTThreadPool::SetNThreads(unsigned nThreads)
+    {
+        if (nThreads == 0) nThreads = 1;
+        if (nThreads == fNThreads && fWorkers.size() + 1 == fNThreads) return;
+
+        StopWorkers();
+        fNThreads = nThreads;
+        StartWorkers();
+        return;
+    }
+
+    void KTThreadPool::ParallelFor(unsigned nTasks, const Task& task)
+    {
+        if (nTasks == 0) return;
+
+        // nothing to share out; run the tasks in order here
+        if (fWorkers.empty() || nTasks == 1)
+        {
+            std::exception_ptr exception;
+            for (unsigned iTask = 0; iTask < nTasks; ++iTask)
+            {
+                try
+                {
+                    task(iTask, 0);
+                }
+                catch (...)
+                {
+                    if (! exception) exception = std::current_exception();
+                }
+            }
+            if (exception) std::rethrow_exception(exception);
+            return;
+        }
+
+        {
+            std::lock_guard< std::mutex > lock(fMutex);
+            fTask = &task;
+            fNTasks = nTasks;
+            fNextTask = 0;
+            fNWorkersBusy = fWorkers.size();
+            fException = std::exception_ptr();
+            ++fGeneration;
+        }
+        fStartCondition.notify_all();
+
+        RunTasks(0);
+
+        std::exception_ptr exception;
+        {
+            std::unique_lock< std::mutex > lock(fMutex);
+            fDoneCondition.wait(lock, [this]{ return fNWorkersBusy == 0; });
+            fTask = NULL;
+            exception = fException;
+            fException = std::exception_ptr();
+        }
+
+        if (exception) std::rethrow_exception(exception);
+        return;
+    }
+
+    void KTThreadPool::StartWorkers()
+    {
+        fStopping = false;
+        fWorkers.reserve(fNThreads - 1);
+        for (unsigned iWorker = 1; iWorker < fNThreads; ++iWorker)
+        {
+            // the worker has to know which loop it's been started after, in case it isn't running yet when the next loop is posted
+            fWorkers.push_back(std::thread(&KTThreadPool::WorkerLoop, this, iWorker, fGeneration));
+        }
+        return;
+    }
+
+    void KTThreadPool::StopWorkers()
+    {
+        {
+            std::lock_guard< std::mutex > lock(fMutex);
+            fStopping = true;
+        }
+        fStartCondition.notify_all();
+
+        for (std::vector< std::thread >::iterator wIt = fWorkers.begin(); wIt != fWorkers.end(); ++wIt)
+        {
+            wIt->join();
+        }
+        fWorkers.clear();
+        return;
+    }
+
+    void KTThreadPool::WorkerLoop(unsigned iWorker, unsigned long lastGeneration)
+    {
+        while (true)
+        {
+            {
+                std::unique_lock< std::mutex > lock(fMutex);
+                fStartCondition.wait(lock, [this, lastGeneration]{ return fStopping || fGeneration != lastGeneration; });
+                if (fStopping) return;
+                lastGeneration = fGeneration;
+            }
+
+            RunTasks(iWorker);
+
+            {
+                std::lock_guard< std::mutex > lock(fMutex);
+                if (--fNWorkersBusy == 0) fDoneCondition.notify_one();
+            }
+        }
+    }
+
+    void KTThreadPool::RunTasks(unsigned iWorker)
+    {
+        for (unsigned iTask = fNextTask++; iTask < fNTasks; iTask = fNextTask++)
+        {
+            try
+            {
+                (*fTask)(iTask, iWorker);
+            }
+            catch (...)
+            {
+                std::lock_guard< std::mutex > lock(fMutex);
+                if (! fException) fException = std::current_exception();
+            }
+        }
+        return;
+    }
+
+} /* namespace Katydid */
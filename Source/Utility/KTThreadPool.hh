@@ -0,0 +1,86 @@
+/**
+ @file KTThreadPool.hh
+ @brief Contains KTThreadPool
+ @details A fixed set of worker threads that run an indexed loop of independent tasks
+ @author: agent
+ @date: Oct 18, 2026
+ */
+
+#ifndef KTTHREADPOOL_HH_
+#define KTTHREADPOOL_HH_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Katydid
+{
+    /*!
+     @class KTThreadPool
+     @author agent
+
+     @brief Runs the iterations of a loop of independent tasks on a fixed set of threads.
+
+     @details
+     ParallelFor(nTasks, task) calls task(iTask, iWorker) once for every iTask in [0, nTasks) and returns when all of them are done.
+     iWorker identifies the thread running the task and is in [0, GetNThreads()), so a task can use per-worker scratch space
+     (e.g. an FFT input array) without locking.
+     The calling thread is worker 0 and takes tasks along with the others, so a pool with one thread creates no threads at all
+     and runs the tasks in order on the calling thread.
+
+     Tasks are handed out in increasing order, but may finish in any order; a task that produces a result should write it to
+     a slot reserved for its index, and the results should be collected after ParallelFor returns.
+
+     If a task throws, the remaining tasks are still run, and the first exception caught is rethrown from ParallelFor.
+     ParallelFor must not be called from within a task, or from more than one thread at a time.
+    */
+    class KTThreadPool
+    {
+        public:
+            typedef std::function< void (unsigned iTask, unsigned iWorker) > Task;
+
+        public:
+            KTThreadPool(unsigned nThreads = 1);
+            ~KTThreadPool();
+
+            /// Sets the total number of threads, including the calling thread; 0 is treated as 1
+            void SetNThreads(unsigned nThreads);
+            unsigned GetNThreads() const;
+
+            /// Runs task(iTask, iWorker) for every iTask in [0, nTasks), and returns when they've all finished
+            void ParallelFor(unsigned nTasks, const Task& task);
+
+        private:
+            void StartWorkers();
+            void StopWorkers();
+            void WorkerLoop(unsigned iWorker, unsigned long lastGeneration);
+            void RunTasks(unsigned iWorker);
+
+            unsigned fNThreads;
+            std::vector< std::thread > fWorkers;
+
+            std::mutex fMutex;
+            std::condition_variable fStartCondition;
+            std::condition_variable fDoneCondition;
+
+            // the current loop; set while ParallelFor is running
+            const Task* fTask;
+            unsigned fNTasks;
+            std::atomic< unsigned > fNextTask;
+            unsigned fNWorkersBusy;
+            unsigned long fGeneration;
+            bool fStopping;
+            std::exception_ptr fException;
+    };
+
+    inline unsigned KTThreadPool::GetNThreads() const
+    {
+        return fNThreads;
+    }
+
+} /* namespace Katydid */
+#endif /* KTTHREADPOOL_HH_ */
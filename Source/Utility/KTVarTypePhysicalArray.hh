@@ -183,6 +183,10 @@ namespace Katydid
             /// Axis range values do not have default values to avoid ambiguous function signatures
             KTVarTypePhysicalArray(size_t dataTypeSize, uint32_t dataFormat, size_t nBins, double rangeMin, double rangeMax);
 
+            /// View constructor w/ data type & format specified
+            /// The array refers to (but does not own or copy) the bytes at storage; the caller must keep that buffer alive for the lifetime of the array
+            KTVarTypePhysicalArray(storage_type storage, size_t dataTypeSize, uint32_t dataFormat, size_t nBins, double rangeMin, double rangeMax);
+
             /// Interface-only (copyData = false) or copy (copyData = true; default) constructor
             template< typename XOrigInterfaceType >
             KTVarTypePhysicalArray(const KTVarTypePhysicalArray< XOrigInterfaceType >& orig, bool copyData = true);
@@ -200,6 +204,9 @@ namespace Katydid
             size_t GetDataTypeSize() const;
             uint32_t GetDataFormat() const;
 
+            /// Returns false if the array is a view onto storage owned elsewhere
+            bool GetOwnsStorage() const;
+
         protected:
             bool fOwnsStorage;
 
@@ -326,6 +333,26 @@ namespace Katydid
     }
 
 
+    template< typename XInterfaceType >
+    KTVarTypePhysicalArray< XInterfaceType >::KTVarTypePhysicalArray(storage_type storage, size_t dataTypeSize, uint32_t dataFormat, size_t nBins, double rangeMin, double rangeMax) :
+            KTAxisProperties< 1 >(rangeMin, rangeMax),
+            fOwnsStorage(false),
+            fUByteData(storage),
+            fNBytes(nBins * dataTypeSize),
+            fDataTypeSize(dataTypeSize),
+            fDataFormat(dataFormat),
+            fArrayGetFcn(NULL),
+            fArraySetFcn(NULL)
+    {
+        try
+        {
+            SetInterfaceFunctions( dataTypeSize, dataFormat );
+        }
+        catch( Nymph::KTException& e ) {throw e;}
+        SetNBinsFunc(new KTNBinsInArray< 1, FixedSize >(nBins));
+    }
+
+
     template< typename XInterfaceType >
     template< typename XOrigInterfaceType >
     KTVarTypePhysicalArray< XInterfaceType >::KTVarTypePhysicalArray(const KTVarTypePhysicalArray< XOrigInterfaceType >& orig, bool copyData) :
@@ -366,6 +393,14 @@ namespace Katydid
     template< typename XOrigInterfaceType >
     KTVarTypePhysicalArray< XInterfaceType >& KTVarTypePhysicalArray< XInterfaceType >::operator=(const KTVarTypePhysicalArray< XOrigInterfaceType >& rhs)
     {
+        if (static_cast< const void* >(this) == static_cast< const void* >(&rhs)) return *this;
+
+        // release the old storage if it belongs to this array; if this was a view, the storage is left alone
+        if (fOwnsStorage && fUByteData != NULL)
+        {
+            delete [] fUByteData;
+        }
+
         SetNBinsFunc(new KTNBinsInArray< 1, FixedSize >(rhs.size()));
 
         fDataTypeSize = rhs.GetDataTypeSize();
@@ -495,6 +530,12 @@ namespace Katydid
         return fDataFormat;
     }
 
+    template< typename XInterfaceType >
+    inline bool KTVarTypePhysicalArray< XInterfaceType >::GetOwnsStorage() const
+    {
+        return fOwnsStorage;
+    }
+
 
     template< typename XInterfaceType >
     inline XInterfaceType KTVarTypePhysicalArray< XInterfaceType >::operator()(unsigned i) const